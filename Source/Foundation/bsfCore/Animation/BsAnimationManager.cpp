@@ -22,6 +22,11 @@ namespace bs
 		mBlendShapeVertexDesc->addVertElem(VET_UBYTE4_NORM, VES_NORMAL, 1, 1);
 	}
 
+	AnimationManager::~AnimationManager()
+	{
+		finishEvaluation();
+	}
+
 	void AnimationManager::setPaused(bool paused)
 	{
 		mPaused = paused;
@@ -38,20 +43,15 @@ namespace bs
 	const EvaluatedAnimationData* AnimationManager::update(bool async)
 	{
 		// Wait for any workers to complete
-		{
-			Lock lock(mMutex);
+		finishEvaluation();
 
-			while (mNumActiveWorkers > 0)
-				mWorkerDoneSignal.wait(lock);
-
-			// Advance the buffers (last write buffer becomes read buffer)
-			if(mSwapBuffers)
-			{
-				mPoseReadBufferIdx = (mPoseReadBufferIdx + 1) % (CoreThread::NUM_SYNC_BUFFERS + 1);
-				mPoseWriteBufferIdx = (mPoseWriteBufferIdx + 1) % (CoreThread::NUM_SYNC_BUFFERS + 1);
+		// Advance the buffers (last write buffer becomes read buffer)
+		if(mSwapBuffers)
+		{
+			mPoseReadBufferIdx = (mPoseReadBufferIdx + 1) % (CoreThread::NUM_SYNC_BUFFERS + 1);
+			mPoseWriteBufferIdx = (mPoseWriteBufferIdx + 1) % (CoreThread::NUM_SYNC_BUFFERS + 1);
 
-				mSwapBuffers = false;
-			}
+			mSwapBuffers = false;
 		}
 
 		if(mPaused)
@@ -99,58 +99,63 @@ namespace bs
 			mCullFrustums.push_back(entry.second->getWorldFrustum());
 		}
 
-		// Prepare the write buffer
+		cullAnimations();
+
+		// Queue visible animations for evaluation, and split them into chunks of roughly equal amount of work
+		mEvaluationEntries.clear();
+		mEvaluationChunks.clear();
+
 		UINT32 totalNumBones = 0;
-		for (auto& anim : mProxies)
+		UINT32 numChunkBones = 0;
+		for (UINT32 i = 0; i < (UINT32)mProxies.size(); i++)
 		{
-			if (anim->skeleton != nullptr)
-				totalNumBones += anim->skeleton->getNumBones();
+			AnimationProxy* anim = mProxies[i].get();
+			const UINT32 numBones = anim->skeleton != nullptr ? anim->skeleton->getNumBones() : 0;
+
+			if (mProxyVisibility[i])
+			{
+				if (numChunkBones == 0)
+					mEvaluationChunks.push_back((UINT32)mEvaluationEntries.size());
+
+				mEvaluationEntries.push_back({ anim, totalNumBones, false, EvaluatedAnimationData::AnimInfo() });
+
+				// Count every animation as at least one bone, as they have other data to evaluate
+				numChunkBones += std::max(numBones, 1U);
+				if (numChunkBones >= BONES_PER_CHUNK)
+					numChunkBones = 0;
+			}
+
+			totalNumBones += numBones;
 		}
 
+		const UINT32 numChunks = (UINT32)mEvaluationChunks.size();
+		mEvaluationChunks.push_back((UINT32)mEvaluationEntries.size());
+
 		// Prepare the write buffer
 		EvaluatedAnimationData& renderData = mAnimData[mPoseWriteBufferIdx];
 		renderData.transforms.resize(totalNumBones);
 		renderData.infos.clear();
 
 		// Queue animation evaluation tasks
+		if (numChunks > 0)
 		{
-			Lock lock(mMutex);
-			mNumActiveWorkers = (UINT32)mProxies.size();
-		}
-
-		UINT32 curBoneIdx = 0;
-		for (auto& anim : mProxies)
-		{
-			auto evaluateAnimWorker = [this, anim, curBoneIdx]()
+			auto evaluateAnimWorker = [this](UINT32 chunkIdx)
 			{
-				UINT32 boneIdx = curBoneIdx;
-				evaluateAnimation(anim.get(), boneIdx);
-
-				Lock lock(mMutex);
+				for (UINT32 i = mEvaluationChunks[chunkIdx]; i < mEvaluationChunks[chunkIdx + 1]; i++)
 				{
-					assert(mNumActiveWorkers > 0);
-					mNumActiveWorkers--;
+					EvaluationEntry& entry = mEvaluationEntries[i];
+					entry.hasAnimInfo = evaluateAnimation(entry.proxy, entry.boneIdx, entry.animInfo);
 				}
-
-				mWorkerDoneSignal.notify_one();
 			};
 
-			SPtr<Task> task = Task::create("AnimWorker", evaluateAnimWorker);
-			TaskScheduler::instance().addTask(task);
-
-			if (anim->skeleton != nullptr)
-				curBoneIdx += anim->skeleton->getNumBones();
+			mEvaluationTask = TaskGroup::create("AnimWorker", evaluateAnimWorker, numChunks);
+			TaskScheduler::instance().addTaskGroup(mEvaluationTask);
 		}
 
 		// Wait for tasks to complete
 		if(!async)
 		{
-			{
-				Lock lock(mMutex);
-
-				while (mNumActiveWorkers > 0)
-					mWorkerDoneSignal.wait(lock);
-			}
+			finishEvaluation();
 
 			// Trigger events and update attachments (for the data we just evaluated)
 			for (auto& anim : mAnimations)
@@ -165,30 +170,74 @@ namespace bs
 		return &mAnimData[mPoseReadBufferIdx];
 	}
 
-	void AnimationManager::evaluateAnimation(AnimationProxy* anim, UINT32& curBoneIdx)
+	void AnimationManager::cullAnimations()
 	{
-		if (anim->mCullEnabled)
+		const UINT32 numProxies = (UINT32)mProxies.size();
+		for (UINT32 i = 0; i < 3; i++)
 		{
-			bool isVisible = false;
-			for (auto& frustum : mCullFrustums)
+			mProxyCenters[i].resize(numProxies);
+			mProxyExtents[i].resize(numProxies);
+		}
+
+		for (UINT32 i = 0; i < numProxies; i++)
+		{
+			const AABox& bounds = mProxies[i]->mBounds;
+
+			const Vector3 center = bounds.getCenter();
+			const Vector3 extents = bounds.getHalfSize();
+
+			for (UINT32 j = 0; j < 3; j++)
 			{
-				if (frustum.intersects(anim->mBounds))
-				{
-					isVisible = true;
-					break;
-				}
+				mProxyCenters[j][i] = center[j];
+				mProxyExtents[j][i] = Math::abs(extents[j]);
 			}
+		}
+
+		mProxyVisibility.resize(numProxies);
+		mProxyVisibility.reset(false);
+
+		if (numProxies == 0)
+			return;
+
+		const float* const centers[3] = { mProxyCenters[0].data(), mProxyCenters[1].data(), mProxyCenters[2].data() };
+		const float* const extents[3] = { mProxyExtents[0].data(), mProxyExtents[1].data(), mProxyExtents[2].data() };
+
+		for (auto& frustum : mCullFrustums)
+			frustum.intersects(centers, extents, numProxies, mProxyVisibility.data());
+
+		for (UINT32 i = 0; i < numProxies; i++)
+		{
+			if (!mProxies[i]->mCullEnabled)
+				mProxyVisibility[i] = true;
+		}
+	}
 
-			if (!isVisible)
-				return;
+	void AnimationManager::finishEvaluation()
+	{
+		if (mEvaluationTask == nullptr)
+			return;
+
+		mEvaluationTask->wait();
+		mEvaluationTask = nullptr;
+
+		EvaluatedAnimationData& renderData = mAnimData[mPoseWriteBufferIdx];
+		for (auto& entry : mEvaluationEntries)
+		{
+			if (entry.hasAnimInfo)
+				renderData.infos[entry.proxy->id] = entry.animInfo;
 		}
 
+		mEvaluationEntries.clear();
+	}
+
+	bool AnimationManager::evaluateAnimation(AnimationProxy* anim, UINT32 boneIdx, 
+		EvaluatedAnimationData::AnimInfo& animInfo)
+	{
 		EvaluatedAnimationData& renderData = mAnimData[mPoseWriteBufferIdx];
 		
 		UINT32 prevPoseBufferIdx = (mPoseWriteBufferIdx + CoreThread::NUM_SYNC_BUFFERS) % (CoreThread::NUM_SYNC_BUFFERS + 1);
 		EvaluatedAnimationData& prevRenderData = mAnimData[prevPoseBufferIdx];
 
-		EvaluatedAnimationData::AnimInfo animInfo;
 		bool hasAnimInfo = false;
 
 		// Evaluate skeletal animation
@@ -198,11 +247,11 @@ namespace bs
 
 			EvaluatedAnimationData::PoseInfo& poseInfo = animInfo.poseInfo;
 			poseInfo.animId = anim->id;
-			poseInfo.startIdx = curBoneIdx;
+			poseInfo.startIdx = boneIdx;
 			poseInfo.numBones = numBones;
 
 			memset(anim->skeletonPose.hasOverride, 0, sizeof(bool) * anim->skeletonPose.numBones);
-			Matrix4* boneDst = renderData.transforms.data() + curBoneIdx;
+			Matrix4* boneDst = renderData.transforms.data() + boneIdx;
 
 			// Copy transforms from mapped scene objects
 			UINT32 boneTfrmIdx = 0;
@@ -221,7 +270,6 @@ namespace bs
 			// Animate bones
 			anim->skeleton->getPose(boneDst, anim->skeletonPose, anim->skeletonMask, anim->layers, anim->numLayers);
 
-			curBoneIdx += numBones;
 			hasAnimInfo = true;
 		}
 		else
@@ -497,11 +545,7 @@ namespace bs
 		else
 			animInfo.morphShapeInfo.version = 1;
 
-		if (hasAnimInfo)
-		{
-			Lock lock(mMutex);
-			renderData.infos[anim->id] = animInfo;
-		}
+		return hasAnimInfo;
 	}
 
 	UINT64 AnimationManager::registerAnimation(Animation* anim)
@@ -7,6 +7,7 @@
 #include "CoreThread/BsCoreThread.h"
 #include "Math/BsConvexVolume.h"
 #include "RenderAPI/BsVertexDataDesc.h"
+#include "Utility/BsBitfield.h"
 
 namespace bs
 {
@@ -58,6 +59,7 @@ namespace bs
 	{
 	public:
 		AnimationManager();
+		~AnimationManager();
 
 		/** Pauses or resumes the animation evaluation. */
 		void setPaused(bool paused);
@@ -105,14 +107,39 @@ namespace bs
 		/** Unregisters an animation with the specified ID. Must be called before an Animation is destroyed. */
 		void unregisterAnimation(UINT64 id);
 
+		/** Information about a single animation queued for evaluation, and the output of the evaluation. */
+		struct EvaluationEntry
+		{
+			AnimationProxy* proxy;
+			UINT32 boneIdx;
+			bool hasAnimInfo;
+			EvaluatedAnimationData::AnimInfo animInfo;
+		};
+
+		/** 
+		 * Determines which animation proxies are visible from any of the cull frustums, and outputs the result in 
+		 * mProxyVisibility. Bounds of all proxies are tested against each frustum in a single batch.
+		 */
+		void cullAnimations();
+
 		/** 
 		 * Evaluates animation for a single object and writes the result in the currently active write buffer. 
 		 *
 		 * @param[in]	anim		Proxy representing the animation to evaluate.
-		 * @param[in]	boneIdx		Index in the output buffer in which to write evaluated bone information. This will be
-		 *							automatically advanced by the number of written bone transforms.
+		 * @param[in]	boneIdx		Index in the output buffer in which to write evaluated bone information.
+		 * @param[out]	animInfo	Information about where the evaluated animation data is stored.
+		 * @return					True if @p animInfo was populated, false otherwise.
 		 */
-		void evaluateAnimation(AnimationProxy* anim, UINT32& boneIdx);
+		bool evaluateAnimation(AnimationProxy* anim, UINT32 boneIdx, EvaluatedAnimationData::AnimInfo& animInfo);
+
+		/** 
+		 * Blocks until the evaluation started by the last call to update() completes, and records the evaluated
+		 * animation information in the write buffer.
+		 */
+		void finishEvaluation();
+
+		/** Maximum number of bones to evaluate in a single evaluation task item. */
+		static constexpr UINT32 BONES_PER_CHUNK = 256;
 
 		UINT64 mNextId;
 		UnorderedMap<UINT64, Animation*> mAnimations;
@@ -130,13 +157,17 @@ namespace bs
 		Vector<ConvexVolume> mCullFrustums;
 		EvaluatedAnimationData mAnimData[CoreThread::NUM_SYNC_BUFFERS + 1];
 
+		Vector<float> mProxyCenters[3];
+		Vector<float> mProxyExtents[3];
+		Bitfield mProxyVisibility;
+
+		Vector<EvaluationEntry> mEvaluationEntries;
+		Vector<UINT32> mEvaluationChunks;
+		SPtr<TaskGroup> mEvaluationTask;
+
 		UINT32 mPoseReadBufferIdx;
 		UINT32 mPoseWriteBufferIdx;
-		
-		Signal mWorkerDoneSignal;
-		Mutex mMutex;
 
-		UINT32 mNumActiveWorkers = 0;
 		bool mSwapBuffers = false;
 	};
 
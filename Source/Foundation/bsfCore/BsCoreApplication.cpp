@@ -30,6 +30,7 @@
 #include "Profiling/BsProfilingManager.h"
 #include "Profiling/BsProfilerCPU.h"
 #include "Profiling/BsProfilerGPU.h"
+#include "Debug/BsTraceRecorder.h"
 #include "Managers/BsQueryManager.h"
 #include "Threading/BsThreadPool.h"
 #include "Threading/BsTaskScheduler.h"
@@ -113,6 +114,7 @@ namespace bs
 		ThreadPool::shutDown();
 		ProfilingManager::shutDown();
 		ProfilerCPU::shutDown();
+		TraceRecorder::shutDown();
 		MessageHandler::shutDown();
 		ShaderManager::shutDown();
 
@@ -131,6 +133,7 @@ namespace bs
 
 		ShaderManager::startUp(getShaderIncludeHandler());
 		MessageHandler::startUp();
+		TraceRecorder::startUp();
 		ProfilerCPU::startUp();
 		ProfilingManager::startUp();
 		ThreadPool::startUp<TThreadPool<ThreadBansheePolicy>>((numWorkerThreads));
@@ -238,6 +241,10 @@ namespace bs
 				const float stepSeconds = step / 1000000.0f;
 				for (UINT32 i = 0; i < numIterations; i++)
 				{
+					// Apply results of the physics step started by the previous fixed update, if it is running in the
+					// background, so this update observes them
+					gPhysics().syncSimulation();
+
 					fixedUpdate();
 					PROFILE_CALL(gSceneManager()._fixedUpdate(), "Scene fixed update");
 					PROFILE_CALL(gPhysics().fixedUpdate(stepSeconds), "Physics simulation");
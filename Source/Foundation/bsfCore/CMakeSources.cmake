@@ -231,6 +231,8 @@ set(BS_CORE_INC_IMAGE
 	"bsfCore/Image/BsPixelUtil.h"
 	"bsfCore/Image/BsPixelVolume.h"
 	"bsfCore/Image/BsSpriteTexture.h"
+	"bsfCore/Private/Image/BsPixelConversion.h"
+	"bsfCore/Private/Image/BsBlockDecoder.h"
 )
 
 set(BS_CORE_SRC_UTILITY
@@ -429,6 +431,8 @@ set(BS_CORE_SRC_IMAGE
 	"bsfCore/Image/BsTexture.cpp"
 	"bsfCore/Image/BsPixelUtil.cpp"
 	"bsfCore/Image/BsSpriteTexture.cpp"
+	"bsfCore/Private/Image/BsPixelConversion.cpp"
+	"bsfCore/Private/Image/BsBlockDecoder.cpp"
 )
 
 set(BS_CORE_SRC_MATERIAL
@@ -599,7 +603,9 @@ set(BS_CORE_INC_PARTICLES
 	"bsfCore/Particles/BsParticleDistribution.h"
 	"bsfCore/Particles/BsParticleModule.h"
 	"bsfCore/Particles/BsVectorField.h"
+	"bsfCore/Particles/BsParticleCommon.h"
 	"bsfCore/Private/Particles/BsParticleSet.h"
+	"bsfCore/Private/Particles/BsParticleKernels.h"
 )
 
 set(BS_CORE_SRC_PARTICLES
@@ -609,6 +615,7 @@ set(BS_CORE_SRC_PARTICLES
 	"bsfCore/Particles/BsParticleManager.cpp"
 	"bsfCore/Particles/BsParticleDistribution.cpp"
 	"bsfCore/Particles/BsVectorField.cpp"
+	"bsfCore/Private/Particles/BsParticleKernels.cpp"
 )
 
 set(BS_CORE_INC_PLATFORM
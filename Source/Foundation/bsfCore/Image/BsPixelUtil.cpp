@@ -6,10 +6,40 @@
 #include "Math/BsMath.h"
 #include "Error/BsException.h"
 #include "Image/BsTexture.h"
+#include "Private/Image/BsPixelConversion.h"
+#include "Private/Image/BsBlockDecoder.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Math/BsSIMD.h"
+#include "Math/BsVector3.h"
 #include <nvtt.h>
 
 namespace bs
 {
+	/** Images with at least this many pixels are processed on multiple threads. */
+	static constexpr UINT32 PARALLEL_MIN_PIXELS = 256 * 256;
+
+	/** Minimum number of pixels processed by a single thread at once. */
+	static constexpr UINT32 PARALLEL_GRAIN_PIXELS = 16384;
+
+	/**
+	 * Calls @p worker over the range [0, count), splitting the range over the task scheduler's workers if the image is
+	 * large enough. Each element of the range represents @p pixelsPerElement pixels, and each thread processes at least
+	 * @p grainPixels pixels at once.
+	 */
+	static void processPixelRange(UINT32 count, UINT32 pixelsPerElement,
+		const std::function<void(UINT32, UINT32)>& worker, UINT32 grainPixels = PARALLEL_GRAIN_PIXELS)
+	{
+		const bool parallel = count * pixelsPerElement >= PARALLEL_MIN_PIXELS && TaskScheduler::isStarted();
+
+		if (parallel)
+		{
+			const UINT32 grainSize = Math::divideAndRoundUp(grainPixels, pixelsPerElement);
+			TaskScheduler::instance().parallelFor(0, count, grainSize, worker);
+		}
+		else
+			worker(0, count);
+	}
+
 	/**
 	 * Performs pixel data resampling using the point filter (nearest neighbor). Does not perform format conversions.
 	 *
@@ -18,41 +48,48 @@ namespace bs
 	template<UINT32 elementSize> struct NearestResampler
 	{
 		static void scale(const PixelData& source, const PixelData& dest)
+		{
+			processPixelRange(dest.getHeight() * dest.getDepth(), dest.getWidth(), [&](UINT32 begin, UINT32 end)
+			{
+				scaleRows(source, dest, begin, end);
+			});
+		}
+
+		/** Resamples rows in range [begin, end) of @p dest, counting rows of all depth slices. */
+		static void scaleRows(const PixelData& source, const PixelData& dest, UINT32 begin, UINT32 end)
 		{
 			UINT8* sourceData = source.getData();
-			UINT8* destPtr = dest.getData();
 
 			// Get steps for traversing source data in 16/48 fixed point format
 			UINT64 stepX = ((UINT64)source.getWidth() << 48) / dest.getWidth();
 			UINT64 stepY = ((UINT64)source.getHeight() << 48) / dest.getHeight();
 			UINT64 stepZ = ((UINT64)source.getDepth() << 48) / dest.getDepth();
 
-			UINT64 curZ = (stepZ >> 1) - 1; // Offset half a pixel to start at pixel center
-			for (UINT32 z = dest.getFront(); z < dest.getBack(); z++, curZ += stepZ)
+			for (UINT32 row = begin; row < end; row++)
 			{
-				UINT32 offsetZ = (UINT32)(curZ >> 48) * source.getSlicePitch();
+				const UINT32 y = row % dest.getHeight();
+				const UINT32 z = row / dest.getHeight();
 
-				UINT64 curY = (stepY >> 1) - 1; // Offset half a pixel to start at pixel center
-				for (UINT32 y = dest.getTop(); y < dest.getBottom(); y++, curY += stepY)
-				{
-					UINT32 offsetY = (UINT32)(curY >> 48) * source.getRowPitch();
+				// Offset half a pixel to start at pixel center
+				UINT64 curZ = (stepZ >> 1) - 1 + z * stepZ;
+				UINT64 curY = (stepY >> 1) - 1 + y * stepY;
 
-					UINT64 curX = (stepX >> 1) - 1; // Offset half a pixel to start at pixel center
-					for (UINT32 x = dest.getLeft(); x < dest.getRight(); x++, curX += stepX)
-					{
-						UINT32 offsetX = (UINT32)(curX >> 48);
-						UINT32 offsetBytes = elementSize*(offsetX + offsetY + offsetZ);
+				UINT32 offsetZ = (UINT32)(curZ >> 48) * source.getSlicePitch();
+				UINT32 offsetY = (UINT32)(curY >> 48) * source.getRowPitch();
 
-						UINT8* curSourcePtr = sourceData + offsetBytes;
+				UINT8* destPtr = dest.getData() + elementSize * (y * dest.getRowPitch() + z * dest.getSlicePitch());
 
-						memcpy(destPtr, curSourcePtr, elementSize);
-						destPtr += elementSize;
-					}
+				UINT64 curX = (stepX >> 1) - 1; // Offset half a pixel to start at pixel center
+				for (UINT32 x = dest.getLeft(); x < dest.getRight(); x++, curX += stepX)
+				{
+					UINT32 offsetX = (UINT32)(curX >> 48);
+					UINT32 offsetBytes = elementSize*(offsetX + offsetY + offsetZ);
 
-					destPtr += elementSize*dest.getRowSkip();
-				}
+					UINT8* curSourcePtr = sourceData + offsetBytes;
 
-				destPtr += elementSize*dest.getSliceSkip();
+					memcpy(destPtr, curSourcePtr, elementSize);
+					destPtr += elementSize;
+				}
 			}
 		}
 	};
@@ -61,12 +98,20 @@ namespace bs
 	struct LinearResampler
 	{
 		static void scale(const PixelData& source, const PixelData& dest)
+		{
+			processPixelRange(dest.getHeight() * dest.getDepth(), dest.getWidth(), [&](UINT32 begin, UINT32 end)
+			{
+				scaleRows(source, dest, begin, end);
+			});
+		}
+
+		/** Resamples rows in range [begin, end) of @p dest, counting rows of all depth slices. */
+		static void scaleRows(const PixelData& source, const PixelData& dest, UINT32 begin, UINT32 end)
 		{
 			UINT32 sourceElemSize = PixelUtil::getNumElemBytes(source.getFormat());
 			UINT32 destElemSize = PixelUtil::getNumElemBytes(dest.getFormat());
 
 			UINT8* sourceData = source.getData();
-			UINT8* destPtr = dest.getData();
 
 			// Get steps for traversing source data in 16/48 fixed point precision format
 			UINT64 stepX = ((UINT64)source.getWidth() << 48) / dest.getWidth();
@@ -79,67 +124,67 @@ namespace bs
 			// that will be used for determining the blend amount.
 			UINT32 temp = 0;
 
-			UINT64 curZ = (stepZ >> 1) - 1; // Offset half a pixel to start at pixel center
-			for (UINT32 z = dest.getFront(); z < dest.getBack(); z++, curZ += stepZ)
+			for (UINT32 row = begin; row < end; row++)
 			{
+				const UINT32 y = row % dest.getHeight();
+				const UINT32 z = row / dest.getHeight();
+
+				// Offset half a pixel to start at pixel center
+				const UINT64 curZ = (stepZ >> 1) - 1 + z * stepZ;
+				const UINT64 curY = (stepY >> 1) - 1 + y * stepY;
+
 				temp = UINT32(curZ >> 32);
 				temp = (temp > 0x8000)? temp - 0x8000 : 0;
 				UINT32 sampleCoordZ1 = temp >> 16;
 				UINT32 sampleCoordZ2 = std::min(sampleCoordZ1 + 1, (UINT32)source.getDepth() - 1);
 				float sampleWeightZ = (temp & 0xFFFF) / 65536.0f;
 
-				UINT64 curY = (stepY >> 1) - 1; // Offset half a pixel to start at pixel center
-				for (UINT32 y = dest.getTop(); y < dest.getBottom(); y++, curY += stepY)
+				temp = (UINT32)(curY >> 32);
+				temp = (temp > 0x8000)? temp - 0x8000 : 0;
+				UINT32 sampleCoordY1 = temp >> 16;
+				UINT32 sampleCoordY2 = std::min(sampleCoordY1 + 1, (UINT32)source.getHeight() - 1);
+				float sampleWeightY = (temp & 0xFFFF) / 65536.0f;
+
+				UINT8* destPtr = dest.getData() + destElemSize * (y * dest.getRowPitch() + z * dest.getSlicePitch());
+
+				UINT64 curX = (stepX >> 1) - 1; // Offset half a pixel to start at pixel center
+				for (UINT32 x = dest.getLeft(); x < dest.getRight(); x++, curX += stepX)
 				{
-					temp = (UINT32)(curY >> 32);
+					temp = (UINT32)(curX >> 32);
 					temp = (temp > 0x8000)? temp - 0x8000 : 0;
-					UINT32 sampleCoordY1 = temp >> 16;
-					UINT32 sampleCoordY2 = std::min(sampleCoordY1 + 1, (UINT32)source.getHeight() - 1);
-					float sampleWeightY = (temp & 0xFFFF) / 65536.0f;
+					UINT32 sampleCoordX1 = temp >> 16;
+					UINT32 sampleCoordX2 = std::min(sampleCoordX1 + 1, (UINT32)source.getWidth() - 1);
+					float sampleWeightX = (temp & 0xFFFF) / 65536.0f;
 
-					UINT64 curX = (stepX >> 1) - 1; // Offset half a pixel to start at pixel center
-					for (UINT32 x = dest.getLeft(); x < dest.getRight(); x++, curX += stepX)
-					{
-						temp = (UINT32)(curX >> 32);
-						temp = (temp > 0x8000)? temp - 0x8000 : 0;
-						UINT32 sampleCoordX1 = temp >> 16;
-						UINT32 sampleCoordX2 = std::min(sampleCoordX1 + 1, (UINT32)source.getWidth() - 1);
-						float sampleWeightX = (temp & 0xFFFF) / 65536.0f;
-
-						Color x1y1z1, x2y1z1, x1y2z1, x2y2z1;
-						Color x1y1z2, x2y1z2, x1y2z2, x2y2z2;
+					Color x1y1z1, x2y1z1, x1y2z1, x2y2z1;
+					Color x1y1z2, x2y1z2, x1y2z2, x2y2z2;
 
 #define GETSOURCEDATA(x, y, z) sourceData + sourceElemSize*((x)+(y)*source.getRowPitch() + (z)*source.getSlicePitch())
 
-						PixelUtil::unpackColor(&x1y1z1, source.getFormat(), GETSOURCEDATA(sampleCoordX1, sampleCoordY1, sampleCoordZ1));
-						PixelUtil::unpackColor(&x2y1z1, source.getFormat(), GETSOURCEDATA(sampleCoordX2, sampleCoordY1, sampleCoordZ1));
-						PixelUtil::unpackColor(&x1y2z1, source.getFormat(), GETSOURCEDATA(sampleCoordX1, sampleCoordY2, sampleCoordZ1));
-						PixelUtil::unpackColor(&x2y2z1, source.getFormat(), GETSOURCEDATA(sampleCoordX2, sampleCoordY2, sampleCoordZ1));
-						PixelUtil::unpackColor(&x1y1z2, source.getFormat(), GETSOURCEDATA(sampleCoordX1, sampleCoordY1, sampleCoordZ2));
-						PixelUtil::unpackColor(&x2y1z2, source.getFormat(), GETSOURCEDATA(sampleCoordX2, sampleCoordY1, sampleCoordZ2));
-						PixelUtil::unpackColor(&x1y2z2, source.getFormat(), GETSOURCEDATA(sampleCoordX1, sampleCoordY2, sampleCoordZ2));
-						PixelUtil::unpackColor(&x2y2z2, source.getFormat(), GETSOURCEDATA(sampleCoordX2, sampleCoordY2, sampleCoordZ2));
+					PixelUtil::unpackColor(&x1y1z1, source.getFormat(), GETSOURCEDATA(sampleCoordX1, sampleCoordY1, sampleCoordZ1));
+					PixelUtil::unpackColor(&x2y1z1, source.getFormat(), GETSOURCEDATA(sampleCoordX2, sampleCoordY1, sampleCoordZ1));
+					PixelUtil::unpackColor(&x1y2z1, source.getFormat(), GETSOURCEDATA(sampleCoordX1, sampleCoordY2, sampleCoordZ1));
+					PixelUtil::unpackColor(&x2y2z1, source.getFormat(), GETSOURCEDATA(sampleCoordX2, sampleCoordY2, sampleCoordZ1));
+					PixelUtil::unpackColor(&x1y1z2, source.getFormat(), GETSOURCEDATA(sampleCoordX1, sampleCoordY1, sampleCoordZ2));
+					PixelUtil::unpackColor(&x2y1z2, source.getFormat(), GETSOURCEDATA(sampleCoordX2, sampleCoordY1, sampleCoordZ2));
+					PixelUtil::unpackColor(&x1y2z2, source.getFormat(), GETSOURCEDATA(sampleCoordX1, sampleCoordY2, sampleCoordZ2));
+					PixelUtil::unpackColor(&x2y2z2, source.getFormat(), GETSOURCEDATA(sampleCoordX2, sampleCoordY2, sampleCoordZ2));
 #undef GETSOURCEDATA
 
-						Color accum =
-							x1y1z1 * ((1.0f - sampleWeightX)*(1.0f - sampleWeightY)*(1.0f - sampleWeightZ)) +
-							x2y1z1 * (        sampleWeightX *(1.0f - sampleWeightY)*(1.0f - sampleWeightZ)) +
-							x1y2z1 * ((1.0f - sampleWeightX)*        sampleWeightY *(1.0f - sampleWeightZ)) +
-							x2y2z1 * (        sampleWeightX *        sampleWeightY *(1.0f - sampleWeightZ)) +
-							x1y1z2 * ((1.0f - sampleWeightX)*(1.0f - sampleWeightY)*        sampleWeightZ ) +
-							x2y1z2 * (        sampleWeightX *(1.0f - sampleWeightY)*        sampleWeightZ ) +
-							x1y2z2 * ((1.0f - sampleWeightX)*        sampleWeightY *        sampleWeightZ ) +
-							x2y2z2 * (        sampleWeightX *        sampleWeightY *        sampleWeightZ );
+					Color accum =
+						x1y1z1 * ((1.0f - sampleWeightX)*(1.0f - sampleWeightY)*(1.0f - sampleWeightZ)) +
+						x2y1z1 * (        sampleWeightX *(1.0f - sampleWeightY)*(1.0f - sampleWeightZ)) +
+						x1y2z1 * ((1.0f - sampleWeightX)*        sampleWeightY *(1.0f - sampleWeightZ)) +
+						x2y2z1 * (        sampleWeightX *        sampleWeightY *(1.0f - sampleWeightZ)) +
+						x1y1z2 * ((1.0f - sampleWeightX)*(1.0f - sampleWeightY)*        sampleWeightZ ) +
+						x2y1z2 * (        sampleWeightX *(1.0f - sampleWeightY)*        sampleWeightZ ) +
+						x1y2z2 * ((1.0f - sampleWeightX)*        sampleWeightY *        sampleWeightZ ) +
+						x2y2z2 * (        sampleWeightX *        sampleWeightY *        sampleWeightZ );
 
-						PixelUtil::packColor(accum, dest.getFormat(), destPtr);
-
-						destPtr += destElemSize;
-					}
+					PixelUtil::packColor(accum, dest.getFormat(), destPtr);
 
-					destPtr += destElemSize * dest.getRowSkip();
+					destPtr += destElemSize;
 				}
-
-				destPtr += destElemSize * dest.getSliceSkip();
 			}
 		}
 	};
@@ -152,12 +197,20 @@ namespace bs
 	struct LinearResampler_Float32
 	{
 		static void scale(const PixelData& source, const PixelData& dest)
+		{
+			processPixelRange(dest.getHeight() * dest.getDepth(), dest.getWidth(), [&](UINT32 begin, UINT32 end)
+			{
+				scaleRows(source, dest, begin, end);
+			});
+		}
+
+		/** Resamples rows in range [begin, end) of @p dest, counting rows of all depth slices. */
+		static void scaleRows(const PixelData& source, const PixelData& dest, UINT32 begin, UINT32 end)
 		{
 			UINT32 numSourceChannels = PixelUtil::getNumElemBytes(source.getFormat()) / sizeof(float);
 			UINT32 numDestChannels = PixelUtil::getNumElemBytes(dest.getFormat()) / sizeof(float);
 
 			float* sourceData = (float*)source.getData();
-			float* destPtr = (float*)dest.getData();
 
 			// Get steps for traversing source data in 16/48 fixed point precision format
 			UINT64 stepX = ((UINT64)source.getWidth() << 48) / dest.getWidth();
@@ -170,87 +223,88 @@ namespace bs
 			// that will be used for determining the blend amount.
 			UINT32 temp = 0;
 
-			UINT64 curZ = (stepZ >> 1) - 1; // Offset half a pixel to start at pixel center
-			for (UINT32 z = dest.getFront(); z < dest.getBack(); z++, curZ += stepZ)
+			for (UINT32 row = begin; row < end; row++)
 			{
+				const UINT32 y = row % dest.getHeight();
+				const UINT32 z = row / dest.getHeight();
+
+				// Offset half a pixel to start at pixel center
+				const UINT64 curZ = (stepZ >> 1) - 1 + z * stepZ;
+				const UINT64 curY = (stepY >> 1) - 1 + y * stepY;
+
 				temp = (UINT32)(curZ >> 32);
 				temp = (temp > 0x8000)? temp - 0x8000 : 0;
 				UINT32 sampleCoordZ1 = temp >> 16;
 				UINT32 sampleCoordZ2 = std::min(sampleCoordZ1 + 1, (UINT32)source.getDepth() - 1);
 				float sampleWeightZ = (temp & 0xFFFF) / 65536.0f;
 
-				UINT64 curY = (stepY >> 1) - 1; // Offset half a pixel to start at pixel center
-				for (UINT32 y = dest.getTop(); y < dest.getBottom(); y++, curY += stepY)
+				temp = (UINT32)(curY >> 32);
+				temp = (temp > 0x8000)? temp - 0x8000 : 0;
+				UINT32 sampleCoordY1 = temp >> 16;
+				UINT32 sampleCoordY2 = std::min(sampleCoordY1 + 1, (UINT32)source.getHeight() - 1);
+				float sampleWeightY = (temp & 0xFFFF) / 65536.0f;
+
+				float* destPtr = (float*)dest.getData() +
+					numDestChannels * (y * dest.getRowPitch() + z * dest.getSlicePitch());
+
+				UINT64 curX = (stepX >> 1) - 1; // Offset half a pixel to start at pixel center
+				for (UINT32 x = dest.getLeft(); x < dest.getRight(); x++, curX += stepX)
 				{
-					temp = (UINT32)(curY >> 32);
+					temp = (UINT32)(curX >> 32);
 					temp = (temp > 0x8000)? temp - 0x8000 : 0;
-					UINT32 sampleCoordY1 = temp >> 16;
-					UINT32 sampleCoordY2 = std::min(sampleCoordY1 + 1, (UINT32)source.getHeight() - 1);
-					float sampleWeightY = (temp & 0xFFFF) / 65536.0f;
+					UINT32 sampleCoordX1 = temp >> 16;
+					UINT32 sampleCoordX2 = std::min(sampleCoordX1 + 1, (UINT32)source.getWidth() - 1);
+					float sampleWeightX = (temp & 0xFFFF) / 65536.0f;
 
-					UINT64 curX = (stepX >> 1) - 1; // Offset half a pixel to start at pixel center
-					for (UINT32 x = dest.getLeft(); x < dest.getRight(); x++, curX += stepX)
-					{
-						temp = (UINT32)(curX >> 32);
-						temp = (temp > 0x8000)? temp - 0x8000 : 0;
-						UINT32 sampleCoordX1 = temp >> 16;
-						UINT32 sampleCoordX2 = std::min(sampleCoordX1 + 1, (UINT32)source.getWidth() - 1);
-						float sampleWeightX = (temp & 0xFFFF) / 65536.0f;
-
-						// process R,G,B,A simultaneously for cache coherence?
-						float accum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+					// process R,G,B,A simultaneously for cache coherence?
+					float accum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
 
 
 #define ACCUM3(x,y,z,factor) \
-						{ float f = factor; \
-						UINT32 offset = (x + y*source.getRowPitch() + z*source.getSlicePitch())*numSourceChannels; \
-						accum[0] += sourceData[offset + 0] * f; accum[1] += sourceData[offset + 1] * f; \
-						accum[2] += sourceData[offset + 2] * f; }
+					{ float f = factor; \
+					UINT32 offset = (x + y*source.getRowPitch() + z*source.getSlicePitch())*numSourceChannels; \
+					accum[0] += sourceData[offset + 0] * f; accum[1] += sourceData[offset + 1] * f; \
+					accum[2] += sourceData[offset + 2] * f; }
 
 #define ACCUM4(x,y,z,factor) \
-						{ float f = factor; \
-						UINT32 offset = (x + y*source.getRowPitch() + z*source.getSlicePitch())*numSourceChannels; \
-						accum[0] += sourceData[offset + 0] * f; accum[1] += sourceData[offset + 1] * f; \
-						accum[2] += sourceData[offset + 2] * f; accum[3] += sourceData[offset + 3] * f; }
+					{ float f = factor; \
+					UINT32 offset = (x + y*source.getRowPitch() + z*source.getSlicePitch())*numSourceChannels; \
+					accum[0] += sourceData[offset + 0] * f; accum[1] += sourceData[offset + 1] * f; \
+					accum[2] += sourceData[offset + 2] * f; accum[3] += sourceData[offset + 3] * f; }
 
-						if (numSourceChannels == 3 || numDestChannels == 3)
-						{
-							// RGB
-							ACCUM3(sampleCoordX1, sampleCoordY1, sampleCoordZ1, (1.0f - sampleWeightX) * (1.0f - sampleWeightY) * (1.0f - sampleWeightZ));
-							ACCUM3(sampleCoordX2, sampleCoordY1, sampleCoordZ1, sampleWeightX		   * (1.0f - sampleWeightY) * (1.0f - sampleWeightZ));
-							ACCUM3(sampleCoordX1, sampleCoordY2, sampleCoordZ1, (1.0f - sampleWeightX) * sampleWeightY			* (1.0f - sampleWeightZ));
-							ACCUM3(sampleCoordX2, sampleCoordY2, sampleCoordZ1, sampleWeightX		   * sampleWeightY		    * (1.0f - sampleWeightZ));
-							ACCUM3(sampleCoordX1, sampleCoordY1, sampleCoordZ2, (1.0f - sampleWeightX) * (1.0f - sampleWeightY) * sampleWeightZ);
-							ACCUM3(sampleCoordX2, sampleCoordY1, sampleCoordZ2, sampleWeightX		   * (1.0f - sampleWeightY) * sampleWeightZ);
-							ACCUM3(sampleCoordX1, sampleCoordY2, sampleCoordZ2, (1.0f - sampleWeightX) * sampleWeightY			* sampleWeightZ);
-							ACCUM3(sampleCoordX2, sampleCoordY2, sampleCoordZ2, sampleWeightX		   * sampleWeightY			* sampleWeightZ);
-							accum[3] = 1.0f;
-						}
-						else
-						{
-							// RGBA
-							ACCUM4(sampleCoordX1, sampleCoordY1, sampleCoordZ1, (1.0f - sampleWeightX) * (1.0f - sampleWeightY) * (1.0f - sampleWeightZ));
-							ACCUM4(sampleCoordX2, sampleCoordY1, sampleCoordZ1, sampleWeightX		   * (1.0f - sampleWeightY) * (1.0f - sampleWeightZ));
-							ACCUM4(sampleCoordX1, sampleCoordY2, sampleCoordZ1, (1.0f - sampleWeightX) * sampleWeightY			* (1.0f - sampleWeightZ));
-							ACCUM4(sampleCoordX2, sampleCoordY2, sampleCoordZ1, sampleWeightX		   * sampleWeightY			* (1.0f - sampleWeightZ));
-							ACCUM4(sampleCoordX1, sampleCoordY1, sampleCoordZ2, (1.0f - sampleWeightX) * (1.0f - sampleWeightY) * sampleWeightZ);
-							ACCUM4(sampleCoordX2, sampleCoordY1, sampleCoordZ2, sampleWeightX		   * (1.0f - sampleWeightY) * sampleWeightZ);
-							ACCUM4(sampleCoordX1, sampleCoordY2, sampleCoordZ2, (1.0f - sampleWeightX) * sampleWeightY			* sampleWeightZ);
-							ACCUM4(sampleCoordX2, sampleCoordY2, sampleCoordZ2, sampleWeightX		   * sampleWeightY			* sampleWeightZ);
-						}
+					if (numSourceChannels == 3 || numDestChannels == 3)
+					{
+						// RGB
+						ACCUM3(sampleCoordX1, sampleCoordY1, sampleCoordZ1, (1.0f - sampleWeightX) * (1.0f - sampleWeightY) * (1.0f - sampleWeightZ));
+						ACCUM3(sampleCoordX2, sampleCoordY1, sampleCoordZ1, sampleWeightX		   * (1.0f - sampleWeightY) * (1.0f - sampleWeightZ));
+						ACCUM3(sampleCoordX1, sampleCoordY2, sampleCoordZ1, (1.0f - sampleWeightX) * sampleWeightY			* (1.0f - sampleWeightZ));
+						ACCUM3(sampleCoordX2, sampleCoordY2, sampleCoordZ1, sampleWeightX		   * sampleWeightY		    * (1.0f - sampleWeightZ));
+						ACCUM3(sampleCoordX1, sampleCoordY1, sampleCoordZ2, (1.0f - sampleWeightX) * (1.0f - sampleWeightY) * sampleWeightZ);
+						ACCUM3(sampleCoordX2, sampleCoordY1, sampleCoordZ2, sampleWeightX		   * (1.0f - sampleWeightY) * sampleWeightZ);
+						ACCUM3(sampleCoordX1, sampleCoordY2, sampleCoordZ2, (1.0f - sampleWeightX) * sampleWeightY			* sampleWeightZ);
+						ACCUM3(sampleCoordX2, sampleCoordY2, sampleCoordZ2, sampleWeightX		   * sampleWeightY			* sampleWeightZ);
+						accum[3] = 1.0f;
+					}
+					else
+					{
+						// RGBA
+						ACCUM4(sampleCoordX1, sampleCoordY1, sampleCoordZ1, (1.0f - sampleWeightX) * (1.0f - sampleWeightY) * (1.0f - sampleWeightZ));
+						ACCUM4(sampleCoordX2, sampleCoordY1, sampleCoordZ1, sampleWeightX		   * (1.0f - sampleWeightY) * (1.0f - sampleWeightZ));
+						ACCUM4(sampleCoordX1, sampleCoordY2, sampleCoordZ1, (1.0f - sampleWeightX) * sampleWeightY			* (1.0f - sampleWeightZ));
+						ACCUM4(sampleCoordX2, sampleCoordY2, sampleCoordZ1, sampleWeightX		   * sampleWeightY			* (1.0f - sampleWeightZ));
+						ACCUM4(sampleCoordX1, sampleCoordY1, sampleCoordZ2, (1.0f - sampleWeightX) * (1.0f - sampleWeightY) * sampleWeightZ);
+						ACCUM4(sampleCoordX2, sampleCoordY1, sampleCoordZ2, sampleWeightX		   * (1.0f - sampleWeightY) * sampleWeightZ);
+						ACCUM4(sampleCoordX1, sampleCoordY2, sampleCoordZ2, (1.0f - sampleWeightX) * sampleWeightY			* sampleWeightZ);
+						ACCUM4(sampleCoordX2, sampleCoordY2, sampleCoordZ2, sampleWeightX		   * sampleWeightY			* sampleWeightZ);
+					}
 
-						memcpy(destPtr, accum, sizeof(float)*numDestChannels);
+					memcpy(destPtr, accum, sizeof(float)*numDestChannels);
 
 #undef ACCUM3
 #undef ACCUM4
 
-						destPtr += numDestChannels;
-					}
-
-					destPtr += numDestChannels*dest.getRowSkip();
+					destPtr += numDestChannels;
 				}
-
-				destPtr += numDestChannels*dest.getSliceSkip();
 			}
 		}
 	};
@@ -280,8 +334,16 @@ namespace bs
 				return;
 			}
 
+			processPixelRange(dest.getHeight(), dest.getWidth(), [&](UINT32 begin, UINT32 end)
+			{
+				scaleRows(source, dest, begin, end);
+			});
+		}
+
+		/** Resamples rows in range [begin, end) of @p dest. Only handles 2D data. */
+		static void scaleRows(const PixelData& source, const PixelData& dest, UINT32 begin, UINT32 end)
+		{
 			UINT8* sourceData = (UINT8*)source.getData();
-			UINT8* destPtr = (UINT8*)dest.getData();
 
 			// Get steps for traversing source data in 16/48 fixed point precision format
 			UINT64 stepX = ((UINT64)source.getWidth() << 48) / dest.getWidth();
@@ -293,9 +355,10 @@ namespace bs
 			// that will be used for determining the blend amount.
 			UINT32 temp;
 
-			UINT64 curY = (stepY >> 1) - 1; // Offset half a pixel to start at pixel center
-			for (UINT32 y = dest.getTop(); y < dest.getBottom(); y++, curY += stepY)
+			for (UINT32 y = begin; y < end; y++)
 			{
+				const UINT64 curY = (stepY >> 1) - 1 + y * stepY; // Offset half a pixel to start at pixel center
+
 				temp = (UINT32)(curY >> 36);
 				temp = (temp > 0x800)? temp - 0x800: 0;
 				UINT32 sampleWeightY = temp & 0xFFF;
@@ -305,6 +368,8 @@ namespace bs
 				UINT32 sampleY1Offset = sampleCoordY1 * source.getRowPitch();
 				UINT32 sampleY2Offset = sampleCoordY2 * source.getRowPitch();
 
+				UINT8* destPtr = (UINT8*)dest.getData() + channels * y * dest.getRowPitch();
+
 				UINT64 curX = (stepX >> 1) - 1; // Offset half a pixel to start at pixel center
 				for (UINT32 x = dest.getLeft(); x < dest.getRight(); x++, curX += stepX)
 				{
@@ -328,11 +393,463 @@ namespace bs
 						destPtr++;
 					}
 				}
-				destPtr += channels*dest.getRowSkip();
 			}
 		}
 	};
 
+	/** Number of intervals in the lookup tables used for converting between sRGB and linear space. */
+	static constexpr UINT32 SRGB_LUT_SIZE = 4096;
+
+	/** Converts a value in range [0, 1] from sRGB to linear space. */
+	static float srgbToLinear(float value)
+	{
+		if (value <= 0.04045f)
+			return value / 12.92f;
+
+		return std::pow((value + 0.055f) / 1.055f, 2.4f);
+	}
+
+	/** Converts a value in range [0, 1] from linear to sRGB space. */
+	static float linearToSrgb(float value)
+	{
+		if (value <= 0.0031308f)
+			return value * 12.92f;
+
+		return 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+	}
+
+	/**
+	 * Approximates a color space conversion over range [0, 1] by linearly interpolating a lookup table. Values outside
+	 * of the range are clamped.
+	 */
+	struct ColorSpaceLUT
+	{
+		ColorSpaceLUT(float(*convert)(float))
+		{
+			for (UINT32 i = 0; i <= SRGB_LUT_SIZE; i++)
+				values[i] = convert(i / (float)SRGB_LUT_SIZE);
+		}
+
+		float operator()(float value) const
+		{
+			const float position = Math::clamp01(value) * SRGB_LUT_SIZE;
+			const UINT32 index = std::min((UINT32)position, SRGB_LUT_SIZE - 1);
+			const float fraction = position - index;
+
+			return values[index] + (values[index + 1] - values[index]) * fraction;
+		}
+
+		float values[SRGB_LUT_SIZE + 1];
+	};
+
+	/** Returns a lookup table converting from sRGB to linear space. */
+	static const ColorSpaceLUT& getSrgbToLinearLUT()
+	{
+		static const ColorSpaceLUT lut(&srgbToLinear);
+		return lut;
+	}
+
+	/** Returns a lookup table converting from linear to sRGB space. */
+	static const ColorSpaceLUT& getLinearToSrgbLUT()
+	{
+		static const ColorSpaceLUT lut(&linearToSrgb);
+		return lut;
+	}
+
+	/**
+	 * Reads @p count pixels from a row of a 2D image, starting at the provided coordinates, and outputs them as linear
+	 * RGBA32F.
+	 *
+	 * @param[in]	src			Image to read from.
+	 * @param[in]	convert		Kernel converting from the format of @p src to PF_RGBA32F, or null if there is none.
+	 * @param[in]	isSRGB		If true the color channels of @p src are in sRGB space.
+	 * @param[in]	x			Horizontal coordinate of the first pixel to read.
+	 * @param[in]	y			Row to read from.
+	 * @param[in]	count		Number of pixels to read.
+	 * @param[out]	output		Buffer with room for @p count RGBA32F pixels.
+	 */
+	static void readLinearPixels(const PixelData& src, PixelRowConversionFunc convert, bool isSRGB, UINT32 x, UINT32 y,
+		UINT32 count, float* output)
+	{
+		const UINT32 pixelSize = PixelUtil::getNumElemBytes(src.getFormat());
+		const UINT8* srcPtr = src.getData()
+			+ (src.getLeft() + x + (src.getTop() + y) * src.getRowPitch()) * pixelSize;
+
+		if (src.getFormat() == PF_RGBA32F)
+			memcpy(output, srcPtr, count * pixelSize);
+		else if (convert != nullptr)
+			convert(srcPtr, (UINT8*)output, count);
+		else
+		{
+			for (UINT32 i = 0; i < count; i++)
+			{
+				float* pixel = output + i * 4;
+				PixelUtil::unpackColor(&pixel[0], &pixel[1], &pixel[2], &pixel[3], src.getFormat(),
+					srcPtr + i * pixelSize);
+			}
+		}
+
+		if (isSRGB)
+		{
+			const ColorSpaceLUT& toLinear = getSrgbToLinearLUT();
+			for (UINT32 i = 0; i < count; i++)
+			{
+				float* pixel = output + i * 4;
+				pixel[0] = toLinear(pixel[0]);
+				pixel[1] = toLinear(pixel[1]);
+				pixel[2] = toLinear(pixel[2]);
+			}
+		}
+	}
+
+	/** Minimum number of pixels filtered by a single thread at once by the separable mip-map filters. */
+	static constexpr UINT32 MIP_FILTER_GRAIN_PIXELS = PARALLEL_GRAIN_PIXELS * 8;
+
+	/** Maximum number of mip levels generated from a single tile of the source image by the box filter. */
+	static constexpr UINT32 MIP_TILE_LEVELS = 6;
+
+	/** Returns the radius of a mip-map filter, in destination pixels. */
+	static float getFilterRadius(MipMapFilter filter)
+	{
+		switch (filter)
+		{
+		case MipMapFilter::Box:
+			return 0.5f;
+		case MipMapFilter::Triangle:
+			return 1.0f;
+		default:
+			return 3.0f;
+		}
+	}
+
+	/** Normalized sinc function. */
+	static float sinc(float x)
+	{
+		if (std::abs(x) < 1e-5f)
+			return 1.0f;
+
+		x *= Math::PI;
+		return std::sin(x) / x;
+	}
+
+	/** Zeroth order modified Bessel function of the first kind. */
+	static float bessel0(float x)
+	{
+		float sum = 1.0f;
+		float term = 1.0f;
+		for (UINT32 i = 1; i < 32; i++)
+		{
+			const float factor = x * 0.5f / i;
+			term *= factor * factor;
+			sum += term;
+
+			if (term < sum * 1e-7f)
+				break;
+		}
+
+		return sum;
+	}
+
+	/** Evaluates a mip-map filter at the provided distance from its center, in destination pixels. */
+	static float evaluateFilter(MipMapFilter filter, float x)
+	{
+		x = std::abs(x);
+
+		switch (filter)
+		{
+		case MipMapFilter::Box:
+			return x <= 0.5f ? 1.0f : 0.0f;
+		case MipMapFilter::Triangle:
+			return std::max(0.0f, 1.0f - x);
+		case MipMapFilter::Kaiser:
+		{
+			static constexpr float ALPHA = 4.0f;
+			const float radius = getFilterRadius(filter);
+			if (x >= radius)
+				return 0.0f;
+
+			const float t = x / radius;
+			return sinc(x) * bessel0(ALPHA * std::sqrt(1.0f - t * t)) / bessel0(ALPHA);
+		}
+		case MipMapFilter::Lanczos:
+		{
+			const float radius = getFilterRadius(filter);
+			if (x >= radius)
+				return 0.0f;
+
+			return sinc(x) * sinc(x / radius);
+		}
+		}
+
+		return 0.0f;
+	}
+
+	/** Maps a pixel coordinate outside of an image of size @p size back into the image. */
+	static UINT32 wrapPixelCoordinate(INT32 coord, UINT32 size, MipMapWrapMode wrapMode)
+	{
+		switch (wrapMode)
+		{
+		case MipMapWrapMode::Clamp:
+			return (UINT32)Math::clamp(coord, 0, (INT32)size - 1);
+		case MipMapWrapMode::Repeat:
+			return (UINT32)(((coord % (INT32)size) + (INT32)size) % (INT32)size);
+		default:
+		case MipMapWrapMode::Mirror:
+		{
+			const INT32 period = (INT32)size * 2;
+			const INT32 wrapped = ((coord % period) + period) % period;
+
+			return (UINT32)(wrapped < (INT32)size ? wrapped : period - 1 - wrapped);
+		}
+		}
+	}
+
+	/** Source pixels and weights used for downsampling a single dimension of an image. */
+	struct MipMapFilterTaps
+	{
+		MipMapFilterTaps(UINT32 srcSize, UINT32 dstSize, MipMapFilter filter, MipMapWrapMode wrapMode)
+		{
+			const float scale = srcSize / (float)dstSize;
+			const float radius = getFilterRadius(filter) * scale;
+
+			count = (UINT32)std::floor(radius * 2.0f) + 1;
+			indices.resize(dstSize * count);
+			weights.resize(dstSize * count);
+
+			for (UINT32 i = 0; i < dstSize; i++)
+			{
+				const float center = (i + 0.5f) * scale;
+				const INT32 first = (INT32)std::ceil(center - radius - 0.5f);
+
+				float total = 0.0f;
+				for (UINT32 j = 0; j < count; j++)
+				{
+					const INT32 coord = first + (INT32)j;
+					const float weight = evaluateFilter(filter, (coord + 0.5f - center) / scale);
+
+					indices[i * count + j] = wrapPixelCoordinate(coord, srcSize, wrapMode);
+					weights[i * count + j] = weight;
+					total += weight;
+				}
+
+				if (total != 0.0f)
+				{
+					for (UINT32 j = 0; j < count; j++)
+						weights[i * count + j] /= total;
+				}
+			}
+		}
+
+		UINT32 count; /**< Number of taps per destination pixel. */
+		Vector<UINT32> indices; /**< Index of the source pixel read by each tap. */
+		Vector<float> weights; /**< Normalized weight of each tap. */
+	};
+
+	/**
+	 * Generates a mip level by downsampling @p src with a separable filter. Rows of the destination are processed in
+	 * parallel bands, each filtering the source rows it needs horizontally and then filtering those vertically.
+	 *
+	 * @param[in]	src			Image to downsample.
+	 * @param[in]	convert		Kernel converting from the format of @p src to PF_RGBA32F, or null if there is none.
+	 * @param[in]	isSRGB		If true the color channels of @p src are in sRGB space.
+	 * @param[out]	dst			Destination image, in PF_RGBA32F format.
+	 * @param[in]	options		Options determining the filter and how to handle pixels outside of the image.
+	 */
+	static void downsampleSeparable(const PixelData& src, PixelRowConversionFunc convert, bool isSRGB, PixelData& dst,
+		const MipMapGenOptions& options)
+	{
+		using namespace simd;
+
+		const UINT32 srcWidth = src.getWidth();
+		const UINT32 dstWidth = dst.getWidth();
+
+		const MipMapFilterTaps tapsX(srcWidth, dstWidth, options.filter, options.wrapMode);
+		const MipMapFilterTaps tapsY(src.getHeight(), dst.getHeight(), options.filter, options.wrapMode);
+
+		processPixelRange(dst.getHeight(), dstWidth, [&](UINT32 begin, UINT32 end)
+		{
+			// Source rows needed by the band, which might wrap around the image
+			UnorderedMap<UINT32, UINT32> bandRows;
+			for (UINT32 i = begin * tapsY.count; i < end * tapsY.count; i++)
+			{
+				if (tapsY.weights[i] != 0.0f)
+					bandRows.insert(std::make_pair(tapsY.indices[i], (UINT32)bandRows.size()));
+			}
+
+			Vector<float> sourceRow(srcWidth * 4);
+			Vector<float> filteredRows(bandRows.size() * dstWidth * 4);
+			for (auto& entry : bandRows)
+			{
+				readLinearPixels(src, convert, isSRGB, 0, entry.first, srcWidth, sourceRow.data());
+
+				float* output = filteredRows.data() + entry.second * dstWidth * 4;
+				for (UINT32 x = 0; x < dstWidth; x++)
+				{
+					float32x4 sum = splat<float32x4>(0.0f);
+					for (UINT32 i = x * tapsX.count; i < (x + 1) * tapsX.count; i++)
+					{
+						const float32x4 pixel = load_u<float32x4>(sourceRow.data() + tapsX.indices[i] * 4);
+						sum = add(sum, mul(pixel, splat<float32x4>(tapsX.weights[i])));
+					}
+
+					store_u(output + x * 4, sum);
+				}
+			}
+
+			for (UINT32 y = begin; y < end; y++)
+			{
+				float* output = (float*)dst.getData() + y * dst.getRowPitch() * 4;
+				memset(output, 0, dstWidth * 4 * sizeof(float));
+
+				for (UINT32 i = y * tapsY.count; i < (y + 1) * tapsY.count; i++)
+				{
+					if (tapsY.weights[i] == 0.0f)
+						continue;
+
+					const float* input = filteredRows.data() + bandRows[tapsY.indices[i]] * dstWidth * 4;
+					const float32x4 weight = splat<float32x4>(tapsY.weights[i]);
+					for (UINT32 x = 0; x < dstWidth * 4; x += 4)
+					{
+						const float32x4 weighted = mul(load_u<float32x4>(input + x), weight);
+						store_u(output + x, add(load_u<float32x4>(output + x), weighted));
+					}
+				}
+			}
+		}, MIP_FILTER_GRAIN_PIXELS);
+	}
+
+	/**
+	 * Generates multiple mip levels at once using the box filter. The source is split into square tiles which are
+	 * downsampled in cache, all the way to a single pixel, before moving onto the next tile. Tiles are processed in
+	 * parallel.
+	 *
+	 * @param[in]	src			Image to downsample. Its width and height must be multiples of the tile size.
+	 * @param[in]	convert		Kernel converting from the format of @p src to PF_RGBA32F, or null if there is none.
+	 * @param[in]	isSRGB		If true the color channels of @p src are in sRGB space.
+	 * @param[out]	levels		Destination mip levels in PF_RGBA32F format, each half the size of the previous one. The
+	 *							number of levels determines the tile size.
+	 */
+	static void downsampleBoxTiled(const PixelData& src, PixelRowConversionFunc convert, bool isSRGB,
+		const Vector<PixelData*>& levels)
+	{
+		using namespace simd;
+
+		const UINT32 numLevels = (UINT32)levels.size();
+		const UINT32 tileSize = 1 << numLevels;
+		const UINT32 numTilesX = src.getWidth() >> numLevels;
+		const UINT32 numTilesY = src.getHeight() >> numLevels;
+
+		processPixelRange(numTilesY, src.getWidth() * tileSize, [&](UINT32 begin, UINT32 end)
+		{
+			Vector<float> tileData[2];
+			tileData[0].resize(tileSize * tileSize * 4);
+			tileData[1].resize(tileSize * tileSize * 4);
+
+			for (UINT32 tileY = begin; tileY < end; tileY++)
+			{
+				for (UINT32 tileX = 0; tileX < numTilesX; tileX++)
+				{
+					float* input = tileData[0].data();
+					float* output = tileData[1].data();
+
+					for (UINT32 y = 0; y < tileSize; y++)
+					{
+						readLinearPixels(src, convert, isSRGB, tileX * tileSize, tileY * tileSize + y, tileSize,
+							input + y * tileSize * 4);
+					}
+
+					UINT32 size = tileSize;
+					for (UINT32 i = 0; i < numLevels; i++)
+					{
+						const UINT32 halfSize = size / 2;
+						for (UINT32 y = 0; y < halfSize; y++)
+						{
+							const float* row0 = input + y * 2 * size * 4;
+							const float* row1 = row0 + size * 4;
+
+							for (UINT32 x = 0; x < halfSize; x++)
+							{
+								const float32x4 sum = add(
+									add(load_u<float32x4>(row0 + x * 8), load_u<float32x4>(row0 + x * 8 + 4)),
+									add(load_u<float32x4>(row1 + x * 8), load_u<float32x4>(row1 + x * 8 + 4)));
+
+								store_u(output + (y * halfSize + x) * 4, mul(sum, splat<float32x4>(0.25f)));
+							}
+
+							const PixelData& level = *levels[i];
+							float* levelRow = (float*)level.getData() +
+								((tileY * halfSize + y) * level.getRowPitch() + tileX * halfSize) * 4;
+
+							memcpy(levelRow, output + y * halfSize * 4, halfSize * 4 * sizeof(float));
+						}
+
+						std::swap(input, output);
+						size = halfSize;
+					}
+				}
+			}
+		});
+	}
+
+	/**
+	 * Counts the pixels of @p image whose alpha, multiplied by @p scale, exceeds @p threshold. @p convert is a kernel
+	 * converting from the format of @p image to PF_RGBA32F, or null if there is none.
+	 */
+	static UINT64 countAlphaCoverage(const PixelData& image, PixelRowConversionFunc convert, float scale,
+		float threshold)
+	{
+		std::atomic<UINT64> count(0);
+		processPixelRange(image.getHeight(), image.getWidth(), [&](UINT32 begin, UINT32 end)
+		{
+			Vector<float> row(image.getWidth() * 4);
+
+			UINT64 rangeCount = 0;
+			for (UINT32 y = begin; y < end; y++)
+			{
+				readLinearPixels(image, convert, false, 0, y, image.getWidth(), row.data());
+
+				for (UINT32 x = 0; x < image.getWidth(); x++)
+				{
+					if (row[x * 4 + 3] * scale > threshold)
+						rangeCount++;
+				}
+			}
+
+			count += rangeCount;
+		});
+
+		return count;
+	}
+
+	/**
+	 * Finds a factor to scale the alpha of a mip level by, so the fraction of its pixels with alpha above @p threshold
+	 * matches @p targetCoverage.
+	 */
+	static float findAlphaCoverageScale(const PixelData& level, float threshold, float targetCoverage)
+	{
+		static constexpr UINT32 NUM_ITERATIONS = 10;
+
+		const float numPixels = (float)(level.getWidth() * level.getHeight());
+
+		float minScale = 0.0f;
+		float maxScale = 4.0f;
+		float scale = 1.0f;
+		for (UINT32 i = 0; i < NUM_ITERATIONS; i++)
+		{
+			const float coverage = countAlphaCoverage(level, nullptr, scale, threshold) / numPixels;
+			if (coverage < targetCoverage)
+				minScale = scale;
+			else if (coverage > targetCoverage)
+				maxScale = scale;
+			else
+				break;
+
+			scale = (minScale + maxScale) * 0.5f;
+		}
+
+		return scale;
+	}
+
 	/**	Data describing a pixel format. */
 	struct PixelFormatDescription
 	{
@@ -1198,43 +1715,6 @@ namespace bs
 		UINT8* bufferEnd;
 	};
 
-	/**	Handles output from NVTT library for a mip-map chain. */
-	struct NVTTMipmapOutputHandler : public nvtt::OutputHandler
-	{
-		NVTTMipmapOutputHandler(const Vector<SPtr<PixelData>>& buffers)
-			:buffers(buffers), bufferWritePos(nullptr), bufferEnd(nullptr)
-		{ }
-
-		void beginImage(int size, int width, int height, int depth, int face, int miplevel) override
-		{
-			assert(miplevel >= 0 && miplevel < (int)buffers.size());
-			assert((UINT32)size == buffers[miplevel]->getConsecutiveSize());
-
-			activeBuffer = buffers[miplevel];
-
-			bufferWritePos = activeBuffer->getData();
-			bufferEnd = bufferWritePos + activeBuffer->getConsecutiveSize();
-		}
-
-		bool writeData(const void* data, int size) override
-		{
-			assert((bufferWritePos + size) <= bufferEnd);
-			memcpy(bufferWritePos, data, size);
-			bufferWritePos += size;
-
-			return true;
-		}
-
-		void endImage() override
-		{ }
-
-		Vector<SPtr<PixelData>> buffers;
-		SPtr<PixelData> activeBuffer;
-
-		UINT8* bufferWritePos;
-		UINT8* bufferEnd;
-	};
-
 	nvtt::Format toNVTTFormat(PixelFormat format)
 	{
 		switch (format)
@@ -1294,20 +1774,140 @@ namespace bs
 		return nvtt::AlphaMode_None;
 	}
 
-	nvtt::WrapMode toNVTTWrapMode(MipMapWrapMode wrapMode)
+	/** Number of pixels compressed by a single task, when compressing on multiple threads. */
+	static constexpr UINT32 COMPRESSION_CHUNK_PIXELS = 256 * 128;
+
+	/** A horizontal strip of an image, consisting of one or multiple rows of 4x4 blocks. */
+	struct CompressionChunk
 	{
-		switch (wrapMode)
+		const PixelData* src;
+		PixelData* dst;
+		UINT32 firstBlockRow;
+		UINT32 numBlockRows;
+	};
+
+	/** Checks if @p src can be compressed into @p dst, and logs an error if not. */
+	static bool canCompress(const PixelData& src, const PixelData& dst, const CompressionOptions& options)
+	{
+		if (!PixelUtil::isCompressed(options.format))
 		{
-		case MipMapWrapMode::Clamp:
-			return nvtt::WrapMode_Clamp;
-		case MipMapWrapMode::Mirror:
-			return nvtt::WrapMode_Mirror;
-		case MipMapWrapMode::Repeat:
-			return nvtt::WrapMode_Repeat;
+			LOGERR("Compression failed. Destination format is not a valid compressed format.")
+			return false;
 		}
 
-		// Unknown alpha mode
-		return nvtt::WrapMode_Mirror;
+		if (src.getDepth() != 1)
+		{
+			LOGERR("Compression failed. 3D texture compression not supported.")
+			return false;
+		}
+
+		if (PixelUtil::isCompressed(src.getFormat()))
+		{
+			LOGERR("Compression failed. Source data cannot be compressed.");
+			return false;
+		}
+
+		assert(src.getWidth() == dst.getWidth() && src.getHeight() == dst.getHeight() &&
+			dst.getFormat() == options.format);
+
+		return true;
+	}
+
+	/** Splits @p src into strips of block rows that can be compressed independently, and appends them to @p chunks. */
+	static void splitIntoCompressionChunks(const PixelData& src, PixelData& dst, Vector<CompressionChunk>& chunks)
+	{
+		const UINT32 numBlockRows = Math::divideAndRoundUp(src.getHeight(), 4U);
+		const UINT32 blockRowPixels = Math::divideAndRoundUp(src.getWidth(), 4U) * 16;
+		const UINT32 blockRowsPerChunk = std::max(1U, COMPRESSION_CHUNK_PIXELS / blockRowPixels);
+
+		for (UINT32 i = 0; i < numBlockRows; i += blockRowsPerChunk)
+			chunks.push_back({ &src, &dst, i, std::min(blockRowsPerChunk, numBlockRows - i) });
+	}
+
+	/** Compresses a single strip of block rows, writing the blocks to their location in the destination buffer. */
+	static bool compressChunk(const CompressionChunk& chunk, const CompressionOptions& options)
+	{
+		const PixelData& src = *chunk.src;
+		const UINT32 width = src.getWidth();
+		const UINT32 top = chunk.firstBlockRow * 4;
+		const UINT32 height = std::min(src.getHeight() - top, chunk.numBlockRows * 4);
+
+		const UINT32 elemSize = PixelUtil::getNumElemBytes(src.getFormat());
+		PixelData srcRows(width, height, 1, src.getFormat());
+		srcRows.setExternalBuffer(src.getData() + (src.getLeft() + (src.getTop() + top) * src.getRowPitch()) * elemSize);
+		srcRows.setRowPitch(src.getRowPitch());
+		srcRows.setSlicePitch(src.getRowPitch() * height);
+
+		PixelFormat interimFormat = options.format == PF_BC6H ? PF_RGBA32F : PF_BGRA8;
+
+		PixelData interimData(width, height, 1, interimFormat);
+		interimData.allocateInternalBuffer();
+		PixelUtil::bulkPixelConversion(srcRows, interimData);
+
+		nvtt::InputOptions io;
+		io.setTextureLayout(nvtt::TextureType_2D, width, height);
+		io.setMipmapGeneration(false);
+		io.setAlphaMode(toNVTTAlphaMode(options.alphaMode));
+		io.setNormalMap(options.isNormalMap);
+
+		if (interimFormat == PF_RGBA32F)
+			io.setFormat(nvtt::InputFormat_RGBA_32F);
+		else
+			io.setFormat(nvtt::InputFormat_BGRA_8UB);
+
+		if (options.isSRGB)
+			io.setGamma(2.2f, 2.2f);
+		else
+			io.setGamma(1.0f, 1.0f);
+
+		io.setMipmapData(interimData.getData(), width, height);
+
+		nvtt::CompressionOptions co;
+		co.setFormat(toNVTTFormat(options.format));
+		co.setQuality(toNVTTQuality(options.quality));
+
+		// Blocks are stored row by row, so the strip maps to a contiguous range of the destination buffer
+		const UINT32 blockRowSize = PixelUtil::getMemorySize(width, 4, 1, options.format);
+		UINT8* dstData = chunk.dst->getData() + chunk.firstBlockRow * blockRowSize;
+		NVTTCompressOutputHandler outputHandler(dstData, chunk.numBlockRows * blockRowSize);
+
+		nvtt::OutputOptions oo;
+		oo.setOutputHeader(false);
+		oo.setOutputHandler(&outputHandler);
+
+		nvtt::Compressor compressor;
+		return compressor.process(io, co, oo);
+	}
+
+	/**
+	 * Compresses all the provided chunks. Chunks are distributed over the task scheduler's workers if there is more than
+	 * one. This is safe to call from within a task (e.g. during import), as the calling thread processes the chunks
+	 * not yet picked up by the workers instead of blocking on them.
+	 */
+	static void compressChunks(const Vector<CompressionChunk>& chunks, const CompressionOptions& options)
+	{
+		std::atomic<bool> failed(false);
+		const auto compressWorker = [&](UINT32 idx)
+		{
+			if (!compressChunk(chunks[idx], options))
+				failed = true;
+		};
+
+		if (chunks.size() > 1 && TaskScheduler::isStarted())
+		{
+			SPtr<TaskGroup> task = TaskGroup::create("PixelCompression", compressWorker, (UINT32)chunks.size());
+			TaskScheduler::instance().addTaskGroup(task);
+
+			task->wait();
+		}
+		else
+		{
+			for (UINT32 i = 0; i < (UINT32)chunks.size(); i++)
+				compressWorker(i);
+		}
+
+		if (failed)
+			LOGERR("Compression failed. Internal error.");
 	}
 
 	UINT32 PixelUtil::getNumElemBytes(PixelFormat format)
@@ -1871,7 +2471,7 @@ namespace bs
 			src.getHeight() == dst.getHeight() &&
 			src.getDepth() == dst.getDepth());
 
-		// Check for compressed formats, we don't support decompression
+		// Check for decompression
 		if (PixelUtil::isCompressed(src.getFormat()))
 		{
 			if (src.getFormat() == dst.getFormat())
@@ -1879,9 +2479,14 @@ namespace bs
 				memcpy(dst.getData(), src.getData(), src.getConsecutiveSize());
 				return;
 			}
+			else if (!PixelUtil::isCompressed(dst.getFormat()))
+			{
+				decompress(src, dst);
+				return;
+			}
 			else
 			{
-				LOGERR("bulkPixelConversion() cannot be used to compress or decompress images");
+				LOGERR("bulkPixelConversion() cannot be used to convert between different compressed formats");
 				return;
 			}
 		}
@@ -1947,6 +2552,43 @@ namespace bs
 			return;
 		}
 
+		// Common format pairs have specialized kernels, converting a row at a time
+		const PixelRowConversionFunc convertRow = PixelConversion::find(src.getFormat(), dst.getFormat());
+		if (convertRow != nullptr)
+		{
+			const UINT32 srcPixelSize = PixelUtil::getNumElemBytes(src.getFormat());
+			const UINT32 dstPixelSize = PixelUtil::getNumElemBytes(dst.getFormat());
+			const UINT8* srcptr = static_cast<UINT8*>(src.getData())
+				+ (src.getLeft() + src.getTop() * src.getRowPitch() + src.getFront() * src.getSlicePitch()) * srcPixelSize;
+			UINT8* dstptr = static_cast<UINT8*>(dst.getData())
+				+ (dst.getLeft() + dst.getTop() * dst.getRowPitch() + dst.getFront() * dst.getSlicePitch()) * dstPixelSize;
+
+			const UINT32 srcRowPitchBytes = src.getRowPitch() * srcPixelSize;
+			const UINT32 srcSlicePitchBytes = src.getSlicePitch() * srcPixelSize;
+			const UINT32 dstRowPitchBytes = dst.getRowPitch() * dstPixelSize;
+			const UINT32 dstSlicePitchBytes = dst.getSlicePitch() * dstPixelSize;
+
+			const UINT32 width = src.getWidth();
+			const UINT32 height = src.getHeight();
+			const UINT32 numRows = height * src.getDepth();
+
+			const auto worker = [&](UINT32 begin, UINT32 end)
+			{
+				for (UINT32 i = begin; i < end; i++)
+				{
+					const UINT32 y = i % height;
+					const UINT32 z = i / height;
+
+					convertRow(srcptr + y * srcRowPitchBytes + z * srcSlicePitchBytes,
+						dstptr + y * dstRowPitchBytes + z * dstSlicePitchBytes, width);
+				}
+			};
+
+			processPixelRange(numRows, width, worker);
+
+			return;
+		}
+
 		UINT32 srcPixelSize = PixelUtil::getNumElemBytes(src.getFormat());
 		UINT32 dstPixelSize = PixelUtil::getNumElemBytes(dst.getFormat());
 		UINT8 *srcptr = static_cast<UINT8*>(src.getData())
@@ -2378,64 +3020,109 @@ namespace bs
 
 	void PixelUtil::compress(const PixelData& src, PixelData& dst, const CompressionOptions& options)
 	{
-		if (!isCompressed(options.format))
-		{
-			LOGERR("Compression failed. Destination format is not a valid compressed format.")
+		if (!canCompress(src, dst, options))
 			return;
+
+		Vector<CompressionChunk> chunks;
+		splitIntoCompressionChunks(src, dst, chunks);
+
+		compressChunks(chunks, options);
+	}
+
+	void PixelUtil::compress(const Vector<SPtr<PixelData>>& src, const Vector<SPtr<PixelData>>& dst,
+		const CompressionOptions& options)
+	{
+		assert(src.size() == dst.size());
+
+		Vector<CompressionChunk> chunks;
+		for (UINT32 i = 0; i < (UINT32)src.size(); i++)
+		{
+			if (!canCompress(*src[i], *dst[i], options))
+				return;
+
+			splitIntoCompressionChunks(*src[i], *dst[i], chunks);
 		}
 
-		if (src.getDepth() != 1)
+		compressChunks(chunks, options);
+	}
+
+	void PixelUtil::decompress(const PixelData& src, PixelData& dst)
+	{
+		assert(src.getWidth() == dst.getWidth() &&
+			src.getHeight() == dst.getHeight() &&
+			src.getDepth() == dst.getDepth());
+
+		const BlockDecodeFunc decodeBlock = BlockDecoder::find(src.getFormat());
+		if (decodeBlock == nullptr)
 		{
-			LOGERR("Compression failed. 3D texture compression not supported.")
+			LOGERR("Decompression failed. Source data is not in a supported compressed format.");
 			return;
 		}
 
-		if (isCompressed(src.getFormat()))
+		if (isCompressed(dst.getFormat()))
 		{
-			LOGERR("Compression failed. Source data cannot be compressed.");
+			LOGERR("Decompression failed. Destination format cannot be compressed.");
 			return;
 		}
 
-		PixelFormat interimFormat = options.format == PF_BC6H ? PF_RGBA32F : PF_BGRA8;
+		// Blocks decode to a fixed format, convert from it if another one was requested
+		const PixelFormat decodedFormat = BlockDecoder::getDecodedFormat(src.getFormat());
+		if (dst.getFormat() != decodedFormat)
+		{
+			PixelData interimData(src.getWidth(), src.getHeight(), src.getDepth(), decodedFormat);
+			interimData.allocateInternalBuffer();
 
-		PixelData interimData(src.getWidth(), src.getHeight(), 1, interimFormat);
-		interimData.allocateInternalBuffer();
-		bulkPixelConversion(src, interimData);
+			decompress(src, interimData);
+			bulkPixelConversion(interimData, dst);
+			return;
+		}
 
-		nvtt::InputOptions io;
-		io.setTextureLayout(nvtt::TextureType_2D, src.getWidth(), src.getHeight());
-		io.setMipmapGeneration(false);
-		io.setAlphaMode(toNVTTAlphaMode(options.alphaMode));
-		io.setNormalMap(options.isNormalMap);
+		const UINT32 blockSize = BlockDecoder::getBlockSize(src.getFormat());
+		const UINT32 pixelSize = getNumElemBytes(decodedFormat);
 
-		if (interimFormat == PF_RGBA32F)
-			io.setFormat(nvtt::InputFormat_RGBA_32F);
-		else
-			io.setFormat(nvtt::InputFormat_BGRA_8UB);
+		const UINT8* srcptr = static_cast<UINT8*>(src.getData());
+		UINT8* dstptr = static_cast<UINT8*>(dst.getData())
+			+ (dst.getLeft() + dst.getTop() * dst.getRowPitch() + dst.getFront() * dst.getSlicePitch()) * pixelSize;
 
-		if (options.isSRGB)
-			io.setGamma(2.2f, 2.2f);
-		else
-			io.setGamma(1.0f, 1.0f);
+		// Compressed data is stored as rows of 4x4 blocks, with pitches rounded up to whole blocks
+		const UINT32 srcBlockRowPitchBytes = (src.getRowPitch() / 4) * blockSize;
+		const UINT32 srcSlicePitchBytes = (src.getSlicePitch() / 16) * blockSize;
+		const UINT32 dstRowPitchBytes = dst.getRowPitch() * pixelSize;
+		const UINT32 dstSlicePitchBytes = dst.getSlicePitch() * pixelSize;
 
-		io.setMipmapData(interimData.getData(), src.getWidth(), src.getHeight());
+		const UINT32 width = src.getWidth();
+		const UINT32 height = src.getHeight();
+		const UINT32 numBlocksX = Math::divideAndRoundUp(width, 4U);
+		const UINT32 numBlocksY = Math::divideAndRoundUp(height, 4U);
 
-		nvtt::CompressionOptions co;
-		co.setFormat(toNVTTFormat(options.format));
-		co.setQuality(toNVTTQuality(options.quality));
+		const auto worker = [&](UINT32 begin, UINT32 end)
+		{
+			UINT8 pixels[16 * 16];
+			for (UINT32 i = begin; i < end; i++)
+			{
+				const UINT32 blockY = i % numBlocksY;
+				const UINT32 z = i / numBlocksY;
 
-		NVTTCompressOutputHandler outputHandler(dst.getData(), dst.getConsecutiveSize());
+				const UINT8* srcRow = srcptr + blockY * srcBlockRowPitchBytes + z * srcSlicePitchBytes;
+				UINT8* dstRow = dstptr + blockY * 4 * dstRowPitchBytes + z * dstSlicePitchBytes;
 
-		nvtt::OutputOptions oo;
-		oo.setOutputHeader(false);
-		oo.setOutputHandler(&outputHandler);
+				// Blocks on the right and bottom edges may extend past the image
+				const UINT32 rowsInBlock = std::min(4U, height - blockY * 4);
+				for (UINT32 blockX = 0; blockX < numBlocksX; blockX++)
+				{
+					decodeBlock(srcRow + blockX * blockSize, pixels);
 
-		nvtt::Compressor compressor;
-		if (!compressor.process(io, co, oo))
-		{
-			LOGERR("Compression failed. Internal error.");
-			return;
-		}
+					const UINT32 columnsInBlock = std::min(4U, width - blockX * 4);
+					for (UINT32 y = 0; y < rowsInBlock; y++)
+					{
+						memcpy(dstRow + y * dstRowPitchBytes + blockX * 4 * pixelSize, pixels + y * 4 * pixelSize,
+							columnsInBlock * pixelSize);
+					}
+				}
+			}
+		};
+
+		processPixelRange(numBlocksY * src.getDepth(), width * 4, worker);
 	}
 
 	Vector<SPtr<PixelData>> PixelUtil::genMipmaps(const PixelData& src, const MipMapGenOptions& options)
@@ -2454,101 +3141,110 @@ namespace bs
 			return outputMipBuffers;
 		}
 
-		if (!Bitwise::isPow2(src.getWidth()) || !Bitwise::isPow2(src.getHeight()))
-		{
-			LOGERR("Mipmap generation failed. Texture width & height must be powers of 2.");
-			return outputMipBuffers;
-		}
-
-		PixelFormat interimFormat = isFloatingPoint(src.getFormat()) ? PF_RGBA32F : PF_BGRA8;
-
-		PixelData interimData(src.getWidth(), src.getHeight(), 1, interimFormat);
-		interimData.allocateInternalBuffer();
-		bulkPixelConversion(src, interimData);
-
-		if (interimFormat != PF_RGBA32F)
-			flipComponentOrder(interimData);
-
-		nvtt::InputOptions io;
-		io.setTextureLayout(nvtt::TextureType_2D, src.getWidth(), src.getHeight());
-		io.setMipmapGeneration(true);
-		io.setNormalMap(options.isNormalMap);
-		io.setNormalizeMipmaps(options.normalizeMipmaps);
-		io.setWrapMode(toNVTTWrapMode(options.wrapMode));
-
-		if (interimFormat == PF_RGBA32F)
-			io.setFormat(nvtt::InputFormat_RGBA_32F);
-		else
-			io.setFormat(nvtt::InputFormat_BGRA_8UB);
-
-		if (options.isSRGB)
-			io.setGamma(2.2f, 2.2f);
-		else
-			io.setGamma(1.0f, 1.0f);
-
-		io.setMipmapData(interimData.getData(), src.getWidth(), src.getHeight());
-
-		nvtt::CompressionOptions co;
-		co.setFormat(nvtt::Format_RGBA);
+		// Mip levels are generated in linear space, as RGBA32F, and converted to the source format once done
+		const PixelRowConversionFunc toFloat = PixelConversion::find(src.getFormat(), PF_RGBA32F);
+		const UINT32 numMips = getMaxMipmaps(src.getWidth(), src.getHeight(), 1, src.getFormat());
 
-		if (interimFormat == PF_RGBA32F)
+		Vector<SPtr<PixelData>> floatMipBuffers(numMips + 1);
+		for (UINT32 i = 1; i <= numMips; i++)
 		{
-			co.setPixelType(nvtt::PixelType_Float);
-			co.setPixelFormat(32, 32, 32, 32);
+			UINT32 mipWidth, mipHeight, mipDepth;
+			getSizeForMipLevel(src.getWidth(), src.getHeight(), 1, i, mipWidth, mipHeight, mipDepth);
+
+			floatMipBuffers[i] = bs_shared_ptr_new<PixelData>(mipWidth, mipHeight, 1, PF_RGBA32F);
+			floatMipBuffers[i]->allocateInternalBuffer();
 		}
-		else
+
+		// The box filter generates as many levels as possible directly from the source, as long as the tiles
+		// downsample evenly
+		UINT32 numTiledMips = 0;
+		if (options.filter == MipMapFilter::Box && numMips > 0)
 		{
-			co.setPixelType(nvtt::PixelType_UnsignedNorm);
-			co.setPixelFormat(32, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF);
+			numTiledMips = std::min(MIP_TILE_LEVELS, numMips);
+			numTiledMips = std::min(numTiledMips, Bitwise::leastSignificantBit(src.getWidth()));
+			numTiledMips = std::min(numTiledMips, Bitwise::leastSignificantBit(src.getHeight()));
 		}
 
-		UINT32 numMips = getMaxMipmaps(src.getWidth(), src.getHeight(), 1, src.getFormat());
+		if (numTiledMips > 0)
+		{
+			Vector<PixelData*> tiledMipBuffers;
+			for (UINT32 i = 1; i <= numTiledMips; i++)
+				tiledMipBuffers.push_back(floatMipBuffers[i].get());
 
-		Vector<SPtr<PixelData>> rgbaMipBuffers;
+			downsampleBoxTiled(src, toFloat, options.isSRGB, tiledMipBuffers);
+		}
 
-		// Note: This can be done more effectively without creating so many temp buffers
-		// and working with the original formats directly, but it would complicate the code
-		// too much at the moment.
-		UINT32 curWidth = src.getWidth();
-		UINT32 curHeight = src.getHeight();
-		for (UINT32 i = 0; i < numMips; i++)
+		for (UINT32 i = numTiledMips + 1; i <= numMips; i++)
 		{
-			rgbaMipBuffers.push_back(bs_shared_ptr_new<PixelData>(curWidth, curHeight, 1, interimFormat));
-			rgbaMipBuffers.back()->allocateInternalBuffer();
-
-			if (curWidth > 1)
-				curWidth = curWidth / 2;
+			if (i == 1)
+				downsampleSeparable(src, toFloat, options.isSRGB, *floatMipBuffers[i], options);
+			else
+				downsampleSeparable(*floatMipBuffers[i - 1], nullptr, false, *floatMipBuffers[i], options);
+		}
 
-			if (curHeight > 1)
-				curHeight = curHeight / 2;
+		float targetCoverage = 0.0f;
+		if (options.preserveAlphaCoverage)
+		{
+			const UINT64 numCovered = countAlphaCoverage(src, toFloat, 1.0f, options.alphaCoverageThreshold);
+			targetCoverage = numCovered / (float)(src.getWidth() * src.getHeight());
 		}
 
-		rgbaMipBuffers.push_back(bs_shared_ptr_new<PixelData>(curWidth, curHeight, 1, interimFormat));
-		rgbaMipBuffers.back()->allocateInternalBuffer();
+		SPtr<PixelData> baseBuffer = bs_shared_ptr_new<PixelData>(src.getWidth(), src.getHeight(), 1, src.getFormat());
+		baseBuffer->allocateInternalBuffer();
+		bulkPixelConversion(src, *baseBuffer);
 
-		NVTTMipmapOutputHandler outputHandler(rgbaMipBuffers);
+		outputMipBuffers.push_back(baseBuffer);
 
-		nvtt::OutputOptions oo;
-		oo.setOutputHeader(false);
-		oo.setOutputHandler(&outputHandler);
-
-		nvtt::Compressor compressor;
-		if (!compressor.process(io, co, oo))
+		const bool normalize = options.isNormalMap && options.normalizeMipmaps;
+		for (UINT32 i = 1; i <= numMips; i++)
 		{
-			LOGERR("Mipmap generation failed. Internal error.");
-			return outputMipBuffers;
-		}
+			PixelData& floatBuffer = *floatMipBuffers[i];
 
-		interimData.freeInternalBuffer();
+			float alphaScale = 1.0f;
+			if (options.preserveAlphaCoverage)
+				alphaScale = findAlphaCoverageScale(floatBuffer, options.alphaCoverageThreshold, targetCoverage);
 
-		for (UINT32 i = 0; i < (UINT32)rgbaMipBuffers.size(); i++)
-		{
-			SPtr<PixelData> argbBuffer = rgbaMipBuffers[i];
-			SPtr<PixelData> outputBuffer = bs_shared_ptr_new<PixelData>(argbBuffer->getWidth(), argbBuffer->getHeight(), 1, src.getFormat());
+			if (normalize || options.isSRGB || alphaScale != 1.0f)
+			{
+				processPixelRange(floatBuffer.getHeight(), floatBuffer.getWidth(), [&](UINT32 begin, UINT32 end)
+				{
+					const ColorSpaceLUT& toSrgb = getLinearToSrgbLUT();
+					for (UINT32 y = begin; y < end; y++)
+					{
+						float* row = (float*)floatBuffer.getData() + y * floatBuffer.getRowPitch() * 4;
+						for (UINT32 x = 0; x < floatBuffer.getWidth(); x++)
+						{
+							float* pixel = row + x * 4;
+
+							if (normalize)
+							{
+								Vector3 normal(pixel[0] * 2.0f - 1.0f, pixel[1] * 2.0f - 1.0f, pixel[2] * 2.0f - 1.0f);
+								normal = Vector3::normalize(normal) * 0.5f + Vector3(0.5f, 0.5f, 0.5f);
+
+								pixel[0] = normal.x;
+								pixel[1] = normal.y;
+								pixel[2] = normal.z;
+							}
+
+							if (options.isSRGB)
+							{
+								pixel[0] = toSrgb(pixel[0]);
+								pixel[1] = toSrgb(pixel[1]);
+								pixel[2] = toSrgb(pixel[2]);
+							}
+
+							pixel[3] = std::min(pixel[3] * alphaScale, 1.0f);
+						}
+					}
+				});
+			}
+
+			SPtr<PixelData> outputBuffer = bs_shared_ptr_new<PixelData>(floatBuffer.getWidth(),
+				floatBuffer.getHeight(), 1, src.getFormat());
 			outputBuffer->allocateInternalBuffer();
 
-			bulkPixelConversion(*argbBuffer, *outputBuffer);
-			argbBuffer->freeInternalBuffer();
+			bulkPixelConversion(floatBuffer, *outputBuffer);
+			floatBuffer.freeInternalBuffer();
 
 			outputMipBuffers.push_back(outputBuffer);
 		}
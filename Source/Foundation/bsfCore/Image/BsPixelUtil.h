@@ -44,7 +44,8 @@ namespace bs
 	{
 		Box,
 		Triangle,
-		Kaiser
+		Kaiser,
+		Lanczos
 	};
 
 	/** Determines on which axes to mirror an image. */
@@ -76,6 +77,8 @@ namespace bs
 		bool isNormalMap = false; /*< Determines does the input data represent a normal map. */
 		bool normalizeMipmaps = false; /*< Should the downsampled values be re-normalized. Only relevant for mip-maps representing normal maps. */
 		bool isSRGB = false; /*< Determines has the input data been gamma corrected. */
+		bool preserveAlphaCoverage = false; /*< Scales alpha of the generated mip-maps so the percentage of pixels passing the alpha test stays the same as in the base level. Prevents alpha tested textures from fading out in the distance. */
+		float alphaCoverageThreshold = 0.5f; /*< Alpha test reference value used when preserving alpha coverage. */
 	};
 
 	/**	Utility methods for converting and managing pixel data and formats. */
@@ -247,12 +250,29 @@ namespace bs
 		/** Flips the order of components in each individual pixel. For example RGBA -> ABGR. */
 		static void flipComponentOrder(PixelData& data);
 
-		/** Compresses the provided data using the specified compression options.  */
+		/**
+		 * Compresses the provided data using the specified compression options. Large images are split into strips of
+		 * blocks that are compressed on multiple threads.
+		 */
 		static void compress(const PixelData& src, PixelData& dst, const CompressionOptions& options);
 
+		/**
+		 * Compresses multiple images at once (e.g. all faces and mip levels of a texture) using the specified
+		 * compression options. Compression of all the images is distributed over multiple threads. Both lists must be of
+		 * the same size, with each destination having an allocated buffer matching the size of its source.
+		 */
+		static void compress(const Vector<SPtr<PixelData>>& src, const Vector<SPtr<PixelData>>& dst,
+			const CompressionOptions& options);
+
+		/**
+		 * Decompresses the provided block compressed data into an uncompressed format. Provided pixel data objects must
+		 * have previously allocated buffers of adequate size and their sizes must match.
+		 */
+		static void decompress(const PixelData& src, PixelData& dst);
+
 		/**
 		 * Generates mip-maps from the provided source data using the specified compression options. Returned list includes
-		 * the base level.
+		 * the base level. Filtering is performed in linear space, on multiple threads for large images.
 		 *
 		 * @return	A list of calculated mip-map data. First entry is the largest mip and other follow in order from 
 		 *			largest to smallest.
@@ -7,7 +7,7 @@ namespace bs
 {
 	TextureImportOptions::TextureImportOptions()
 		: mFormat(PF_RGBA8), mGenerateMips(false), mMaxMip(0), mCPUCached(false), mSRGB(false), mCubemap(false)
-		, mCubemapSourceType(CubemapSourceType::Faces)
+		, mCubemapSourceType(CubemapSourceType::Faces), mCompressionQuality(CompressionQuality::Normal)
 	{ }
 
 	SPtr<TextureImportOptions> TextureImportOptions::create()
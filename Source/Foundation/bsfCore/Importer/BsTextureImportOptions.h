@@ -81,6 +81,15 @@ namespace bs
 		 */
 		CubemapSourceType getCubemapSourceType() const { return mCubemapSourceType; }
 
+		/**
+		 * Sets the quality to use when compressing the texture, if a compressed format was chosen. Lower quality
+		 * settings compress considerably faster, which can be useful when iterating on content.
+		 */
+		void setCompressionQuality(CompressionQuality quality) { mCompressionQuality = quality; }
+
+		/** Returns the quality to use when compressing the texture, if a compressed format was chosen. */
+		CompressionQuality getCompressionQuality() const { return mCompressionQuality; }
+
 		/** Creates a new import options object that allows you to customize how are textures imported. */
 		static SPtr<TextureImportOptions> create();
 
@@ -100,6 +109,7 @@ namespace bs
 		bool mSRGB;
 		bool mCubemap;
 		CubemapSourceType mCubemapSourceType;
+		CompressionQuality mCompressionQuality;
 	};
 
 	/** @} */
@@ -125,14 +125,22 @@ namespace bs
 		desc.skeleton = mSkeleton;
 		desc.morphShapes = mMorphShapes;
 
-		ct::Mesh* obj = new (bs_alloc<ct::Mesh>()) ct::Mesh(mCPUData, desc, GDF_DEFAULT);
+		SPtr<MeshData> initialData = mCPUData;
+		if ((mUsage & MU_CPUCACHED) == 0)
+			mCPUData = nullptr;
+		else if (mCPUData != nullptr && mCPUData->_isReferencingStream())
+		{
+			// Data was read in place from the resource file. Keep a copy in the cache so the file isn't held open for
+			// the lifetime of the mesh, while the initial upload can still use the original.
+			mCPUData = allocBuffer();
+			memcpy(mCPUData->getData(), initialData->getData(), initialData->getSize());
+		}
+
+		ct::Mesh* obj = new (bs_alloc<ct::Mesh>()) ct::Mesh(initialData, desc, GDF_DEFAULT);
 
 		SPtr<ct::CoreObject> meshCore = bs_shared_ptr<ct::Mesh>(obj);
 		meshCore->_setThisPtr(meshCore);
 
-		if ((mUsage & MU_CPUCACHED) == 0)
-			mCPUData = nullptr;
-
 		return meshCore;
 	}
 
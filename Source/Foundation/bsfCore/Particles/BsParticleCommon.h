@@ -0,0 +1,24 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup Particles-Internal
+	 *  @{
+	 */
+
+	/** Information about particle systems processed during the last call to ParticleManager::update(). */
+	struct ParticleUpdateStats
+	{
+		/** Number of particle systems that were simulated. */
+		UINT32 numSimulated = 0;
+
+		/** Number of particle systems outside of all camera frustums, whose simulation was deferred to a later frame. */
+		UINT32 numSkipped = 0;
+	};
+
+	/** @} */
+}
@@ -7,6 +7,7 @@
 #include "Math/BsRandom.h"
 #include "Renderer/BsRenderable.h"
 #include "Private/Particles/BsParticleSet.h"
+#include "Private/Particles/BsParticleKernels.h"
 #include "Private/RTTI/BsParticleSystemRTTI.h"
 #include "Animation/BsAnimation.h"
 #include "Animation/BsAnimationManager.h"
@@ -107,6 +108,16 @@ namespace bs
 			bs_zero_out(indices);
 	}
 
+	/**
+	 * Checks if the distribution evaluates to the same value for every particle spawned during a single frame, without
+	 * consuming any random numbers.
+	 */
+	template <class T>
+	bool isUniformPerSpawn(const TDistribution<T>& distribution)
+	{
+		return distribution.getType() == PDT_Constant || distribution.getType() == PDT_Curve;
+	}
+
 	template <class T>
 	UINT32 spawnMultiple(T* spawner, const Random& random, ParticleSet& particles, UINT32 count)
 	{
@@ -1124,16 +1135,31 @@ namespace bs
 
 		ParticleSetData& particles = set.getParticles();
 
-		for(UINT32 i = firstIdx; i < endIdx; i++)
+		if(isUniformPerSpawn(mInitialLifetime))
 		{
 			const float lifetime = mInitialLifetime.evaluate(emitterT, random);
 
-			particles.initialLifetime[i] = lifetime;
-			particles.lifetime[i] = lifetime;
+			ParticleKernels::fill(particles.initialLifetime + firstIdx, lifetime, numToSpawn);
+			ParticleKernels::fill(particles.lifetime + firstIdx, lifetime, numToSpawn);
 		}
+		else
+		{
+			for(UINT32 i = firstIdx; i < endIdx; i++)
+			{
+				const float lifetime = mInitialLifetime.evaluate(emitterT, random);
 
-		for(UINT32 i = firstIdx; i < endIdx; i++)
-			particles.velocity[i] *= mInitialSpeed.evaluate(emitterT, random);
+				particles.initialLifetime[i] = lifetime;
+				particles.lifetime[i] = lifetime;
+			}
+		}
+
+		if(isUniformPerSpawn(mInitialSpeed))
+			ParticleKernels::scale(particles.velocity + firstIdx, mInitialSpeed.evaluate(emitterT, random), numToSpawn);
+		else
+		{
+			for(UINT32 i = firstIdx; i < endIdx; i++)
+				particles.velocity[i] *= mInitialSpeed.evaluate(emitterT, random);
+		}
 
 		if(!mUse3DSize)
 		{
@@ -1191,17 +1217,13 @@ namespace bs
 		for(UINT32 i = firstIdx; i < endIdx; i++)
 			particles.seed[i] = random.get();
 
-		for(UINT32 i = firstIdx; i < endIdx; i++)
-			particles.frame[i] = 0.0f;
+		ParticleKernels::fill(particles.frame + firstIdx, 0.0f, numToSpawn);
 
 		// If in world-space we apply the transform here, otherwise we apply it in the rendering code
 		if(state.worldSpace)
 		{
-			for (UINT32 i = firstIdx; i < endIdx; i++)
-				particles.position[i] = state.localToWorld.multiplyAffine(particles.position[i]);
-
-			for (UINT32 i = firstIdx; i < endIdx; i++)
-				particles.velocity[i] = state.localToWorld.multiplyDirection(particles.velocity[i]);
+			ParticleKernels::multiplyAffine(particles.position + firstIdx, state.localToWorld, numToSpawn);
+			ParticleKernels::multiplyDirection(particles.velocity + firstIdx, state.localToWorld, numToSpawn);
 		}
 	}	
 	
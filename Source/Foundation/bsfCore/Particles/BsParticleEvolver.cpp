@@ -2,6 +2,7 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Particles/BsParticleEvolver.h"
 #include "Private/Particles/BsParticleSet.h"
+#include "Private/Particles/BsParticleKernels.h"
 #include "Private/RTTI/BsParticleSystemRTTI.h"
 #include "Particles/BsVectorField.h"
 #include "Image/BsSpriteTexture.h"
@@ -136,6 +137,21 @@ namespace bs
 		ParticleSetData& particles = set.getParticles();
 
 		const Vector3 center = evaluateTransformed(mDesc.center, state, state.nrmTimeEnd, random, mDesc.worldSpace);
+
+		// If properties don't vary per particle, all particles share the same rotation and can be processed in bulk
+		if(mDesc.velocity.getType() == PDT_Constant && mDesc.radial.getType() == PDT_Constant)
+		{
+			Vector3 orbitVelocity = evaluateTransformed<true>(mDesc.velocity, state, 0.0f, random, mDesc.worldSpace);
+			orbitVelocity *= Math::TWO_PI;
+			orbitVelocity *= state.timeStep;
+
+			const Matrix3 rotation(Radian(orbitVelocity.x), Radian(orbitVelocity.y), Radian(orbitVelocity.z));
+			const float radial = mDesc.radial.getMinConstant() * state.timeStep;
+
+			ParticleKernels::orbit(particles.position, center, rotation, radial, count);
+			return;
+		}
+
 		for (UINT32 i = 0; i < count; i++)
 		{
 			const float particleT = (particles.initialLifetime[i] - particles.lifetime[i]) / particles.initialLifetime[i];
@@ -181,6 +197,16 @@ namespace bs
 		const UINT32 count = set.getParticleCount();
 		ParticleSetData& particles = set.getParticles();
 
+		// If velocity doesn't vary per particle, move all particles in bulk
+		if(mDesc.velocity.getType() == PDT_Constant)
+		{
+			const Vector3 velocity = evaluateTransformed<true>(mDesc.velocity, state, 0.0f, random, 
+				mDesc.worldSpace) * state.timeStep;
+
+			ParticleKernels::add(particles.position, velocity, count);
+			return;
+		}
+
 		for (UINT32 i = 0; i < count; i++)
 		{
 			const float particleT = (particles.initialLifetime[i] - particles.lifetime[i]) / particles.initialLifetime[i];
@@ -217,8 +243,7 @@ namespace bs
 		const UINT32 count = set.getParticleCount();
 		ParticleSetData& particles = set.getParticles();
 
-		for (UINT32 i = 0; i < count; i++)
-			particles.velocity[i] += gravity * state.timeStep;
+		ParticleKernels::add(particles.velocity, gravity * state.timeStep, count);
 	}
 
 	RTTITypeBase* ParticleGravity::getRTTIStatic()
@@ -344,7 +369,7 @@ namespace bs
 			else
 			{
 				const Matrix4& worldToLocal = state.worldToLocal;
-				localPlanes = bs_stack_alloc<Plane>(numParticles);
+				localPlanes = bs_stack_alloc<Plane>(numPlanes);
 
 				for (UINT32 i = 0; i < numPlanes; i++)
 					localPlanes[i] = worldToLocal.multiplyAffine(mCollisionPlanes[i]);
@@ -352,8 +377,15 @@ namespace bs
 				planes = localPlanes;
 			}
 
-			for(UINT32 i = 0; i < numParticles; i++)
+			// Only particles near a plane can collide with it, find them in bulk first
+			const auto candidates = bs_stack_alloc<UINT32>(numParticles);
+			const UINT32 numCandidates = ParticleKernels::findNearPlanes(particles.position, numParticles, planes, 
+				numPlanes, mDesc.radius, candidates);
+
+			for(UINT32 candidateIdx = 0; candidateIdx < numCandidates; candidateIdx++)
 			{
+				const UINT32 i = candidates[candidateIdx];
+
 				Vector3& position = particles.position[i];
 				Vector3& velocity = particles.velocity[i];
 
@@ -386,6 +418,8 @@ namespace bs
 				}
 			}
 
+			bs_stack_free(candidates);
+
 			if(localPlanes)
 				bs_stack_free(localPlanes);
 		}
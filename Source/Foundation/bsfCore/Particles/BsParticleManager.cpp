@@ -8,6 +8,9 @@
 #include "Private/Particles/BsParticleSet.h"
 #include "Animation/BsAnimationManager.h"
 #include "Image/BsPixelUtil.h"
+#include "Scene/BsSceneManager.h"
+#include "Renderer/BsCamera.h"
+#include "Utility/BsRadixSort.h"
 
 namespace bs
 {
@@ -367,105 +370,205 @@ namespace bs
 		if(mPaused)
 			return &mSimulationData[mReadBufferIdx];
 
-		// TODO - Perform culling (but only on deterministic particle systems). In which case cache the bounds so we don't
-		// need to recalculate them below
+		const float frameDelta = gTime().getFrameDelta();
+
+		// Build frustums for culling
+		mCullFrustums.clear();
+
+		auto& allCameras = gSceneManager().getAllCameras();
+		for(auto& entry : allCameras)
+		{
+			bool isOverlayCamera = entry.second->getRenderSettings()->overlayOnly;
+			if (isOverlayCamera)
+				continue;
+
+			// TODO: Not checking if camera and particle system's layers match. If we checked more systems could be
+			// culled.
+			mCullFrustums.push_back(entry.second->getWorldFrustum());
+		}
+
+		mSystemList.clear();
+		for (auto& system : mSystems)
+			mSystemList.push_back(system);
+
+		cullParticleSystems();
+
+		// Visible systems are simulated every frame. Systems outside of all frustums accumulate the elapsed time, and are
+		// only simulated once enough of it has passed. This keeps their bounds reasonably up to date, so we can detect
+		// when they become visible, at which point they catch up right away.
+		mSimulationEntries.clear();
+		mStats = ParticleUpdateStats();
 
 		// Prepare the write buffer
 		ParticlePerFrameData& simulationData = mSimulationData[mWriteBufferIdx];
 		simulationData.cpuData.clear();
 		simulationData.gpuData.clear();
+		simulationData.culledBounds.clear();
 
-		// Queue evaluation tasks
+		for (UINT32 i = 0; i < (UINT32)mSystemList.size(); i++)
 		{
-			Lock lock(mMutex);
-			mNumActiveWorkers = (UINT32)mSystems.size();
+			ParticleSystem* system = mSystemList[i];
+			system->mDeferredTime += frameDelta;
+
+			if (!mSystemVisibility[i] && system->mDeferredTime < CULLED_UPDATE_INTERVAL)
+			{
+				// The renderer has no render data for the system this frame, so let it know not to draw it, and which
+				// bounds to cull it with
+				const ParticleSystemSettings& settings = system->getSettings();
+				if(system->mParticleSet && !settings.gpuSimulation)
+				{
+					simulationData.culledBounds[system->mId] =
+						settings.useAutomaticBounds ? system->mCachedBounds : settings.customBounds;
+				}
+
+				mStats.numSkipped++;
+				continue;
+			}
+
+			mSimulationEntries.push_back({ system, system->mDeferredTime, nullptr, nullptr });
+			system->mDeferredTime = 0.0f;
 		}
 
-		float timeDelta = gTime().getFrameDelta();
+		mStats.numSimulated = (UINT32)mSimulationEntries.size();
 
 		ParticleSimulationDataPool& simDataPool = m->simDataPool[mWriteBufferIdx];
 		simDataPool.clear();
 
-		for (auto& system : mSystems)
+		// Queue evaluation tasks
+		const auto evaluateWorker = [this, &animData, &simDataPool](UINT32 idx)
 		{
-			const auto evaluateWorker = [this, timeDelta, system, &animData, &simDataPool, &simulationData]()
+			SimulationEntry& entry = mSimulationEntries[idx];
+			ParticleSystem* system = entry.system;
+
+			// Advance the simulation
+			system->_simulate(entry.timeDelta, &animData);
+
+			if(system->mParticleSet)
 			{
-				// Advance the simulation
-				system->_simulate(timeDelta, &animData);
+				// Generate simulation data to transfer to the core thread
+				const UINT32 numParticles = system->mParticleSet->getParticleCount();
+				const ParticleSystemSettings& settings = system->getSettings();
 
-				ParticleRenderData* simulationDataCPU = nullptr;
-				ParticleGPUSimulationData* simulationDataGPU = nullptr;
-				if(system->mParticleSet)
+				if(settings.gpuSimulation)
+					entry.gpuData = simDataPool.allocGPU(*system->mParticleSet);
+				else
 				{
-					// Generate simulation data to transfer to the core thread
-					const UINT32 numParticles = system->mParticleSet->getParticleCount();
-					const ParticleSystemSettings& settings = system->getSettings();
+					ParticleRenderData* simulationDataCPU;
+					if(settings.renderMode == ParticleRenderMode::Billboard)
+						simulationDataCPU = simDataPool.allocCPUBillboard(*system->mParticleSet);
+					else
+						simulationDataCPU = simDataPool.allocCPUMesh(*system->mParticleSet);
+
+					simulationDataCPU->numParticles = numParticles;
+
+					if(settings.useAutomaticBounds)
+					{
+						// Remember the bounds so they can be used for culling in the following frames
+						system->mCachedBounds = system->_calculateBounds();
+						system->mHasCachedBounds = numParticles > 0;
 
-					if(settings.gpuSimulation)
-						simulationDataGPU = simDataPool.allocGPU(*system->mParticleSet);
+						simulationDataCPU->bounds = system->mCachedBounds;
+					}
 					else
+						simulationDataCPU->bounds = settings.customBounds;
+
+					// If using a camera-independant sorting mode, sort the particles right away
+					switch (settings.sortMode)
 					{
-						if(settings.renderMode == ParticleRenderMode::Billboard)
-							simulationDataCPU = simDataPool.allocCPUBillboard(*system->mParticleSet);
-						else
-							simulationDataCPU = simDataPool.allocCPUMesh(*system->mParticleSet);
-
-						simulationDataCPU->numParticles = numParticles;
-
-						if(settings.useAutomaticBounds)
-							simulationDataCPU->bounds = system->_calculateBounds();
-						else
-							simulationDataCPU->bounds = settings.customBounds;
-
-						// If using a camera-independant sorting mode, sort the particles right away
-						switch (settings.sortMode)
-						{
-						default:
-						case ParticleSortMode::None: // No sort, just point the indices back to themselves
-							for (UINT32 i = 0; i < numParticles; i++)
-								simulationDataCPU->indices[i] = i;
-							break;
-						case ParticleSortMode::OldToYoung:
-						case ParticleSortMode::YoungToOld:
-							sortParticles(*system->mParticleSet, settings.sortMode, Vector3::ZERO, simulationDataCPU->indices.data());
-							break;
-						case ParticleSortMode::Distance: break;
-						}
+					default:
+					case ParticleSortMode::None: // No sort, just point the indices back to themselves
+						for (UINT32 i = 0; i < numParticles; i++)
+							simulationDataCPU->indices[i] = i;
+						break;
+					case ParticleSortMode::OldToYoung:
+					case ParticleSortMode::YoungToOld:
+						sortParticles(*system->mParticleSet, settings.sortMode, Vector3::ZERO, simulationDataCPU->indices.data());
+						break;
+					case ParticleSortMode::Distance: break;
 					}
+
+					entry.cpuData = simulationDataCPU;
 				}
+			}
+		};
 
-				{
-					Lock lock(mMutex);
+		if(!mSimulationEntries.empty())
+		{
+			SPtr<TaskGroup> task = TaskGroup::create("ParticleWorker", evaluateWorker, (UINT32)mSimulationEntries.size());
+			TaskScheduler::instance().addTaskGroup(task);
 
-					assert(mNumActiveWorkers > 0);
-					mNumActiveWorkers--;
+			// Wait for tasks to complete
+			task->wait();
+		}
 
-					if(simulationDataCPU)
-						simulationData.cpuData[system->mId] = simulationDataCPU;
-					else if(simulationDataGPU)
-						simulationData.gpuData[system->mId] = simulationDataGPU;
-				}
+		for(auto& entry : mSimulationEntries)
+		{
+			if(entry.cpuData)
+				simulationData.cpuData[entry.system->mId] = entry.cpuData;
+			else if(entry.gpuData)
+				simulationData.gpuData[entry.system->mId] = entry.gpuData;
+		}
 
-				mWorkerDoneSignal.notify_one();
-			};
+		mSwapBuffers = true;
+
+		return &mSimulationData[mReadBufferIdx];
+	}
 
-			SPtr<Task> task = Task::create("ParticleWorker", evaluateWorker);
-			TaskScheduler::instance().addTask(task);
+	void ParticleManager::cullParticleSystems()
+	{
+		const UINT32 numSystems = (UINT32)mSystemList.size();
+		for (UINT32 i = 0; i < 3; i++)
+		{
+			mSystemCenters[i].resize(numSystems);
+			mSystemExtents[i].resize(numSystems);
 		}
 
-		// Wait for tasks to complete
-		TaskScheduler::instance().addWorker(); // Make the current core available for work (since this thread waits)
+		mSystemVisibility.resize(numSystems);
+		mSystemVisibility.reset(false);
+
+		if (numSystems == 0)
+			return;
+
+		for (UINT32 i = 0; i < numSystems; i++)
 		{
-			Lock lock(mMutex);
+			const ParticleSystem* system = mSystemList[i];
+			const ParticleSystemSettings& settings = system->getSettings();
+
+			// GPU simulated systems don't report their bounds back, so they can only be culled using custom bounds. Systems
+			// with unknown bounds get marked as visible below.
+			AABox bounds = AABox::BOX_EMPTY;
+			if (!settings.useAutomaticBounds)
+				bounds = settings.customBounds;
+			else if (system->mHasCachedBounds && !settings.gpuSimulation)
+				bounds = system->mCachedBounds;
+
+			if (settings.simulationSpace == ParticleSimulationSpace::Local)
+				bounds.transformAffine(system->getTransform().getMatrix());
+
+			const Vector3 center = bounds.getCenter();
+			const Vector3 extents = bounds.getHalfSize();
 
-			while (mNumActiveWorkers > 0)
-				mWorkerDoneSignal.wait(lock);
+			for (UINT32 j = 0; j < 3; j++)
+			{
+				mSystemCenters[j][i] = center[j];
+				mSystemExtents[j][i] = Math::abs(extents[j]);
+			}
 		}
-		TaskScheduler::instance().removeWorker();
 
-		mSwapBuffers = true;
+		const float* const centers[3] = { mSystemCenters[0].data(), mSystemCenters[1].data(), mSystemCenters[2].data() };
+		const float* const extents[3] = { mSystemExtents[0].data(), mSystemExtents[1].data(), mSystemExtents[2].data() };
 
-		return &mSimulationData[mReadBufferIdx];
+		for (auto& frustum : mCullFrustums)
+			frustum.intersects(centers, extents, numSystems, mSystemVisibility.data());
+
+		for (UINT32 i = 0; i < numSystems; i++)
+		{
+			const ParticleSystem* system = mSystemList[i];
+			const ParticleSystemSettings& settings = system->getSettings();
+
+			if (settings.useAutomaticBounds && (!system->mHasCachedBounds || settings.gpuSimulation))
+				mSystemVisibility[i] = true;
+		}
 	}
 
 	void ParticleManager::sortParticles(const ParticleSet& set, ParticleSortMode sortMode, const Vector3& viewPoint, 
@@ -473,24 +576,16 @@ namespace bs
 	{
 		assert(sortMode != ParticleSortMode::None);
 
-		struct ParticleSortData
-		{
-			ParticleSortData(float key, UINT32 idx)
-				:key(key), idx(idx)
-			{ }
-
-			float key;
-			UINT32 idx;
-		};
-
 		const UINT32 count = set.getParticleCount();
 		const ParticleSetData& particles = set.getParticles();
 
 		bs_frame_mark();
 		{
-			FrameVector<ParticleSortData> sortData;
-			sortData.reserve(count);
+			FrameVector<UINT32> keys(count);
+			FrameVector<UINT32> tmpKeys(count);
+			FrameVector<UINT32> tmpIndices(count);
 
+			// Keys are inverted so the ascending radix sort outputs particles with the largest key first
 			switch(sortMode)
 			{
 			default:
@@ -498,33 +593,29 @@ namespace bs
 				for(UINT32 i = 0; i < count; i++)
 				{
 					float distance = viewPoint.squaredDistance(particles.position[i]);
-					sortData.emplace_back(distance, i);
+					keys[i] = ~floatToSortableUInt(distance);
 				}
 				break;
 			case ParticleSortMode::OldToYoung: 
 				for(UINT32 i = 0; i < count; i++)
 				{
 					float lifetime = particles.lifetime[i];
-					sortData.emplace_back(lifetime, i);
+					keys[i] = ~floatToSortableUInt(lifetime);
 				}
 				break;
 			case ParticleSortMode::YoungToOld:
 				for(UINT32 i = 0; i < count; i++)
 				{
 					float lifetime = particles.initialLifetime[i] - particles.lifetime[i];
-					sortData.emplace_back(lifetime, i);
+					keys[i] = ~floatToSortableUInt(lifetime);
 				}
 				break;
 			}
 
-			std::sort(sortData.begin(), sortData.end(), 
-				[](const ParticleSortData& lhs, const ParticleSortData& rhs)
-			{
-				return rhs.key < lhs.key;
-			});
-
 			for (UINT32 i = 0; i < count; i++)
-				indices[i] = sortData[i].idx;
+				indices[i] = i;
+
+			radixSortParallel(keys.data(), indices, tmpKeys.data(), tmpIndices.data(), count);
 		}
 		bs_frame_clear();
 	}
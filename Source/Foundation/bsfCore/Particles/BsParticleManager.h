@@ -6,8 +6,11 @@
 #include "Image/BsPixelData.h"
 #include "Utility/BsModule.h"
 #include "Math/BsAABox.h"
+#include "Math/BsConvexVolume.h"
+#include "Utility/BsBitfield.h"
 #include "CoreThread/BsCoreThread.h"
 #include "BsParticleSystem.h"
+#include "Particles/BsParticleCommon.h"
 
 namespace bs
 {
@@ -116,9 +119,18 @@ namespace bs
 	{
 		UnorderedMap<UINT32, ParticleRenderData*> cpuData;
 		UnorderedMap<UINT32, ParticleGPUSimulationData*> gpuData;
+
+		/**
+		 * Bounds of CPU simulated particle systems whose simulation was skipped this frame as they were outside of all
+		 * camera frustums. Such systems have no entry in cpuData and should not be drawn.
+		 */
+		UnorderedMap<UINT32, AABox> culledBounds;
 	};
 
-	/** Keeps track of all active ParticleSystem%s and performs per-frame updates. */
+	/** 
+	 * Keeps track of all active ParticleSystem%s and performs per-frame updates. Particle systems outside of all camera
+	 * frustums are only simulated at a reduced rate, until they become visible.
+	 */
 	class BS_CORE_EXPORT ParticleManager final : public Module<ParticleManager>
 	{
 		struct Members;
@@ -132,9 +144,27 @@ namespace bs
 		 */
 		ParticlePerFrameData* update(const EvaluatedAnimationData& animData);
 
+		/** Returns information about the particle systems processed during the last call to update(). */
+		const ParticleUpdateStats& getStats() const { return mStats; }
+
 	private:
 		friend class ParticleSystem;
 
+		/** Information about a single particle system queued for simulation, and the output of the simulation. */
+		struct SimulationEntry
+		{
+			ParticleSystem* system;
+			float timeDelta;
+			ParticleRenderData* cpuData;
+			ParticleGPUSimulationData* gpuData;
+		};
+
+		/** 
+		 * Determines which particle systems are visible from any of the cull frustums, and outputs the result in 
+		 * mSystemVisibility, in the same order as mSystemList. Systems without known bounds are always visible. 
+		 */
+		void cullParticleSystems();
+
 		/** Must be called by a ParticleSystem upon construction. */
 		UINT32 registerParticleSystem(ParticleSystem* system);
 
@@ -155,16 +185,24 @@ namespace bs
 
 		bool mPaused = false;
 
+		/** Time after which a particle system outside of all camera frustums is simulated, in seconds. */
+		static constexpr float CULLED_UPDATE_INTERVAL = 0.25f;
+
+		// Culling
+		Vector<ParticleSystem*> mSystemList;
+		Vector<ConvexVolume> mCullFrustums;
+		Vector<float> mSystemCenters[3];
+		Vector<float> mSystemExtents[3];
+		Bitfield mSystemVisibility;
+		ParticleUpdateStats mStats;
+
 		// Worker threads
 		ParticlePerFrameData mSimulationData[CoreThread::NUM_SYNC_BUFFERS];
+		Vector<SimulationEntry> mSimulationEntries;
 
 		UINT32 mReadBufferIdx = 1;
 		UINT32 mWriteBufferIdx = 0;
 		
-		Signal mWorkerDoneSignal;
-		Mutex mMutex;
-
-		UINT32 mNumActiveWorkers = 0;
 		bool mSwapBuffers = false;
 	};
 
@@ -5,6 +5,7 @@
 #include "Particles/BsParticleEmitter.h"
 #include "Particles/BsParticleEvolver.h"
 #include "Private/Particles/BsParticleSet.h"
+#include "Private/Particles/BsParticleKernels.h"
 #include "Private/RTTI/BsParticleSystemRTTI.h"
 #include "Allocators/BsPoolAlloc.h"
 #include "Material/BsMaterial.h"
@@ -207,6 +208,8 @@ namespace bs
 
 		mState = State::Playing;
 		mTime = 0.0f;
+		mDeferredTime = 0.0f;
+		mHasCachedBounds = false;
 		mRandom.setSeed(mSeed);
 	}
 
@@ -223,6 +226,7 @@ namespace bs
 
 		mState = State::Stopped;
 		mParticleSet->clear();
+		mHasCachedBounds = false;
 	}
 
 	void ParticleSystem::_simulate(float timeDelta, const EvaluatedAnimationData* animData)
@@ -267,8 +271,7 @@ namespace bs
 			const ParticleSetData& particles = mParticleSet->getParticles();
 
 			// Remember old positions
-			for (UINT32 i = 0; i < numParticles; i++)
-				particles.prevPosition[i] = particles.position[i];
+			bs_copy(particles.prevPosition, particles.position, numParticles);
 
 			const auto& evolverList = mEvolvers.mSortedList;
 
@@ -286,8 +289,7 @@ namespace bs
 			}
 
 			// Simulate
-			for (UINT32 i = 0; i < numParticles; i++)
-				particles.position[i] += particles.velocity[i] * timeStep;
+			ParticleKernels::addScaled(particles.position, particles.velocity, timeStep, numParticles);
 
 			// Evolve post-simulation
 			for (; evolverIter != evolverList.end(); ++evolverIter)
@@ -297,22 +299,20 @@ namespace bs
 			}
 
 			// Decrement lifetime
-			for (UINT32 i = 0; i < numParticles; i++)
-				particles.lifetime[i] -= timeStep;
+			ParticleKernels::subtract(particles.lifetime, timeStep, numParticles);
 
 			// Kill expired particles
-			for (UINT32 i = 0; i < numParticles;)
+			// TODO - Upon freeing a particle don't immediately remove it to save on swap, since we will be immediately
+			// spawning new particles. Perhaps keep a list of recently removed particles so it can immediately be
+			// re-used for spawn, and then only after spawn remove extra particles
+			UINT32 expiredIdx = ParticleKernels::findExpired(particles.lifetime, 0, numParticles);
+			while (expiredIdx < numParticles)
 			{
-				// TODO - Upon freeing a particle don't immediately remove it to save on swap, since we will be immediately
-				// spawning new particles. Perhaps keep a list of recently removed particles so it can immediately be
-				// re-used for spawn, and then only after spawn remove extra particles
-				if (particles.lifetime[i] <= 0.0f)
-				{
-					mParticleSet->freeParticle(i);
-					numParticles--;
-				}
-				else
-					i++;
+				// Last particle gets moved into the freed slot, so it needs to be checked as well
+				mParticleSet->freeParticle(expiredIdx);
+				numParticles--;
+
+				expiredIdx = ParticleKernels::findExpired(particles.lifetime, expiredIdx, numParticles);
 			}
 		}
 
@@ -640,6 +640,11 @@ namespace bs
 		Random mRandom;
 		ParticleSet* mParticleSet = nullptr;
 
+		// Culling, managed by ParticleManager
+		AABox mCachedBounds;
+		bool mHasCachedBounds = false;
+		float mDeferredTime = 0.0f;
+
 		/************************************************************************/
 		/* 								RTTI		                     		*/
 		/************************************************************************/
@@ -4,6 +4,10 @@
 #include "Physics/BsRigidbody.h"
 #include "Math/BsRay.h"
 #include "Components/BsCCollider.h"
+#include "Math/BsAABox.h"
+#include "Math/BsSphere.h"
+#include "Math/BsCapsule.h"
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs
 {
@@ -92,6 +96,95 @@ namespace bs
 		return rawToComponent(_convexOverlap(mesh, position, rotation, layer));
 	}
 
+	Capsule Physics::toCapsule(const PhysicsShapeQuery& query)
+	{
+		const Vector3 offset = Vector3::UNIT_Y * query.extents.y;
+		return Capsule(LineSegment3(query.center - offset, query.center + offset), query.extents.x);
+	}
+
+	void Physics::rayCastBatch(const PhysicsRayQuery* queries, UINT32 count, PhysicsQueryHit* hits, bool* wasHit) const
+	{
+		const auto worker = [this, queries, hits, wasHit](UINT32 begin, UINT32 end)
+		{
+			for (UINT32 i = begin; i < end; i++)
+			{
+				const PhysicsRayQuery& query = queries[i];
+				wasHit[i] = rayCast(query.origin, query.unitDir, hits[i], query.layer, query.max);
+			}
+		};
+
+		TaskScheduler::instance().parallelFor(0, count, QUERY_BATCH_GRAIN_SIZE, worker);
+	}
+
+	void Physics::shapeCastBatch(const PhysicsShapeQuery* queries, UINT32 count, PhysicsQueryHit* hits,
+		bool* wasHit) const
+	{
+		const auto worker = [this, queries, hits, wasHit](UINT32 begin, UINT32 end)
+		{
+			for (UINT32 i = begin; i < end; i++)
+			{
+				const PhysicsShapeQuery& query = queries[i];
+
+				switch (query.shape)
+				{
+				case PhysicsQueryShape::Box:
+					wasHit[i] = boxCast(AABox(query.center - query.extents, query.center + query.extents), 
+						query.rotation, query.unitDir, hits[i], query.layer, query.max);
+					break;
+				case PhysicsQueryShape::Sphere:
+					wasHit[i] = sphereCast(Sphere(query.center, query.extents.x), query.unitDir, hits[i], 
+						query.layer, query.max);
+					break;
+				case PhysicsQueryShape::Capsule:
+					wasHit[i] = capsuleCast(toCapsule(query), query.rotation, query.unitDir, hits[i], query.layer, 
+						query.max);
+					break;
+				}
+			}
+		};
+
+		TaskScheduler::instance().parallelFor(0, count, QUERY_BATCH_GRAIN_SIZE, worker);
+	}
+
+	void Physics::overlapAnyBatch(const PhysicsShapeQuery* queries, UINT32 count, bool* overlaps) const
+	{
+		const auto worker = [this, queries, overlaps](UINT32 begin, UINT32 end)
+		{
+			for (UINT32 i = begin; i < end; i++)
+			{
+				const PhysicsShapeQuery& query = queries[i];
+
+				switch (query.shape)
+				{
+				case PhysicsQueryShape::Box:
+					overlaps[i] = boxOverlapAny(AABox(query.center - query.extents, query.center + query.extents),
+						query.rotation, query.layer);
+					break;
+				case PhysicsQueryShape::Sphere:
+					overlaps[i] = sphereOverlapAny(Sphere(query.center, query.extents.x), query.layer);
+					break;
+				case PhysicsQueryShape::Capsule:
+					overlaps[i] = capsuleOverlapAny(toCapsule(query), query.rotation, query.layer);
+					break;
+				}
+			}
+		};
+
+		TaskScheduler::instance().parallelFor(0, count, QUERY_BATCH_GRAIN_SIZE, worker);
+	}
+
+	void Physics::overlapBatch(const PhysicsShapeQuery* queries, UINT32 count, Collider** colliders,
+		UINT32 maxCollidersPerQuery, UINT32* numColliders) const
+	{
+		const auto worker = [this, queries, colliders, maxCollidersPerQuery, numColliders](UINT32 begin, UINT32 end)
+		{
+			for (UINT32 i = begin; i < end; i++)
+				numColliders[i] = _overlap(queries[i], &colliders[i * maxCollidersPerQuery], maxCollidersPerQuery);
+		};
+
+		TaskScheduler::instance().parallelFor(0, count, QUERY_BATCH_GRAIN_SIZE, worker);
+	}
+
 	Physics& gPhysics()
 	{
 		return Physics::instance();
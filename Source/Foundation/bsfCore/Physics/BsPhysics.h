@@ -46,13 +46,63 @@ namespace bs
 		 * Enables continous collision detection. This will prevent fast-moving objects from tunneling through each other.
 		 * You must also enable CCD for individual Rigidbodies. This option can have a significant performance impact.
 		 */
-		CCD_Enable = 1<<3
+		CCD_Enable = 1<<3,
+		/**
+		 * Runs each physics step in the background, overlapping it with the rest of the frame. The step is started at the
+		 * end of a fixed update and its results are applied at the start of the next one, adding one fixed step of
+		 * latency. While a step is running, changes to physics objects are buffered until it completes and scene queries
+		 * observe the state from before the step.
+		 *
+		 * @see Physics::syncSimulation
+		 */
+		AsyncSimulation = 1<<4,
+		/**
+		 * Interpolates transforms of moving rigidbodies between the two most recent physics steps, every frame. This
+		 * hides the stepping that is visible when the fixed update rate is lower than the frame rate, at a cost of
+		 * displaying the physics state with up to one step of delay.
+		 */
+		Interpolation = 1<<5
 	};
 
 	/** @copydoc CharacterCollisionFlag */
 	typedef Flags<PhysicsFlag> PhysicsFlags;
 	BS_FLAGS_OPERATORS(PhysicsFlag)
 
+	/** Types of geometry that can be used by batched shape queries. */
+	enum class PhysicsQueryShape
+	{
+		Box, /**< Oriented box. */
+		Sphere, /**< Sphere. */
+		Capsule /**< Capsule, with its segment along the local Y axis. */
+	};
+
+	/** Describes a single ray cast, as part of a batch. */
+	struct PhysicsRayQuery
+	{
+		Vector3 origin = Vector3::ZERO; /**< Origin of the ray. */
+		Vector3 unitDir = Vector3::UNIT_Z; /**< Unit direction of the ray. */
+		float max = FLT_MAX; /**< Maximum distance from the ray origin to search for hits. */
+		UINT64 layer = BS_ALL_LAYERS; /**< Layers to consider for the query. */
+	};
+
+	/** Describes a single shape cast or shape overlap query, as part of a batch. */
+	struct PhysicsShapeQuery
+	{
+		PhysicsQueryShape shape = PhysicsQueryShape::Sphere; /**< Type of the shape to query with. */
+		Vector3 center = Vector3::ZERO; /**< Center of the shape, in world space. */
+		Quaternion rotation = Quaternion::IDENTITY; /**< Orientation of the shape. Ignored for spheres. */
+
+		/** 
+		 * Size of the shape. For boxes this is the half-size along each axis, for spheres x is the radius, and for
+		 * capsules x is the radius while y is half the length of the capsule segment.
+		 */
+		Vector3 extents = Vector3::ZERO;
+
+		Vector3 unitDir = Vector3::UNIT_Z; /**< Unit direction to cast the shape in. Ignored by overlap queries. */
+		float max = FLT_MAX; /**< Maximum distance to cast the shape. Ignored by overlap queries. */
+		UINT64 layer = BS_ALL_LAYERS; /**< Layers to consider for the query. */
+	};
+
 	/** Provides global physics settings, factory methods for physics objects and scene queries. */
 	class BS_CORE_EXPORT BS_SCRIPT_EXPORT(m:Physics) Physics : public Module<Physics>
 	{
@@ -127,7 +177,7 @@ namespace bs
 		 * Performs a sweep into the scene using a capsule and returns the closest found hit, if any.
 		 * 
 		 * @param[in]	capsule		Capsule to sweep through the scene.
-		 * @param[in]	rotation	Orientation of the capsule.
+		 * @param[in]	rotation	Orientation of the capsule. The capsule segment extends along the local Y axis.
 		 * @param[in]	unitDir		Unit direction towards which to perform the sweep.
 		 * @param[out]	hit			Information recorded about a hit. Only valid if method returns true.
 		 * @param[in]	layer		Layers to consider for the query. This allows you to ignore certain groups of objects.
@@ -215,7 +265,7 @@ namespace bs
 		 * Performs a sweep into the scene using a capsule and returns all found hits.
 		 * 
 		 * @param[in]	capsule		Capsule to sweep through the scene.
-		 * @param[in]	rotation	Orientation of the capsule.
+		 * @param[in]	rotation	Orientation of the capsule. The capsule segment extends along the local Y axis.
 		 * @param[in]	unitDir		Unit direction towards which to perform the sweep.
 		 * @param[in]	layer		Layers to consider for the query. This allows you to ignore certain groups of objects.
 		 * @param[in]	max			Maximum distance at which to perform the query. Hits past this distance will not be
@@ -306,7 +356,7 @@ namespace bs
 		 * efficient than other types of cast* calls.
 		 * 
 		 * @param[in]	capsule		Capsule to sweep through the scene.
-		 * @param[in]	rotation	Orientation of the capsule.
+		 * @param[in]	rotation	Orientation of the capsule. The capsule segment extends along the local Y axis.
 		 * @param[in]	unitDir		Unit direction towards which to perform the sweep.
 		 * @param[in]	layer		Layers to consider for the query. This allows you to ignore certain groups of objects.
 		 * @param[in]	max			Maximum distance at which to perform the query. Hits past this distance will not be
@@ -360,7 +410,7 @@ namespace bs
 		 * Returns a list of all colliders in the scene that overlap the provided capsule.
 		 * 
 		 * @param[in]	capsule		Capsule to check for overlap.
-		 * @param[in]	rotation	Orientation of the capsule.
+		 * @param[in]	rotation	Orientation of the capsule. The capsule segment extends along the local Y axis.
 		 * @param[in]	layer		Layers to consider for the query. This allows you to ignore certain groups of objects.
 		 * @return					List of all colliders that overlap the capsule.
 		 */
@@ -406,7 +456,7 @@ namespace bs
 		 * Checks if the provided capsule overlaps any other collider in the scene.
 		 * 
 		 * @param[in]	capsule		Capsule to check for overlap.
-		 * @param[in]	rotation	Orientation of the capsule.
+		 * @param[in]	rotation	Orientation of the capsule. The capsule segment extends along the local Y axis.
 		 * @param[in]	layer		Layers to consider for the query. This allows you to ignore certain groups of objects.
 		 * @return					True if there is overlap with another object, false otherwise.
 		 */
@@ -427,6 +477,68 @@ namespace bs
 		virtual bool convexOverlapAny(const HPhysicsMesh& mesh, const Vector3& position, const Quaternion& rotation,
 			UINT64 layer = BS_ALL_LAYERS) const = 0;
 
+		/******************************************************************************************************************/
+		/************************************************ BATCHED QUERIES *************************************************/
+		/******************************************************************************************************************/
+
+		/**
+		 * Casts a set of rays into the scene and returns the closest found hit for each, if any. Queries are executed
+		 * in parallel on the task scheduler workers, and results are written to the provided buffers without any
+		 * allocations.
+		 *
+		 * @param[in]	queries		Rays to cast.
+		 * @param[in]	count		Number of entries in @p queries.
+		 * @param[out]	hits		Buffer with room for @p count entries. Receives the closest hit for each ray. An
+		 *							entry is only valid if the matching @p wasHit entry is true.
+		 * @param[out]	wasHit		Buffer with room for @p count entries. Receives true for each ray that hit
+		 *							something.
+		 */
+		virtual void rayCastBatch(const PhysicsRayQuery* queries, UINT32 count, PhysicsQueryHit* hits, 
+			bool* wasHit) const;
+
+		/**
+		 * Casts a set of shapes through the scene and returns the closest found hit for each, if any. Queries are 
+		 * executed in parallel on the task scheduler workers, and results are written to the provided buffers without
+		 * any allocations.
+		 *
+		 * @param[in]	queries		Shapes to cast.
+		 * @param[in]	count		Number of entries in @p queries.
+		 * @param[out]	hits		Buffer with room for @p count entries. Receives the closest hit for each shape. An
+		 *							entry is only valid if the matching @p wasHit entry is true.
+		 * @param[out]	wasHit		Buffer with room for @p count entries. Receives true for each shape that hit
+		 *							something.
+		 */
+		virtual void shapeCastBatch(const PhysicsShapeQuery* queries, UINT32 count, PhysicsQueryHit* hits,
+			bool* wasHit) const;
+
+		/**
+		 * Checks which of the provided shapes overlap any collider in the scene. Queries are executed in parallel on
+		 * the task scheduler workers.
+		 *
+		 * @param[in]	queries		Shapes to check for overlap.
+		 * @param[in]	count		Number of entries in @p queries.
+		 * @param[out]	overlaps	Buffer with room for @p count entries. Receives true for each shape that overlaps
+		 *							another collider.
+		 */
+		virtual void overlapAnyBatch(const PhysicsShapeQuery* queries, UINT32 count, bool* overlaps) const;
+
+		/**
+		 * Finds colliders overlapping each of the provided shapes. Queries are executed in parallel on the task
+		 * scheduler workers, and results are written to the provided buffers without any allocations.
+		 *
+		 * @param[in]	queries					Shapes to check for overlap.
+		 * @param[in]	count					Number of entries in @p queries.
+		 * @param[out]	colliders				Buffer with room for @p count * @p maxCollidersPerQuery entries.
+		 *										Colliders overlapping the shape at index i are written starting at
+		 *										index i * @p maxCollidersPerQuery.
+		 * @param[in]	maxCollidersPerQuery	Maximum number of colliders to report per query. Any further overlapping
+		 *										colliders are ignored.
+		 * @param[out]	numColliders			Buffer with room for @p count entries. Receives the number of colliders
+		 *										written for each query.
+		 */
+		virtual void overlapBatch(const PhysicsShapeQuery* queries, UINT32 count, Collider** colliders,
+			UINT32 maxCollidersPerQuery, UINT32* numColliders) const;
+
 		/******************************************************************************************************************/
 		/************************************************* OPTIONS ********************************************************/
 		/******************************************************************************************************************/
@@ -440,6 +552,14 @@ namespace bs
 		/** Pauses or resumes the physics simulation. */
 		virtual void setPaused(bool paused) = 0;
 
+		/**
+		 * Waits until a physics step running in the background completes, and applies its results. Call this before
+		 * performing scene queries that must observe the latest simulation results. Does nothing if no step is running.
+		 *
+		 * @see PhysicsFlag::AsyncSimulation
+		 */
+		virtual void syncSimulation() { }
+
 		/** @copydoc setGravity() */
 		BS_SCRIPT_EXPORT(n:Gravity,pr:getter)
 		virtual Vector3 getGravity() const = 0;
@@ -558,6 +678,12 @@ namespace bs
 		 */
 		virtual void update() { }
 
+		/**
+		 * Returns statistics about each simulation step completed between the two most recent calls to update(), in the
+		 * order the steps completed. Empty if the physics implementation doesn't record statistics.
+		 */
+		const Vector<PhysicsStepStats>& getStepStats() const { return mStepStats; }
+
 		/** @copydoc Physics::boxOverlap() */
 		virtual Vector<Collider*> _boxOverlap(const AABox& box, const Quaternion& rotation,
 			UINT64 layer = BS_ALL_LAYERS) const = 0;
@@ -573,6 +699,18 @@ namespace bs
 		virtual Vector<Collider*> _convexOverlap(const HPhysicsMesh& mesh, const Vector3& position,
 			const Quaternion& rotation, UINT64 layer = BS_ALL_LAYERS) const = 0;
 
+		/**
+		 * Finds colliders overlapping the shape described by a batched shape query, without allocating any memory.
+		 *
+		 * @param[in]	query			Shape to check for overlap.
+		 * @param[out]	colliders		Buffer with room for @p maxColliders entries. Receives the overlapping
+		 *								colliders.
+		 * @param[in]	maxColliders	Maximum number of colliders to report. Any further overlapping colliders are
+		 *								ignored.
+		 * @return						Number of colliders written to @p colliders.
+		 */
+		virtual UINT32 _overlap(const PhysicsShapeQuery& query, Collider** colliders, UINT32 maxColliders) const = 0;
+
 		/** 
 		 * Checks does the ray hit the provided collider. 
 		 *
@@ -596,11 +734,21 @@ namespace bs
 	protected:
 		friend class Rigidbody;
 
+		/** Number of queries processed by a single worker at once, when executing batched queries. */
+		static constexpr UINT32 QUERY_BATCH_GRAIN_SIZE = 32;
+
+		/** 
+		 * Converts the capsule described by a batched shape query into a Capsule with its segment along the Y axis. The
+		 * query rotation must be applied separately, the same as for the individual capsule queries.
+		 */
+		static Capsule toCapsule(const PhysicsShapeQuery& query);
+
 		mutable Mutex mMutex;
 		bool mCollisionMap[CollisionMapSize][CollisionMapSize];
 
 		bool mUpdateInProgress = false;
 		PhysicsFlags mFlags;
+		Vector<PhysicsStepStats> mStepStats;
 	};
 
 	/** Provides easier access to Physics. */
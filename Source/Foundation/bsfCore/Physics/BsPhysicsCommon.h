@@ -87,5 +87,18 @@ namespace bs
 		Collider* colliderRaw = nullptr; /**< Collider that was hit. */
 	};
 
+	/** Information about how the tasks of a single physics simulation step were executed. */
+	struct PhysicsStepStats
+	{
+		/** Total number of simulation tasks executed during the step. */
+		UINT32 numTasks = 0;
+
+		/** Number of tasks executed by the thread waiting for the step results, rather than by worker threads. */
+		UINT32 numTasksOnWaitingThread = 0;
+
+		/** Time the waiting thread spent waiting for the step results, in milliseconds. */
+		float waitTime = 0.0f;
+	};
+
 	/** @} */
 }
\ No newline at end of file
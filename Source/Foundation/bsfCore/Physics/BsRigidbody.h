@@ -305,6 +305,9 @@ namespace bs
 		 */
 		void _setTransform(const Vector3& position, const Quaternion& rotation);
 
+		/** Returns the scene object that receives the transform updates from the physics simulation. */
+		const HSceneObject& _getLinkedSO() const { return mLinkedSO; }
+
 		/** 
 		 * Sets the object that owns this physics object, if any. Used for high level systems so they can easily map their
 		 * high level physics objects from the low level ones returned by various queries and events.
@@ -0,0 +1,740 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/Image/BsBlockDecoder.h"
+#include "Utility/BsBitwise.h"
+
+namespace bs
+{
+	/** Subset of each pixel for BC6H and BC7 partitions with two subsets, one bit per pixel. */
+	static constexpr UINT16 PARTITIONS_2[64] =
+	{
+		0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+		0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+		0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+		0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+		0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+		0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+		0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+		0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+	};
+
+	/** Subset of each pixel for BC7 partitions with three subsets, two bits per pixel. */
+	static constexpr UINT32 PARTITIONS_3[64] =
+	{
+		0xAA685050, 0x6A5A5040, 0x5A5A4200, 0x5450A0A8, 0xA5A50000, 0xA0A05050, 0x5555A0A0, 0x5A5A5050,
+		0xAA550000, 0xAA555500, 0xAAAA5500, 0x90909090, 0x94949494, 0xA4A4A4A4, 0xA9A59450, 0x2A0A4250,
+		0xA5945040, 0x0A425054, 0xA5A5A500, 0x55A0A0A0, 0xA8A85454, 0x6A6A4040, 0xA4A45000, 0x1A1A0500,
+		0x0050A4A4, 0xAAA59090, 0x14696914, 0x69691400, 0xA08585A0, 0xAA821414, 0x50A4A450, 0x6A5A0200,
+		0xA9A58000, 0x5090A0A8, 0xA8A09050, 0x24242424, 0x00AA5500, 0x24924924, 0x24499224, 0x50A50A50,
+		0x500AA550, 0xAAAA4444, 0x66660000, 0xA5A0A5A0, 0x50A050A0, 0x69286928, 0x44AAAA44, 0x66666600,
+		0xAA444444, 0x54A854A8, 0x95809580, 0x96969600, 0xA85454A8, 0x80959580, 0xAA141414, 0x96960000,
+		0xAAAA1414, 0xA05050A0, 0xA0A5A5A0, 0x96000000, 0x40804080, 0xA9A8A9A8, 0xAAAAAA44, 0x2A4A5254,
+	};
+
+	/** Index of the anchor pixel of the second subset, for partitions with two subsets. */
+	static constexpr UINT8 ANCHORS_2[64] =
+	{
+		15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+		15, 2, 8, 2, 2, 8, 8, 15, 2, 8, 2, 2, 8, 8, 2, 2,
+		15, 15, 6, 8, 2, 8, 15, 15, 2, 8, 2, 2, 2, 15, 15, 6,
+		6, 2, 6, 8, 15, 15, 2, 2, 15, 15, 15, 15, 15, 2, 2, 15,
+	};
+
+	/** Index of the anchor pixel of the second subset, for partitions with three subsets. */
+	static constexpr UINT8 ANCHORS_3_SECOND[64] =
+	{
+		3, 3, 15, 15, 8, 3, 15, 15, 8, 8, 6, 6, 6, 5, 3, 3,
+		3, 3, 8, 15, 3, 3, 6, 10, 5, 8, 8, 6, 8, 5, 15, 15,
+		8, 15, 3, 5, 6, 10, 8, 15, 15, 3, 15, 5, 15, 15, 15, 15,
+		3, 15, 5, 5, 5, 8, 5, 10, 5, 10, 8, 13, 15, 12, 3, 3,
+	};
+
+	/** Index of the anchor pixel of the third subset, for partitions with three subsets. */
+	static constexpr UINT8 ANCHORS_3_THIRD[64] =
+	{
+		15, 8, 8, 3, 15, 15, 3, 8, 15, 15, 15, 15, 15, 15, 15, 8,
+		15, 8, 15, 3, 15, 8, 15, 8, 3, 15, 6, 10, 15, 15, 10, 8,
+		15, 3, 15, 10, 10, 8, 9, 10, 6, 15, 8, 15, 3, 6, 6, 8,
+		15, 3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 3, 15, 15, 8,
+	};
+
+	/** Interpolation weights for BC6H and BC7 indices, for 2, 3 and 4 bit indices. */
+	static constexpr UINT32 WEIGHTS_2[4] = { 0, 21, 43, 64 };
+	static constexpr UINT32 WEIGHTS_3[8] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+	static constexpr UINT32 WEIGHTS_4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	/** Returns the interpolation weights for indices with the provided number of bits. */
+	static const UINT32* getWeights(UINT32 numBits)
+	{
+		switch(numBits)
+		{
+		case 2: return WEIGHTS_2;
+		case 3: return WEIGHTS_3;
+		default: return WEIGHTS_4;
+		}
+	}
+
+	/** Interpolates between two endpoints using a weight in range [0, 64]. */
+	static INT32 interpolate(INT32 a, INT32 b, UINT32 weight)
+	{
+		return (a * (64 - (INT32)weight) + b * (INT32)weight + 32) >> 6;
+	}
+
+	/** Reads consecutive bit fields from a 128-bit block, starting at the least significant bit. */
+	class BlockBitReader
+	{
+	public:
+		BlockBitReader(const UINT8* block)
+		{
+			memcpy(&mLow, block, sizeof(mLow));
+			memcpy(&mHigh, block + 8, sizeof(mHigh));
+		}
+
+		/** Reads the next @p count bits (at most 32). */
+		UINT32 read(UINT32 count)
+		{
+			if(count == 0)
+				return 0;
+
+			UINT64 value;
+			if(mPos >= 64)
+				value = mHigh >> (mPos - 64);
+			else if(mPos == 0)
+				value = mLow;
+			else
+				value = (mLow >> mPos) | (mHigh << (64 - mPos));
+
+			mPos += count;
+			return (UINT32)(value & ((1ULL << count) - 1));
+		}
+
+		/** Reads the next @p count bits, with the first bit read becoming the most significant one. */
+		UINT32 readReversed(UINT32 count)
+		{
+			UINT32 value = 0;
+			for(UINT32 i = 0; i < count; i++)
+				value = (value << 1) | read(1);
+
+			return value;
+		}
+
+		/** Skips the next @p count bits. */
+		void skip(UINT32 count) { mPos += count; }
+
+	private:
+		UINT64 mLow;
+		UINT64 mHigh;
+		UINT32 mPos = 0;
+	};
+
+	/** Expands a 5:6:5 packed color into 8-bit components. */
+	static void expand565(UINT32 color, UINT8* output)
+	{
+		const UINT32 r = (color >> 11) & 0x1F;
+		const UINT32 g = (color >> 5) & 0x3F;
+		const UINT32 b = color & 0x1F;
+
+		output[0] = (UINT8)((r << 3) | (r >> 2));
+		output[1] = (UINT8)((g << 2) | (g >> 4));
+		output[2] = (UINT8)((b << 3) | (b >> 2));
+		output[3] = 255;
+	}
+
+	/**
+	 * Decodes the color part of a BC1, BC2 or BC3 block. If @p allowTransparent is true the block may use the mode with
+	 * three colors and transparent black, which only BC1 supports.
+	 */
+	static void decodeColorBlock(const UINT8* block, UINT8* output, bool allowTransparent)
+	{
+		const UINT32 color0 = block[0] | (block[1] << 8);
+		const UINT32 color1 = block[2] | (block[3] << 8);
+
+		UINT8 palette[4][4];
+		expand565(color0, palette[0]);
+		expand565(color1, palette[1]);
+
+		if(color0 > color1 || !allowTransparent)
+		{
+			for(UINT32 i = 0; i < 3; i++)
+			{
+				palette[2][i] = (UINT8)((2 * palette[0][i] + palette[1][i]) / 3);
+				palette[3][i] = (UINT8)((palette[0][i] + 2 * palette[1][i]) / 3);
+			}
+
+			palette[2][3] = 255;
+			palette[3][3] = 255;
+		}
+		else
+		{
+			for(UINT32 i = 0; i < 3; i++)
+				palette[2][i] = (UINT8)((palette[0][i] + palette[1][i]) / 2);
+
+			palette[2][3] = 255;
+			memset(palette[3], 0, sizeof(palette[3]));
+		}
+
+		UINT32 indices;
+		memcpy(&indices, block + 4, sizeof(indices));
+
+		for(UINT32 i = 0; i < 16; i++)
+			memcpy(output + i * 4, palette[(indices >> (i * 2)) & 0x3], 4);
+	}
+
+	/**
+	 * Decodes a BC4 block, or the alpha part of a BC3 block. Writes a single 8-bit channel, with @p stride bytes
+	 * between consecutive pixels.
+	 */
+	static void decodeChannelBlock(const UINT8* block, UINT8* output, UINT32 stride)
+	{
+		UINT32 palette[8];
+		palette[0] = block[0];
+		palette[1] = block[1];
+
+		if(palette[0] > palette[1])
+		{
+			for(UINT32 i = 2; i < 8; i++)
+				palette[i] = ((8 - i) * palette[0] + (i - 1) * palette[1]) / 7;
+		}
+		else
+		{
+			for(UINT32 i = 2; i < 6; i++)
+				palette[i] = ((6 - i) * palette[0] + (i - 1) * palette[1]) / 5;
+
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+
+		UINT64 indices = 0;
+		memcpy(&indices, block + 2, 6);
+
+		for(UINT32 i = 0; i < 16; i++)
+			output[i * stride] = (UINT8)palette[(indices >> (i * 3)) & 0x7];
+	}
+
+	static void decodeBC1(const UINT8* block, UINT8* output)
+	{
+		decodeColorBlock(block, output, true);
+	}
+
+	static void decodeBC2(const UINT8* block, UINT8* output)
+	{
+		decodeColorBlock(block + 8, output, false);
+
+		UINT64 alpha;
+		memcpy(&alpha, block, sizeof(alpha));
+
+		for(UINT32 i = 0; i < 16; i++)
+			output[i * 4 + 3] = (UINT8)(((alpha >> (i * 4)) & 0xF) * 17);
+	}
+
+	static void decodeBC3(const UINT8* block, UINT8* output)
+	{
+		decodeColorBlock(block + 8, output, false);
+		decodeChannelBlock(block, output + 3, 4);
+	}
+
+	static void decodeBC4(const UINT8* block, UINT8* output)
+	{
+		for(UINT32 i = 0; i < 16; i++)
+		{
+			output[i * 4 + 1] = 0;
+			output[i * 4 + 2] = 0;
+			output[i * 4 + 3] = 255;
+		}
+
+		decodeChannelBlock(block, output, 4);
+	}
+
+	static void decodeBC5(const UINT8* block, UINT8* output)
+	{
+		for(UINT32 i = 0; i < 16; i++)
+		{
+			output[i * 4 + 2] = 0;
+			output[i * 4 + 3] = 255;
+		}
+
+		decodeChannelBlock(block, output, 4);
+		decodeChannelBlock(block + 8, output + 1, 4);
+	}
+
+	/** Layout of a single BC7 mode. */
+	struct BC7ModeInfo
+	{
+		UINT8 numSubsets;
+		UINT8 partitionBits;
+		UINT8 rotationBits;
+		UINT8 indexSelectionBits;
+		UINT8 colorBits;
+		UINT8 alphaBits;
+		UINT8 endpointPBits;
+		UINT8 sharedPBits;
+		UINT8 indexBits;
+		UINT8 secondaryIndexBits;
+	};
+
+	static constexpr BC7ModeInfo BC7_MODES[8] =
+	{
+		{ 3, 4, 0, 0, 4, 0, 1, 0, 3, 0 },
+		{ 2, 6, 0, 0, 6, 0, 0, 1, 3, 0 },
+		{ 3, 6, 0, 0, 5, 0, 0, 0, 2, 0 },
+		{ 2, 6, 0, 0, 7, 0, 1, 0, 2, 0 },
+		{ 1, 0, 2, 1, 5, 6, 0, 0, 2, 3 },
+		{ 1, 0, 2, 0, 7, 8, 0, 0, 2, 2 },
+		{ 1, 0, 0, 0, 7, 7, 1, 0, 4, 0 },
+		{ 2, 6, 0, 0, 5, 5, 1, 0, 2, 0 },
+	};
+
+	/** Expands an endpoint component with @p numBits bits to 8 bits. */
+	static UINT32 expandBC7Component(UINT32 value, UINT32 numBits)
+	{
+		value <<= 8 - numBits;
+		return value | (value >> numBits);
+	}
+
+	static void decodeBC7(const UINT8* block, UINT8* output)
+	{
+		// Mode is determined by the position of the lowest set bit, and blocks without one are invalid
+		if(block[0] == 0)
+		{
+			memset(output, 0, 16 * 4);
+			return;
+		}
+
+		const UINT32 mode = Bitwise::leastSignificantBit(block[0]);
+		const BC7ModeInfo& info = BC7_MODES[mode];
+
+		BlockBitReader bits(block);
+		bits.skip(mode + 1);
+
+		const UINT32 partition = bits.read(info.partitionBits);
+		const UINT32 rotation = bits.read(info.rotationBits);
+		const UINT32 indexSelection = bits.read(info.indexSelectionBits);
+
+		const UINT32 numEndpoints = info.numSubsets * 2;
+		UINT32 endpoints[6][4];
+		for(UINT32 i = 0; i < 3; i++)
+		{
+			for(UINT32 j = 0; j < numEndpoints; j++)
+				endpoints[j][i] = bits.read(info.colorBits);
+		}
+
+		for(UINT32 j = 0; j < numEndpoints; j++)
+			endpoints[j][3] = bits.read(info.alphaBits);
+
+		UINT32 colorBits = info.colorBits;
+		UINT32 alphaBits = info.alphaBits;
+		if(info.endpointPBits != 0 || info.sharedPBits != 0)
+		{
+			UINT32 pBits[6];
+			if(info.endpointPBits != 0)
+			{
+				for(UINT32 j = 0; j < numEndpoints; j++)
+					pBits[j] = bits.read(1);
+			}
+			else
+			{
+				for(UINT32 j = 0; j < info.numSubsets; j++)
+				{
+					pBits[j * 2 + 0] = bits.read(1);
+					pBits[j * 2 + 1] = pBits[j * 2 + 0];
+				}
+			}
+
+			for(UINT32 j = 0; j < numEndpoints; j++)
+			{
+				for(UINT32 i = 0; i < 4; i++)
+					endpoints[j][i] = (endpoints[j][i] << 1) | pBits[j];
+			}
+
+			colorBits++;
+			if(alphaBits != 0)
+				alphaBits++;
+		}
+
+		for(UINT32 j = 0; j < numEndpoints; j++)
+		{
+			for(UINT32 i = 0; i < 3; i++)
+				endpoints[j][i] = expandBC7Component(endpoints[j][i], colorBits);
+
+			endpoints[j][3] = alphaBits != 0 ? expandBC7Component(endpoints[j][3], alphaBits) : 255;
+		}
+
+		// Subset of each pixel, and whether its index is stored with one bit less
+		UINT32 subsets[16];
+		bool anchors[16] = { true };
+		for(UINT32 i = 0; i < 16; i++)
+		{
+			switch(info.numSubsets)
+			{
+			case 1: subsets[i] = 0; break;
+			case 2: subsets[i] = (PARTITIONS_2[partition] >> i) & 0x1; break;
+			default: subsets[i] = (PARTITIONS_3[partition] >> (i * 2)) & 0x3; break;
+			}
+		}
+
+		if(info.numSubsets == 2)
+			anchors[ANCHORS_2[partition]] = true;
+		else if(info.numSubsets == 3)
+		{
+			anchors[ANCHORS_3_SECOND[partition]] = true;
+			anchors[ANCHORS_3_THIRD[partition]] = true;
+		}
+
+		UINT32 indices[16];
+		for(UINT32 i = 0; i < 16; i++)
+			indices[i] = bits.read(info.indexBits - (anchors[i] ? 1 : 0));
+
+		// Modes with separate alpha indices only have a single subset
+		UINT32 secondaryIndices[16];
+		if(info.secondaryIndexBits != 0)
+		{
+			for(UINT32 i = 0; i < 16; i++)
+				secondaryIndices[i] = bits.read(info.secondaryIndexBits - (i == 0 ? 1 : 0));
+		}
+
+		const UINT32* colorWeights = getWeights(info.indexBits);
+		const UINT32* alphaWeights = colorWeights;
+		const UINT32* colorIndices = indices;
+		const UINT32* alphaIndices = indices;
+
+		if(info.secondaryIndexBits != 0)
+		{
+			if(indexSelection == 0)
+			{
+				alphaWeights = getWeights(info.secondaryIndexBits);
+				alphaIndices = secondaryIndices;
+			}
+			else
+			{
+				colorWeights = getWeights(info.secondaryIndexBits);
+				colorIndices = secondaryIndices;
+			}
+		}
+
+		for(UINT32 i = 0; i < 16; i++)
+		{
+			const UINT32* endpoint0 = endpoints[subsets[i] * 2 + 0];
+			const UINT32* endpoint1 = endpoints[subsets[i] * 2 + 1];
+
+			UINT8* pixel = output + i * 4;
+			for(UINT32 j = 0; j < 3; j++)
+				pixel[j] = (UINT8)interpolate(endpoint0[j], endpoint1[j], colorWeights[colorIndices[i]]);
+
+			pixel[3] = (UINT8)interpolate(endpoint0[3], endpoint1[3], alphaWeights[alphaIndices[i]]);
+
+			if(rotation != 0)
+				std::swap(pixel[3], pixel[rotation - 1]);
+		}
+	}
+
+	/** Layout of a single BC6H mode, other than the endpoint bit positions. */
+	struct BC6HModeInfo
+	{
+		bool transformed;
+		UINT8 numSubsets;
+		UINT8 endpointBits;
+		UINT8 deltaBits[3];
+	};
+
+	static constexpr BC6HModeInfo BC6H_MODES[14] =
+	{
+		{ true, 2, 10, { 5, 5, 5 } },
+		{ true, 2, 7, { 6, 6, 6 } },
+		{ true, 2, 11, { 5, 4, 4 } },
+		{ true, 2, 11, { 4, 5, 4 } },
+		{ true, 2, 11, { 4, 4, 5 } },
+		{ true, 2, 9, { 5, 5, 5 } },
+		{ true, 2, 8, { 6, 5, 5 } },
+		{ true, 2, 8, { 5, 6, 5 } },
+		{ true, 2, 8, { 5, 5, 6 } },
+		{ false, 2, 6, { 6, 6, 6 } },
+		{ false, 1, 10, { 10, 10, 10 } },
+		{ true, 1, 11, { 9, 9, 9 } },
+		{ true, 1, 12, { 8, 8, 8 } },
+		{ true, 1, 16, { 4, 4, 4 } },
+	};
+
+	/** Sign extends a value with @p numBits bits. */
+	static INT32 signExtend(UINT32 value, UINT32 numBits)
+	{
+		const UINT32 shift = 32 - numBits;
+		return (INT32)(value << shift) >> shift;
+	}
+
+	/** Converts an unsigned BC6H endpoint component with @p numBits bits to 16 bits. */
+	static INT32 unquantizeBC6H(INT32 value, UINT32 numBits)
+	{
+		if(numBits >= 15 || value == 0)
+			return value;
+
+		if(value == (1 << numBits) - 1)
+			return 0xFFFF;
+
+		return ((value << 16) + 0x8000) >> numBits;
+	}
+
+	/**
+	 * Reads the mode specific endpoint layout of a BC6H block. Each mode stores the endpoints and their most
+	 * significant bits in a different order. Endpoints are output as the first and second endpoint of the first
+	 * subset, followed by the endpoints of the second subset.
+	 */
+	static bool readBC6HEndpoints(BlockBitReader& bits, UINT32& mode, UINT32 (&endpoints)[4][3])
+	{
+		UINT32 modeBits = bits.read(2);
+		if(modeBits > 1)
+			modeBits |= bits.read(3) << 2;
+
+		memset(endpoints, 0, sizeof(endpoints));
+
+		UINT32 (&w)[3] = endpoints[0];
+		UINT32 (&x)[3] = endpoints[1];
+		UINT32 (&y)[3] = endpoints[2];
+		UINT32 (&z)[3] = endpoints[3];
+
+		// Reads @p count bits into the provided value, starting at bit @p start
+		const auto readInto = [&bits](UINT32& value, UINT32 start, UINT32 count = 1)
+		{
+			value |= bits.read(count) << start;
+		};
+
+		switch(modeBits)
+		{
+		case 0x00:
+			mode = 0;
+			readInto(y[1], 4); readInto(y[2], 4); readInto(z[2], 4);
+			readInto(w[0], 0, 10); readInto(w[1], 0, 10); readInto(w[2], 0, 10);
+			readInto(x[0], 0, 5); readInto(z[1], 4); readInto(y[1], 0, 4);
+			readInto(x[1], 0, 5); readInto(z[2], 0); readInto(z[1], 0, 4);
+			readInto(x[2], 0, 5); readInto(z[2], 1); readInto(y[2], 0, 4);
+			readInto(y[0], 0, 5); readInto(z[2], 2); readInto(z[0], 0, 5); readInto(z[2], 3);
+			break;
+		case 0x01:
+			mode = 1;
+			readInto(y[1], 5); readInto(z[1], 4); readInto(z[1], 5);
+			readInto(w[0], 0, 7); readInto(z[2], 0); readInto(z[2], 1); readInto(y[2], 4);
+			readInto(w[1], 0, 7); readInto(y[2], 5); readInto(z[2], 2); readInto(y[1], 4);
+			readInto(w[2], 0, 7); readInto(z[2], 3); readInto(z[2], 5); readInto(z[2], 4);
+			readInto(x[0], 0, 6); readInto(y[1], 0, 4);
+			readInto(x[1], 0, 6); readInto(z[1], 0, 4);
+			readInto(x[2], 0, 6); readInto(y[2], 0, 4);
+			readInto(y[0], 0, 6); readInto(z[0], 0, 6);
+			break;
+		case 0x02:
+			mode = 2;
+			readInto(w[0], 0, 10); readInto(w[1], 0, 10); readInto(w[2], 0, 10);
+			readInto(x[0], 0, 5); readInto(w[0], 10); readInto(y[1], 0, 4);
+			readInto(x[1], 0, 4); readInto(w[1], 10); readInto(z[2], 0); readInto(z[1], 0, 4);
+			readInto(x[2], 0, 4); readInto(w[2], 10); readInto(z[2], 1); readInto(y[2], 0, 4);
+			readInto(y[0], 0, 5); readInto(z[2], 2); readInto(z[0], 0, 5); readInto(z[2], 3);
+			break;
+		case 0x06:
+			mode = 3;
+			readInto(w[0], 0, 10); readInto(w[1], 0, 10); readInto(w[2], 0, 10);
+			readInto(x[0], 0, 4); readInto(w[0], 10); readInto(z[1], 4); readInto(y[1], 0, 4);
+			readInto(x[1], 0, 5); readInto(w[1], 10); readInto(z[1], 0, 4);
+			readInto(x[2], 0, 4); readInto(w[2], 10); readInto(z[2], 1); readInto(y[2], 0, 4);
+			readInto(y[0], 0, 4); readInto(z[2], 0); readInto(z[2], 2); readInto(z[0], 0, 4);
+			readInto(y[1], 4); readInto(z[2], 3);
+			break;
+		case 0x0A:
+			mode = 4;
+			readInto(w[0], 0, 10); readInto(w[1], 0, 10); readInto(w[2], 0, 10);
+			readInto(x[0], 0, 4); readInto(w[0], 10); readInto(y[2], 4); readInto(y[1], 0, 4);
+			readInto(x[1], 0, 4); readInto(w[1], 10); readInto(z[2], 0); readInto(z[1], 0, 4);
+			readInto(x[2], 0, 5); readInto(w[2], 10); readInto(y[2], 0, 4);
+			readInto(y[0], 0, 4); readInto(z[2], 1); readInto(z[2], 2); readInto(z[0], 0, 4);
+			readInto(z[2], 4); readInto(z[2], 3);
+			break;
+		case 0x0E:
+			mode = 5;
+			readInto(w[0], 0, 9); readInto(y[2], 4); readInto(w[1], 0, 9); readInto(y[1], 4);
+			readInto(w[2], 0, 9); readInto(z[2], 4);
+			readInto(x[0], 0, 5); readInto(z[1], 4); readInto(y[1], 0, 4);
+			readInto(x[1], 0, 5); readInto(z[2], 0); readInto(z[1], 0, 4);
+			readInto(x[2], 0, 5); readInto(z[2], 1); readInto(y[2], 0, 4);
+			readInto(y[0], 0, 5); readInto(z[2], 2); readInto(z[0], 0, 5); readInto(z[2], 3);
+			break;
+		case 0x12:
+			mode = 6;
+			readInto(w[0], 0, 8); readInto(z[1], 4); readInto(y[2], 4);
+			readInto(w[1], 0, 8); readInto(z[2], 2); readInto(y[1], 4);
+			readInto(w[2], 0, 8); readInto(z[2], 3); readInto(z[2], 4);
+			readInto(x[0], 0, 6); readInto(y[1], 0, 4);
+			readInto(x[1], 0, 5); readInto(z[2], 0); readInto(z[1], 0, 4);
+			readInto(x[2], 0, 5); readInto(z[2], 1); readInto(y[2], 0, 4);
+			readInto(y[0], 0, 6); readInto(z[0], 0, 6);
+			break;
+		case 0x16:
+			mode = 7;
+			readInto(w[0], 0, 8); readInto(z[2], 0); readInto(y[2], 4);
+			readInto(w[1], 0, 8); readInto(y[1], 5); readInto(y[1], 4);
+			readInto(w[2], 0, 8); readInto(z[1], 5); readInto(z[2], 4);
+			readInto(x[0], 0, 5); readInto(z[1], 4); readInto(y[1], 0, 4);
+			readInto(x[1], 0, 6); readInto(z[1], 0, 4);
+			readInto(x[2], 0, 5); readInto(z[2], 1); readInto(y[2], 0, 4);
+			readInto(y[0], 0, 5); readInto(z[2], 2); readInto(z[0], 0, 5); readInto(z[2], 3);
+			break;
+		case 0x1A:
+			mode = 8;
+			readInto(w[0], 0, 8); readInto(z[2], 1); readInto(y[2], 4);
+			readInto(w[1], 0, 8); readInto(y[2], 5); readInto(y[1], 4);
+			readInto(w[2], 0, 8); readInto(z[2], 5); readInto(z[2], 4);
+			readInto(x[0], 0, 5); readInto(z[1], 4); readInto(y[1], 0, 4);
+			readInto(x[1], 0, 5); readInto(z[2], 0); readInto(z[1], 0, 4);
+			readInto(x[2], 0, 6); readInto(y[2], 0, 4);
+			readInto(y[0], 0, 5); readInto(z[2], 2); readInto(z[0], 0, 5); readInto(z[2], 3);
+			break;
+		case 0x1E:
+			mode = 9;
+			readInto(w[0], 0, 6); readInto(z[1], 4); readInto(z[2], 0); readInto(z[2], 1); readInto(y[2], 4);
+			readInto(w[1], 0, 6); readInto(y[1], 5); readInto(y[2], 5); readInto(z[2], 2); readInto(y[1], 4);
+			readInto(w[2], 0, 6); readInto(z[1], 5); readInto(z[2], 3); readInto(z[2], 5); readInto(z[2], 4);
+			readInto(x[0], 0, 6); readInto(y[1], 0, 4);
+			readInto(x[1], 0, 6); readInto(z[1], 0, 4);
+			readInto(x[2], 0, 6); readInto(y[2], 0, 4);
+			readInto(y[0], 0, 6); readInto(z[0], 0, 6);
+			break;
+		case 0x03:
+			mode = 10;
+			readInto(w[0], 0, 10); readInto(w[1], 0, 10); readInto(w[2], 0, 10);
+			readInto(x[0], 0, 10); readInto(x[1], 0, 10); readInto(x[2], 0, 10);
+			break;
+		case 0x07:
+			mode = 11;
+			readInto(w[0], 0, 10); readInto(w[1], 0, 10); readInto(w[2], 0, 10);
+			readInto(x[0], 0, 9); readInto(w[0], 10);
+			readInto(x[1], 0, 9); readInto(w[1], 10);
+			readInto(x[2], 0, 9); readInto(w[2], 10);
+			break;
+		case 0x0B:
+			mode = 12;
+			readInto(w[0], 0, 10); readInto(w[1], 0, 10); readInto(w[2], 0, 10);
+			readInto(x[0], 0, 8); w[0] |= bits.readReversed(2) << 10;
+			readInto(x[1], 0, 8); w[1] |= bits.readReversed(2) << 10;
+			readInto(x[2], 0, 8); w[2] |= bits.readReversed(2) << 10;
+			break;
+		case 0x0F:
+			mode = 13;
+			readInto(w[0], 0, 10); readInto(w[1], 0, 10); readInto(w[2], 0, 10);
+			readInto(x[0], 0, 4); w[0] |= bits.readReversed(6) << 10;
+			readInto(x[1], 0, 4); w[1] |= bits.readReversed(6) << 10;
+			readInto(x[2], 0, 4); w[2] |= bits.readReversed(6) << 10;
+			break;
+		default:
+			return false;
+		}
+
+		return true;
+	}
+
+	static void decodeBC6H(const UINT8* block, UINT8* output)
+	{
+		BlockBitReader bits(block);
+
+		UINT32 mode;
+		UINT32 packedEndpoints[4][3];
+		if(!readBC6HEndpoints(bits, mode, packedEndpoints))
+		{
+			// Reserved modes decode to black
+			const UINT16 black[4] = { 0, 0, 0, Bitwise::floatToHalf(1.0f) };
+			for(UINT32 i = 0; i < 16; i++)
+				memcpy(output + i * 8, black, sizeof(black));
+
+			return;
+		}
+
+		const BC6HModeInfo& info = BC6H_MODES[mode];
+		const UINT32 partition = info.numSubsets == 2 ? bits.read(5) : 0;
+
+		// Other endpoints are stored relative to the first one
+		const UINT32 numEndpoints = info.numSubsets * 2;
+		const UINT32 endpointMask = (1U << info.endpointBits) - 1;
+
+		INT32 endpoints[4][3];
+		for(UINT32 i = 0; i < 3; i++)
+		{
+			endpoints[0][i] = (INT32)packedEndpoints[0][i];
+
+			for(UINT32 j = 1; j < numEndpoints; j++)
+			{
+				if(info.transformed)
+				{
+					const INT32 delta = signExtend(packedEndpoints[j][i], info.deltaBits[i]);
+					endpoints[j][i] = (endpoints[0][i] + delta) & endpointMask;
+				}
+				else
+					endpoints[j][i] = (INT32)packedEndpoints[j][i];
+			}
+
+			for(UINT32 j = 0; j < numEndpoints; j++)
+				endpoints[j][i] = unquantizeBC6H(endpoints[j][i], info.endpointBits);
+		}
+
+		const UINT32 indexBits = info.numSubsets == 2 ? 3 : 4;
+		const UINT32 anchor = info.numSubsets == 2 ? ANCHORS_2[partition] : 0;
+		const UINT32* weights = getWeights(indexBits);
+
+		const UINT16 one = Bitwise::floatToHalf(1.0f);
+		for(UINT32 i = 0; i < 16; i++)
+		{
+			const UINT32 index = bits.read(indexBits - ((i == 0 || i == anchor) ? 1 : 0));
+			const UINT32 subset = info.numSubsets == 2 ? (PARTITIONS_2[partition] >> i) & 0x1 : 0;
+
+			const INT32* endpoint0 = endpoints[subset * 2 + 0];
+			const INT32* endpoint1 = endpoints[subset * 2 + 1];
+
+			UINT16 pixel[4];
+			for(UINT32 j = 0; j < 3; j++)
+			{
+				// Scale to the range of finite half floats
+				const INT32 value = interpolate(endpoint0[j], endpoint1[j], weights[index]);
+				pixel[j] = (UINT16)((value * 31) >> 6);
+			}
+
+			pixel[3] = one;
+			memcpy(output + i * 8, pixel, sizeof(pixel));
+		}
+	}
+
+	BlockDecodeFunc BlockDecoder::find(PixelFormat format)
+	{
+		switch(format)
+		{
+		case PF_BC1:
+		case PF_BC1a:
+			return &decodeBC1;
+		case PF_BC2:
+			return &decodeBC2;
+		case PF_BC3:
+			return &decodeBC3;
+		case PF_BC4:
+			return &decodeBC4;
+		case PF_BC5:
+			return &decodeBC5;
+		case PF_BC6H:
+			return &decodeBC6H;
+		case PF_BC7:
+			return &decodeBC7;
+		default:
+			return nullptr;
+		}
+	}
+
+	PixelFormat BlockDecoder::getDecodedFormat(PixelFormat format)
+	{
+		return format == PF_BC6H ? PF_RGBA16F : PF_RGBA8;
+	}
+
+	UINT32 BlockDecoder::getBlockSize(PixelFormat format)
+	{
+		switch(format)
+		{
+		case PF_BC1:
+		case PF_BC1a:
+		case PF_BC4:
+			return 8;
+		default:
+			return 16;
+		}
+	}
+}
@@ -0,0 +1,35 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Image/BsPixelData.h"
+
+namespace bs
+{
+	/** @addtogroup Utility-Core-Internal
+	 *  @{
+	 */
+
+	/** Decodes a single 4x4 block of compressed data into 16 pixels, written to @p output in row-major order. */
+	typedef void(*BlockDecodeFunc)(const UINT8* block, UINT8* output);
+
+	/**
+	 * Decoders for block compressed (BC1-BC7) pixel formats. BC6H blocks decode to PF_RGBA16F, and all other formats
+	 * decode to PF_RGBA8. Channels not present in the compressed format are set to zero, and alpha to one.
+	 */
+	class BS_CORE_EXPORT BlockDecoder
+	{
+	public:
+		/** Returns a decoder for blocks of @p format, or null if the format isn't supported. */
+		static BlockDecodeFunc find(PixelFormat format);
+
+		/** Returns the format of the pixels output by the decoder for @p format. */
+		static PixelFormat getDecodedFormat(PixelFormat format);
+
+		/** Returns the size of a single 4x4 block of @p format, in bytes. */
+		static UINT32 getBlockSize(PixelFormat format);
+	};
+
+	/** @} */
+}
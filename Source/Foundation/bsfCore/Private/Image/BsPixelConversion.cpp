@@ -0,0 +1,375 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/Image/BsPixelConversion.h"
+#include "Math/BsSIMD.h"
+#include "Utility/BsBitwise.h"
+
+namespace bs
+{
+	/**
+	 * Describes the layout of a four byte, 8-bit per component format. Red and blue are at bit offsets @p redShift and
+	 * 16 - @p redShift, green is always in the second byte and alpha, if present, in the fourth byte.
+	 */
+	template<PixelFormat format>
+	struct Format8Info;
+
+	template<> struct Format8Info<PF_RGBA8> { enum { redShift = 0, hasAlpha = true }; };
+	template<> struct Format8Info<PF_BGRA8> { enum { redShift = 16, hasAlpha = true }; };
+	template<> struct Format8Info<PF_RGB8> { enum { redShift = 0, hasAlpha = false }; };
+	template<> struct Format8Info<PF_BGR8> { enum { redShift = 16, hasAlpha = false }; };
+
+	/** 
+	 * Converts a float to an 8-bit normalized value. Unlike Bitwise::unormToUint() this maps [0, 1] to [0, 255], so
+	 * conversions from 8-bit formats to floats and back are lossless.
+	 */
+	static UINT32 floatToUnorm8(float value)
+	{
+		return Math::roundToPosInt(Math::clamp01(value) * 255.0f);
+	}
+
+	/** SIMD version of floatToUnorm8(). */
+	static simd::uint32x4 floatToUnorm8(const simd::float32x4& value)
+	{
+		using namespace simd;
+
+		const float32x4 clamped = min(max(value, splat<float32x4>(0.0f)), splat<float32x4>(1.0f));
+		return (uint32x4)to_int32(add(mul(clamped, splat<float32x4>(255.0f)), splat<float32x4>(0.5f)));
+	}
+
+	/** SIMD version of Bitwise::floatToHalfI(), operating on eight values at once. */
+	static simd::uint32<8> floatToHalf(const simd::uint32<8>& value)
+	{
+		using namespace simd;
+
+		const uint32<8> sign = bit_and(shift_r<16>(value), splat<uint32<8>>(0x8000));
+		const int32<8> exponent = sub((int32<8>)bit_and(shift_r<23>(value), splat<uint32<8>>(0xFF)),
+			splat<int32<8>>(127 - 15));
+		const uint32<8> mantissa = bit_and(value, splat<uint32<8>>(0x007FFFFF));
+		const uint32<8> halfMantissa = shift_r<13>(mantissa);
+
+		uint32<8> output = bit_or(bit_or(sign, shift_l<10>((uint32<8>)exponent)), halfMantissa);
+
+		// Overflow
+		const uint32<8> infinity = bit_or(sign, splat<uint32<8>>(0x7C00));
+		output = blend(infinity, output, cmp_gt(exponent, splat<int32<8>>(30)));
+
+		// Infinity and NaN, making sure NaNs don't turn into infinities once the mantissa is truncated
+		uint32<8> nan = bit_or(infinity, halfMantissa);
+		const mask_int32<8> lostMantissa = bit_and(cmp_eq(halfMantissa, splat<uint32<8>>(0)),
+			cmp_neq(mantissa, splat<uint32<8>>(0)));
+		nan = blend(bit_or(nan, splat<uint32<8>>(1)), nan, lostMantissa);
+		output = blend(nan, output, cmp_eq(exponent, splat<int32<8>>(0xFF - (127 - 15))));
+
+		// Denormals. Equivalent to shifting the mantissa with the implicit bit by the exponent, which can't be done
+		// per-lane with SSE, so scale the absolute value instead.
+		const float32<8> absValue = bit_cast<float32<8>>(bit_and(value, splat<uint32<8>>(0x7FFFFFFF)));
+		const uint32<8> denormal = bit_or(sign, (uint32<8>)to_int32(mul(absValue, splat<float32<8>>(16777216.0f))));
+		output = blend(denormal, output, cmp_le(exponent, splat<int32<8>>(0)));
+
+		// Underflow, sign is not preserved
+		return blend(splat<uint32<8>>(0), output, cmp_lt(exponent, splat<int32<8>>(-10)));
+	}
+
+	/** SIMD version of Bitwise::halfToFloatI(), operating on eight values at once. */
+	static simd::uint32<8> halfToFloat(const simd::uint32<8>& value)
+	{
+		using namespace simd;
+
+		const uint32<8> sign = shift_l<16>(bit_and(value, splat<uint32<8>>(0x8000)));
+		const uint32<8> exponent = bit_and(shift_r<10>(value), splat<uint32<8>>(0x1F));
+		const uint32<8> halfMantissa = bit_and(value, splat<uint32<8>>(0x03FF));
+		const uint32<8> mantissa = shift_l<13>(halfMantissa);
+
+		uint32<8> output = bit_or(bit_or(sign, shift_l<23>(add(exponent, splat<uint32<8>>(127 - 15)))), mantissa);
+
+		// Infinity and NaN
+		const uint32<8> nan = bit_or(bit_or(sign, splat<uint32<8>>(0x7F800000)), mantissa);
+		output = blend(nan, output, cmp_eq(exponent, splat<uint32<8>>(31)));
+
+		// Zero and denormals, all of which are exactly representable as normalized 32-bit floats
+		const float32<8> denormalValue = mul(to_float32((int32<8>)halfMantissa),
+			splat<float32<8>>(1.0f / 16777216.0f));
+		const uint32<8> denormal = bit_or(sign, bit_cast<uint32<8>>(denormalValue));
+
+		return blend(denormal, output, cmp_eq(exponent, splat<uint32<8>>(0)));
+	}
+
+	/** Swizzles between two four byte, 8-bit per component formats. */
+	template<PixelFormat srcFormat, PixelFormat dstFormat>
+	static void convert8To8(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		using namespace simd;
+		using SrcInfo = Format8Info<srcFormat>;
+		using DstInfo = Format8Info<dstFormat>;
+
+		const UINT32 numSimd = count & ~3U;
+		for(UINT32 i = 0; i < numSimd; i += 4)
+		{
+			const uint32x4 value = load_u<uint32x4>(src + i * 4);
+			const uint32x4 byteMask = splat<uint32x4>(0xFF);
+
+			const uint32x4 r = bit_and(shift_r<SrcInfo::redShift>(value), byteMask);
+			const uint32x4 g = bit_and(shift_r<8>(value), byteMask);
+			const uint32x4 b = bit_and(shift_r<16 - SrcInfo::redShift>(value), byteMask);
+
+			uint32x4 output = bit_or(bit_or(shift_l<DstInfo::redShift>(r), shift_l<8>(g)),
+				shift_l<16 - DstInfo::redShift>(b));
+
+			if(DstInfo::hasAlpha)
+			{
+				if(SrcInfo::hasAlpha)
+					output = bit_or(output, bit_and(value, splat<uint32x4>(0xFF000000)));
+				else
+					output = bit_or(output, splat<uint32x4>(0xFF000000));
+			}
+
+			store_u(dst + i * 4, output);
+		}
+
+		for(UINT32 i = numSimd; i < count; i++)
+		{
+			UINT32 value;
+			memcpy(&value, src + i * 4, sizeof(value));
+
+			const UINT32 r = (value >> SrcInfo::redShift) & 0xFF;
+			const UINT32 g = (value >> 8) & 0xFF;
+			const UINT32 b = (value >> (16 - SrcInfo::redShift)) & 0xFF;
+			const UINT32 a = SrcInfo::hasAlpha ? (value >> 24) : 0xFF;
+
+			UINT32 output = (r << DstInfo::redShift) | (g << 8) | (b << (16 - DstInfo::redShift));
+			if(DstInfo::hasAlpha)
+				output |= a << 24;
+
+			memcpy(dst + i * 4, &output, sizeof(output));
+		}
+	}
+
+	/** Converts a four byte, 8-bit per component format to PF_RGBA32F. */
+	template<PixelFormat srcFormat>
+	static void convert8ToFloat(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		using namespace simd;
+		using SrcInfo = Format8Info<srcFormat>;
+
+		float* output = (float*)dst;
+
+		const UINT32 numSimd = count & ~3U;
+		for(UINT32 i = 0; i < numSimd; i += 4)
+		{
+			const uint32x4 value = load_u<uint32x4>(src + i * 4);
+			const uint32x4 byteMask = splat<uint32x4>(0xFF);
+			const float32x4 scale = splat<float32x4>(255.0f);
+
+			float32x4 r = div(to_float32((int32x4)bit_and(shift_r<SrcInfo::redShift>(value), byteMask)), scale);
+			float32x4 g = div(to_float32((int32x4)bit_and(shift_r<8>(value), byteMask)), scale);
+			float32x4 b = div(to_float32((int32x4)bit_and(shift_r<16 - SrcInfo::redShift>(value), byteMask)), scale);
+			float32x4 a = splat<float32x4>(1.0f);
+
+			if(SrcInfo::hasAlpha)
+				a = div(to_float32((int32x4)shift_r<24>(value)), scale);
+
+			// Components of a single pixel per register
+			transpose4(r, g, b, a);
+
+			float* pixel = output + i * 4;
+			store_u(pixel + 0, r);
+			store_u(pixel + 4, g);
+			store_u(pixel + 8, b);
+			store_u(pixel + 12, a);
+		}
+
+		for(UINT32 i = numSimd; i < count; i++)
+		{
+			UINT32 value;
+			memcpy(&value, src + i * 4, sizeof(value));
+
+			float* pixel = output + i * 4;
+			pixel[0] = ((value >> SrcInfo::redShift) & 0xFF) / 255.0f;
+			pixel[1] = ((value >> 8) & 0xFF) / 255.0f;
+			pixel[2] = ((value >> (16 - SrcInfo::redShift)) & 0xFF) / 255.0f;
+			pixel[3] = SrcInfo::hasAlpha ? (value >> 24) / 255.0f : 1.0f;
+		}
+	}
+
+	/** Converts PF_RGBA32F to a four byte, 8-bit per component format. */
+	template<PixelFormat dstFormat>
+	static void convertFloatTo8(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		using namespace simd;
+		using DstInfo = Format8Info<dstFormat>;
+
+		const float* input = (const float*)src;
+
+		const UINT32 numSimd = count & ~3U;
+		for(UINT32 i = 0; i < numSimd; i += 4)
+		{
+			const float* pixel = input + i * 4;
+			float32x4 r = load_u<float32x4>(pixel + 0);
+			float32x4 g = load_u<float32x4>(pixel + 4);
+			float32x4 b = load_u<float32x4>(pixel + 8);
+			float32x4 a = load_u<float32x4>(pixel + 12);
+
+			// Single component of four pixels per register
+			transpose4(r, g, b, a);
+
+			uint32x4 output = bit_or(bit_or(shift_l<DstInfo::redShift>(floatToUnorm8(r)), shift_l<8>(floatToUnorm8(g))),
+				shift_l<16 - DstInfo::redShift>(floatToUnorm8(b)));
+
+			if(DstInfo::hasAlpha)
+				output = bit_or(output, shift_l<24>(floatToUnorm8(a)));
+
+			store_u(dst + i * 4, output);
+		}
+
+		for(UINT32 i = numSimd; i < count; i++)
+		{
+			const float* pixel = input + i * 4;
+
+			UINT32 output = (floatToUnorm8(pixel[0]) << DstInfo::redShift) | (floatToUnorm8(pixel[1]) << 8) |
+				(floatToUnorm8(pixel[2]) << (16 - DstInfo::redShift));
+
+			if(DstInfo::hasAlpha)
+				output |= floatToUnorm8(pixel[3]) << 24;
+
+			memcpy(dst + i * 4, &output, sizeof(output));
+		}
+	}
+
+	/** Converts a 32-bit float format with @p numComponents components to its 16-bit float equivalent. */
+	template<UINT32 numComponents>
+	static void convertFloatToHalf(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		using namespace simd;
+
+		const float* input = (const float*)src;
+		UINT16* output = (UINT16*)dst;
+
+		const UINT32 numValues = count * numComponents;
+		const UINT32 numSimd = numValues & ~7U;
+		for(UINT32 i = 0; i < numSimd; i += 8)
+		{
+			const uint32<8> value = bit_cast<uint32<8>>(load_u<float32<8>>(input + i));
+			store_u(output + i, (uint16<8>)to_int16(floatToHalf(value)));
+		}
+
+		for(UINT32 i = numSimd; i < numValues; i++)
+			output[i] = Bitwise::floatToHalf(input[i]);
+	}
+
+	/** Converts a 16-bit float format with @p numComponents components to its 32-bit float equivalent. */
+	template<UINT32 numComponents>
+	static void convertHalfToFloat(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		using namespace simd;
+
+		const UINT16* input = (const UINT16*)src;
+		float* output = (float*)dst;
+
+		const UINT32 numValues = count * numComponents;
+		const UINT32 numSimd = numValues & ~7U;
+		for(UINT32 i = 0; i < numSimd; i += 8)
+		{
+			const uint32<8> value = to_uint32(load_u<uint16<8>>(input + i));
+			store_u(output + i, bit_cast<float32<8>>(halfToFloat(value)));
+		}
+
+		for(UINT32 i = numSimd; i < numValues; i++)
+			output[i] = Bitwise::halfToFloat(input[i]);
+	}
+
+	/**
+	 * Performs two conversions in sequence, through an intermediate format with @p tempPixelSize bytes per pixel. Pixels
+	 * are processed in small chunks so the intermediate data stays in the cache.
+	 */
+	template<PixelRowConversionFunc first, PixelRowConversionFunc second, UINT32 srcPixelSize, UINT32 tempPixelSize,
+		UINT32 dstPixelSize>
+	static void convertChained(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		static constexpr UINT32 CHUNK_SIZE = 64;
+		alignas(16) UINT8 temp[CHUNK_SIZE * tempPixelSize];
+
+		for(UINT32 i = 0; i < count; i += CHUNK_SIZE)
+		{
+			const UINT32 chunkCount = std::min(CHUNK_SIZE, count - i);
+
+			first(src + i * srcPixelSize, temp, chunkCount);
+			second(temp, dst + i * dstPixelSize, chunkCount);
+		}
+	}
+
+	/** Converts a four byte, 8-bit per component format to PF_RGBA16F. */
+	template<PixelFormat srcFormat>
+	static void convert8ToHalf(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		convertChained<&convert8ToFloat<srcFormat>, &convertFloatToHalf<4>, 4, 16, 8>(src, dst, count);
+	}
+
+	/** Converts PF_RGBA16F to a four byte, 8-bit per component format. */
+	template<PixelFormat dstFormat>
+	static void convertHalfTo8(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		convertChained<&convertHalfToFloat<4>, &convertFloatTo8<dstFormat>, 8, 16, 4>(src, dst, count);
+	}
+
+	/** Kernel for converting between a specific pair of formats. */
+	struct PixelConversionEntry
+	{
+		PixelFormat srcFormat;
+		PixelFormat dstFormat;
+		PixelRowConversionFunc func;
+	};
+
+	static const PixelConversionEntry CONVERSIONS[] =
+	{
+		{ PF_RGBA8, PF_BGRA8, &convert8To8<PF_RGBA8, PF_BGRA8> },
+		{ PF_RGBA8, PF_RGB8, &convert8To8<PF_RGBA8, PF_RGB8> },
+		{ PF_RGBA8, PF_BGR8, &convert8To8<PF_RGBA8, PF_BGR8> },
+		{ PF_BGRA8, PF_RGBA8, &convert8To8<PF_BGRA8, PF_RGBA8> },
+		{ PF_BGRA8, PF_RGB8, &convert8To8<PF_BGRA8, PF_RGB8> },
+		{ PF_BGRA8, PF_BGR8, &convert8To8<PF_BGRA8, PF_BGR8> },
+		{ PF_RGB8, PF_RGBA8, &convert8To8<PF_RGB8, PF_RGBA8> },
+		{ PF_RGB8, PF_BGRA8, &convert8To8<PF_RGB8, PF_BGRA8> },
+		{ PF_RGB8, PF_BGR8, &convert8To8<PF_RGB8, PF_BGR8> },
+		{ PF_BGR8, PF_RGBA8, &convert8To8<PF_BGR8, PF_RGBA8> },
+		{ PF_BGR8, PF_BGRA8, &convert8To8<PF_BGR8, PF_BGRA8> },
+		{ PF_BGR8, PF_RGB8, &convert8To8<PF_BGR8, PF_RGB8> },
+
+		{ PF_RGBA8, PF_RGBA32F, &convert8ToFloat<PF_RGBA8> },
+		{ PF_BGRA8, PF_RGBA32F, &convert8ToFloat<PF_BGRA8> },
+		{ PF_RGB8, PF_RGBA32F, &convert8ToFloat<PF_RGB8> },
+		{ PF_BGR8, PF_RGBA32F, &convert8ToFloat<PF_BGR8> },
+
+		{ PF_RGBA32F, PF_RGBA8, &convertFloatTo8<PF_RGBA8> },
+		{ PF_RGBA32F, PF_BGRA8, &convertFloatTo8<PF_BGRA8> },
+		{ PF_RGBA32F, PF_RGB8, &convertFloatTo8<PF_RGB8> },
+		{ PF_RGBA32F, PF_BGR8, &convertFloatTo8<PF_BGR8> },
+
+		{ PF_RGBA8, PF_RGBA16F, &convert8ToHalf<PF_RGBA8> },
+		{ PF_BGRA8, PF_RGBA16F, &convert8ToHalf<PF_BGRA8> },
+		{ PF_RGB8, PF_RGBA16F, &convert8ToHalf<PF_RGB8> },
+		{ PF_BGR8, PF_RGBA16F, &convert8ToHalf<PF_BGR8> },
+
+		{ PF_RGBA16F, PF_RGBA8, &convertHalfTo8<PF_RGBA8> },
+		{ PF_RGBA16F, PF_BGRA8, &convertHalfTo8<PF_BGRA8> },
+		{ PF_RGBA16F, PF_RGB8, &convertHalfTo8<PF_RGB8> },
+		{ PF_RGBA16F, PF_BGR8, &convertHalfTo8<PF_BGR8> },
+
+		{ PF_R32F, PF_R16F, &convertFloatToHalf<1> },
+		{ PF_RG32F, PF_RG16F, &convertFloatToHalf<2> },
+		{ PF_RGBA32F, PF_RGBA16F, &convertFloatToHalf<4> },
+		{ PF_R16F, PF_R32F, &convertHalfToFloat<1> },
+		{ PF_RG16F, PF_RG32F, &convertHalfToFloat<2> },
+		{ PF_RGBA16F, PF_RGBA32F, &convertHalfToFloat<4> },
+	};
+
+	PixelRowConversionFunc PixelConversion::find(PixelFormat srcFormat, PixelFormat dstFormat)
+	{
+		for(auto& entry : CONVERSIONS)
+		{
+			if(entry.srcFormat == srcFormat && entry.dstFormat == dstFormat)
+				return entry.func;
+		}
+
+		return nullptr;
+	}
+}
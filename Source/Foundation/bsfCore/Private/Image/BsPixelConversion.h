@@ -0,0 +1,33 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Image/BsPixelData.h"
+
+namespace bs
+{
+	/** @addtogroup Utility-Core-Internal
+	 *  @{
+	 */
+
+	/** Converts @p count consecutive pixels from @p src, writing them to @p dst in a different pixel format. */
+	typedef void(*PixelRowConversionFunc)(const UINT8* src, UINT8* dst, UINT32 count);
+
+	/**
+	 * SIMD kernels converting between commonly used pixel formats, as a faster alternative to unpacking and packing each
+	 * pixel through PixelUtil::unpackColor() and PixelUtil::packColor(). Covers swizzles between 8-bit formats,
+	 * conversions between 8-bit and floating point formats, and conversions between 32-bit and 16-bit floats.
+	 */
+	class BS_CORE_EXPORT PixelConversion
+	{
+	public:
+		/**
+		 * Returns a kernel converting pixels from @p srcFormat to @p dstFormat, or null if there is no specialized kernel
+		 * for that pair of formats.
+		 */
+		static PixelRowConversionFunc find(PixelFormat srcFormat, PixelFormat dstFormat);
+	};
+
+	/** @} */
+}
@@ -0,0 +1,328 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/Particles/BsParticleKernels.h"
+#include "Math/BsSIMD.h"
+#include "Math/BsMatrix3.h"
+#include "Math/BsMatrix4.h"
+#include "Math/BsPlane.h"
+#include "Utility/BsBitwise.h"
+
+namespace bs
+{
+	/** Checks if the pointer is aligned to the size of a SIMD register. */
+	static bool isAligned(const void* ptr)
+	{
+		return ((size_t)ptr & 15) == 0;
+	}
+
+	/** Converts a SIMD comparison result into a bitmask with one bit per lane. */
+	static UINT32 laneMask(const simd::mask_float32x4& mask)
+	{
+		using namespace simd;
+
+		// Each lane sets four bits in the byte mask, keep one bit per lane
+		const UINT32 byteMask = extract_bits_any(bit_cast<uint8x16>(bit_cast<uint32x4>(mask)));
+		return (byteMask & 0x1) | ((byteMask >> 3) & 0x2) | ((byteMask >> 6) & 0x4) | ((byteMask >> 9) & 0x8);
+	}
+
+	/**
+	 * Transforms the first @p count entries of @p data by @p matrix, applying the translation if @p isPoint is true.
+	 * Entries before the first aligned one are transformed individually.
+	 */
+	static void transform(Vector3* data, const Matrix4& matrix, bool isPoint, UINT32 count)
+	{
+		using namespace simd;
+
+		UINT32 start = 0;
+		for(; start < count && !isAligned(data + start); start++)
+		{
+			if(isPoint)
+				data[start] = matrix.multiplyAffine(data[start]);
+			else
+				data[start] = matrix.multiplyDirection(data[start]);
+		}
+
+		float32x4 mat[3][4];
+		for(UINT32 row = 0; row < 3; row++)
+		{
+			for(UINT32 col = 0; col < 4; col++)
+				mat[row][col] = splat<float32x4>(isPoint || col < 3 ? matrix[row][col] : 0.0f);
+		}
+
+		const UINT32 numSimd = start + ((count - start) & ~3U);
+		for(UINT32 i = start; i < numSimd; i += 4)
+		{
+			float* ptr = &data[i].x;
+
+			float32x4 x, y, z;
+			load_packed3(x, y, z, ptr);
+
+			const float32x4 newX = simd::add(simd::add(mul(mat[0][0], x), mul(mat[0][1], y)),
+				simd::add(mul(mat[0][2], z), mat[0][3]));
+			const float32x4 newY = simd::add(simd::add(mul(mat[1][0], x), mul(mat[1][1], y)),
+				simd::add(mul(mat[1][2], z), mat[1][3]));
+			const float32x4 newZ = simd::add(simd::add(mul(mat[2][0], x), mul(mat[2][1], y)),
+				simd::add(mul(mat[2][2], z), mat[2][3]));
+
+			store_packed3(ptr, newX, newY, newZ);
+		}
+
+		for(UINT32 i = numSimd; i < count; i++)
+		{
+			if(isPoint)
+				data[i] = matrix.multiplyAffine(data[i]);
+			else
+				data[i] = matrix.multiplyDirection(data[i]);
+		}
+	}
+
+	void ParticleKernels::add(Vector3* data, const Vector3& value, UINT32 count)
+	{
+		assert(isAligned(data));
+
+		using namespace simd;
+
+		// Four vectors fit exactly into three registers, so process them as a flat array of floats and rotate the
+		// components of the added value to match
+		const float32x4 value0 = make_float(value.x, value.y, value.z, value.x);
+		const float32x4 value1 = make_float(value.y, value.z, value.x, value.y);
+		const float32x4 value2 = make_float(value.z, value.x, value.y, value.z);
+
+		const UINT32 numSimd = count & ~3U;
+		for(UINT32 i = 0; i < numSimd; i += 4)
+		{
+			float* ptr = &data[i].x;
+
+			store(ptr + 0, simd::add(load<float32x4>(ptr + 0), value0));
+			store(ptr + 4, simd::add(load<float32x4>(ptr + 4), value1));
+			store(ptr + 8, simd::add(load<float32x4>(ptr + 8), value2));
+		}
+
+		for(UINT32 i = numSimd; i < count; i++)
+			data[i] += value;
+	}
+
+	void ParticleKernels::addScaled(Vector3* dst, const Vector3* src, float scale, UINT32 count)
+	{
+		assert(isAligned(dst) && isAligned(src));
+
+		using namespace simd;
+
+		const float32x4 scaleVec = splat<float32x4>(scale);
+
+		// Same operation is applied to all components, so process as a flat array of floats
+		float* dstPtr = &dst->x;
+		const float* srcPtr = &src->x;
+
+		const UINT32 numFloats = count * 3;
+		const UINT32 numSimd = numFloats & ~3U;
+		for(UINT32 i = 0; i < numSimd; i += 4)
+		{
+			float32x4 value = load<float32x4>(dstPtr + i);
+			value = simd::add(value, mul(load<float32x4>(srcPtr + i), scaleVec));
+
+			store(dstPtr + i, value);
+		}
+
+		for(UINT32 i = numSimd; i < numFloats; i++)
+			dstPtr[i] += srcPtr[i] * scale;
+	}
+
+	void ParticleKernels::subtract(float* data, float value, UINT32 count)
+	{
+		assert(isAligned(data));
+
+		using namespace simd;
+
+		const float32x4 valueVec = splat<float32x4>(value);
+
+		const UINT32 numSimd = count & ~3U;
+		for(UINT32 i = 0; i < numSimd; i += 4)
+			store(data + i, sub(load<float32x4>(data + i), valueVec));
+
+		for(UINT32 i = numSimd; i < count; i++)
+			data[i] -= value;
+	}
+
+	UINT32 ParticleKernels::findExpired(const float* lifetime, UINT32 start, UINT32 count)
+	{
+		using namespace simd;
+
+		const float32x4 zero = make_zero();
+
+		// Particles are removed by swapping with the last one, so the start isn't necessarily aligned
+		UINT32 i = start;
+		for(; i + 4 <= count; i += 4)
+		{
+			const UINT32 mask = laneMask(cmp_le(load_u<float32x4>(lifetime + i), zero));
+			if(mask != 0)
+				return i + Bitwise::leastSignificantBit(mask);
+		}
+
+		for(; i < count; i++)
+		{
+			if(lifetime[i] <= 0.0f)
+				return i;
+		}
+
+		return count;
+	}
+
+	void ParticleKernels::orbit(Vector3* position, const Vector3& center, const Matrix3& rotation, float radial,
+		UINT32 count)
+	{
+		assert(isAligned(position));
+
+		using namespace simd;
+
+		const float32x4 centerX = splat<float32x4>(center.x);
+		const float32x4 centerY = splat<float32x4>(center.y);
+		const float32x4 centerZ = splat<float32x4>(center.z);
+
+		float32x4 rot[3][3];
+		for(UINT32 row = 0; row < 3; row++)
+		{
+			for(UINT32 col = 0; col < 3; col++)
+				rot[row][col] = splat<float32x4>(rotation[row][col]);
+		}
+
+		const float32x4 radialVec = splat<float32x4>(radial);
+		const float32x4 minLength = splat<float32x4>(1e-08f);
+
+		const UINT32 numSimd = count & ~3U;
+		for(UINT32 i = 0; i < numSimd; i += 4)
+		{
+			float* ptr = &position[i].x;
+
+			float32x4 x, y, z;
+			load_packed3(x, y, z, ptr);
+
+			x = sub(x, centerX);
+			y = sub(y, centerY);
+			z = sub(z, centerZ);
+
+			float32x4 newX = simd::add(simd::add(mul(rot[0][0], x), mul(rot[0][1], y)), mul(rot[0][2], z));
+			float32x4 newY = simd::add(simd::add(mul(rot[1][0], x), mul(rot[1][1], y)), mul(rot[1][2], z));
+			float32x4 newZ = simd::add(simd::add(mul(rot[2][0], x), mul(rot[2][1], y)), mul(rot[2][2], z));
+
+			if(radial != 0.0f)
+			{
+				// Push along the normalized offset, leaving offsets too short to normalize as they are
+				const float32x4 length = sqrt(simd::add(simd::add(mul(x, x), mul(y, y)), mul(z, z)));
+				const float32x4 scale = blend(div(radialVec, length), radialVec, cmp_gt(length, minLength));
+
+				newX = simd::add(newX, mul(x, scale));
+				newY = simd::add(newY, mul(y, scale));
+				newZ = simd::add(newZ, mul(z, scale));
+			}
+
+			x = simd::add(newX, centerX);
+			y = simd::add(newY, centerY);
+			z = simd::add(newZ, centerZ);
+
+			store_packed3(ptr, x, y, z);
+		}
+
+		for(UINT32 i = numSimd; i < count; i++)
+		{
+			const Vector3 point = position[i] - center;
+			Vector3 newPoint = rotation.multiply(point);
+
+			if(radial != 0.0f)
+				newPoint += Vector3::normalize(point) * radial;
+
+			position[i] = center + newPoint;
+		}
+	}
+
+	UINT32 ParticleKernels::findNearPlanes(const Vector3* position, UINT32 count, const Plane* planes, UINT32 numPlanes,
+		float radius, UINT32* output)
+	{
+		assert(isAligned(position));
+
+		using namespace simd;
+
+		const float32x4 radiusVec = splat<float32x4>(radius);
+
+		UINT32 numFound = 0;
+		const UINT32 numSimd = count & ~3U;
+		for(UINT32 i = 0; i < numSimd; i += 4)
+		{
+			float32x4 x, y, z;
+			load_packed3(x, y, z, &position[i].x);
+
+			UINT32 nearMask = 0;
+			for(UINT32 j = 0; j < numPlanes; j++)
+			{
+				const Plane& plane = planes[j];
+
+				const float32x4 normalX = splat<float32x4>(plane.normal.x);
+				const float32x4 normalY = splat<float32x4>(plane.normal.y);
+				const float32x4 normalZ = splat<float32x4>(plane.normal.z);
+				const float32x4 planeD = splat<float32x4>(plane.d);
+
+				const float32x4 dist = sub(simd::add(simd::add(mul(x, normalX), mul(y, normalY)), mul(z, normalZ)), planeD);
+				nearMask |= laneMask(cmp_le(dist, radiusVec));
+			}
+
+			for(; nearMask != 0; nearMask &= nearMask - 1)
+				output[numFound++] = i + Bitwise::leastSignificantBit(nearMask);
+		}
+
+		for(UINT32 i = numSimd; i < count; i++)
+		{
+			for(UINT32 j = 0; j < numPlanes; j++)
+			{
+				if(planes[j].getDistance(position[i]) <= radius)
+				{
+					output[numFound++] = i;
+					break;
+				}
+			}
+		}
+
+		return numFound;
+	}
+
+	void ParticleKernels::fill(float* data, float value, UINT32 count)
+	{
+		using namespace simd;
+
+		const float32x4 valueVec = splat<float32x4>(value);
+
+		const UINT32 numSimd = count & ~3U;
+		for(UINT32 i = 0; i < numSimd; i += 4)
+			store_u(data + i, valueVec);
+
+		for(UINT32 i = numSimd; i < count; i++)
+			data[i] = value;
+	}
+
+	void ParticleKernels::scale(Vector3* data, float scale, UINT32 count)
+	{
+		using namespace simd;
+
+		const float32x4 scaleVec = splat<float32x4>(scale);
+
+		// Same operation is applied to all components, so process as a flat array of floats
+		float* ptr = &data->x;
+
+		const UINT32 numFloats = count * 3;
+		const UINT32 numSimd = numFloats & ~3U;
+		for(UINT32 i = 0; i < numSimd; i += 4)
+			store_u(ptr + i, mul(load_u<float32x4>(ptr + i), scaleVec));
+
+		for(UINT32 i = numSimd; i < numFloats; i++)
+			ptr[i] *= scale;
+	}
+
+	void ParticleKernels::multiplyAffine(Vector3* data, const Matrix4& matrix, UINT32 count)
+	{
+		transform(data, matrix, true, count);
+	}
+
+	void ParticleKernels::multiplyDirection(Vector3* data, const Matrix4& matrix, UINT32 count)
+	{
+		transform(data, matrix, false, count);
+	}
+}
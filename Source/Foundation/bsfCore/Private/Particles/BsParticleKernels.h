@@ -0,0 +1,74 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Math/BsVector3.h"
+
+namespace bs
+{
+	/** @addtogroup Particles-Internal
+	 *  @{
+	 */
+
+	/**
+	 * SIMD kernels operating over entire particle attribute streams, as stored in ParticleSetData. Streams of Vector3
+	 * are expected to be 16-byte aligned, which ParticleSetData guarantees.
+	 */
+	class BS_CORE_EXPORT ParticleKernels
+	{
+	public:
+		/** Adds @p value to each of the first @p count entries of @p data. */
+		static void add(Vector3* data, const Vector3& value, UINT32 count);
+
+		/** Adds @p src scaled by @p scale to each of the first @p count entries of @p dst. */
+		static void addScaled(Vector3* dst, const Vector3* src, float scale, UINT32 count);
+
+		/** Subtracts @p value from each of the first @p count entries of @p data. */
+		static void subtract(float* data, float value, UINT32 count);
+
+		/**
+		 * Returns the index of the first entry in range [@p start, @p count) of @p lifetime whose value is zero or less,
+		 * or @p count if there is no such entry.
+		 */
+		static UINT32 findExpired(const float* lifetime, UINT32 start, UINT32 count);
+
+		/**
+		 * Rotates each of the first @p count entries of @p position around @p center using the provided rotation, and
+		 * then moves it away from the center by @p radial units.
+		 */
+		static void orbit(Vector3* position, const Vector3& center, const Matrix3& rotation, float radial,
+			UINT32 count);
+
+		/**
+		 * Finds all entries in the first @p count entries of @p position that are less than @p radius away from the front
+		 * side of any of the provided planes, or behind it. Indices of the found entries are written to @p output, which
+		 * must have room for @p count indices. Returns the number of found entries.
+		 */
+		static UINT32 findNearPlanes(const Vector3* position, UINT32 count, const Plane* planes, UINT32 numPlanes,
+			float radius, UINT32* output);
+
+		/**
+		 * Sets each of the first @p count entries of @p data to @p value. Unlike the kernels above @p data doesn't need
+		 * to be aligned, since newly spawned particles can start at any index.
+		 */
+		static void fill(float* data, float value, UINT32 count);
+
+		/** Multiplies each of the first @p count entries of @p data by @p scale. @p data doesn't need to be aligned. */
+		static void scale(Vector3* data, float scale, UINT32 count);
+
+		/**
+		 * Transforms each of the first @p count entries of @p data as a point, same as Matrix4::multiplyAffine. @p data
+		 * doesn't need to be aligned.
+		 */
+		static void multiplyAffine(Vector3* data, const Matrix4& matrix, UINT32 count);
+
+		/**
+		 * Transforms each of the first @p count entries of @p data as a direction, same as Matrix4::multiplyDirection.
+		 * @p data doesn't need to be aligned.
+		 */
+		static void multiplyDirection(Vector3* data, const Matrix4& matrix, UINT32 count);
+	};
+
+	/** @} */
+}
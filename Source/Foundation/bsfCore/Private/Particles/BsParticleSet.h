@@ -15,12 +15,18 @@ namespace bs
 	 *  @{
 	 */
 
-	/** Handles buffers containing particle data and their allocation/deallocation. */
+	/** 
+	 * Handles buffers containing particle data and their allocation/deallocation. Capacity is always a multiple of
+	 * SIMD_WIDTH, so every buffer starts at a 16-byte boundary and can be processed using SIMD kernels.
+	 */
 	struct ParticleSetData
 	{
+		/** Number of particles processed at once by the SIMD kernels. */
+		static constexpr UINT32 SIMD_WIDTH = 4;
+
 		/** Creates a new set and allocates enough space for @p capacity particles. */
 		ParticleSetData(UINT32 capacity)
-			:capacity(capacity)
+			:capacity(padCapacity(capacity))
 		{
 			allocate();
 		}
@@ -30,7 +36,7 @@ namespace bs
 		 * them from the @p other set. 
 		 */
 		ParticleSetData(UINT32 capacity, const ParticleSetData& other)
-			:capacity(capacity)
+			:capacity(padCapacity(capacity))
 		{
 			allocate();
 			copy(other);
@@ -74,6 +80,12 @@ namespace bs
 		UINT32* indices = nullptr;
 
 	private:
+		/** Rounds up the capacity so that all buffers remain aligned when allocated one after another. */
+		static UINT32 padCapacity(UINT32 capacity)
+		{
+			return Math::divideAndRoundUp(capacity, SIMD_WIDTH) * SIMD_WIDTH;
+		}
+
 		/** 
 		 * Allocates a new set of buffers with enough space to store number of particles equal to the current capacity. *
 		 * Called must ensure any previously allocated buffer is freed by calling free().
@@ -4,6 +4,35 @@
 #include "Testing/BsTestSuite.h"
 #include "Animation/BsAnimationCurve.h"
 #include "Particles/BsParticleDistribution.h"
+#include "Particles/BsParticleEvolver.h"
+#include "Private/Particles/BsParticleSet.h"
+#include "Private/Particles/BsParticleKernels.h"
+#include "Private/Image/BsPixelConversion.h"
+#include "Private/Image/BsBlockDecoder.h"
+#include "Image/BsPixelUtil.h"
+#include "Image/BsColor.h"
+#include "Math/BsPlane.h"
+#include "Profiling/BsProfilerCPU.h"
+#include "Profiling/BsProfilingManager.h"
+#include "Particles/BsParticleManager.h"
+#include "Particles/BsParticleSystem.h"
+#include "Animation/BsAnimationManager.h"
+#include "CoreThread/BsCoreObjectManager.h"
+#include "CoreThread/BsCoreThread.h"
+#include "Renderer/BsRenderer.h"
+#include "Renderer/BsRendererFactory.h"
+#include "Renderer/BsRendererManager.h"
+#include "Scene/BsGameObjectManager.h"
+#include "Scene/BsSceneManager.h"
+#include "Scene/BsSceneObject.h"
+#include "Threading/BsThreadPool.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Utility/BsTime.h"
+#include "Serialization/BsMemorySerializer.h"
+#include "Serialization/BsBinarySerializer.h"
+#include "FileSystem/BsDataStream.h"
+#include "Utility/BsTimer.h"
+#include "Debug/BsDebug.h"
 
 namespace bs
 {
@@ -17,20 +46,134 @@ namespace bs
 		return acceleration * time;
 	}
 
+	/** Renderer that renders nothing. Allows core objects that notify the renderer to be created in tests. */
+	class NullTestRenderer : public ct::Renderer
+	{
+	public:
+		const StringID& getName() const override
+		{
+			static StringID name("NullTestRenderer");
+			return name;
+		}
+
+		void renderAll(PerFrameData perFrameData) override { }
+		void captureSceneCubeMap(const SPtr<ct::Texture>& cubemap, const Vector3& position,
+			const ct::CaptureSettings& settings) override { }
+	};
+
+	/** Factory that creates the NullTestRenderer. */
+	class NullTestRendererFactory : public RendererFactory
+	{
+	public:
+		SPtr<ct::Renderer> create() override { return bs_shared_ptr_new<NullTestRenderer>(); }
+
+		const String& name() const override
+		{
+			static String name = "NullTestRenderer";
+			return name;
+		}
+	};
+
+	/** Returns the state of a world space particle system with an identity transform, advanced by a single step. */
+	ParticleSystemState createParticleTestState(float timeStep)
+	{
+		ParticleSystemState state;
+		state.timeStart = 0.0f;
+		state.timeEnd = timeStep;
+		state.nrmTimeStart = 0.0f;
+		state.nrmTimeEnd = timeStep;
+		state.length = 1.0f;
+		state.timeStep = timeStep;
+		state.maxParticles = std::numeric_limits<UINT32>::max();
+		state.worldSpace = true;
+		state.gpuSimulated = false;
+		state.localToWorld = Matrix4::IDENTITY;
+		state.worldToLocal = Matrix4::IDENTITY;
+		state.system = nullptr;
+		state.animData = nullptr;
+
+		return state;
+	}
+
+	/** Allocates the requested number of particles in the set, with random positions, velocities and lifetimes. */
+	void initParticleTestSet(Random& random, ParticleSet& set, UINT32 numParticles)
+	{
+		set.allocParticles(numParticles);
+
+		ParticleSetData& particles = set.getParticles();
+		for(UINT32 i = 0; i < numParticles; i++)
+		{
+			particles.position[i] = Vector3(random.getSNorm(), random.getSNorm(), random.getSNorm()) * 10.0f;
+			particles.velocity[i] = Vector3(random.getSNorm(), random.getSNorm(), random.getSNorm());
+			particles.initialLifetime[i] = 1.0f;
+			particles.lifetime[i] = random.getUNorm();
+			particles.seed[i] = i;
+		}
+	}
+
 	class CoreTestSuite : public TestSuite
 	{
 	public:
 		CoreTestSuite();
 
+		void startUp() override;
+		void shutDown() override;
+
 	private:
 		void testAnimCurveIntegration();
 		void testLookupTable();
+		void testParticleEvolvers();
+		void testPixelConversion();
+		void testBlockDecompression();
+		void testMipMapGeneration();
+		void testTextureCompression();
+		void testStaticProfilerScopes();
+		void testParticleStatsReport();
+		void testDataBlockAlignment();
+		void testBatchedWorldTransforms();
+
+#if BS_BENCHMARKS
+		void benchmarkParticleEvolvers();
+		void benchmarkBlockDecompression();
+		void benchmarkTextureCompression();
+#endif
 	};
 
 	CoreTestSuite::CoreTestSuite()
 	{
 		BS_ADD_TEST(CoreTestSuite::testAnimCurveIntegration);
 		BS_ADD_TEST(CoreTestSuite::testLookupTable);
+		BS_ADD_TEST(CoreTestSuite::testParticleEvolvers);
+		BS_ADD_TEST(CoreTestSuite::testPixelConversion);
+		BS_ADD_TEST(CoreTestSuite::testBlockDecompression);
+		BS_ADD_TEST(CoreTestSuite::testMipMapGeneration);
+		BS_ADD_TEST(CoreTestSuite::testTextureCompression);
+		BS_ADD_TEST(CoreTestSuite::testStaticProfilerScopes);
+		BS_ADD_TEST(CoreTestSuite::testParticleStatsReport);
+		BS_ADD_TEST(CoreTestSuite::testDataBlockAlignment);
+		BS_ADD_TEST(CoreTestSuite::testBatchedWorldTransforms);
+
+#if BS_BENCHMARKS
+		BS_ADD_TEST(CoreTestSuite::benchmarkParticleEvolvers);
+		BS_ADD_TEST(CoreTestSuite::benchmarkBlockDecompression);
+		BS_ADD_TEST(CoreTestSuite::benchmarkTextureCompression);
+#endif
+	}
+
+	void CoreTestSuite::startUp()
+	{
+		ProfilerCPU::startUp();
+
+		const UINT32 numCores = BS_THREAD_HARDWARE_CONCURRENCY;
+		ThreadPool::startUp<TThreadPool<>>(numCores, std::max(16U, numCores * 2));
+		TaskScheduler::startUp();
+	}
+
+	void CoreTestSuite::shutDown()
+	{
+		TaskScheduler::shutDown();
+		ThreadPool::shutDown();
+		ProfilerCPU::shutDown();
 	}
 
 	void CoreTestSuite::testAnimCurveIntegration()
@@ -143,6 +286,915 @@ namespace bs
 				BS_TEST_ASSERT(Math::approxEquals(valueLookup[j], valueCurve[j], EPSILON));
 		}
 	}
+
+	void CoreTestSuite::testParticleEvolvers()
+	{
+		static constexpr float EPSILON = 0.0001f;
+		static constexpr float TIME_STEP = 1.0f / 60.0f;
+
+		MemStack::beginThread();
+
+		ParticleSystemState state = createParticleTestState(TIME_STEP);
+
+		PARTICLE_VELOCITY_DESC velocityDesc;
+		velocityDesc.velocity = Vector3(1.0f, 2.0f, 3.0f);
+		ParticleVelocity velocity(velocityDesc);
+
+		PARTICLE_ORBIT_DESC orbitDesc;
+		orbitDesc.center = Vector3(1.0f, 0.0f, -1.0f);
+		orbitDesc.velocity = Vector3(0.0f, 0.5f, 0.1f);
+		orbitDesc.radial = 0.5f;
+		ParticleOrbit orbit(orbitDesc);
+
+		PARTICLE_COLLISONS_DESC collisionsDesc;
+		collisionsDesc.mode = ParticleCollisionMode::Plane;
+		collisionsDesc.radius = 0.1f;
+		ParticleCollisions collisions(collisionsDesc);
+		collisions.setPlanes({ Plane(Vector3::UNIT_Y, -5.0f), Plane(Vector3::UNIT_X, -5.0f) });
+
+		Random random;
+		for(UINT32 numParticles : { 10000U, 100000U, 1000000U })
+		{
+			ParticleSet set(numParticles);
+			initParticleTestSet(random, set, numParticles);
+
+			ParticleSetData& particles = set.getParticles();
+			const Vector3 firstPosition = particles.position[0];
+			const Vector3 lastPosition = particles.position[numParticles - 1];
+
+			velocity.evolve(random, state, set);
+
+			const Vector3 velocityOffset = Vector3(1.0f, 2.0f, 3.0f) * TIME_STEP;
+			BS_TEST_ASSERT(particles.position[0].distance(firstPosition + velocityOffset) < EPSILON);
+			BS_TEST_ASSERT(particles.position[numParticles - 1].distance(lastPosition + velocityOffset) < EPSILON);
+
+			ParticleKernels::add(particles.velocity, Vector3(0.0f, -9.81f, 0.0f) * TIME_STEP, numParticles);
+
+			// Orbiting particles must remain at the same distance from the center, other than the radial offset
+			const float distanceBefore = particles.position[numParticles - 1].distance(orbitDesc.center.getMinConstant());
+
+			orbit.evolve(random, state, set);
+
+			const float distanceAfter = particles.position[numParticles - 1].distance(orbitDesc.center.getMinConstant());
+			BS_TEST_ASSERT(Math::approxEquals(distanceAfter, distanceBefore + 0.5f * TIME_STEP, EPSILON));
+
+			collisions.evolve(random, state, set);
+
+			ParticleKernels::addScaled(particles.position, particles.velocity, TIME_STEP, numParticles);
+			ParticleKernels::subtract(particles.lifetime, TIME_STEP, numParticles);
+
+			UINT32 numExpired = 0;
+			for(UINT32 i = ParticleKernels::findExpired(particles.lifetime, 0, numParticles); i < numParticles;
+				i = ParticleKernels::findExpired(particles.lifetime, i + 1, numParticles))
+			{
+				numExpired++;
+			}
+
+			UINT32 expectedNumExpired = 0;
+			for(UINT32 i = 0; i < numParticles; i++)
+			{
+				if(particles.lifetime[i] <= 0.0f)
+					expectedNumExpired++;
+			}
+
+			BS_TEST_ASSERT(numExpired == expectedNumExpired);
+		}
+
+		// Kernels used when spawning must match the scalar path. Spawned particles can start at any index, so start at
+		// an unaligned one, and with a count that leaves a remainder.
+		{
+			static constexpr UINT32 NUM_PARTICLES = 64;
+			static constexpr UINT32 FIRST = 5;
+			static constexpr UINT32 COUNT = 42;
+
+			ParticleSet set(NUM_PARTICLES);
+			set.allocParticles(NUM_PARTICLES);
+
+			ParticleSetData& particles = set.getParticles();
+			Vector3 positions[NUM_PARTICLES];
+			Vector3 velocities[NUM_PARTICLES];
+			for(UINT32 i = 0; i < NUM_PARTICLES; i++)
+			{
+				positions[i] = Vector3(random.getSNorm(), random.getSNorm(), random.getSNorm());
+				velocities[i] = Vector3(random.getSNorm(), random.getSNorm(), random.getSNorm());
+
+				particles.position[i] = positions[i];
+				particles.velocity[i] = velocities[i];
+				particles.lifetime[i] = 1.0f;
+			}
+
+			const Matrix4 transform = Matrix4::TRS(Vector3(1.0f, 2.0f, 3.0f),
+				Quaternion(Vector3::normalize(Vector3(1.0f, 1.0f, 0.0f)), Degree(30.0f)), Vector3(2.0f, 0.5f, 1.0f));
+
+			ParticleKernels::multiplyAffine(particles.position + FIRST, transform, COUNT);
+			ParticleKernels::multiplyDirection(particles.velocity + FIRST, transform, COUNT);
+			ParticleKernels::scale(particles.velocity + FIRST, 3.0f, COUNT);
+			ParticleKernels::fill(particles.lifetime + FIRST, 2.0f, COUNT);
+
+			for(UINT32 i = 0; i < NUM_PARTICLES; i++)
+			{
+				const bool spawned = i >= FIRST && i < FIRST + COUNT;
+
+				const Vector3 position = spawned ? transform.multiplyAffine(positions[i]) : positions[i];
+				const Vector3 velocity = spawned ? transform.multiplyDirection(velocities[i]) * 3.0f : velocities[i];
+
+				BS_TEST_ASSERT(particles.position[i].distance(position) < EPSILON);
+				BS_TEST_ASSERT(particles.velocity[i].distance(velocity) < EPSILON);
+				BS_TEST_ASSERT(particles.lifetime[i] == (spawned ? 2.0f : 1.0f));
+			}
+		}
+
+		MemStack::endThread();
+	}
+
+#if BS_BENCHMARKS
+	void CoreTestSuite::benchmarkParticleEvolvers()
+	{
+		static constexpr float TIME_STEP = 1.0f / 60.0f;
+		static constexpr UINT32 NUM_ITERATIONS = 10;
+
+		MemStack::beginThread();
+
+		ParticleSystemState state = createParticleTestState(TIME_STEP);
+
+		PARTICLE_VELOCITY_DESC velocityDesc;
+		velocityDesc.velocity = Vector3(1.0f, 2.0f, 3.0f);
+		ParticleVelocity velocity(velocityDesc);
+
+		PARTICLE_ORBIT_DESC orbitDesc;
+		orbitDesc.center = Vector3(1.0f, 0.0f, -1.0f);
+		orbitDesc.velocity = Vector3(0.0f, 0.5f, 0.1f);
+		orbitDesc.radial = 0.5f;
+		ParticleOrbit orbit(orbitDesc);
+
+		PARTICLE_COLLISONS_DESC collisionsDesc;
+		collisionsDesc.mode = ParticleCollisionMode::Plane;
+		collisionsDesc.radius = 0.1f;
+		ParticleCollisions collisions(collisionsDesc);
+		collisions.setPlanes({ Plane(Vector3::UNIT_Y, -5.0f), Plane(Vector3::UNIT_X, -5.0f) });
+
+		Random random;
+		for(UINT32 numParticles : { 10000U, 100000U, 1000000U })
+		{
+			ParticleSet set(numParticles);
+			initParticleTestSet(random, set, numParticles);
+
+			ParticleSetData& particles = set.getParticles();
+
+			UINT64 velocityTime = 0;
+			UINT64 gravityTime = 0;
+			UINT64 orbitTime = 0;
+			UINT64 collisionsTime = 0;
+			UINT64 integrateTime = 0;
+			UINT32 numExpired = 0;
+
+			Timer timer;
+			for(UINT32 i = 0; i < NUM_ITERATIONS; i++)
+			{
+				timer.reset();
+				velocity.evolve(random, state, set);
+				velocityTime += timer.getMicroseconds();
+
+				timer.reset();
+				ParticleKernels::add(particles.velocity, Vector3(0.0f, -9.81f, 0.0f) * TIME_STEP, numParticles);
+				gravityTime += timer.getMicroseconds();
+
+				timer.reset();
+				orbit.evolve(random, state, set);
+				orbitTime += timer.getMicroseconds();
+
+				timer.reset();
+				collisions.evolve(random, state, set);
+				collisionsTime += timer.getMicroseconds();
+
+				timer.reset();
+				ParticleKernels::addScaled(particles.position, particles.velocity, TIME_STEP, numParticles);
+				ParticleKernels::subtract(particles.lifetime, TIME_STEP, numParticles);
+
+				for(UINT32 j = ParticleKernels::findExpired(particles.lifetime, 0, numParticles); j < numParticles;
+					j = ParticleKernels::findExpired(particles.lifetime, j + 1, numParticles))
+				{
+					numExpired++;
+				}
+
+				integrateTime += timer.getMicroseconds();
+			}
+
+			BS_TEST_ASSERT(numExpired > 0);
+
+			gDebug().logDebug("Particle evolvers (" + toString(numParticles) + " particles): velocity " + 
+				toString(velocityTime / NUM_ITERATIONS) + "us, gravity " + toString(gravityTime / NUM_ITERATIONS) +
+				"us, orbit " + toString(orbitTime / NUM_ITERATIONS) + "us, collisions " +
+				toString(collisionsTime / NUM_ITERATIONS) + "us, integrate & expire " +
+				toString(integrateTime / NUM_ITERATIONS) + "us");
+		}
+
+		MemStack::endThread();
+	}
+#endif
+
+	void CoreTestSuite::testPixelConversion()
+	{
+		static constexpr UINT32 WIDTH = 3840;
+		static constexpr UINT32 HEIGHT = 2160;
+
+		Random random;
+		SPtr<PixelData> rgba8 = PixelData::create(WIDTH, HEIGHT, 1, PF_RGBA8);
+		UINT32* rgba8Pixels = (UINT32*)rgba8->getData();
+		for(UINT32 i = 0; i < WIDTH * HEIGHT; i++)
+			rgba8Pixels[i] = random.get();
+
+		SPtr<PixelData> rgba32f = PixelData::create(WIDTH, HEIGHT, 1, PF_RGBA32F);
+		SPtr<PixelData> rgba16f = PixelData::create(WIDTH, HEIGHT, 1, PF_RGBA16F);
+		SPtr<PixelData> bgra8 = PixelData::create(WIDTH, HEIGHT, 1, PF_BGRA8);
+
+		PixelUtil::bulkPixelConversion(*rgba8, *rgba32f);
+		PixelUtil::bulkPixelConversion(*rgba32f, *rgba16f);
+		PixelUtil::bulkPixelConversion(*rgba16f, *bgra8);
+
+		// Kernels must match the generic conversion for a sample of pixels
+		for(UINT32 i = 0; i < WIDTH * HEIGHT; i += 997)
+		{
+			const UINT32 x = i % WIDTH;
+			const UINT32 y = i / WIDTH;
+
+			const Color color = rgba8->getColorAt(x, y);
+			BS_TEST_ASSERT(rgba32f->getColorAt(x, y) == color);
+
+			UINT16 expected[4];
+			PixelUtil::packColor(color, PF_RGBA16F, expected);
+			BS_TEST_ASSERT(memcmp(expected, (UINT8*)rgba16f->getData() + i * 8, sizeof(expected)) == 0);
+		}
+
+		// 8-bit values survive the round trip through half floats, only the red and blue channels are swapped
+		const UINT32* bgra8Pixels = (UINT32*)bgra8->getData();
+		for(UINT32 i = 0; i < WIDTH * HEIGHT; i++)
+		{
+			const UINT32 value = rgba8Pixels[i];
+			const UINT32 swizzled = (value & 0xFF00FF00) | ((value & 0xFF) << 16) | ((value >> 16) & 0xFF);
+
+			if(bgra8Pixels[i] != swizzled)
+			{
+				BS_TEST_ASSERT_MSG(false, "Pixel " + toString(i) + " changed during conversion.");
+				break;
+			}
+		}
+
+		BS_TEST_ASSERT(PixelConversion::find(PF_RGBA8, PF_R8) == nullptr);
+	}
+
+	void CoreTestSuite::testBlockDecompression()
+	{
+		static constexpr UINT32 WIDTH = 3840;
+		static constexpr UINT32 HEIGHT = 2160;
+
+		// BC1 block with pure red and blue endpoints, using a different palette entry for each row
+		const UINT8 bc1Block[8] = { 0x00, 0xF8, 0x1F, 0x00, 0x00, 0x55, 0xAA, 0xFF };
+		const UINT32 bc1Rows[4] = { 0xFF0000FF, 0xFFFF0000, 0xFF5500AA, 0xFFAA0055 };
+
+		SPtr<PixelData> bc1 = PixelData::create(4, 4, 1, PF_BC1);
+		memcpy(bc1->getData(), bc1Block, sizeof(bc1Block));
+
+		SPtr<PixelData> bc1Decoded = PixelData::create(4, 4, 1, PF_RGBA8);
+		PixelUtil::bulkPixelConversion(*bc1, *bc1Decoded);
+
+		const UINT32* bc1Pixels = (UINT32*)bc1Decoded->getData();
+		for(UINT32 i = 0; i < 16; i++)
+			BS_TEST_ASSERT(bc1Pixels[i] == bc1Rows[i / 4]);
+
+		// Known answers for the other formats, worked out from the format specifications. Endpoints are picked so that
+		// all interpolated values are exact, and don't depend on rounding.
+		const auto decodeBlock = [](PixelFormat format, const UINT8* block)
+		{
+			SPtr<PixelData> compressed = PixelData::create(4, 4, 1, format);
+			memcpy(compressed->getData(), block, BlockDecoder::getBlockSize(format));
+
+			SPtr<PixelData> decoded = PixelData::create(4, 4, 1, BlockDecoder::getDecodedFormat(format));
+			PixelUtil::decompress(*compressed, *decoded);
+
+			return decoded;
+		};
+
+		UINT8 block[16];
+
+		// BC2 with explicit alpha increasing by one step per pixel, and the BC1 block above for color
+		const UINT8 bc2Alpha[8] = { 0x10, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE };
+		memcpy(block, bc2Alpha, sizeof(bc2Alpha));
+		memcpy(block + 8, bc1Block, sizeof(bc1Block));
+
+		SPtr<PixelData> bc2Decoded = decodeBlock(PF_BC2, block);
+		const UINT32* bc2Pixels = (UINT32*)bc2Decoded->getData();
+		for(UINT32 i = 0; i < 16; i++)
+			BS_TEST_ASSERT(bc2Pixels[i] == ((bc1Rows[i / 4] & 0x00FFFFFF) | ((i * 17) << 24)));
+
+		// BC3 with alpha endpoints 252 and 0 (eight value mode), cycling each row pair through all the indices
+		const UINT8 bc3Alpha[8] = { 0xFC, 0x00, 0x88, 0xC6, 0xFA, 0x88, 0xC6, 0xFA };
+		const UINT8 bc3AlphaValues[8] = { 252, 0, 216, 180, 144, 108, 72, 36 };
+		memcpy(block, bc3Alpha, sizeof(bc3Alpha));
+		memcpy(block + 8, bc1Block, sizeof(bc1Block));
+
+		SPtr<PixelData> bc3Decoded = decodeBlock(PF_BC3, block);
+		const UINT32* bc3Pixels = (UINT32*)bc3Decoded->getData();
+		for(UINT32 i = 0; i < 16; i++)
+			BS_TEST_ASSERT(bc3Pixels[i] == ((bc1Rows[i / 4] & 0x00FFFFFF) | (bc3AlphaValues[i % 8] << 24)));
+
+		// BC4 with endpoints 0 and 250 (six value mode, with explicit 0 and 255), same indices as above
+		const UINT8 bc4Block[8] = { 0x00, 0xFA, 0x88, 0xC6, 0xFA, 0x88, 0xC6, 0xFA };
+		const UINT8 bc4Values[8] = { 0, 250, 50, 100, 150, 200, 0, 255 };
+
+		SPtr<PixelData> bc4Decoded = decodeBlock(PF_BC4, bc4Block);
+		const UINT32* bc4Pixels = (UINT32*)bc4Decoded->getData();
+		for(UINT32 i = 0; i < 16; i++)
+			BS_TEST_ASSERT(bc4Pixels[i] == (0xFF000000 | bc4Values[i % 8]));
+
+		// BC5 with the BC3 alpha block for red, and the BC4 block for green
+		memcpy(block, bc3Alpha, sizeof(bc3Alpha));
+		memcpy(block + 8, bc4Block, sizeof(bc4Block));
+
+		SPtr<PixelData> bc5Decoded = decodeBlock(PF_BC5, block);
+		const UINT32* bc5Pixels = (UINT32*)bc5Decoded->getData();
+		for(UINT32 i = 0; i < 16; i++)
+			BS_TEST_ASSERT(bc5Pixels[i] == (0xFF000000 | bc3AlphaValues[i % 8] | (bc4Values[i % 8] << 8)));
+
+		// BC6H mode 11 (single subset, 10-bit endpoints) with endpoints (0, 1023, 512) and (1023, 0, 256), and each
+		// pixel using the index equal to its position. Results are half floats.
+		const UINT8 bc6hBlock[16] =
+			{ 0x03, 0x80, 0xFF, 0x01, 0xFC, 0x1F, 0x00, 0x80, 0x10, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE };
+		const UINT16 bc6hValues[16][3] =
+		{
+			{ 0x0000, 0x7BFF, 0x3E0F }, { 0x07C0, 0x743F, 0x3C1F }, { 0x1170, 0x6A8F, 0x39B3 },
+			{ 0x1930, 0x62CF, 0x37C3 }, { 0x20F0, 0x5B0F, 0x35D3 }, { 0x28B0, 0x534F, 0x33E3 },
+			{ 0x3260, 0x499F, 0x3177 }, { 0x3A20, 0x41DF, 0x2F87 }, { 0x41DF, 0x3A20, 0x2D97 },
+			{ 0x499F, 0x3260, 0x2BA7 }, { 0x534F, 0x28B0, 0x293B }, { 0x5B0F, 0x20F0, 0x274B },
+			{ 0x62CF, 0x1930, 0x255B }, { 0x6A8F, 0x1170, 0x236B }, { 0x743F, 0x07C0, 0x20FF },
+			{ 0x7BFF, 0x0000, 0x1F0F }
+		};
+
+		SPtr<PixelData> bc6hDecoded = decodeBlock(PF_BC6H, bc6hBlock);
+		const UINT16* bc6hPixels = (UINT16*)bc6hDecoded->getData();
+		for(UINT32 i = 0; i < 16; i++)
+		{
+			for(UINT32 j = 0; j < 3; j++)
+				BS_TEST_ASSERT(bc6hPixels[i * 4 + j] == bc6hValues[i][j]);
+
+			BS_TEST_ASSERT(bc6hPixels[i * 4 + 3] == 0x3C00);
+		}
+
+		// BC7 mode 6 (single subset, 7-bit endpoints with a p-bit) with endpoints (0, 254, 100, 254) and
+		// (255, 1, 201, 255), and each pixel using the index equal to its position
+		const UINT8 bc7Block[16] =
+			{ 0x40, 0xC0, 0xFF, 0x0F, 0x90, 0x91, 0xFF, 0x7F, 0x11, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE };
+		const UINT32 bc7Values[16] =
+		{
+			0xFE64FE00, 0xFE6AEE10, 0xFE72DA24, 0xFE79CB34, 0xFE7FBB44, 0xFE85AB54, 0xFE8D9768, 0xFE938778,
+			0xFF9A7887, 0xFFA06897, 0xFFA854AB, 0xFFAE44BB, 0xFFB434CB, 0xFFBB25DB, 0xFFC311EF, 0xFFC901FF
+		};
+
+		SPtr<PixelData> bc7Decoded = decodeBlock(PF_BC7, bc7Block);
+		const UINT32* bc7Pixels = (UINT32*)bc7Decoded->getData();
+		for(UINT32 i = 0; i < 16; i++)
+			BS_TEST_ASSERT(bc7Pixels[i] == bc7Values[i]);
+
+		// Decode each format from random data, which exercises all block modes. Decoding whole images must match
+		// decoding the blocks individually.
+		const PixelFormat formats[] = { PF_BC1, PF_BC2, PF_BC3, PF_BC4, PF_BC5, PF_BC6H, PF_BC7 };
+
+		Random random;
+		for(auto format : formats)
+		{
+			SPtr<PixelData> compressed = PixelData::create(WIDTH, HEIGHT, 1, format);
+			UINT32* compressedData = (UINT32*)compressed->getData();
+			for(UINT32 i = 0; i < compressed->getSize() / sizeof(UINT32); i++)
+				compressedData[i] = random.get();
+
+			const PixelFormat decodedFormat = BlockDecoder::getDecodedFormat(format);
+			SPtr<PixelData> decoded = PixelData::create(WIDTH, HEIGHT, 1, decodedFormat);
+
+			PixelUtil::decompress(*compressed, *decoded);
+
+			// Pixels must match the individually decoded blocks, for a sample of blocks
+			const UINT32 blockSize = BlockDecoder::getBlockSize(format);
+			const UINT32 pixelSize = PixelUtil::getNumElemBytes(decodedFormat);
+			const BlockDecodeFunc decodeBlock = BlockDecoder::find(format);
+			for(UINT32 i = 0; i < (WIDTH / 4) * (HEIGHT / 4); i += 997)
+			{
+				const UINT32 x = (i % (WIDTH / 4)) * 4;
+				const UINT32 y = (i / (WIDTH / 4)) * 4;
+
+				UINT8 pixels[16 * 16];
+				decodeBlock((UINT8*)compressedData + i * blockSize, pixels);
+
+				for(UINT32 row = 0; row < 4; row++)
+				{
+					const UINT8* decodedRow = decoded->getData() + ((y + row) * WIDTH + x) * pixelSize;
+					BS_TEST_ASSERT(memcmp(pixels + row * 4 * pixelSize, decodedRow, 4 * pixelSize) == 0);
+				}
+			}
+		}
+	}
+
+#if BS_BENCHMARKS
+	void CoreTestSuite::benchmarkBlockDecompression()
+	{
+		static constexpr UINT32 WIDTH = 3840;
+		static constexpr UINT32 HEIGHT = 2160;
+		static constexpr UINT32 NUM_ITERATIONS = 5;
+
+		const PixelFormat formats[] = { PF_BC1, PF_BC2, PF_BC3, PF_BC4, PF_BC5, PF_BC6H, PF_BC7 };
+
+		// Random data exercises all block modes of every format
+		Random random;
+		String timings;
+		for(auto format : formats)
+		{
+			SPtr<PixelData> compressed = PixelData::create(WIDTH, HEIGHT, 1, format);
+			UINT32* compressedData = (UINT32*)compressed->getData();
+			for(UINT32 i = 0; i < compressed->getSize() / sizeof(UINT32); i++)
+				compressedData[i] = random.get();
+
+			SPtr<PixelData> decoded = PixelData::create(WIDTH, HEIGHT, 1, BlockDecoder::getDecodedFormat(format));
+
+			Timer timer;
+			for(UINT32 i = 0; i < NUM_ITERATIONS; i++)
+				PixelUtil::decompress(*compressed, *decoded);
+
+			const UINT64 decodeTime = std::max(timer.getMicroseconds() / NUM_ITERATIONS, (UINT64)1);
+			const UINT64 pixelsPerUs = (WIDTH * HEIGHT) / decodeTime;
+
+			timings += ", " + PixelUtil::getFormatName(format) + " " + toString(decodeTime) + "us (" +
+				toString(pixelsPerUs) + " MPixel/s)";
+		}
+
+		gDebug().logDebug("Block decompression (" + toString(WIDTH) + "x" + toString(HEIGHT) + ")" + timings);
+	}
+#endif
+
+	void CoreTestSuite::testMipMapGeneration()
+	{
+		static constexpr UINT32 WIDTH = 3840;
+		static constexpr UINT32 HEIGHT = 2160;
+
+		// Box filter averages 2x2 blocks, in linear space for sRGB data
+		SPtr<PixelData> checker = PixelData::create(2, 2, 1, PF_RGBA8);
+		UINT32* checkerPixels = (UINT32*)checker->getData();
+		checkerPixels[0] = checkerPixels[3] = 0xFFFFFFFF;
+		checkerPixels[1] = checkerPixels[2] = 0xFF000000;
+
+		MipMapGenOptions linearOptions;
+		Vector<SPtr<PixelData>> linearMips = PixelUtil::genMipmaps(*checker, linearOptions);
+		BS_TEST_ASSERT(linearMips.size() == 2);
+		BS_TEST_ASSERT(linearMips[0]->getColorAt(1, 0) == checker->getColorAt(1, 0));
+		BS_TEST_ASSERT(*(UINT32*)linearMips[1]->getData() == 0xFF808080);
+
+		MipMapGenOptions srgbOptions;
+		srgbOptions.isSRGB = true;
+		Vector<SPtr<PixelData>> srgbMips = PixelUtil::genMipmaps(*checker, srgbOptions);
+		BS_TEST_ASSERT(*(UINT32*)srgbMips[1]->getData() == 0xFFBCBCBC);
+
+		// Constant images stay constant with every filter, including on sizes that don't divide evenly
+		const MipMapFilter filters[] = { MipMapFilter::Box, MipMapFilter::Triangle, MipMapFilter::Kaiser,
+			MipMapFilter::Lanczos };
+
+		SPtr<PixelData> constant = PixelData::create(37, 20, 1, PF_RGBA8);
+		for(UINT32 i = 0; i < 37 * 20; i++)
+			((UINT32*)constant->getData())[i] = 0x80C04020;
+
+		for(auto filter : filters)
+		{
+			MipMapGenOptions options;
+			options.filter = filter;
+
+			Vector<SPtr<PixelData>> mips = PixelUtil::genMipmaps(*constant, options);
+			BS_TEST_ASSERT(mips.size() == 6);
+
+			for(auto& mip : mips)
+			{
+				const UINT32* mipPixels = (UINT32*)mip->getData();
+				for(UINT32 i = 0; i < mip->getWidth() * mip->getHeight(); i++)
+					BS_TEST_ASSERT(mipPixels[i] == 0x80C04020);
+			}
+		}
+
+		// Alpha coverage of the mip levels matches the base level. Without the correction, averaging noisy alpha whose
+		// mean is below the threshold would drive coverage towards zero.
+		Random random;
+		SPtr<PixelData> foliage = PixelData::create(256, 256, 1, PF_RGBA8);
+		UINT32* foliagePixels = (UINT32*)foliage->getData();
+		UINT32 numBaseCovered = 0;
+		for(UINT32 i = 0; i < 256 * 256; i++)
+		{
+			const UINT32 alpha = random.get() % 200;
+			foliagePixels[i] = (alpha << 24) | 0x808080;
+
+			if(alpha > 127)
+				numBaseCovered++;
+		}
+
+		const float baseCoverage = numBaseCovered / (256.0f * 256.0f);
+
+		MipMapGenOptions coverageOptions;
+		coverageOptions.preserveAlphaCoverage = true;
+		Vector<SPtr<PixelData>> coverageMips = PixelUtil::genMipmaps(*foliage, coverageOptions);
+		for(UINT32 i = 1; i < 5; i++)
+		{
+			const SPtr<PixelData>& mip = coverageMips[i];
+			const UINT32 numPixels = mip->getWidth() * mip->getHeight();
+
+			UINT32 numCovered = 0;
+			for(UINT32 j = 0; j < numPixels; j++)
+			{
+				if((((UINT32*)mip->getData())[j] >> 24) > 127)
+					numCovered++;
+			}
+
+			BS_TEST_ASSERT(Math::approxEquals(numCovered / (float)numPixels, baseCoverage, 0.05f));
+		}
+
+		// Large images are split between multiple threads, which must not change the results
+		SPtr<PixelData> image = PixelData::create(WIDTH, HEIGHT, 1, PF_RGBA8);
+		UINT32* imagePixels = (UINT32*)image->getData();
+		for(UINT32 i = 0; i < WIDTH * HEIGHT; i++)
+			imagePixels[i] = 0x80C04020;
+
+		for(auto filter : filters)
+		{
+			MipMapGenOptions options;
+			options.filter = filter;
+
+			Vector<SPtr<PixelData>> mips = PixelUtil::genMipmaps(*image, options);
+			for(auto& mip : mips)
+			{
+				const UINT32* mipPixels = (UINT32*)mip->getData();
+				for(UINT32 i = 0; i < mip->getWidth() * mip->getHeight(); i += 97)
+					BS_TEST_ASSERT(mipPixels[i] == 0x80C04020);
+			}
+		}
+	}
+
+	void CoreTestSuite::testTextureCompression()
+	{
+		// Gradient whose size isn't a multiple of the block size, split into multiple strips during compression
+		SPtr<PixelData> gradient = PixelData::create(1002, 601, 1, PF_RGBA8);
+		for(UINT32 y = 0; y < gradient->getHeight(); y++)
+		{
+			for(UINT32 x = 0; x < gradient->getWidth(); x++)
+				gradient->setColorAt(Color(x / 1024.0f, y / 1024.0f, 0.5f, 1.0f), x, y);
+		}
+
+		const auto matchesSource = [](const PixelData& source, const PixelData& compressed)
+		{
+			SPtr<PixelData> decoded = PixelData::create(source.getWidth(), source.getHeight(), 1, PF_RGBA8);
+			PixelUtil::bulkPixelConversion(compressed, *decoded);
+
+			for(UINT32 y = 0; y < source.getHeight(); y++)
+			{
+				for(UINT32 x = 0; x < source.getWidth(); x++)
+				{
+					const Color expected = source.getColorAt(x, y);
+					const Color actual = decoded->getColorAt(x, y);
+					for(UINT32 i = 0; i < 3; i++)
+					{
+						if(std::abs(expected[i] - actual[i]) > 0.06f)
+							return false;
+					}
+				}
+			}
+
+			return true;
+		};
+
+		CompressionOptions options;
+		options.format = PF_BC1;
+		options.quality = CompressionQuality::Fastest;
+
+		SPtr<PixelData> compressed = PixelData::create(1002, 601, 1, PF_BC1);
+		PixelUtil::compress(*gradient, *compressed, options);
+		BS_TEST_ASSERT(matchesSource(*gradient, *compressed));
+
+		// All mip levels compressed at once, must match the levels compressed one by one
+		Vector<SPtr<PixelData>> mips = PixelUtil::genMipmaps(*gradient, MipMapGenOptions());
+		Vector<SPtr<PixelData>> compressedMips;
+		for(auto& mip : mips)
+			compressedMips.push_back(PixelData::create(mip->getWidth(), mip->getHeight(), 1, PF_BC1));
+
+		PixelUtil::compress(mips, compressedMips, options);
+		for(UINT32 i = 0; i < (UINT32)mips.size(); i++)
+		{
+			SPtr<PixelData> compressedMip = PixelData::create(mips[i]->getWidth(), mips[i]->getHeight(), 1, PF_BC1);
+			PixelUtil::compress(*mips[i], *compressedMip, options);
+
+			BS_TEST_ASSERT(memcmp(compressedMip->getData(), compressedMips[i]->getData(), compressedMip->getSize()) == 0);
+		}
+	}
+
+#if BS_BENCHMARKS
+	void CoreTestSuite::benchmarkTextureCompression()
+	{
+		static constexpr UINT32 WIDTH = 3840;
+		static constexpr UINT32 HEIGHT = 2160;
+
+		Random random;
+		SPtr<PixelData> image = PixelData::create(WIDTH, HEIGHT, 1, PF_RGBA8);
+		UINT32* imagePixels = (UINT32*)image->getData();
+		for(UINT32 i = 0; i < WIDTH * HEIGHT; i++)
+			imagePixels[i] = random.get();
+
+		// Throughput of each format and quality level
+		CompressionOptions options;
+		String timings;
+		for(auto format : { PF_BC1, PF_BC3 })
+		{
+			for(auto quality : { CompressionQuality::Fastest, CompressionQuality::Normal })
+			{
+				options.format = format;
+				options.quality = quality;
+
+				SPtr<PixelData> output = PixelData::create(WIDTH, HEIGHT, 1, format);
+
+				Timer timer;
+				PixelUtil::compress(*image, *output, options);
+				timings += ", " + PixelUtil::getFormatName(format) + " quality " + toString((UINT32)quality) + " " +
+					toString(timer.getMicroseconds()) + "us";
+			}
+		}
+
+		gDebug().logDebug("Texture compression (" + toString(WIDTH) + "x" + toString(HEIGHT) + ")" + timings);
+	}
+#endif
+
+	void CoreTestSuite::testStaticProfilerScopes()
+	{
+		static_assert(ProfilerCPU::hashSampleName("") == 2166136261u, "");
+		static_assert(ProfilerCPU::hashSampleName("a") == 0xe40c292cu, "");
+
+		for(UINT32 i = 0; i < 10; i++)
+		{
+			BS_PROFILE_SCOPE("TestStaticOuter");
+			{
+				BS_PROFILE_SCOPE("TestStaticInner");
+			}
+		}
+
+		{
+			// Same name from a different call site shares the sample
+			BS_PROFILE_SCOPE("TestStaticOuter");
+		}
+
+		// Registering again returns the existing sample
+		ProfilerStaticSample outer = ProfilerCPU::registerStaticSample("TestStaticOuter",
+			ProfilerCPU::hashSampleName("TestStaticOuter"));
+		ProfilerStaticSample inner = ProfilerCPU::registerStaticSample("TestStaticInner",
+			ProfilerCPU::hashSampleName("TestStaticInner"));
+		BS_TEST_ASSERT(outer.index != inner.index);
+
+		// Colliding hash still results in separate samples
+		ProfilerStaticSample collision = ProfilerCPU::registerStaticSample("TestStaticCollision",
+			ProfilerCPU::hashSampleName("TestStaticOuter"));
+		BS_TEST_ASSERT(collision.index != outer.index && collision.index != inner.index);
+
+		UINT64 start = ProfilerCPU::beginStaticSample(collision);
+		ProfilerCPU::endStaticSample(collision, start);
+
+		CPUProfilerReport report = gProfilerCPU().generateReport();
+
+		const CPUProfilerStaticSamplingEntry* outerEntry = nullptr;
+		const CPUProfilerStaticSamplingEntry* innerEntry = nullptr;
+		const CPUProfilerStaticSamplingEntry* collisionEntry = nullptr;
+		for(auto& entry : report.getStaticSamplingData())
+		{
+			if(entry.name == "TestStaticOuter")
+				outerEntry = &entry;
+			else if(entry.name == "TestStaticInner")
+				innerEntry = &entry;
+			else if(entry.name == "TestStaticCollision")
+				collisionEntry = &entry;
+		}
+
+		BS_TEST_ASSERT(outerEntry != nullptr && outerEntry->numCalls == 11);
+		BS_TEST_ASSERT(innerEntry != nullptr && innerEntry->numCalls == 10);
+		BS_TEST_ASSERT(collisionEntry != nullptr && collisionEntry->numCalls == 1);
+
+		if(outerEntry != nullptr && innerEntry != nullptr)
+		{
+			BS_TEST_ASSERT(outerEntry->totalCycles >= innerEntry->totalCycles);
+			BS_TEST_ASSERT(outerEntry->maxCycles <= outerEntry->totalCycles);
+			BS_TEST_ASSERT(outerEntry->totalTimeMs >= 0.0);
+		}
+
+		gProfilerCPU().reset();
+		report = gProfilerCPU().generateReport();
+		BS_TEST_ASSERT(report.getStaticSamplingData().empty());
+
+		// Samples from task workers are only reported when requested, and only once
+		static constexpr UINT32 NUM_TASKS = 16;
+
+		Vector<SPtr<Task>> tasks;
+		for(UINT32 i = 0; i < NUM_TASKS; i++)
+		{
+			tasks.push_back(Task::create("TestStaticWorker", []()
+			{
+				BS_PROFILE_SCOPE("TestStaticWorker");
+			}));
+
+			TaskScheduler::instance().addTask(tasks.back());
+		}
+
+		for(auto& task : tasks)
+			task->wait();
+
+		const auto findWorkerEntry = [](const CPUProfilerReport& report) -> const CPUProfilerStaticSamplingEntry*
+		{
+			for(auto& entry : report.getStaticSamplingData())
+			{
+				if(entry.name == "TestStaticWorker")
+					return &entry;
+			}
+
+			return nullptr;
+		};
+
+		report = gProfilerCPU().generateReport();
+		BS_TEST_ASSERT(findWorkerEntry(report) == nullptr);
+
+		report = gProfilerCPU().generateReport(true);
+		const CPUProfilerStaticSamplingEntry* workerEntry = findWorkerEntry(report);
+		BS_TEST_ASSERT(workerEntry != nullptr && workerEntry->numCalls == NUM_TASKS);
+
+		report = gProfilerCPU().generateReport(true);
+		BS_TEST_ASSERT(findWorkerEntry(report) == nullptr);
+	}
+
+	void CoreTestSuite::testParticleStatsReport()
+	{
+		Time::startUp();
+		CoreThread::startUp();
+		CoreObjectManager::startUp();
+		GameObjectManager::startUp();
+		SceneManager::startUp();
+		ProfilingManager::startUp();
+
+		RendererManager::startUp();
+		RendererManager::instance()._registerFactory(bs_shared_ptr_new<NullTestRendererFactory>());
+		RendererManager::instance().setActive("NullTestRenderer");
+
+		// Not reported while the particle manager isn't running
+		gProfiler()._update();
+		BS_TEST_ASSERT(gProfiler().getReport(ProfiledThread::Sim).particleStats.numSimulated == 0);
+
+		ParticleManager::startUp();
+
+		{
+			// There are no cameras, so a system with custom bounds is culled and its update deferred. A system with
+			// automatic bounds but no particles yet has unknown bounds, and is always simulated.
+			ParticleSystemSettings culledSettings;
+			culledSettings.useAutomaticBounds = false;
+			culledSettings.customBounds = AABox(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f));
+
+			SPtr<ParticleSystem> culledSystems[2] = { ParticleSystem::create(), ParticleSystem::create() };
+			for(auto& entry : culledSystems)
+				entry->setSettings(culledSettings);
+
+			SPtr<ParticleSystem> visibleSystem = ParticleSystem::create();
+
+			// Initialize the core thread counterparts
+			gCoreThread().submitAll(true);
+
+			EvaluatedAnimationData animData;
+			ParticleManager::instance().update(animData);
+			gProfiler()._update();
+
+			const ParticleUpdateStats& stats = gProfiler().getReport(ProfiledThread::Sim).particleStats;
+			BS_TEST_ASSERT(stats.numSimulated == 1);
+			BS_TEST_ASSERT(stats.numSkipped == 2);
+		}
+
+		// Destroy the core thread counterparts while the renderer is still around
+		gCoreThread().submitAll(true);
+
+		RendererManager::shutDown();
+		ParticleManager::shutDown();
+		ProfilingManager::shutDown();
+		SceneManager::shutDown();
+		GameObjectManager::shutDown();
+		CoreObjectManager::shutDown();
+		CoreThread::shutDown();
+		Time::shutDown();
+	}
+
+	void CoreTestSuite::testDataBlockAlignment()
+	{
+		// Odd-sized image so the data block size doesn't happen to keep the following data aligned
+		SPtr<PixelData> source = PixelData::create(7, 3, 1, PF_RGB8);
+		UINT8* sourceData = source->getData();
+		for(UINT32 i = 0; i < source->getConsecutiveSize(); i++)
+			sourceData[i] = (UINT8)i;
+
+		MemorySerializer ms;
+		UINT32 numBytes = 0;
+		UINT8* bytes = ms.encode(source.get(), numBytes);
+
+		// Stream owns the memory, allowing the data block to be referenced in place
+		SPtr<MemoryDataStream> stream = bs_shared_ptr_new<MemoryDataStream>(bytes, numBytes);
+
+		BinarySerializer bs;
+		SPtr<PixelData> decoded = std::static_pointer_cast<PixelData>(bs.decode(stream, numBytes));
+		BS_TEST_ASSERT(decoded != nullptr);
+
+		if(decoded != nullptr)
+		{
+			const UINT8* decodedData = decoded->getData();
+			BS_TEST_ASSERT(decodedData >= bytes && decodedData < bytes + numBytes);
+			BS_TEST_ASSERT((decodedData - bytes) % BinarySerializer::DATA_BLOCK_ALIGNMENT == 0);
+
+			BS_TEST_ASSERT(decoded->getConsecutiveSize() == source->getConsecutiveSize());
+			BS_TEST_ASSERT(memcmp(decodedData, sourceData, source->getConsecutiveSize()) == 0);
+		}
+	}
+
+	void CoreTestSuite::testBatchedWorldTransforms()
+	{
+		static constexpr float EPSILON = 0.001f;
+
+		Time::startUp();
+		CoreThread::startUp();
+		CoreObjectManager::startUp();
+		GameObjectManager::startUp();
+		SceneManager::startUp();
+
+		{
+			// Parent at the scene root, with a child and a grandchild. Only the parent and the child are moved, and
+			// the child is provided first.
+			HSceneObject parent = SceneObject::create("Parent");
+			parent->setPosition(Vector3(1.0f, 0.0f, 0.0f));
+
+			HSceneObject child = SceneObject::create("Child");
+			child->setParent(parent, false);
+			child->setPosition(Vector3(0.0f, 1.0f, 0.0f));
+
+			HSceneObject grandchild = SceneObject::create("Grandchild");
+			grandchild->setParent(child, false);
+			grandchild->setPosition(Vector3(1.0f, 0.0f, 0.0f));
+
+			HSceneObject immovable = SceneObject::create("Immovable");
+			immovable->setMobility(ObjectMobility::Immovable);
+
+			// Clean all the transforms, so the batched update is the only thing that can mark them dirty
+			HSceneObject allObjects[] = { parent, child, grandchild, immovable };
+
+			UINT32 oldHashes[4];
+			for(UINT32 i = 0; i < 4; i++)
+			{
+				allObjects[i]->updateTransformsIfDirty();
+				oldHashes[i] = allObjects[i]->getTransformHash();
+			}
+
+			const Quaternion parentRotation(Vector3::UNIT_Y, Degree(90.0f));
+
+			SceneObject* objects[] = { child.get(), parent.get(), immovable.get() };
+			const Vector3 positions[] =
+				{ Vector3(0.0f, 5.0f, 0.0f), Vector3(10.0f, 0.0f, 0.0f), Vector3(3.0f, 3.0f, 3.0f) };
+			const Quaternion rotations[] = { Quaternion::IDENTITY, parentRotation, Quaternion::IDENTITY };
+
+			SceneObject::_setWorldTransforms(objects, positions, rotations, 3);
+
+			// Moved objects and their descendants are dirty, the immovable object wasn't touched
+			BS_TEST_ASSERT(parent->getTransformHash() != oldHashes[0]);
+			BS_TEST_ASSERT(child->getTransformHash() != oldHashes[1]);
+			BS_TEST_ASSERT(grandchild->getTransformHash() != oldHashes[2]);
+			BS_TEST_ASSERT(immovable->getTransformHash() == oldHashes[3]);
+
+			// World transforms match the requested ones
+			BS_TEST_ASSERT(Math::approxEquals(parent->getTransform().getPosition(), positions[1], EPSILON));
+			BS_TEST_ASSERT(Math::approxEquals(parent->getTransform().getRotation(), rotations[1], EPSILON));
+			BS_TEST_ASSERT(Math::approxEquals(child->getTransform().getPosition(), positions[0], EPSILON));
+			BS_TEST_ASSERT(Math::approxEquals(child->getTransform().getRotation(), rotations[0], EPSILON));
+			BS_TEST_ASSERT(Math::approxEquals(immovable->getTransform().getPosition(), Vector3::ZERO, EPSILON));
+
+			// Local transforms are relative to the parent's new transform
+			const Quaternion invParentRotation = parentRotation.inverse();
+			const Vector3 expectedChildPosition = invParentRotation.rotate(positions[0] - positions[1]);
+
+			BS_TEST_ASSERT(Math::approxEquals(parent->getLocalTransform().getPosition(), positions[1], EPSILON));
+			BS_TEST_ASSERT(Math::approxEquals(child->getLocalTransform().getPosition(), expectedChildPosition,
+				EPSILON));
+			BS_TEST_ASSERT(Math::approxEquals(child->getLocalTransform().getRotation(), invParentRotation, EPSILON));
+
+			// The grandchild keeps its local transform and follows the child
+			BS_TEST_ASSERT(Math::approxEquals(grandchild->getLocalTransform().getPosition(), Vector3(1.0f, 0.0f, 0.0f),
+				EPSILON));
+			BS_TEST_ASSERT(Math::approxEquals(grandchild->getTransform().getPosition(), Vector3(1.0f, 5.0f, 0.0f),
+				EPSILON));
+
+			for(auto& entry : allObjects)
+				entry->destroy(true);
+		}
+
+		SceneManager::shutDown();
+		GameObjectManager::shutDown();
+		CoreObjectManager::shutDown();
+		CoreThread::shutDown();
+		Time::shutDown();
+	}
 }
 
 using namespace bs;
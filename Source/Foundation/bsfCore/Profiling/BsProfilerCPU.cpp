@@ -2,6 +2,7 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Profiling/BsProfilerCPU.h"
 #include "Debug/BsDebug.h"
+#include "Debug/BsTraceRecorder.h"
 #include "Platform/BsPlatform.h"
 #include <chrono>
 
@@ -25,6 +26,26 @@ using namespace std::chrono;
 
 namespace bs
 {
+	/** Value of ProfiledBlock::traceName before the block's name is registered with the TraceRecorder. */
+	static constexpr UINT32 UNREGISTERED_TRACE_NAME = (UINT32)-1;
+
+	namespace
+	{
+		/** Names of all samples registered through ProfilerCPU::registerStaticSample(). */
+		struct StaticSampleRegistry
+		{
+			Mutex mutex;
+			UnorderedMap<UINT32, UINT32> indices;
+			Vector<String> names;
+		};
+
+		StaticSampleRegistry& getStaticSampleRegistry()
+		{
+			static StaticSampleRegistry registry;
+			return registry;
+		}
+	}
+
 	ProfilerCPU::Timer::Timer()
 		:startTime(0.0f)
 	{
@@ -184,6 +205,7 @@ namespace bs
 
 		activeBlocks->push(activeBlock);
 		
+		traceBlock(rootBlock, true);
 		rootBlock->basic.beginSample();
 		isActive = true;
 	}
@@ -195,6 +217,7 @@ namespace bs
 		else
 			activeBlock.block->precise.endSample();
 
+		traceBlock(activeBlock.block, false);
 		activeBlocks->pop();
 
 		if(!isActive)
@@ -212,6 +235,7 @@ namespace bs
 				else
 					curBlock.block->precise.endSample();
 
+				traceBlock(curBlock.block, false);
 				activeBlocks->pop();
 			}
 		}
@@ -233,6 +257,10 @@ namespace bs
 
 		rootBlock = nullptr;
 		frameAlloc.clear(); // Note: This never actually frees memory
+
+		ScopedSpinLock lock(staticSampleLock);
+		for(auto& entry : staticSamples)
+			entry = StaticSampleData();
 	}
 
 	ProfilerCPU::ProfiledBlock* ProfilerCPU::ThreadInfo::getBlock(const char* name)
@@ -240,6 +268,7 @@ namespace bs
 		ProfiledBlock* block = frameAlloc.construct<ProfiledBlock>(&frameAlloc);
 		block->name = (char*)frameAlloc.alloc(((UINT32)strlen(name) + 1) * sizeof(char));
 		strcpy(block->name, name);
+		block->traceName = UNREGISTERED_TRACE_NAME;
 
 		return block;
 	}
@@ -278,6 +307,7 @@ namespace bs
 	ProfilerCPU::ProfilerCPU()
 		: mBasicTimerOverhead(0.0), mPreciseTimerOverhead(0), mBasicSamplingOverheadMs(0.0), mPreciseSamplingOverheadMs(0.0)
 		, mBasicSamplingOverheadCycles(0), mPreciseSamplingOverheadCycles(0)
+		, mCalibrationCycles(TraceRecorder::getTimestamp()), mCalibrationTime(high_resolution_clock::now())
 	{
 		// TODO - We only estimate overhead on program start. It might be better to estimate it each time beginThread is called,
 		// and keep separate values per thread.
@@ -292,6 +322,8 @@ namespace bs
 
 		for(auto& threadInfo : mActiveThreads)
 			bs_delete<ThreadInfo, ProfilerAlloc>(threadInfo);
+
+		ThreadInfo::activeThread = nullptr;
 	}
 
 	void ProfilerCPU::beginThread(const char* name)
@@ -299,19 +331,35 @@ namespace bs
 		ThreadInfo* thread = ThreadInfo::activeThread;
 		if(thread == nullptr)
 		{
-			ThreadInfo::activeThread = bs_new<ThreadInfo, ProfilerAlloc>();
-			thread = ThreadInfo::activeThread;
+			thread = getThreadInfo();
 
-			{
-				Lock lock(mThreadSync);
+			if(TraceRecorder::isStarted())
+				TraceRecorder::instance().setThreadName(name);
+		}
 
-				mActiveThreads.push_back(thread);
-			}
+		if(!thread->isSampledThread)
+		{
+			Lock lock(mThreadSync);
+			thread->isSampledThread = true;
 		}
 
 		thread->begin(name);
 	}
 
+	ProfilerCPU::ThreadInfo* ProfilerCPU::getThreadInfo()
+	{
+		if(ThreadInfo::activeThread != nullptr)
+			return ThreadInfo::activeThread;
+
+		ThreadInfo* thread = bs_new<ThreadInfo, ProfilerAlloc>();
+		ThreadInfo::activeThread = thread;
+
+		Lock lock(mThreadSync);
+		mActiveThreads.push_back(thread);
+
+		return thread;
+	}
+
 	void ProfilerCPU::endThread()
 	{
 		// I don't do a nullcheck where on purpose, so endSample can be called ASAP
@@ -346,6 +394,7 @@ namespace bs
 		thread->activeBlock = ActiveBlock(ActiveSamplingType::Basic, block);
 		thread->activeBlocks->push(thread->activeBlock);
 
+		traceBlock(block, true);
 		block->basic.beginSample();
 	}
 
@@ -376,6 +425,7 @@ namespace bs
 #endif
 
 		block->basic.endSample();
+		traceBlock(block, false);
 
 		thread->activeBlocks->pop();
 
@@ -413,6 +463,7 @@ namespace bs
 		thread->activeBlock = ActiveBlock(ActiveSamplingType::Precise, block);
 		thread->activeBlocks->push(thread->activeBlock);
 
+		traceBlock(block, true);
 		block->precise.beginSample();
 	}
 
@@ -443,6 +494,7 @@ namespace bs
 #endif
 
 		block->precise.endSample();
+		traceBlock(block, false);
 
 		thread->activeBlocks->pop();
 
@@ -460,17 +512,88 @@ namespace bs
 			thread->reset();
 	}
 
-	CPUProfilerReport ProfilerCPU::generateReport()
+	CPUProfilerReport ProfilerCPU::generateReport(bool includeWorkerThreads)
 	{
 		CPUProfilerReport report;
 
 		ThreadInfo* thread = ThreadInfo::activeThread;
 		if(thread == nullptr)
-			return report;
+		{
+			if(!includeWorkerThreads)
+				return report;
+
+			thread = getThreadInfo();
+		}
 
 		if(thread->isActive)
 			thread->end();
 
+		ProfilerVector<StaticSampleData> staticSamples;
+		{
+			ScopedSpinLock lock(thread->staticSampleLock);
+			staticSamples = thread->staticSamples;
+		}
+
+		// Take the samples of workers, leaving them empty for the next report
+		if(includeWorkerThreads)
+		{
+			Lock lock(mThreadSync);
+
+			for(auto& entry : mActiveThreads)
+			{
+				if(entry == thread || entry->isSampledThread)
+					continue;
+
+				ScopedSpinLock sampleLock(entry->staticSampleLock);
+
+				if(entry->staticSamples.size() > staticSamples.size())
+					staticSamples.resize(entry->staticSamples.size());
+
+				for(UINT32 i = 0; i < (UINT32)entry->staticSamples.size(); i++)
+				{
+					StaticSampleData& src = entry->staticSamples[i];
+					StaticSampleData& dst = staticSamples[i];
+
+					dst.numCalls += src.numCalls;
+					dst.totalCycles += src.totalCycles;
+					dst.maxCycles = std::max(dst.maxCycles, src.maxCycles);
+
+					src = StaticSampleData();
+				}
+			}
+		}
+
+		// Static samples are stored flat, by index, so they only need to be converted to time
+		if(!staticSamples.empty())
+		{
+			const double elapsedMs = duration_cast<nanoseconds>(high_resolution_clock::now() - mCalibrationTime).count()
+				* 0.000001;
+			const UINT64 elapsedCycles = TraceRecorder::getTimestamp() - mCalibrationCycles;
+			const double msPerCycle = elapsedCycles > 0 ? elapsedMs / elapsedCycles : 0.0;
+
+			StaticSampleRegistry& registry = getStaticSampleRegistry();
+			Lock lock(registry.mutex);
+
+			for(UINT32 i = 0; i < (UINT32)staticSamples.size(); i++)
+			{
+				const StaticSampleData& data = staticSamples[i];
+				if(data.numCalls == 0)
+					continue;
+
+				CPUProfilerStaticSamplingEntry entry;
+				entry.name = registry.names[i];
+				entry.numCalls = data.numCalls;
+				entry.totalCycles = data.totalCycles;
+				entry.maxCycles = data.maxCycles;
+				entry.avgCycles = data.totalCycles / data.numCalls;
+				entry.totalTimeMs = data.totalCycles * msPerCycle;
+				entry.maxTimeMs = data.maxCycles * msPerCycle;
+				entry.avgTimeMs = entry.totalTimeMs / data.numCalls;
+
+				report.mStaticSamplingEntries.push_back(entry);
+			}
+		}
+
 		// We need to separate out basic and precise data and form two separate hierarchies
 		if(thread->rootBlock == nullptr)
 			return report;
@@ -760,6 +883,101 @@ namespace bs
 		return report;
 	}
 
+	void ProfilerCPU::traceBlock(ProfiledBlock* block, bool begin)
+	{
+		if(!TraceRecorder::isStarted())
+			return;
+
+		TraceRecorder& recorder = TraceRecorder::instance();
+		if(!recorder.isEnabled())
+			return;
+
+		// Blocks are re-created every frame, but registering a name that was already seen is just a lookup
+		if(block->traceName == UNREGISTERED_TRACE_NAME)
+			block->traceName = TraceRecorder::registerName(block->name);
+
+		if(begin)
+			recorder.beginEvent(block->traceName);
+		else
+			recorder.endEvent(block->traceName);
+	}
+
+	ProfilerStaticSample ProfilerCPU::registerStaticSample(const char* name, UINT32 nameHash)
+	{
+		ProfilerStaticSample sample;
+		sample.traceName = TraceRecorder::registerName(name);
+
+		StaticSampleRegistry& registry = getStaticSampleRegistry();
+		Lock lock(registry.mutex);
+
+		auto iterFind = registry.indices.find(nameHash);
+		if(iterFind == registry.indices.end())
+		{
+			sample.index = (UINT32)registry.names.size();
+			registry.names.push_back(name);
+			registry.indices[nameHash] = sample.index;
+
+			return sample;
+		}
+
+		if(registry.names[iterFind->second] == name)
+		{
+			sample.index = iterFind->second;
+			return sample;
+		}
+
+		// Hash collision, samples with colliding names aren't in the lookup table, so find them the slow way
+		for(UINT32 i = 0; i < (UINT32)registry.names.size(); i++)
+		{
+			if(registry.names[i] == name)
+			{
+				sample.index = i;
+				return sample;
+			}
+		}
+
+		LOGWRN("Static profiler sample \"" + String(name) + "\" has the same name hash as \"" +
+			registry.names[iterFind->second] + "\". Registration will be slower for the sample.");
+
+		sample.index = (UINT32)registry.names.size();
+		registry.names.push_back(name);
+
+		return sample;
+	}
+
+	UINT64 ProfilerCPU::beginStaticSample(const ProfilerStaticSample& sample)
+	{
+		if(TraceRecorder::isStarted())
+			TraceRecorder::instance().beginEvent(sample.traceName);
+
+		return TraceRecorder::getTimestamp();
+	}
+
+	void ProfilerCPU::endStaticSample(const ProfilerStaticSample& sample, UINT64 startCycles)
+	{
+		const UINT64 cycles = TraceRecorder::getTimestamp() - startCycles;
+
+		if(TraceRecorder::isStarted())
+			TraceRecorder::instance().endEvent(sample.traceName);
+
+		if(!isStarted())
+			return;
+
+		ThreadInfo* thread = ThreadInfo::activeThread;
+		if(thread == nullptr)
+			thread = instance().getThreadInfo();
+
+		ScopedSpinLock lock(thread->staticSampleLock);
+
+		if(sample.index >= (UINT32)thread->staticSamples.size())
+			thread->staticSamples.resize(sample.index + 1);
+
+		StaticSampleData& data = thread->staticSamples[sample.index];
+		data.numCalls++;
+		data.totalCycles += cycles;
+		data.maxCycles = std::max(data.maxCycles, cycles);
+	}
+
 	void ProfilerCPU::estimateTimerOverhead()
 	{
 		// Get an idea of how long timer calls and RDTSC takes
@@ -4,6 +4,7 @@
 
 #include "BsCorePrerequisites.h"
 #include "Utility/BsModule.h"
+#include "Debug/BsTraceRecorder.h"
 
 namespace bs
 {
@@ -13,6 +14,13 @@ namespace bs
 
 	class CPUProfilerReport;
 
+	/** Identifies a sample registered through ProfilerCPU::registerStaticSample(). */
+	struct ProfilerStaticSample
+	{
+		UINT32 index; /**< Index of the sample's data in the per-thread sample list. */
+		UINT32 traceName; /**< Identifier of the sample name, as registered with the TraceRecorder. */
+	};
+
 	/**
 	 * Provides various performance measuring methods.
 	 * 			
@@ -170,6 +178,7 @@ namespace bs
 			ProfiledBlock* findChild(const char* name) const;
 
 			char* name;
+			UINT32 traceName;
 			
 			ProfileData basic;
 			PreciseProfileData precise;
@@ -177,6 +186,14 @@ namespace bs
 			Vector<ProfiledBlock*, StdFrameAlloc<ProfiledBlock*>> children;
 		};
 
+		/** Data accumulated by a single static sample on a single thread. */
+		struct StaticSampleData
+		{
+			UINT64 numCalls = 0;
+			UINT64 totalCycles = 0;
+			UINT64 maxCycles = 0;
+		};
+
 		/**	CPU sampling type. */
 		enum class ActiveSamplingType
 		{
@@ -235,6 +252,16 @@ namespace bs
 			FrameAlloc frameAlloc;
 			ActiveBlock activeBlock;
 			Stack<ActiveBlock, StdFrameAlloc<ActiveBlock>>* activeBlocks;
+
+			/**
+			 * Static samples recorded on the thread, by sample index. Guarded by @p staticSampleLock, as samples of
+			 * threads not started with beginThread() are collected by other threads.
+			 */
+			ProfilerVector<StaticSampleData> staticSamples;
+			SpinLock staticSampleLock;
+
+			/** True if beginThread() was called on the thread at least once. Written under ProfilerCPU::mThreadSync. */
+			bool isSampledThread = false;
 		};
 
 	public:
@@ -298,11 +325,54 @@ namespace bs
 
 		/**
 		 * Generates a report from all previously sampled data.
+		 *
+		 * @param[in]	includeWorkerThreads	If true, static samples (see BS_PROFILE_SCOPE) recorded on threads
+		 *										that were never started with beginThread(), such as task scheduler
+		 *										workers, are merged into the report. Their samples are cleared once
+		 *										reported, so each is reported once, on the first thread requesting it.
 		 * 			
 		 * @note	Generating a report will stop all in-progress sampling. You should make sure
 		 * 			you call endSample* manually beforehand so this doesn't have to happen.
 		 */
-		CPUProfilerReport generateReport();
+		CPUProfilerReport generateReport(bool includeWorkerThreads = false);
+
+		/**
+		 * Computes a hash of the provided sample name, used for identifying static samples. Can be evaluated at compile
+		 * time.
+		 */
+		static constexpr UINT32 hashSampleName(const char* name)
+		{
+			// FNV-1a
+			UINT32 hash = 2166136261u;
+			for(; *name != '\0'; name++)
+				hash = (hash ^ (UINT8)*name) * 16777619u;
+
+			return hash;
+		}
+
+		/**
+		 * Registers a static sample with the provided name. Static samples are registered only once per call site,
+		 * after which they are recorded by index, without any name lookups or allocations. This makes them cheap enough
+		 * to be used in tight loops, at the cost of only reporting aggregate values and no hierarchy. Use
+		 * BS_PROFILE_SCOPE instead of calling this directly.
+		 *
+		 * @param[in]	name		Name of the sample. Call sites using the same name share the same sample.
+		 * @param[in]	nameHash	Hash of the name, as returned by hashSampleName().
+		 * @return					Identifier to pass to beginStaticSample() and endStaticSample().
+		 */
+		static ProfilerStaticSample registerStaticSample(const char* name, UINT32 nameHash);
+
+		/**
+		 * Begins a measurement of a static sample on the calling thread. Must be followed by endStaticSample(). Does
+		 * not require the thread to be registered with beginThread(), and can be called even if the profiler isn't
+		 * started.
+		 *
+		 * @return	Current cycle count, to be passed to endStaticSample().
+		 */
+		static UINT64 beginStaticSample(const ProfilerStaticSample& sample);
+
+		/** Ends a measurement started with beginStaticSample(), and adds it to the calling thread's sample data. */
+		static void endStaticSample(const ProfilerStaticSample& sample, UINT64 startCycles);
 
 	private:
 		/**
@@ -311,6 +381,12 @@ namespace bs
 		 */
 		void estimateTimerOverhead();
 
+		/** Records the start or the end of the provided block with the TraceRecorder, if it is recording. */
+		static void traceBlock(ProfiledBlock* block, bool begin);
+
+		/** Returns the profiling data of the calling thread, creating it if this is the first time it is used. */
+		ThreadInfo* getThreadInfo();
+
 	private:
 		double mBasicTimerOverhead;
 		UINT64 mPreciseTimerOverhead;
@@ -320,6 +396,9 @@ namespace bs
 		UINT64 mBasicSamplingOverheadCycles;
 		UINT64 mPreciseSamplingOverheadCycles;
 
+		UINT64 mCalibrationCycles;
+		std::chrono::high_resolution_clock::time_point mCalibrationTime;
+
 		ProfilerVector<ThreadInfo*> mActiveThreads;
 		Mutex mThreadSync;
 	};
@@ -385,6 +464,21 @@ namespace bs
 		ProfilerVector<CPUProfilerPreciseSamplingEntry> childEntries;
 	};
 
+	/** Profiling entry containing aggregate information about a single static sample. See BS_PROFILE_SCOPE. */
+	struct BS_CORE_EXPORT CPUProfilerStaticSamplingEntry
+	{
+		String name; /**< Name of the sample. */
+		UINT64 numCalls = 0; /**< Number of times the sample was recorded. */
+
+		UINT64 avgCycles = 0; /**< Average number of cycles per call. */
+		UINT64 maxCycles = 0; /**< Maximum number of cycles of a single call. */
+		UINT64 totalCycles = 0; /**< Total number of cycles across all calls. */
+
+		double avgTimeMs = 0.0; /**< Average time per call. In milliseconds. */
+		double maxTimeMs = 0.0; /**< Maximum time of a single call. In milliseconds. */
+		double totalTimeMs = 0.0; /**< Total time across all calls. In milliseconds. */
+	};
+
 	/** CPU profiling report containing all profiling information for a single profiling session. */
 	class BS_CORE_EXPORT CPUProfilerReport
 	{
@@ -403,11 +497,18 @@ namespace bs
 		 */
 		const CPUProfilerPreciseSamplingEntry& getPreciseSamplingData() const { return mPreciseSamplingRootEntry; }
 
+		/** Returns data for all static samples recorded on the thread at least once, in order of registration. */
+		const ProfilerVector<CPUProfilerStaticSamplingEntry>& getStaticSamplingData() const
+		{
+			return mStaticSamplingEntries;
+		}
+
 	private:
 		friend class ProfilerCPU;
 
 		CPUProfilerBasicSamplingEntry mBasicSamplingRootEntry;
 		CPUProfilerPreciseSamplingEntry mPreciseSamplingRootEntry;
+		ProfilerVector<CPUProfilerStaticSamplingEntry> mStaticSamplingEntries;
 	};
 
 	/** Provides global access to ProfilerCPU instance. */
@@ -421,5 +522,42 @@ namespace bs
 		bs::gProfilerCPU().endSample(name);			\
 	}
 
+	/**
+	 * Helper class that measures a static sample for the duration of the current block. Use BS_PROFILE_SCOPE instead of
+	 * using it directly.
+	 */
+	class ProfileStaticScope
+	{
+	public:
+		ProfileStaticScope(const ProfilerStaticSample& sample)
+			:mSample(sample), mStartCycles(ProfilerCPU::beginStaticSample(sample))
+		{ }
+
+		~ProfileStaticScope()
+		{
+			ProfilerCPU::endStaticSample(mSample, mStartCycles);
+		}
+
+	private:
+		const ProfilerStaticSample& mSample;
+		UINT64 mStartCycles;
+	};
+
+	/**
+	 * Measures the remainder of the current block as a static sample with the provided name (see
+	 * ProfilerCPU::registerStaticSample). The name must be a string literal, as its hash is computed at compile time
+	 * and the sample is only registered the first time the block is entered. Samples are reported per-thread in
+	 * CPUProfilerReport::getStaticSamplingData(), and also recorded by the TraceRecorder when it is enabled.
+	 */
+#if BS_PROFILING_ENABLED
+	#define BS_PROFILE_SCOPE(name)																					\
+		static const bs::ProfilerStaticSample BS_TRACE_CONCAT(_bsProfileSample, __LINE__) =							\
+			bs::ProfilerCPU::registerStaticSample(name,																\
+				std::integral_constant<bs::UINT32, bs::ProfilerCPU::hashSampleName(name)>::value);					\
+		bs::ProfileStaticScope BS_TRACE_CONCAT(_bsProfileScope, __LINE__)(BS_TRACE_CONCAT(_bsProfileSample, __LINE__));
+#else
+	#define BS_PROFILE_SCOPE(name)
+#endif
+
 	/** @} */
 }
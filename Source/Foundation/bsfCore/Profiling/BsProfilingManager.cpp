@@ -2,6 +2,8 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Profiling/BsProfilingManager.h"
 #include "Math/BsMath.h"
+#include "Physics/BsPhysics.h"
+#include "Particles/BsParticleManager.h"
 
 namespace bs
 {
@@ -27,10 +29,30 @@ namespace bs
 	void ProfilingManager::_update()
 	{
 #if BS_PROFILING_ENABLED
-		mSavedSimReports[mNextSimReportIdx].cpuReport = gProfilerCPU().generateReport();
+		ProfilerReport& report = mSavedSimReports[mNextSimReportIdx];
+		// Static samples from task workers are reported along with the sim thread
+		report.cpuReport = gProfilerCPU().generateReport(true);
 
 		gProfilerCPU().reset();
 
+		if(TaskScheduler::isStarted() && TaskScheduler::instance().isStatisticsEnabled())
+		{
+			report.taskSchedulerReport = TaskScheduler::instance().generateReport();
+			TaskScheduler::instance().resetStatistics();
+		}
+		else
+			report.taskSchedulerReport = TaskSchedulerReport();
+
+		if(ParticleManager::isStarted())
+			report.particleStats = ParticleManager::instance().getStats();
+		else
+			report.particleStats = ParticleUpdateStats();
+
+		if(Physics::isStarted())
+			report.physicsStepStats = gPhysics().getStepStats();
+		else
+			report.physicsStepStats.clear();
+
 		mNextSimReportIdx = (mNextSimReportIdx + 1) % NUM_SAVED_FRAMES;
 #endif
 	}
@@ -5,6 +5,9 @@
 #include "BsCorePrerequisites.h"
 #include "Utility/BsModule.h"
 #include "Profiling/BsProfilerCPU.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Particles/BsParticleCommon.h"
+#include "Physics/BsPhysicsCommon.h"
 
 namespace bs
 {
@@ -16,6 +19,21 @@ namespace bs
 	struct ProfilerReport
 	{
 		CPUProfilerReport cpuReport;
+
+		/**
+		 * Task scheduler statistics for the frame. Only provided in sim thread reports, and only if statistics are
+		 * enabled through TaskScheduler::setStatisticsEnabled().
+		 */
+		TaskSchedulerReport taskSchedulerReport;
+
+		/** Number of particle systems simulated and skipped during the frame. Only provided in sim thread reports. */
+		ParticleUpdateStats particleStats;
+
+		/**
+		 * Statistics about each physics simulation step completed during the frame, in the order the steps completed.
+		 * Only provided in sim thread reports.
+		 */
+		Vector<PhysicsStepStats> physicsStepStats;
 	};
 
 	/**	Type of thread used by the profiler. */
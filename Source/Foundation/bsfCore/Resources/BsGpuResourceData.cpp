@@ -4,6 +4,7 @@
 #include "Private/RTTI/BsGpuResourceDataRTTI.h"
 #include "CoreThread/BsCoreThread.h"
 #include "Error/BsException.h"
+#include "FileSystem/BsDataStream.h"
 
 namespace bs
 {
@@ -18,6 +19,7 @@ namespace bs
 		mData = copy.mData;
 		mLocked = copy.mLocked; // TODO - This should be shared by all copies pointing to the same data?
 		mOwnsData = false;
+		mSourceStream = copy.mSourceStream;
 	}
 
 	GpuResourceData::~GpuResourceData()
@@ -30,6 +32,7 @@ namespace bs
 		mData = rhs.mData;
 		mLocked = rhs.mLocked; // TODO - This should be shared by all copies pointing to the same data?
 		mOwnsData = false;
+		mSourceStream = rhs.mSourceStream;
 
 		return *this;
 	}
@@ -70,6 +73,13 @@ namespace bs
 
 	void GpuResourceData::freeInternalBuffer()
 	{
+		if(mSourceStream != nullptr)
+		{
+			mSourceStream = nullptr;
+			mData = nullptr;
+			return;
+		}
+
 		if(mData == nullptr || !mOwnsData)
 			return;
 
@@ -101,6 +111,33 @@ namespace bs
 		mOwnsData = false;
 	}
 
+	void GpuResourceData::_readFromStream(const SPtr<DataStream>& stream, UINT32 size)
+	{
+		// Data blocks are aligned by the serializer, but data encoded before that can start at any offset within the
+		// stream, so only reference those aligned well enough to be accessed as 32-bit values (floats and integers)
+		static constexpr UINT32 MIN_ALIGNMENT = 4;
+
+		if (!stream->isFile())
+		{
+			SPtr<MemoryDataStream> memStream = std::static_pointer_cast<MemoryDataStream>(stream);
+			UINT8* data = memStream->getCurrentPtr();
+
+			const bool aligned = ((UINT64)data % MIN_ALIGNMENT) == 0;
+			const bool enoughData = memStream->size() - memStream->tell() >= size;
+			if (memStream->isMemoryReferenceable() && aligned && enoughData)
+			{
+				setExternalBuffer(data);
+				mSourceStream = memStream;
+
+				memStream->skip(size);
+				return;
+			}
+		}
+
+		allocateInternalBuffer(size);
+		stream->read(mData, size);
+	}
+
 	void GpuResourceData::_lock() const
 	{
 		mLocked = true;
@@ -66,6 +66,22 @@ namespace bs
 		 */
 		void setExternalBuffer(UINT8* data);
 
+		/**
+		 * Fills the internal buffer with @p size bytes read from the provided stream. If the stream allows its memory
+		 * to be referenced (see MemoryDataStream::isMemoryReferenceable) the data is referenced directly instead of
+		 * being copied, and a reference to the stream is kept for as long as the data is used.
+		 *
+		 * @note	If any internal data is allocated, it is freed.
+		 */
+		void _readFromStream(const SPtr<DataStream>& stream, UINT32 size);
+
+		/**
+		 * Checks if the data references memory of the stream it was read from (see _readFromStream()), instead of
+		 * being stored in a separate buffer. Such data keeps the stream (e.g. a memory mapped file) alive for as long
+		 * as it is referenced.
+		 */
+		bool _isReferencingStream() const { return mSourceStream != nullptr; }
+
 		/** Checks if the internal buffer is locked due to some other thread using it. */
 		bool isLocked() const { return mLocked; }
 
@@ -86,6 +102,7 @@ namespace bs
 		UINT8* mData;
 		bool mOwnsData;
 		mutable bool mLocked;
+		SPtr<MemoryDataStream> mSourceStream;
 
 		/************************************************************************/
 		/* 								SERIALIZATION                      		*/
@@ -19,6 +19,15 @@
 
 namespace bs
 {
+	/** Returns the number of bytes that need to be inserted at @p offset in order to align it to @p alignment. */
+	static UINT32 getDataPaddingSize(size_t offset, UINT32 alignment)
+	{
+		if(alignment == 0)
+			return 0;
+
+		return (UINT32)((alignment - offset % alignment) % alignment);
+	}
+
 	Resources::Resources()
 	{
 		{
@@ -355,7 +364,12 @@ namespace bs
 	{
 		Lock fileLock = FileScheduler::getLock(filePath);
 
-		SPtr<DataStream> stream = FileSystem::openFile(filePath, true);
+		// Map the file if possible, so that data blocks (e.g. texture and mesh data) can be referenced in place instead
+		// of being read into separately allocated buffers
+		SPtr<DataStream> stream = FileSystem::mapFile(filePath);
+		if (stream == nullptr)
+			stream = FileSystem::openFile(filePath, true);
+
 		if (stream == nullptr)
 			return nullptr;
 
@@ -377,8 +391,18 @@ namespace bs
 				UINT32 objectSize = 0;
 				stream->read(&objectSize, sizeof(objectSize));
 
+				const size_t metaDataOffset = stream->tell();
+
 				BinarySerializer bs;
 				metaData = std::static_pointer_cast<SavedResourceData>(bs.decode(stream, objectSize, params));
+
+				if(metaData)
+				{
+					stream->seek(metaDataOffset + objectSize);
+
+					const size_t objectOffset = stream->tell() + sizeof(UINT32);
+					stream->skip(getDataPaddingSize(objectOffset, metaData->getDataAlignment()));
+				}
 			}
 		}
 
@@ -612,7 +636,7 @@ namespace bs
 
 		UINT32 compressionMethod = (compress && resource->isCompressible()) ? 1 : 0;
 		SPtr<SavedResourceData> resourceData = bs_shared_ptr_new<SavedResourceData>(dependencyUUIDs, 
-			resource->allowAsyncLoading(), compressionMethod);
+			resource->allowAsyncLoading(), compressionMethod, BinarySerializer::DATA_BLOCK_ALIGNMENT);
 
 		Path parentDir = filePath.getDirectory();
 		if (!FileSystem::exists(parentDir))
@@ -662,6 +686,14 @@ namespace bs
 			stream.write((char*)bytes, numBytes);
 			
 			bs_free(bytes);
+
+			// Pad so the object data starts at an aligned offset, allowing its data blocks to be referenced in place
+			// when the file is mapped
+			const UINT32 objectOffset = sizeof(UINT32) + numBytes + sizeof(UINT32);
+			const UINT32 paddingSize = getDataPaddingSize(objectOffset, resourceData->getDataAlignment());
+			const char padding[BinarySerializer::DATA_BLOCK_ALIGNMENT] = { 0 };
+
+			stream.write(padding, paddingSize);
 		}
 
 		// Write object data
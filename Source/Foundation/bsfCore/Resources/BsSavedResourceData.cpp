@@ -6,11 +6,13 @@
 namespace bs
 {
 	SavedResourceData::SavedResourceData()
-		:mAllowAsync(true), mCompressionMethod(0)
+		:mAllowAsync(true), mCompressionMethod(0), mDataAlignment(0)
 	{ }
 
-	SavedResourceData::SavedResourceData(const Vector<UUID>& dependencies, bool allowAsync, UINT32 compressionMethod)
-		:mDependencies(dependencies), mAllowAsync(allowAsync), mCompressionMethod(compressionMethod)
+	SavedResourceData::SavedResourceData(const Vector<UUID>& dependencies, bool allowAsync, UINT32 compressionMethod,
+		UINT32 dataAlignment)
+		:mDependencies(dependencies), mAllowAsync(allowAsync), mCompressionMethod(compressionMethod),
+		mDataAlignment(dataAlignment)
 	{ }
 
 	RTTITypeBase* SavedResourceData::getRTTIStatic()
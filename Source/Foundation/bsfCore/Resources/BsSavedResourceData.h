@@ -20,7 +20,8 @@ namespace bs
 	{
 	public:
 		SavedResourceData();
-		SavedResourceData(const Vector<UUID>& dependencies, bool allowAsync, UINT32 compressionMethod);
+		SavedResourceData(const Vector<UUID>& dependencies, bool allowAsync, UINT32 compressionMethod,
+			UINT32 dataAlignment);
 
 		/**	Returns a list of all resource dependencies. */
 		const Vector<UUID>& getDependencies() const { return mDependencies; }
@@ -31,10 +32,17 @@ namespace bs
 		/** Returns the method used for compressing the resource. 0 if none. */
 		UINT32 getCompressionMethod() const { return mCompressionMethod; }
 
+		/**
+		 * Returns the alignment, in bytes, of the resource data within the file. 0 if the data isn't aligned (resources
+		 * saved before alignment was introduced).
+		 */
+		UINT32 getDataAlignment() const { return mDataAlignment; }
+
 	private:
 		Vector<UUID> mDependencies;
 		bool mAllowAsync;
 		UINT32 mCompressionMethod;
+		UINT32 mDataAlignment;
 
 	/************************************************************************/
 	/* 								SERIALIZATION                      		*/
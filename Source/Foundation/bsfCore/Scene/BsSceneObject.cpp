@@ -11,6 +11,7 @@
 #include "Scene/BsPrefabUtility.h"
 #include "Math/BsMatrix3.h"
 #include "BsCoreApplication.h"
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs
 {
@@ -287,6 +288,71 @@ namespace bs
 		notifyTransformChanged(TCF_Transform);
 	}
 
+	void SceneObject::_setWorldTransforms(SceneObject* const* objects, const Vector3* positions,
+		const Quaternion* rotations, UINT32 count)
+	{
+		static constexpr UINT32 GRAIN_SIZE = 256;
+
+		// Objects parented to the root can't depend on each other, so their local transforms can be calculated in
+		// parallel. Make sure the root transforms are up to date so they can be safely read from multiple threads.
+		const auto isParentRoot = [](const SceneObject* so)
+		{
+			return so->mParent != nullptr && so->mParent->mParent == nullptr;
+		};
+
+		for (UINT32 i = 0; i < count; i++)
+		{
+			if (isParentRoot(objects[i]))
+				objects[i]->mParent->updateTransformsIfDirty();
+		}
+
+		const auto worker = [objects, positions, rotations, &isParentRoot](UINT32 begin, UINT32 end)
+		{
+			for (UINT32 i = begin; i < end; i++)
+			{
+				SceneObject* so = objects[i];
+				if (so->mMobility != ObjectMobility::Movable || !isParentRoot(so))
+					continue;
+
+				const Transform& parentTfrm = so->mParent->getTransform();
+				so->mLocalTfrm.setWorldPosition(positions[i], parentTfrm);
+				so->mLocalTfrm.setWorldRotation(rotations[i], parentTfrm);
+			}
+		};
+
+		TaskScheduler::instance().parallelFor(0, count, GRAIN_SIZE, worker);
+
+		// Mark the objects moved above dirty first, as their children might come before them in the list
+		for (UINT32 i = 0; i < count; i++)
+		{
+			SceneObject* so = objects[i];
+			if (so->mMobility == ObjectMobility::Movable && isParentRoot(so))
+				so->notifyTransformChanged(TCF_Transform);
+		}
+
+		// Remaining objects might be children of objects moved above, so handle them in order
+		for (UINT32 i = 0; i < count; i++)
+		{
+			SceneObject* so = objects[i];
+			if (so->mMobility != ObjectMobility::Movable || isParentRoot(so))
+				continue;
+
+			if (so->mParent != nullptr)
+			{
+				const Transform& parentTfrm = so->mParent->getTransform();
+				so->mLocalTfrm.setWorldPosition(positions[i], parentTfrm);
+				so->mLocalTfrm.setWorldRotation(rotations[i], parentTfrm);
+			}
+			else
+			{
+				so->mLocalTfrm.setPosition(positions[i]);
+				so->mLocalTfrm.setRotation(rotations[i]);
+			}
+
+			so->notifyTransformChanged(TCF_Transform);
+		}
+	}
+
 	void SceneObject::setWorldScale(const Vector3& scale)
 	{
 		if (mMobility != ObjectMobility::Movable)
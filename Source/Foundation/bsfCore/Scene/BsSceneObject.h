@@ -145,6 +145,18 @@ namespace bs
 		/** Recursively disables the provided set of flags on this object and all children. */
 		void _unsetFlags(UINT32 flags);
 
+		/**
+		 * Sets world positions and rotations of multiple scene objects at once, for systems that move large numbers of
+		 * objects every frame (e.g. physics). Local transforms of objects parented directly to the scene root are
+		 * calculated in parallel. Afterwards each object is marked dirty and its components are notified, in a single
+		 * pass on the calling thread. Each object is notified once, rather than once per changed property.
+		 *
+		 * Objects whose parent is also in the list must come after the parent, unless the parent is parented directly
+		 * to the scene root.
+		 */
+		static void _setWorldTransforms(SceneObject* const* objects, const Vector3* positions, 
+			const Quaternion* rotations, UINT32 count);
+
 		/** @} */
 
 	private:
@@ -23,6 +23,7 @@ set(BS_ENGINE_SRC_GUI
 	"bsfEngine/GUI/BsGUIElement.cpp"
 	"bsfEngine/GUI/BsGUILabel.cpp"
 	"bsfEngine/GUI/BsGUIManager.cpp"
+	"bsfEngine/GUI/BsGUIBatchUtility.cpp"
 	"bsfEngine/GUI/BsGUISkin.cpp"
 	"bsfEngine/GUI/BsGUILayout.cpp"
 	"bsfEngine/GUI/BsGUILayoutX.cpp"
@@ -193,6 +194,7 @@ set(BS_ENGINE_INC_GUI
 	"bsfEngine/GUI/BsGUIElementStyle.h"
 	"bsfEngine/GUI/BsGUILabel.h"
 	"bsfEngine/GUI/BsGUIManager.h"
+	"bsfEngine/GUI/BsGUIBatchUtility.h"
 	"bsfEngine/GUI/BsGUISkin.h"
 	"bsfEngine/GUI/BsGUILayout.h"
 	"bsfEngine/GUI/BsGUILayoutX.h"
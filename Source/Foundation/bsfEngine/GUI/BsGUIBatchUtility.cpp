@@ -0,0 +1,120 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "GUI/BsGUIBatchUtility.h"
+
+namespace bs
+{
+	/** Orders render elements by their GUI element and render element index. */
+	static bool compareByElement(const GUIBatchElement& a, const GUIBatchElement& b)
+	{
+		return a.element < b.element || (a.element == b.element && a.renderElement < b.renderElement);
+	}
+
+	UINT32 GUIBatchUtility::countUnchanged(const Vector<GUIBatchElement>& oldElements,
+		const Vector<GUIBatchElement>& newElements)
+	{
+		auto isBatchingEqual = [](const GUIBatchElement& a, const GUIBatchElement& b)
+		{
+			return a.element == b.element && a.renderElement == b.renderElement && a.widget == b.widget &&
+				a.depth == b.depth && a.mergeHash == b.mergeHash && a.bounds == b.bounds &&
+				a.meshType == b.meshType;
+		};
+
+		UINT32 numUnchanged = 0;
+		UINT32 maxUnchanged = (UINT32)std::min(newElements.size(), oldElements.size());
+		while (numUnchanged < maxUnchanged && isBatchingEqual(newElements[numUnchanged], oldElements[numUnchanged]))
+			numUnchanged++;
+
+		return numUnchanged;
+	}
+
+	void GUIBatchUtility::findReusableGeometry(const Vector<GUIBatchElement>& oldElements,
+		const Vector<GUIBatchElement>& newElements, UINT32 numUnchanged, const Vector<GUIElement*>& updatedElements,
+		Vector<const GUIBatchElement*>& sources, bool (&inPlace)[2])
+	{
+		// Old elements are only searched for past the unchanged range, which is usually empty or short
+		bs_frame_mark();
+		{
+			FrameVector<UINT32> oldElementsByPtr;
+			if(numUnchanged < (UINT32)newElements.size())
+			{
+				oldElementsByPtr.resize(oldElements.size());
+				for(UINT32 i = 0; i < (UINT32)oldElements.size(); i++)
+					oldElementsByPtr[i] = i;
+
+				std::sort(oldElementsByPtr.begin(), oldElementsByPtr.end(), [&oldElements](UINT32 a, UINT32 b)
+				{
+					return compareByElement(oldElements[a], oldElements[b]);
+				});
+			}
+
+			sources.assign(newElements.size(), nullptr);
+			for(UINT32 elemIdx = 0; elemIdx < (UINT32)newElements.size(); elemIdx++)
+			{
+				const GUIBatchElement& elem = newElements[elemIdx];
+				if(std::binary_search(updatedElements.begin(), updatedElements.end(), elem.element))
+					continue;
+
+				const GUIBatchElement* oldElem = nullptr;
+				if(elemIdx < numUnchanged)
+					oldElem = &oldElements[elemIdx];
+				else
+				{
+					auto iterFind = std::lower_bound(oldElementsByPtr.begin(), oldElementsByPtr.end(), elem,
+						[&oldElements](UINT32 a, const GUIBatchElement& b)
+					{
+						return compareByElement(oldElements[a], b);
+					});
+
+					if(iterFind != oldElementsByPtr.end() && oldElements[*iterFind].element == elem.element &&
+						oldElements[*iterFind].renderElement == elem.renderElement)
+					{
+						oldElem = &oldElements[*iterFind];
+					}
+				}
+
+				if(oldElem == nullptr || oldElem->meshType != elem.meshType ||
+					oldElem->numVertices != elem.numVertices || oldElem->numIndices != elem.numIndices)
+				{
+					continue;
+				}
+
+				sources[elemIdx] = oldElem;
+
+				UINT32 typeIdx = (UINT32)elem.meshType;
+				if(oldElem->vertexOffset != elem.vertexOffset || oldElem->indexOffset != elem.indexOffset)
+					inPlace[typeIdx] = false;
+			}
+		}
+		bs_frame_clear();
+	}
+
+	void GUIBatchUtility::mergeRanges(Vector<GUIMeshRange>& ranges)
+	{
+		if(ranges.empty())
+			return;
+
+		std::sort(ranges.begin(), ranges.end(), [](const GUIMeshRange& a, const GUIMeshRange& b)
+		{
+			return a.vertexOffset < b.vertexOffset || (a.vertexOffset == b.vertexOffset && a.indexOffset < b.indexOffset);
+		});
+
+		UINT32 numMerged = 0;
+		for(UINT32 i = 1; i < (UINT32)ranges.size(); i++)
+		{
+			GUIMeshRange& last = ranges[numMerged];
+			const GUIMeshRange& range = ranges[i];
+
+			if(range.vertexOffset == last.vertexOffset + last.numVertices &&
+				range.indexOffset == last.indexOffset + last.numIndices)
+			{
+				last.numVertices += range.numVertices;
+				last.numIndices += range.numIndices;
+			}
+			else
+				ranges[++numMerged] = range;
+		}
+
+		ranges.resize(numMerged + 1);
+	}
+}
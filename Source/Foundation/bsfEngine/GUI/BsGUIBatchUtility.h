@@ -0,0 +1,85 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsPrerequisites.h"
+#include "Math/BsRect2I.h"
+
+namespace bs
+{
+	/** @addtogroup GUI-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Information about how a single render element of a GUI element was batched, along with the properties that
+	 * determined its batch. Used for only rebatching and regenerating the elements that changed since the last update.
+	 */
+	struct GUIBatchElement
+	{
+		GUIElement* element;
+		UINT32 renderElement;
+		GUIWidget* widget;
+		UINT32 depth;
+		UINT64 mergeHash;
+		Rect2I bounds;
+		GUIMeshType meshType;
+
+		UINT32 groupIdx; /**< Index of the group the element was added to, among the groups with the same hash. */
+		UINT32 numVertices;
+		UINT32 numIndices;
+		UINT32 vertexOffset;
+		UINT32 indexOffset;
+	};
+
+	/** Contiguous range of vertices and indices in a GUI mesh. */
+	struct GUIMeshRange
+	{
+		UINT32 vertexOffset;
+		UINT32 numVertices;
+		UINT32 indexOffset;
+		UINT32 numIndices;
+	};
+
+	/** Helper methods used by the GUIManager for reusing batches and geometry between GUI mesh updates. */
+	class BS_EXPORT GUIBatchUtility
+	{
+	public:
+		/**
+		 * Returns the number of leading render elements whose batching properties haven't changed since the last
+		 * update. These elements are guaranteed to end up in the same batches as in the last update.
+		 *
+		 * @param[in]	oldElements		Render elements as batched by the last update, sorted in rendering order.
+		 * @param[in]	newElements		Render elements to batch, sorted in rendering order.
+		 */
+		static UINT32 countUnchanged(const Vector<GUIBatchElement>& oldElements,
+			const Vector<GUIBatchElement>& newElements);
+
+		/**
+		 * Finds the geometry generated for each render element by the last update, if it can be reused.
+		 *
+		 * @param[in]		oldElements			Render elements as batched by the last update.
+		 * @param[in]		newElements			Render elements as batched by the current update, with assigned
+		 *										vertex and index offsets.
+		 * @param[in]		numUnchanged		Number of leading elements, as returned by countUnchanged().
+		 * @param[in]		updatedElements		Sorted list of GUI elements whose contents were updated since the
+		 *										last update. Their geometry can't be reused.
+		 * @param[out]		sources				Receives an entry per new element. The entry is the old element to
+		 *										copy the geometry from, or null if the geometry must be regenerated.
+		 * @param[in, out]	inPlace				Flag per mesh type, which should be true if the mesh buffers keep the
+		 *										same size. Cleared if any reused geometry moved to a new offset, in
+		 *										which case the geometry can't be updated in place.
+		 */
+		static void findReusableGeometry(const Vector<GUIBatchElement>& oldElements,
+			const Vector<GUIBatchElement>& newElements, UINT32 numUnchanged, const Vector<GUIElement*>& updatedElements,
+			Vector<const GUIBatchElement*>& sources, bool (&inPlace)[2]);
+
+		/**
+		 * Sorts the provided ranges by their offset and merges the ranges that are adjacent in both the vertex and the
+		 * index buffer, so they can be written with as few writes as possible.
+		 */
+		static void mergeRanges(Vector<GUIMeshRange>& ranges);
+	};
+
+	/** @} */
+}
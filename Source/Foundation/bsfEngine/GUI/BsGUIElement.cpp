@@ -19,6 +19,7 @@ namespace bs
 
 	void GUIElement::_updateRenderElements()
 	{
+		mFlags &= ~GUIElem_ContentOutdated;
 		updateRenderElementsInternal();
 	}
 
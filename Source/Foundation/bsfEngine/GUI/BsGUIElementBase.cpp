@@ -207,6 +207,18 @@ namespace bs
 
 	void GUIElementBase::_markLayoutAsDirty() 
 	{ 
+		// Parent sizes depend on sizes of their children, so invalidate cached sizes up to the first parent whose sizes
+		// were already invalidated (in which case all of its parents were invalidated as well). This is done even for
+		// hidden elements, as they still take up space in their parent layouts.
+		mFlags |= GUIElem_SizeDirty | GUIElem_ContentOutdated;
+
+		GUIElementBase* parent = mParentElement;
+		while (parent != nullptr && !parent->_isSizeDirty())
+		{
+			parent->mFlags |= GUIElem_SizeDirty;
+			parent = parent->mParentElement;
+		}
+
 		if(!_isVisible())
 			return;
 
@@ -407,8 +419,11 @@ namespace bs
 	{
 		for(auto& child : mChildren)
 		{
-			child->_updateOptimalLayoutSizes();
+			if (child->_isSizeDirty())
+				child->_updateOptimalLayoutSizes();
 		}
+
+		mFlags &= ~(GUIElem_SizeDirty | GUIElem_ChildrenDirty);
 	}
 
 	void GUIElementBase::_updateLayoutInternal(const GUILayoutData& data)
@@ -419,6 +434,32 @@ namespace bs
 		}
 	}
 
+	void GUIElementBase::_setLayoutData(const GUILayoutData& data)
+	{
+		if (data.area != mLayoutData.area || data.clipRect != mLayoutData.clipRect)
+			mFlags |= GUIElem_ContentOutdated;
+
+		if (data.cullClipped && (data.clipRect.width == 0 || data.clipRect.height == 0))
+			mFlags |= GUIElem_Culled;
+		else
+			mFlags &= ~GUIElem_Culled;
+
+		mLayoutData = data;
+	}
+
+	void GUIElementBase::layoutChild(GUIElementBase* child, const GUILayoutData& data)
+	{
+		bool wasCulled = child->_isCulled();
+		child->_setLayoutData(data);
+
+		// All children of an element that remains culled were culled during the last update as well, so they can keep
+		// their current layout until the element comes back into view
+		if (wasCulled && child->_isCulled())
+			return;
+
+		child->_updateLayoutInternal(data);
+	}
+
 	LayoutSizeRange GUIElementBase::_calculateLayoutSizeRange() const
 	{
 		const GUIDimensions& dimensions = _getDimensions();
@@ -465,6 +506,7 @@ namespace bs
 
 		element->_setParent(this);
 		mChildren.push_back(element);
+		mFlags |= GUIElem_ChildrenDirty;
 
 		element->_setActive(_isActive());
 		element->_setVisible(_isVisible());
@@ -484,6 +526,7 @@ namespace bs
 			{
 				mChildren.erase(iter);
 				element->_setParent(nullptr);
+				mFlags |= GUIElem_ChildrenDirty;
 				foundElem = true;
 
 				_markLayoutAsDirty();
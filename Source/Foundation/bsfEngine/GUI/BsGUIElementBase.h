@@ -39,7 +39,11 @@ namespace bs
 			GUIElem_HiddenSelf = 0x08,
 			GUIElem_InactiveSelf = 0x10,
 			GUIElem_Disabled = 0x20,
-			GUIElem_DisabledSelf = 0x40
+			GUIElem_DisabledSelf = 0x40,
+			GUIElem_SizeDirty = 0x80, /**< Optimal sizes of the element or its children need to be recalculated. */
+			GUIElem_ChildrenDirty = 0x100, /**< Child elements were added or removed since last optimal size update. */
+			GUIElem_ContentOutdated = 0x200, /**< Contents need to be rebuilt following the next layout update. */
+			GUIElem_Culled = 0x400 /**< Element is fully clipped within an area that culls clipped elements. */
 		};
 
 	public:
@@ -151,7 +155,10 @@ namespace bs
 		 */
 		virtual void _updateLayout(const GUILayoutData& data);
 
-		/** Calculates optimal sizes of all child elements, as determined by their style and layout options. */
+		/**
+		 * Calculates optimal sizes of all child elements, as determined by their style and layout options. Calculated
+		 * sizes are cached, and only elements whose layout was marked as dirty since the last call are recalculated.
+		 */
 		virtual void _updateOptimalLayoutSizes();
 
 		/** @copydoc _updateLayout */
@@ -172,7 +179,7 @@ namespace bs
 			const Vector<LayoutSizeRange>& sizeRanges, const LayoutSizeRange& mySizeRange) const;
 
 		/** Updates layout data that determines GUI elements final position & depth in the GUI widget. */
-		virtual void _setLayoutData(const GUILayoutData& data) { mLayoutData = data; }
+		virtual void _setLayoutData(const GUILayoutData& data);
 
 		/** Retrieves layout data that determines GUI elements final position & depth in the GUI widget. */
 		const GUILayoutData& _getLayoutData() const { return mLayoutData; }
@@ -295,6 +302,22 @@ namespace bs
 		/**	Marks the element contents to be up to date (meaning it's processed by the GUI system). */
 		void _markAsClean();
 
+		/** Checks if the optimal size of the element or one of its children needs to be recalculated. */
+		bool _isSizeDirty() const { return (mFlags & GUIElem_SizeDirty) != 0; }
+
+		/**
+		 * Checks if the element's contents need to be rebuilt because its layout changed. Such elements will have their
+		 * contents marked as dirty during the next layout update, unless they are culled.
+		 */
+		bool _isContentOutdated() const { return (mFlags & GUIElem_ContentOutdated) != 0; }
+
+		/**
+		 * Checks if the element is fully clipped within an area that culls clipped elements (see
+		 * GUILayoutData::cullClipped). Culled elements don't have their children laid out or their contents rebuilt,
+		 * and aren't rendered.
+		 */
+		bool _isCulled() const { return (mFlags & GUIElem_Culled) != 0; }
+
 		/** @} */
 
 	protected:
@@ -304,6 +327,12 @@ namespace bs
 		/**	Refreshes update parents of all child elements. */
 		void refreshChildUpdateParents();
 
+		/**
+		 * Assigns layout data to a child element and updates the layout of its own children. If the child element is
+		 * culled and was also culled during the last update, its children are left as they are.
+		 */
+		void layoutChild(GUIElementBase* child, const GUILayoutData& data);
+
 		/**
 		 * Finds the first parent element whose size doesn't depend on child sizes.
 		 *			
@@ -334,7 +363,7 @@ namespace bs
 		GUIElementBase* mParentElement = nullptr;
 
 		Vector<GUIElementBase*> mChildren;	
-		UINT8 mFlags = GUIElem_Dirty;
+		UINT16 mFlags = GUIElem_Dirty | GUIElem_SizeDirty | GUIElem_ContentOutdated;
 
 		GUIDimensions mDimensions;
 		GUILayoutData mLayoutData;
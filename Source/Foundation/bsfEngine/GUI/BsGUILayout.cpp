@@ -49,6 +49,7 @@ namespace bs
 
 		element->_setParent(this);
 		mChildren.insert(mChildren.begin() + idx, element);
+		mFlags |= GUIElem_ChildrenDirty;
 		
 		element->_setActive(_isActive());
 		element->_setVisible(_isVisible());
@@ -69,12 +70,41 @@ namespace bs
 
 		GUIElementBase* child = mChildren[idx];
 		mChildren.erase(mChildren.begin() + idx);
+		mFlags |= GUIElem_ChildrenDirty;
 
 		child->_setParent(nullptr);
 
 		_markLayoutAsDirty();
 	}
 
+	bool GUILayout::_getCachedActualSize(UINT32 width, UINT32 height, Vector2I& size) const
+	{
+		for (UINT32 i = 0; i < mNumCachedActualSizes; i++)
+		{
+			const CachedActualSize& entry = mCachedActualSizes[i];
+			if (entry.width == width && entry.height == height)
+			{
+				size = entry.size;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void GUILayout::_setCachedActualSize(UINT32 width, UINT32 height, const Vector2I& size)
+	{
+		// Replace the oldest entry once the cache is full
+		CachedActualSize& entry = mCachedActualSizes[mNextCachedActualSize];
+		entry.width = width;
+		entry.height = height;
+		entry.size = size;
+
+		mNextCachedActualSize = (mNextCachedActualSize + 1) % MAX_CACHED_ACTUAL_SIZES;
+		if (mNumCachedActualSizes < MAX_CACHED_ACTUAL_SIZES)
+			mNumCachedActualSizes++;
+	}
+
 	const RectOffset& GUILayout::_getPadding() const
 	{
 		static RectOffset padding;
@@ -82,6 +82,17 @@ namespace bs
 		/** @copydoc GUIElementBase::_getOptimalSize */
 		Vector2I _getOptimalSize() const override { return mSizeRange.optimal; }
 
+		/**
+		 * Retrieves the actual size of the layout when placed in an area of the provided size, if it was cached since
+		 * the optimal sizes of the layout last changed. See GUILayoutUtility::calcActualSize.
+		 *
+		 * @return	True if the size was found in the cache, false otherwise.
+		 */
+		bool _getCachedActualSize(UINT32 width, UINT32 height, Vector2I& size) const;
+
+		/** Caches the actual size of the layout when placed in an area of the provided size. */
+		void _setCachedActualSize(UINT32 width, UINT32 height, const Vector2I& size);
+
 		/** @copydoc GUIElementBase::_getPadding */
 		const RectOffset& _getPadding() const override;
 
@@ -91,8 +102,29 @@ namespace bs
 		/** @} */
 
 	protected:
+		/** Actual size of the layout when placed in an area of a specific size. */
+		struct CachedActualSize
+		{
+			UINT32 width;
+			UINT32 height;
+			Vector2I size;
+		};
+
+		/**
+		 * Maximum number of cached actual sizes. Scroll areas calculate the size of their layout for a few different
+		 * areas during each update, depending on which scroll bars are shown.
+		 */
+		static constexpr UINT32 MAX_CACHED_ACTUAL_SIZES = 4;
+
+		/** Clears all cached actual sizes. Must be called whenever the optimal sizes of the layout change. */
+		void clearCachedActualSizes() { mNumCachedActualSizes = 0; }
+
 		Vector<LayoutSizeRange> mChildSizeRanges;
 		LayoutSizeRange mSizeRange;
+
+		CachedActualSize mCachedActualSizes[MAX_CACHED_ACTUAL_SIZES];
+		UINT32 mNumCachedActualSizes = 0;
+		UINT32 mNextCachedActualSize = 0;
 	};
 
 	/** @} */
@@ -18,7 +18,7 @@ namespace bs
 	struct BS_EXPORT GUILayoutData
 	{
 		GUILayoutData()
-			:depth(0), depthRangeMin(-1), depthRangeMax(-1)
+			:depth(0), depthRangeMin(-1), depthRangeMax(-1), cullClipped(false)
 		{ 
 			setPanelDepth(0);
 		}
@@ -66,6 +66,13 @@ namespace bs
 		UINT32 depth;
 		UINT16 depthRangeMin;
 		UINT16 depthRangeMax;
+
+		/**
+		 * If true, elements that end up fully outside of the clip rectangle are culled. Children of culled elements
+		 * aren't laid out, and culled elements don't have their contents rebuilt or rendered, until they come back
+		 * into view.
+		 */
+		bool cullClipped;
 	};
 
 	/** @} */
@@ -21,6 +21,10 @@ namespace bs
 
 	Vector2I GUILayoutUtility::calcActualSizeInternal(UINT32 width, UINT32 height, GUILayout* layout)
 	{
+		Vector2I actualSize;
+		if (layout->_getCachedActualSize(width, height, actualSize))
+			return actualSize;
+
 		UINT32 numElements = (UINT32)layout->_getNumChildren();
 		Rect2I* elementAreas = nullptr;
 
@@ -81,11 +85,12 @@ namespace bs
 			max.y = std::max(max.y, childArea.y + (INT32)childArea.height);
 		}
 
-		Vector2I actualSize = max - min;
+		actualSize = max - min;
 
 		if (elementAreas != nullptr)
 			bs_stack_free(elementAreas);
 
+		layout->_setCachedActualSize(width, height, actualSize);
 		return actualSize;
 	}
 }
\ No newline at end of file
@@ -23,7 +23,8 @@ namespace bs
 		static Vector2I calcOptimalSize(const GUIElementBase* elem);
 
 		/**
-		 * Calculates the size of elements in a layout of the specified size.
+		 * Calculates the size of elements in a layout of the specified size. Results are cached per layout until
+		 * optimal sizes of the layout change.
 		 * 
 		 * @param[in]	width				Width of the layout.
 		 * @param[in]	height				Height of the layout.
@@ -46,8 +46,12 @@ namespace bs
 
 	void GUILayoutX::_updateOptimalLayoutSizes()
 	{
-		// Update all children first, otherwise we can't determine our own optimal size
-		GUIElementBase::_updateOptimalLayoutSizes();
+		// Cached sizes remain valid until layout of this element or one of its children is marked as dirty
+		if (!_isSizeDirty())
+			return;
+
+		// Cached child sizes no longer correspond to the children if any were added or removed
+		bool updateAllChildren = (mFlags & GUIElem_ChildrenDirty) != 0 || mChildren.size() != mChildSizeRanges.size();
 
 		if(mChildren.size() != mChildSizeRanges.size())
 			mChildSizeRanges.resize(mChildren.size());
@@ -60,13 +64,21 @@ namespace bs
 		{
 			LayoutSizeRange& childSizeRange = mChildSizeRanges[childIdx];
 
+			// Update the child first, otherwise we can't determine our own optimal size
+			bool childSizeDirty = updateAllChildren || child->_isSizeDirty();
+			if (child->_isSizeDirty())
+				child->_updateOptimalLayoutSizes();
+
 			if (child->_isActive())
 			{
-				childSizeRange = child->_getLayoutSizeRange();
-				if (child->_getType() == GUIElementBase::Type::FixedSpace)
+				if (childSizeDirty)
 				{
-					childSizeRange.optimal.y = 0;
-					childSizeRange.min.y = 0;
+					childSizeRange = child->_getLayoutSizeRange();
+					if (child->_getType() == GUIElementBase::Type::FixedSpace)
+					{
+						childSizeRange.optimal.y = 0;
+						childSizeRange.min.y = 0;
+					}
 				}
 
 				UINT32 paddingX = child->_getPadding().left + child->_getPadding().right;
@@ -87,6 +99,9 @@ namespace bs
 		mSizeRange = _getDimensions().calculateSizeRange(optimalSize);
 		mSizeRange.min.x = std::max(mSizeRange.min.x, minSize.x);
 		mSizeRange.min.y = std::max(mSizeRange.min.y, minSize.y);
+
+		clearCachedActualSizes();
+		mFlags &= ~(GUIElem_SizeDirty | GUIElem_ChildrenDirty);
 	}
 
 	void GUILayoutX::_getElementAreas(const Rect2I& layoutArea, Rect2I* elementAreas, UINT32 numElements,
@@ -413,8 +428,7 @@ namespace bs
 				childData.clipRect = childData.area;
 				childData.clipRect.clip(data.clipRect);
 
-				child->_setLayoutData(childData);
-				child->_updateLayoutInternal(childData);
+				layoutChild(child, childData);
 			}
 
 			childIdx++;
@@ -9,6 +9,9 @@
 #include "Material/BsMaterial.h"
 #include "Mesh/BsMeshData.h"
 #include "RenderAPI/BsVertexDataDesc.h"
+#include "RenderAPI/BsVertexData.h"
+#include "RenderAPI/BsVertexBuffer.h"
+#include "RenderAPI/BsIndexBuffer.h"
 #include "Mesh/BsMesh.h"
 #include "Managers/BsRenderWindowManager.h"
 #include "Platform/BsPlatform.h"
@@ -42,21 +45,9 @@ using namespace std::placeholders;
 
 namespace bs
 {
-	struct GUIGroupElement
-	{
-		GUIGroupElement()
-		{ }
-
-		GUIGroupElement(GUIElement* _element, UINT32 _renderElement)
-			:element(_element), renderElement(_renderElement)
-		{ }
-
-		GUIElement* element;
-		UINT32 renderElement;
-	};
-
 	struct GUIMaterialGroup
 	{
+		UINT32 id;
 		SpriteMaterial* material;
 		SpriteMaterialInfo matInfo;
 		GUIMeshType meshType;
@@ -65,7 +56,7 @@ namespace bs
 		UINT32 depth;
 		UINT32 minDepth;
 		Rect2I bounds;
-		Vector<GUIGroupElement> elements;
+		Vector<UINT32> elements;
 	};
 
 	const UINT32 GUIManager::DRAG_DISTANCE = 3;
@@ -440,6 +431,41 @@ namespace bs
 		{ }
 	}
 
+	/** Geometry to write over parts of an existing GUI mesh. */
+	struct GUIMeshRangeData
+	{
+		Vector<GUIMeshRange> ranges;
+		Vector<UINT8> vertices; /**< Vertices of all the ranges, one range after another. */
+		Vector<UINT32> indices; /**< Indices of all the ranges, one range after another. */
+		UINT32 vertexStride = 0;
+	};
+
+	/** Writes the provided geometry over the matching ranges of the mesh's vertex and index buffers. */
+	static void writeGUIMeshRanges(const SPtr<ct::Mesh>& mesh, const SPtr<GUIMeshRangeData>& data)
+	{
+		SPtr<ct::VertexBuffer> vertexBuffer = mesh->getVertexData()->getBuffer(0);
+		SPtr<ct::IndexBuffer> indexBuffer = mesh->getIndexBuffer();
+
+		const UINT32 vertexStride = data->vertexStride;
+		const UINT8* vertices = data->vertices.data();
+		const UINT32* indices = data->indices.data();
+
+		for(auto& range : data->ranges)
+		{
+			if(range.numVertices > 0)
+			{
+				vertexBuffer->writeData(range.vertexOffset * vertexStride, range.numVertices * vertexStride, vertices);
+				vertices += range.numVertices * vertexStride;
+			}
+
+			if(range.numIndices > 0)
+			{
+				indexBuffer->writeData(range.indexOffset * sizeof(UINT32), range.numIndices * sizeof(UINT32), indices);
+				indices += range.numIndices;
+			}
+		}
+	}
+
 	void GUIManager::updateMeshes()
 	{
 		for(auto& cachedMeshData : mCachedGUIData)
@@ -450,12 +476,11 @@ namespace bs
 			bool isDirty = renderData.isDirty;
 			renderData.isDirty = false;
 
+			mUpdatedElementsTemp.clear();
 			for(auto& widget : renderData.widgets)
 			{
-				if (widget->isDirty(true))
-				{
+				if (widget->_cleanDirty(mUpdatedElementsTemp))
 					isDirty = true;
-				}
 			}
 
 			if(!isDirty)
@@ -463,117 +488,153 @@ namespace bs
 
 			mCoreDirty = true;
 
+			// Only the elements that were updated need their geometry regenerated, the rest can be copied from the
+			// previous update
+			std::sort(mUpdatedElementsTemp.begin(), mUpdatedElementsTemp.end());
+
 			bs_frame_mark();
 			{
-				// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
-				auto elemComp = [](const GUIGroupElement& a, const GUIGroupElement& b)
-				{
-					UINT32 aDepth = a.element->_getRenderElementDepth(a.renderElement);
-					UINT32 bDepth = b.element->_getRenderElementDepth(b.renderElement);
-
-					// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
-					// requires all elements to be unique
-					return (aDepth > bDepth) || 
-						(aDepth == bDepth && a.element > b.element) || 
-						(aDepth == bDepth && a.element == b.element && a.renderElement > b.renderElement); 
-				};
+				SPtr<VertexDataDesc> vertexDesc[2] = { mTriangleVertexDesc, mLineVertexDesc };
 
-				FrameSet<GUIGroupElement, std::function<bool(const GUIGroupElement&, const GUIGroupElement&)>> allElements(elemComp);
+				// Make a list of all render elements, along with the properties that determine how they are batched
+				Vector<GUIBatchElement> batchElements;
+				batchElements.reserve(renderData.batchElements.size());
 
 				for (auto& widget : renderData.widgets)
 				{
+					const Matrix4 worldTfrm = widget->getWorldTfrm();
 					const Vector<GUIElement*>& elements = widget->getElements();
 
 					for (auto& element : elements)
 					{
-						if (!element->_isVisible())
+						if (!element->_isVisible() || element->_isCulled())
 							continue;
 
+						Rect2I tfrmedBounds = element->_getClippedBounds();
+						tfrmedBounds.transform(worldTfrm);
+
 						UINT32 numRenderElems = element->_getNumRenderElements();
 						for (UINT32 i = 0; i < numRenderElems; i++)
 						{
-							allElements.insert(GUIGroupElement(element, i));
+							GUIBatchElement entry;
+							entry.element = element;
+							entry.renderElement = i;
+							entry.widget = widget;
+							entry.depth = element->_getRenderElementDepth(i);
+							entry.bounds = tfrmedBounds;
+							entry.groupIdx = 0;
+							entry.vertexOffset = 0;
+							entry.indexOffset = 0;
+
+							SpriteMaterial* spriteMaterial = nullptr;
+							const SpriteMaterialInfo& matInfo = element->_getMaterial(i, &spriteMaterial);
+							assert(spriteMaterial != nullptr);
+
+							entry.mergeHash = spriteMaterial->getMergeHash(matInfo);
+							element->_getMeshInfo(i, entry.numVertices, entry.numIndices, entry.meshType);
+
+							batchElements.push_back(entry);
 						}
 					}
 				}
 
-				// Group the elements in such a way so that we end up with a smallest amount of
-				// meshes, without breaking back to front rendering order
-				FrameUnorderedMap<UINT64, FrameVector<GUIMaterialGroup>> materialGroups;
-				for (auto& elem : allElements)
+				// Sort from farthest to nearest (highest depth to lowest). Pointers are compared just to differentiate
+				// between elements with the same depth. Their order doesn't really matter, but it needs to stay the
+				// same between updates.
+				std::sort(batchElements.begin(), batchElements.end(), 
+					[](const GUIBatchElement& a, const GUIBatchElement& b)
 				{
-					GUIElement* guiElem = elem.element;
-					UINT32 renderElemIdx = elem.renderElement;
-					UINT32 elemDepth = guiElem->_getRenderElementDepth(renderElemIdx);
+					if (a.depth != b.depth)
+						return a.depth > b.depth;
+
+					if (a.element != b.element)
+						return a.element > b.element;
+
+					return a.renderElement > b.renderElement;
+				});
+
+				// Group the elements in such a way so that we end up with a smallest amount of meshes, without breaking
+				// back to front rendering order. Group an element ends up in only depends on elements before it, so
+				// elements before the first one whose batching properties changed since the last update are guaranteed
+				// to end up in the same groups as before, and the group search can be skipped for them.
+				const Vector<GUIBatchElement>& oldElements = renderData.batchElements;
+				const UINT32 numUnchanged = GUIBatchUtility::countUnchanged(oldElements, batchElements);
 
-					Rect2I tfrmedBounds = guiElem->_getClippedBounds();
-					tfrmedBounds.transform(guiElem->_getParentWidget()->getWorldTfrm());
+				FrameUnorderedMap<UINT64, FrameVector<GUIMaterialGroup>> materialGroups;
+				UINT32 numGroups = 0;
+				for (UINT32 elemIdx = 0; elemIdx < (UINT32)batchElements.size(); elemIdx++)
+				{
+					GUIBatchElement& elem = batchElements[elemIdx];
 
 					SpriteMaterial* spriteMaterial = nullptr;
-					const SpriteMaterialInfo& matInfo = guiElem->_getMaterial(renderElemIdx, &spriteMaterial);
-					assert(spriteMaterial != nullptr);
-
-					UINT64 hash = spriteMaterial->getMergeHash(matInfo);
-					FrameVector<GUIMaterialGroup>& groupsPerMaterial = materialGroups[hash];
-					
-					// Try to find a group this material will fit in:
-					//  - Group that has a depth value same or one below elements depth will always be a match
-					//  - Otherwise, we search higher depth values as well, but we only use them if no elements in between those depth values
-					//    overlap the current elements bounds.
+					const SpriteMaterialInfo& matInfo = elem.element->_getMaterial(elem.renderElement, &spriteMaterial);
+
+					FrameVector<GUIMaterialGroup>& groupsPerMaterial = materialGroups[elem.mergeHash];
 					GUIMaterialGroup* foundGroup = nullptr;
 
-					for (auto groupIter = groupsPerMaterial.rbegin(); groupIter != groupsPerMaterial.rend(); ++groupIter)
+					if (elemIdx < numUnchanged)
 					{
-						// If we separate meshes by widget, ignore any groups with widget parents other than mine
-						if (mSeparateMeshesByWidget)
+						UINT32 groupIdx = oldElements[elemIdx].groupIdx;
+						if (groupIdx < (UINT32)groupsPerMaterial.size())
+							foundGroup = &groupsPerMaterial[groupIdx];
+					}
+					else
+					{
+						// Try to find a group this material will fit in:
+						//  - Group that has a depth value same or one below elements depth will always be a match
+						//  - Otherwise, we search higher depth values as well, but we only use them if no elements in
+						//    between those depth values overlap the current elements bounds.
+						for (auto groupIter = groupsPerMaterial.rbegin(); groupIter != groupsPerMaterial.rend();
+							++groupIter)
 						{
-							if (groupIter->elements.size() > 0)
+							GUIMaterialGroup& group = *groupIter;
+
+							// If we separate meshes by widget, ignore any groups with widget parents other than mine
+							if (mSeparateMeshesByWidget)
 							{
-								GUIElement* otherElem = groupIter->elements.begin()->element; // We only need to check the first element
-								if (otherElem->_getParentWidget() != guiElem->_getParentWidget())
+								// We only need to check the first element
+								if (group.elements.size() > 0 && batchElements[group.elements[0]].widget != elem.widget)
 									continue;
 							}
-						}
-
-						GUIMaterialGroup& group = *groupIter;
 
-						if (group.depth == elemDepth)
-						{
-							foundGroup = &group;
-							break;
-						}
-						else
-						{
-							UINT32 startDepth = elemDepth;
-							UINT32 endDepth = group.depth;
+							if (group.depth == elem.depth)
+							{
+								foundGroup = &group;
+								break;
+							}
+							else
+							{
+								UINT32 startDepth = elem.depth;
+								UINT32 endDepth = group.depth;
 
-							Rect2I potentialGroupBounds = group.bounds;
-							potentialGroupBounds.encapsulate(tfrmedBounds);
+								Rect2I potentialGroupBounds = group.bounds;
+								potentialGroupBounds.encapsulate(elem.bounds);
 
-							bool foundOverlap = false;
-							for (auto& material : materialGroups)
-							{
-								for (auto& matGroup : material.second)
+								bool foundOverlap = false;
+								for (auto& material : materialGroups)
 								{
-									if (&matGroup == &group)
-										continue;
-
-									if ((matGroup.minDepth >= startDepth && matGroup.minDepth <= endDepth)
-										|| (matGroup.depth >= startDepth && matGroup.depth <= endDepth))
+									for (auto& matGroup : material.second)
 									{
-										if (matGroup.bounds.overlaps(potentialGroupBounds))
+										if (&matGroup == &group)
+											continue;
+
+										if ((matGroup.minDepth >= startDepth && matGroup.minDepth <= endDepth)
+											|| (matGroup.depth >= startDepth && matGroup.depth <= endDepth))
 										{
-											foundOverlap = true;
-											break;
+											if (matGroup.bounds.overlaps(potentialGroupBounds))
+											{
+												foundOverlap = true;
+												break;
+											}
 										}
 									}
 								}
-							}
 
-							if (!foundOverlap)
-							{
-								foundGroup = &group;
-								break;
+								if (!foundOverlap)
+								{
+									foundGroup = &group;
+									break;
+								}
 							}
 						}
 					}
@@ -583,144 +644,228 @@ namespace bs
 						groupsPerMaterial.push_back(GUIMaterialGroup());
 						foundGroup = &groupsPerMaterial[groupsPerMaterial.size() - 1];
 
-						foundGroup->depth = elemDepth;
-						foundGroup->minDepth = elemDepth;
-						foundGroup->bounds = tfrmedBounds;
-						foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
+						foundGroup->id = numGroups++;
+						foundGroup->depth = elem.depth;
+						foundGroup->minDepth = elem.depth;
+						foundGroup->bounds = elem.bounds;
+						foundGroup->elements.push_back(elemIdx);
 						foundGroup->matInfo = matInfo.clone();
 						foundGroup->material = spriteMaterial;
-
-						guiElem->_getMeshInfo(renderElemIdx, foundGroup->numVertices, foundGroup->numIndices, foundGroup->meshType);
+						foundGroup->meshType = elem.meshType;
+						foundGroup->numVertices = elem.numVertices;
+						foundGroup->numIndices = elem.numIndices;
 					}
 					else
 					{
-						foundGroup->bounds.encapsulate(tfrmedBounds);
-						foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
-						foundGroup->minDepth = std::min(foundGroup->minDepth, elemDepth);
-						
-						UINT32 numVertices;
-						UINT32 numIndices;
-						GUIMeshType meshType;
-						guiElem->_getMeshInfo(renderElemIdx, numVertices, numIndices, meshType);
-						assert(meshType == foundGroup->meshType); // It's expected that GUI element doesn't use same material for different mesh types so this should always be true
-
-						foundGroup->numVertices += numVertices;
-						foundGroup->numIndices += numIndices;
+						// It's expected that GUI element doesn't use same material for different mesh types so this
+						// should always be true
+						assert(elem.meshType == foundGroup->meshType);
+
+						foundGroup->bounds.encapsulate(elem.bounds);
+						foundGroup->elements.push_back(elemIdx);
+						foundGroup->minDepth = std::min(foundGroup->minDepth, elem.depth);
+						foundGroup->numVertices += elem.numVertices;
+						foundGroup->numIndices += elem.numIndices;
 
 						spriteMaterial->merge(foundGroup->matInfo, matInfo);
 					}
-				}
 
-				// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
-				auto groupComp = [](GUIMaterialGroup* a, GUIMaterialGroup* b)
-				{
-					return (a->depth > b->depth) || (a->depth == b->depth && a > b);
-					// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
-					// requires all elements to be unique
-				};
+					elem.groupIdx = (UINT32)(foundGroup - groupsPerMaterial.data());
+				}
 
-				UINT32 numMeshes = 0;
+				// Sort the groups from farthest to nearest (highest depth to lowest)
 				UINT32 numIndices[2] = { 0, 0 };
 				UINT32 numVertices[2] = { 0, 0 };
 
-				FrameSet<GUIMaterialGroup*, std::function<bool(GUIMaterialGroup*, GUIMaterialGroup*)>> sortedGroups(groupComp);
+				FrameVector<GUIMaterialGroup*> sortedGroups;
+				sortedGroups.reserve(numGroups);
+
 				for(auto& material : materialGroups)
 				{
 					for(auto& group : material.second)
 					{
-						sortedGroups.insert(&group);
+						sortedGroups.push_back(&group);
 
 						UINT32 typeIdx = (UINT32)group.meshType;
 						numIndices[typeIdx] += group.numIndices;
 						numVertices[typeIdx] += group.numVertices;
-
-						numMeshes++;
 					}
 				}
 
-				renderData.triangleMesh = nullptr;
-				renderData.lineMesh = nullptr;
+				std::sort(sortedGroups.begin(), sortedGroups.end(), [](GUIMaterialGroup* a, GUIMaterialGroup* b)
+				{
+					return (a->depth > b->depth) || (a->depth == b->depth && a->id < b->id);
+				});
 
-				renderData.cachedMeshes.resize(numMeshes);
+				// Assign each element a range in the vertex and index buffers, in the order the groups are rendered in
+				renderData.cachedMeshes.resize(sortedGroups.size());
 
-				SPtr<MeshData> meshData[2];
-				SPtr<VertexDataDesc> vertexDesc[2] = { mTriangleVertexDesc, mLineVertexDesc };
-
-				UINT8* vertices[2] = { nullptr, nullptr };
-				UINT32* indices[2] = { nullptr, nullptr };
+				UINT32 vertexOffset[2] = { 0, 0 };
+				UINT32 indexOffset[2] = { 0, 0 };
 
-				for(UINT32 i = 0; i < 2; i++)
+				for(UINT32 groupIdx = 0; groupIdx < (UINT32)sortedGroups.size(); groupIdx++)
 				{
-					if(numVertices[i] > 0 && numIndices[i] > 0)
+					GUIMaterialGroup* group = sortedGroups[groupIdx];
+					UINT32 typeIdx = (UINT32)group->meshType;
+
+					GUIMeshData& guiMeshData = renderData.cachedMeshes[groupIdx];
+					guiMeshData.matInfo = group->matInfo;
+					guiMeshData.material = group->material;
+					guiMeshData.widget = batchElements[group->elements[0]].widget;
+					guiMeshData.isLine = group->meshType == GUIMeshType::Line;
+					guiMeshData.indexOffset = indexOffset[typeIdx];
+					guiMeshData.indexCount = group->numIndices;
+
+					for(auto& elemIdx : group->elements)
 					{
-						meshData[i] = MeshData::create(numVertices[i], numIndices[i], vertexDesc[i]);
+						GUIBatchElement& elem = batchElements[elemIdx];
+						elem.vertexOffset = vertexOffset[typeIdx];
+						elem.indexOffset = indexOffset[typeIdx];
 
-						vertices[i] = meshData[i]->getElementData(VES_POSITION);
-						indices[i] = meshData[i]->getIndices32();
+						vertexOffset[typeIdx] += elem.numVertices;
+						indexOffset[typeIdx] += elem.numIndices;
 					}
 				}
 
-				// Fill buffers for each group and update their meshes
-				UINT32 meshIdx = 0;
-				UINT32 vertexOffset[2] = { 0, 0 };
-				UINT32 indexOffset[2] = { 0, 0 };
-
-				for(auto& group : sortedGroups)
+				// Find the previous geometry of each render element, unless the element was updated
+				bool inPlace[2];
+				for(UINT32 i = 0; i < 2; i++)
 				{
-					GUIWidget* widget;
+					inPlace[i] = renderData.vertices[i].size() == numVertices[i] * vertexDesc[i]->getVertexStride(0) &&
+						renderData.indices[i].size() == numIndices[i];
+				}
+
+				Vector<const GUIBatchElement*>& sources = mBatchSourcesTemp;
+				GUIBatchUtility::findReusableGeometry(oldElements, batchElements, numUnchanged, mUpdatedElementsTemp,
+					sources, inPlace);
+
+				// Geometry of the render elements that stayed in the same place doesn't need to be touched, otherwise
+				// generate new buffers, copying over any unchanged geometry
+				Vector<UINT8> newVertices[2];
+				Vector<UINT32> newIndices[2];
+				UINT8* vertices[2];
+				UINT32* indices[2];
 
-					if (group->elements.size() == 0)
-						widget = nullptr;
+				for(UINT32 i = 0; i < 2; i++)
+				{
+					if(inPlace[i])
+					{
+						vertices[i] = renderData.vertices[i].data();
+						indices[i] = renderData.indices[i].data();
+					}
 					else
 					{
-						GUIElement* elem = group->elements.begin()->element;
-						widget = elem->_getParentWidget();
+						newVertices[i].resize(numVertices[i] * vertexDesc[i]->getVertexStride(0));
+						newIndices[i].resize(numIndices[i]);
+
+						vertices[i] = newVertices[i].data();
+						indices[i] = newIndices[i].data();
 					}
+				}
 
-					GUIMeshData& guiMeshData = renderData.cachedMeshes[meshIdx];
-					guiMeshData.matInfo = group->matInfo;
-					guiMeshData.material = group->material;
-					guiMeshData.widget = widget;
-					guiMeshData.isLine = group->meshType == GUIMeshType::Line;
+				// When updating in place, only the regenerated ranges need to be written to the existing meshes
+				for(UINT32 i = 0; i < 2; i++)
+					mDirtyRangesTemp[i].clear();
 
-					UINT32 typeIdx = (UINT32)group->meshType;
-					guiMeshData.indexOffset = indexOffset[typeIdx];
+				for(UINT32 elemIdx = 0; elemIdx < (UINT32)batchElements.size(); elemIdx++)
+				{
+					const GUIBatchElement& elem = batchElements[elemIdx];
+					const GUIBatchElement* oldElem = sources[elemIdx];
+					UINT32 typeIdx = (UINT32)elem.meshType;
 
-					UINT32 groupNumIndices = 0;
-					for(auto& matElement : group->elements)
+					if(oldElem == nullptr)
 					{
-						matElement.element->_fillBuffer(
+						elem.element->_fillBuffer(
 							vertices[typeIdx], indices[typeIdx], 
-							vertexOffset[typeIdx], indexOffset[typeIdx], 
-							numVertices[typeIdx], numIndices[typeIdx], matElement.renderElement);
-
-						UINT32 elemNumVertices;
-						UINT32 elemNumIndices;
-						GUIMeshType meshType;
-						matElement.element->_getMeshInfo(matElement.renderElement, elemNumVertices, elemNumIndices, meshType);
+							elem.vertexOffset, elem.indexOffset, 
+							numVertices[typeIdx], numIndices[typeIdx], elem.renderElement);
 
-						UINT32 indexStart = indexOffset[typeIdx];
-						UINT32 indexEnd = indexStart + elemNumIndices;
+						UINT32 indexStart = elem.indexOffset;
+						UINT32 indexEnd = indexStart + elem.numIndices;
 
 						for(UINT32 i = indexStart; i < indexEnd; i++)
-							indices[typeIdx][i] += vertexOffset[typeIdx];
-
-						indexOffset[typeIdx] += elemNumIndices;
-						vertexOffset[typeIdx] += elemNumVertices;
+							indices[typeIdx][i] += elem.vertexOffset;
 
-						groupNumIndices += elemNumIndices;
+						if(inPlace[typeIdx])
+						{
+							mDirtyRangesTemp[typeIdx].push_back(
+								{ elem.vertexOffset, elem.numVertices, elem.indexOffset, elem.numIndices });
+						}
 					}
+					else if(!inPlace[typeIdx])
+					{
+						UINT32 vertexStride = vertexDesc[typeIdx]->getVertexStride(0);
+						memcpy(vertices[typeIdx] + elem.vertexOffset * vertexStride, 
+							renderData.vertices[typeIdx].data() + oldElem->vertexOffset * vertexStride, 
+							elem.numVertices * vertexStride);
 
-					guiMeshData.indexCount = groupNumIndices;
+						const UINT32* srcIndices = renderData.indices[typeIdx].data() + oldElem->indexOffset;
+						UINT32* dstIndices = indices[typeIdx] + elem.indexOffset;
 
-					meshIdx++;
+						for(UINT32 i = 0; i < elem.numIndices; i++)
+							dstIndices[i] = srcIndices[i] - oldElem->vertexOffset + elem.vertexOffset;
+					}
 				}
 
-				if(meshData[0])
-					renderData.triangleMesh = Mesh::_createPtr(meshData[0], MU_STATIC, DOT_TRIANGLE_LIST);
+				for(UINT32 i = 0; i < 2; i++)
+				{
+					if(!inPlace[i])
+					{
+						renderData.vertices[i].swap(newVertices[i]);
+						renderData.indices[i].swap(newIndices[i]);
+					}
+				}
+
+				renderData.batchElements.swap(batchElements);
 
-				if(meshData[1])
-					renderData.lineMesh = Mesh::_createPtr(meshData[1], MU_STATIC, DOT_LINE_LIST);
+				// Recreate the meshes whose layout changed, otherwise only write the regenerated geometry
+				SPtr<Mesh>* meshes[2] = { &renderData.triangleMesh, &renderData.lineMesh };
+				DrawOperationType drawOps[2] = { DOT_TRIANGLE_LIST, DOT_LINE_LIST };
+
+				for(UINT32 i = 0; i < 2; i++)
+				{
+					if(numVertices[i] == 0 || numIndices[i] == 0)
+					{
+						*meshes[i] = nullptr;
+						continue;
+					}
+
+					if(inPlace[i] && *meshes[i] != nullptr)
+					{
+						Vector<GUIMeshRange>& ranges = mDirtyRangesTemp[i];
+						if(ranges.empty())
+							continue;
+
+						GUIBatchUtility::mergeRanges(ranges);
+
+						const UINT32 vertexStride = vertexDesc[i]->getVertexStride(0);
+						SPtr<GUIMeshRangeData> rangeData = bs_shared_ptr_new<GUIMeshRangeData>();
+						rangeData->ranges = ranges;
+						rangeData->vertexStride = vertexStride;
+
+						for(auto& range : ranges)
+						{
+							const UINT8* rangeVertices = renderData.vertices[i].data() + 
+								range.vertexOffset * vertexStride;
+							rangeData->vertices.insert(rangeData->vertices.end(), rangeVertices,
+								rangeVertices + range.numVertices * vertexStride);
+
+							const UINT32* rangeIndices = renderData.indices[i].data() + range.indexOffset;
+							rangeData->indices.insert(rangeData->indices.end(), rangeIndices,
+								rangeIndices + range.numIndices);
+						}
+
+						gCoreThread().queueCommand(std::bind(&writeGUIMeshRanges, (*meshes[i])->getCore(), rangeData));
+						continue;
+					}
+
+					SPtr<MeshData> meshData = MeshData::create(numVertices[i], numIndices[i], vertexDesc[i]);
+					memcpy(meshData->getStreamData(0), renderData.vertices[i].data(), renderData.vertices[i].size());
+					memcpy(meshData->getIndices32(), renderData.indices[i].data(), numIndices[i] * sizeof(UINT32));
+
+					// Dynamic, as parts of the mesh get rewritten whenever only some of the elements change
+					*meshes[i] = Mesh::_createPtr(meshData, MU_DYNAMIC, drawOps[i]);
+				}
 			}
 
 			bs_frame_clear();			
@@ -16,6 +16,7 @@
 #include "Material/BsMaterialParam.h"
 #include "Renderer/BsParamBlocks.h"
 #include "RenderAPI/BsSubMesh.h"
+#include "GUI/BsGUIBatchUtility.h"
 
 namespace bs
 {
@@ -72,6 +73,13 @@ namespace bs
 			Vector<GUIMeshData> cachedMeshes;
 			Vector<GUIWidget*> widgets;
 			bool isDirty;
+
+			/** Render elements of all widgets as of the last mesh update, sorted from farthest to nearest. */
+			Vector<GUIBatchElement> batchElements;
+
+			/** Vertices and indices of the last mesh update, for triangle and line meshes respectively. */
+			Vector<UINT8> vertices[2];
+			Vector<UINT32> indices[2];
 		};
 
 		/**	Render data for a single GUI group used for notifying the core GUI renderer. */
@@ -241,7 +249,10 @@ namespace bs
 	private:
 		friend class ct::GUIRenderer;
 
-		/**	Recreates all dirty GUI meshes and makes them ready for rendering. */
+		/**
+		 * Recreates all dirty GUI meshes and makes them ready for rendering. Only the render elements that changed
+		 * since the last update are rebatched and have their geometry regenerated.
+		 */
 		void updateMeshes();
 
 		/**	Recreates the input caret texture. */
@@ -366,6 +377,9 @@ namespace bs
 
 		Vector<WidgetInfo> mWidgets;
 		UnorderedMap<const Viewport*, GUIRenderData> mCachedGUIData;
+		Vector<GUIElement*> mUpdatedElementsTemp;
+		Vector<const GUIBatchElement*> mBatchSourcesTemp;
+		Vector<GUIMeshRange> mDirtyRangesTemp[2];
 
 		SPtr<ct::GUIRenderer> mRenderer;
 		bool mCoreDirty;
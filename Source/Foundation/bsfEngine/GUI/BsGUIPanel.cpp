@@ -82,8 +82,12 @@ namespace bs
 
 	void GUIPanel::_updateOptimalLayoutSizes()
 	{
-		// Update all children first, otherwise we can't determine our own optimal size
-		GUIElementBase::_updateOptimalLayoutSizes();
+		// Cached sizes remain valid until layout of this element or one of its children is marked as dirty
+		if (!_isSizeDirty())
+			return;
+
+		// Cached child sizes no longer correspond to the children if any were added or removed
+		bool updateAllChildren = (mFlags & GUIElem_ChildrenDirty) != 0 || mChildren.size() != mChildSizeRanges.size();
 
 		if (mChildren.size() != mChildSizeRanges.size())
 			mChildSizeRanges.resize(mChildren.size());
@@ -96,9 +100,15 @@ namespace bs
 		{
 			LayoutSizeRange& childSizeRange = mChildSizeRanges[childIdx];
 
+			// Update the child first, otherwise we can't determine our own optimal size
+			bool childSizeDirty = updateAllChildren || child->_isSizeDirty();
+			if (child->_isSizeDirty())
+				child->_updateOptimalLayoutSizes();
+
 			if (child->_isActive())
 			{
-				childSizeRange = _getElementSizeRange(child);
+				if (childSizeDirty)
+					childSizeRange = _getElementSizeRange(child);
 
 				UINT32 paddingX = child->_getPadding().left + child->_getPadding().right;
 				UINT32 paddingY = child->_getPadding().top + child->_getPadding().bottom;
@@ -125,6 +135,9 @@ namespace bs
 		mSizeRange = _getDimensions().calculateSizeRange(optimalSize);
 		mSizeRange.min.x = std::max(mSizeRange.min.x, minSize.x);
 		mSizeRange.min.y = std::max(mSizeRange.min.y, minSize.y);
+
+		clearCachedActualSizes();
+		mFlags &= ~(GUIElem_SizeDirty | GUIElem_ChildrenDirty);
 	}
 
 	void GUIPanel::_getElementAreas(const Rect2I& layoutArea, Rect2I* elementAreas, UINT32 numElements,
@@ -258,8 +271,7 @@ namespace bs
 		childData.clipRect = data.area;
 		childData.clipRect.clip(data.clipRect);
 
-		element->_setLayoutData(childData);
-		element->_updateLayoutInternal(childData);
+		layoutChild(element, childData);
 	}
 
 	GUIPanel* GUIPanel::create(INT16 depth, UINT16 depthRangeMin, UINT16 depthRangeMax)
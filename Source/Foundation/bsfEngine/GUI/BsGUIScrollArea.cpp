@@ -20,7 +20,7 @@ namespace bs
 		const String& scrollBarStyle, const String& scrollAreaStyle, const GUIDimensions& dimensions)
 		: GUIElementContainer(dimensions), mVertBarType(vertBarType), mHorzBarType(horzBarType)
 		, mScrollBarStyle(scrollBarStyle), mVertScroll(nullptr), mHorzScroll(nullptr), mVertOffset(0), mHorzOffset(0)
-		, mRecalculateVertOffset(false), mRecalculateHorzOffset(false)
+		, mRecalculateVertOffset(false), mRecalculateHorzOffset(false), mCullClipped(false)
 	{
 		mContentLayout = GUILayoutY::create();
 		_registerChildElement(mContentLayout);
@@ -77,6 +77,10 @@ namespace bs
 
 	void GUIScrollArea::_updateOptimalLayoutSizes()
 	{
+		// Cached sizes remain valid until layout of this element or one of its children is marked as dirty
+		if (!_isSizeDirty())
+			return;
+
 		// Update all children first, otherwise we can't determine our own optimal size
 		GUIElementBase::_updateOptimalLayoutSizes();
 
@@ -303,6 +307,7 @@ namespace bs
 			GUILayoutData layoutData = data;
 			layoutData.area = layoutBounds;
 			layoutData.clipRect = layoutClipRect;
+			layoutData.cullClipped = mCullClipped;
 
 			mContentLayout->_setLayoutData(layoutData);
 			mContentLayout->_updateLayoutInternal(layoutData);
@@ -417,6 +422,15 @@ namespace bs
 		return bounds;
 	}
 
+	void GUIScrollArea::setCullClippedElements(bool cull)
+	{
+		if (mCullClipped == cull)
+			return;
+
+		mCullClipped = cull;
+		_markLayoutAsDirty();
+	}
+
 	void GUIScrollArea::scrollUpPx(UINT32 pixels)
 	{
 		if(mVertScroll != nullptr)
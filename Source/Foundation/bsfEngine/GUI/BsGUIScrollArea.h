@@ -128,6 +128,17 @@ namespace bs
 		 */
 		Rect2I getContentBounds();
 
+		/**
+		 * Determines should elements that are scrolled fully out of view be culled. Culled elements don't have their
+		 * children laid out and their contents rebuilt, and aren't rendered until they are scrolled back into view.
+		 * This significantly speeds up updates of scroll areas with many elements, but bounds reported by culled
+		 * elements and their children will not be up to date. Disabled by default.
+		 */
+		void setCullClippedElements(bool cull);
+
+		/** @copydoc setCullClippedElements */
+		bool getCullClippedElements() const { return mCullClipped; }
+
 		/**
 		 * Number of pixels the scroll bar will occupy when active. This is width for vertical scrollbar, and height for
 		 * horizontal scrollbar.
@@ -207,6 +218,7 @@ namespace bs
 		float mHorzOffset;
 		bool mRecalculateVertOffset;
 		bool mRecalculateHorzOffset;
+		bool mCullClipped;
 
 		Vector2I mVisibleSize;
 		Vector2I mContentSize;
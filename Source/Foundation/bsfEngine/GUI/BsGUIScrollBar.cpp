@@ -211,12 +211,22 @@ namespace bs
 
 	void GUIScrollBar::_setHandleSize(float pct)
 	{
+		float oldHandleSize = mHandleBtn->_getHandleSizePct();
 		mHandleBtn->_setHandleSize(pct);
+
+		// Called during layout update, which only rebuilds contents of elements whose layout changed
+		if (oldHandleSize != mHandleBtn->_getHandleSizePct())
+			mHandleBtn->_markContentAsDirty();
 	}
 
 	void GUIScrollBar::_setScrollPos(float pct)
 	{
+		float oldHandlePos = mHandleBtn->getHandlePos();
 		mHandleBtn->_setHandlePos(pct);
+
+		// Called during layout update, which only rebuilds contents of elements whose layout changed
+		if (oldHandlePos != mHandleBtn->getHandlePos())
+			mHandleBtn->_markContentAsDirty();
 	}
 
 	float GUIScrollBar::getScrollPos() const
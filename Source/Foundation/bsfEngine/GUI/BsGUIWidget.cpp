@@ -17,6 +17,7 @@ namespace bs
 	GUIWidget::GUIWidget(const SPtr<Camera>& camera)
 		: mCamera(camera), mPanel(nullptr), mDepth(128), mIsActive(true), mPosition(BsZero), mRotation(BsIdentity)
 		, mScale(Vector3::ONE), mTransform(BsIdentity), mCachedRTId(0), mWidgetIsDirty(false)
+		, mHasUnreportedChanges(false)
 	{
 		construct(camera);
 	}
@@ -24,6 +25,7 @@ namespace bs
 	GUIWidget::GUIWidget(const HCamera& camera)
 		: mCamera(camera->_getCamera()), mPanel(nullptr), mDepth(128), mIsActive(true), mPosition(BsZero)
 		, mRotation(BsIdentity), mScale(Vector3::ONE), mTransform(BsIdentity), mCachedRTId(0), mWidgetIsDirty(false)
+		, mHasUnreportedChanges(false)
 	{
 		construct(mCamera);
 	}
@@ -83,6 +85,7 @@ namespace bs
 
 		mElements.clear();
 		mDirtyContents.clear();
+		mUnreportedElements.clear();
 	}
 
 	void GUIWidget::setDepth(UINT8 depth)
@@ -209,8 +212,9 @@ namespace bs
 		{
 			GUIPanel* panel = static_cast<GUIPanel*>(updateParent);
 
+			// Updates the optimal size of the dirty element, as well as the size cached by the panel
 			GUIElementBase* dirtyElement = elem;
-			dirtyElement->_updateOptimalLayoutSizes();
+			panel->_updateOptimalLayoutSizes();
 
 			LayoutSizeRange elementSizeRange = panel->_getElementSizeRange(dirtyElement);
 			Rect2I elementArea = panel->_getElementArea(panel->_getLayoutData().area, dirtyElement, elementSizeRange);
@@ -227,7 +231,8 @@ namespace bs
 			updateParent->_updateLayout(childLayoutData);
 		}
 		
-		// Mark dirty contents
+		// Mark dirty contents. Only elements whose layout changed need to be rebuilt, while culled elements are rebuilt
+		// once they are no longer culled.
 		bs_frame_mark();
 		{
 			FrameStack<GUIElementBase*> todo;
@@ -238,8 +243,11 @@ namespace bs
 				GUIElementBase* currentElem = todo.top();
 				todo.pop();
 
-				if (currentElem->_getType() == GUIElementBase::Type::Element)
+				if (currentElem->_getType() == GUIElementBase::Type::Element && currentElem->_isContentOutdated() &&
+					!currentElem->_isCulled())
+				{
 					mDirtyContents.insert(static_cast<GUIElement*>(currentElem));
+				}
 
 				currentElem->_markAsClean();
 
@@ -275,7 +283,12 @@ namespace bs
 		}
 
 		if (elem->_getType() == GUIElementBase::Type::Element)
+		{
 			mDirtyContents.erase(static_cast<GUIElement*>(elem));
+
+			auto iterRemove = std::remove(mUnreportedElements.begin(), mUnreportedElements.end(), elem);
+			mUnreportedElements.erase(iterRemove, mUnreportedElements.end());
+		}
 	}
 
 	void GUIWidget::_markMeshDirty(GUIElementBase* elem)
@@ -345,24 +358,51 @@ namespace bs
 		const bool dirty = mWidgetIsDirty || !mDirtyContents.empty();
 
 		if(cleanIfDirty && dirty)
-		{
-			mWidgetIsDirty = false;
+			clean();
+		
+		return dirty;
+	}
 
-			// Update render contents recursively because updates can cause child GUI elements to become dirty
-			while(!mDirtyContents.empty())
-			{
-				mDirtyContentsTemp.swap(mDirtyContents);
+	bool GUIWidget::_cleanDirty(Vector<GUIElement*>& updatedElements)
+	{
+		if (!mIsActive)
+			return false;
 
-				for (auto& dirtyElement : mDirtyContentsTemp)
-					dirtyElement->_updateRenderElements();
+		if(mWidgetIsDirty || !mDirtyContents.empty())
+			clean();
 
-				mDirtyContentsTemp.clear();
+		// Report changes cleaned by isDirty(true) as well, otherwise their old geometry would get reused
+		if(!mHasUnreportedChanges)
+			return false;
+
+		updatedElements.insert(updatedElements.end(), mUnreportedElements.begin(), mUnreportedElements.end());
+
+		mUnreportedElements.clear();
+		mHasUnreportedChanges = false;
+
+		return true;
+	}
+
+	void GUIWidget::clean()
+	{
+		mWidgetIsDirty = false;
+		mHasUnreportedChanges = true;
+
+		// Update render contents recursively because updates can cause child GUI elements to become dirty
+		while(!mDirtyContents.empty())
+		{
+			mDirtyContentsTemp.swap(mDirtyContents);
+
+			for (auto& dirtyElement : mDirtyContentsTemp)
+			{
+				dirtyElement->_updateRenderElements();
+				mUnreportedElements.push_back(dirtyElement);
 			}
 
-			updateBounds();
+			mDirtyContentsTemp.clear();
 		}
-		
-		return dirty;
+
+		updateBounds();
 	}
 
 	bool GUIWidget::inBounds(const Vector2I& position) const
@@ -64,6 +64,8 @@ namespace bs
 		 * Return true if widget or any of its elements are dirty.
 		 *
 		 * @param[in]	cleanIfDirty	If true, all dirty elements will be updated and widget will be marked as clean.
+		 *								The updated elements are still reported by the next _cleanDirty() call, so
+		 *								their geometry gets rebuilt.
 		 * @return						True if dirty, false if not. If "cleanIfDirty" is true, the returned state is the 
 		 *								one before cleaning.
 		 */
@@ -133,6 +135,17 @@ namespace bs
 		 */
 		void _markContentDirty(GUIElementBase* elem);
 
+		/**
+		 * Updates all dirty elements and marks the widget as clean, same as isDirty(true). Additionally reports which
+		 * elements were updated since the last call, including any updated by isDirty(true), so their render elements
+		 * can be rebuilt without rebuilding the rest of the widget.
+		 *
+		 * @param[out]	updatedElements		List to append the elements whose contents were updated to. Same
+		 *									element might be appended more than once.
+		 * @return							True if the widget changed since the last call.
+		 */
+		bool _cleanDirty(Vector<GUIElement*>& updatedElements);
+
 		/**	Updates the layout of all child elements, repositioning and resizing them as needed. */
 		void _updateLayout();
 
@@ -182,6 +195,12 @@ namespace bs
 		/**	Calculates widget bounds using the bounds of all child elements. */
 		void updateBounds() const;
 
+		/**
+		 * Updates all dirty elements and marks the widget as clean. The changes are recorded until they are reported by
+		 * _cleanDirty().
+		 */
+		void clean();
+
 		/**	Updates the size of the primary GUI panel based on the viewport. */
 		void updateRootPanel();
 
@@ -201,6 +220,8 @@ namespace bs
 
 		Set<GUIElement*> mDirtyContents;
 		Set<GUIElement*> mDirtyContentsTemp;
+		Vector<GUIElement*> mUnreportedElements;
+		bool mHasUnreportedChanges;
 
 		mutable UINT64 mCachedRTId;
 		mutable bool mWidgetIsDirty;
@@ -0,0 +1,213 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Testing/BsConsoleTestOutput.h"
+#include "Testing/BsTestSuite.h"
+#include "GUI/BsGUIBatchUtility.h"
+
+namespace bs
+{
+	/** Creates a render element of a GUI element, as batched by the GUIManager. Offsets are assigned separately. */
+	GUIBatchElement createBatchTestElement(GUIElement* element, UINT32 depth, GUIMeshType meshType, UINT32 numVertices,
+		UINT32 numIndices)
+	{
+		GUIBatchElement output;
+		output.element = element;
+		output.renderElement = 0;
+		output.widget = nullptr;
+		output.depth = depth;
+		output.mergeHash = 0;
+		output.bounds = Rect2I(0, 0, 10, 10);
+		output.meshType = meshType;
+		output.groupIdx = 0;
+		output.numVertices = numVertices;
+		output.numIndices = numIndices;
+		output.vertexOffset = 0;
+		output.indexOffset = 0;
+
+		return output;
+	}
+
+	/** Places the geometry of the render elements one after another, in the order they are provided in. */
+	void assignBatchTestOffsets(Vector<GUIBatchElement>& elements)
+	{
+		UINT32 vertexOffset[2] = { 0, 0 };
+		UINT32 indexOffset[2] = { 0, 0 };
+
+		for(auto& entry : elements)
+		{
+			UINT32 typeIdx = (UINT32)entry.meshType;
+			entry.vertexOffset = vertexOffset[typeIdx];
+			entry.indexOffset = indexOffset[typeIdx];
+
+			vertexOffset[typeIdx] += entry.numVertices;
+			indexOffset[typeIdx] += entry.numIndices;
+		}
+	}
+
+	class EngineTestSuite : public TestSuite
+	{
+	public:
+		EngineTestSuite();
+
+	private:
+		void testGUIBatchReuse();
+		void testGUIMeshRangeMerge();
+	};
+
+	EngineTestSuite::EngineTestSuite()
+	{
+		BS_ADD_TEST(EngineTestSuite::testGUIBatchReuse);
+		BS_ADD_TEST(EngineTestSuite::testGUIMeshRangeMerge);
+	}
+
+	void EngineTestSuite::testGUIBatchReuse()
+	{
+		// Elements are only compared by address, they are never accessed
+		static constexpr UINT32 NUM_ELEMENTS = 5;
+		UINT64 elementStorage[NUM_ELEMENTS];
+
+		GUIElement* elements[NUM_ELEMENTS];
+		for(UINT32 i = 0; i < NUM_ELEMENTS; i++)
+			elements[i] = reinterpret_cast<GUIElement*>(&elementStorage[i]);
+
+		// Three quads and a line, from farthest to nearest
+		Vector<GUIBatchElement> oldElements;
+		oldElements.push_back(createBatchTestElement(elements[0], 4, GUIMeshType::Triangle, 4, 6));
+		oldElements.push_back(createBatchTestElement(elements[1], 3, GUIMeshType::Triangle, 4, 6));
+		oldElements.push_back(createBatchTestElement(elements[2], 2, GUIMeshType::Triangle, 4, 6));
+		oldElements.push_back(createBatchTestElement(elements[3], 1, GUIMeshType::Line, 2, 2));
+		assignBatchTestOffsets(oldElements);
+
+		Vector<GUIElement*> noUpdates;
+		Vector<const GUIBatchElement*> sources;
+
+		// Nothing changed, every batch and all the geometry is reused in place
+		{
+			Vector<GUIBatchElement> newElements = oldElements;
+			const UINT32 numUnchanged = GUIBatchUtility::countUnchanged(oldElements, newElements);
+			BS_TEST_ASSERT(numUnchanged == 4);
+
+			bool inPlace[2] = { true, true };
+			GUIBatchUtility::findReusableGeometry(oldElements, newElements, numUnchanged, noUpdates, sources, inPlace);
+
+			BS_TEST_ASSERT(inPlace[0] && inPlace[1]);
+			for(UINT32 i = 0; i < 4; i++)
+				BS_TEST_ASSERT(sources[i] == &oldElements[i]);
+		}
+
+		// An updated element must have its geometry regenerated, the rest stays in place
+		{
+			Vector<GUIBatchElement> newElements = oldElements;
+			Vector<GUIElement*> updated = { elements[1] };
+
+			const UINT32 numUnchanged = GUIBatchUtility::countUnchanged(oldElements, newElements);
+			BS_TEST_ASSERT(numUnchanged == 4);
+
+			bool inPlace[2] = { true, true };
+			GUIBatchUtility::findReusableGeometry(oldElements, newElements, numUnchanged, updated, sources, inPlace);
+
+			BS_TEST_ASSERT(inPlace[0] && inPlace[1]);
+			BS_TEST_ASSERT(sources[0] == &oldElements[0]);
+			BS_TEST_ASSERT(sources[1] == nullptr);
+			BS_TEST_ASSERT(sources[2] == &oldElements[2]);
+			BS_TEST_ASSERT(sources[3] == &oldElements[3]);
+		}
+
+		// An element that grew can't reuse its geometry. Triangle geometry after it moves, but lines are unaffected.
+		{
+			Vector<GUIBatchElement> newElements = oldElements;
+			newElements[1].numVertices = 8;
+			newElements[1].numIndices = 12;
+			assignBatchTestOffsets(newElements);
+
+			const UINT32 numUnchanged = GUIBatchUtility::countUnchanged(oldElements, newElements);
+
+			// Buffer sizes changed for triangles, so they can't be updated in place to begin with
+			bool inPlace[2] = { false, true };
+			GUIBatchUtility::findReusableGeometry(oldElements, newElements, numUnchanged, noUpdates, sources, inPlace);
+
+			BS_TEST_ASSERT(!inPlace[0] && inPlace[1]);
+			BS_TEST_ASSERT(sources[0] == &oldElements[0]);
+			BS_TEST_ASSERT(sources[1] == nullptr);
+			BS_TEST_ASSERT(sources[2] == &oldElements[2]);
+			BS_TEST_ASSERT(sources[3] == &oldElements[3]);
+		}
+
+		// An element moved to the front. Batches after its old position are invalidated, but geometry of all elements
+		// can still be found and copied to its new place.
+		{
+			Vector<GUIBatchElement> newElements = { oldElements[1], oldElements[2], oldElements[3], oldElements[0] };
+			newElements[3].depth = 0;
+			assignBatchTestOffsets(newElements);
+
+			const UINT32 numUnchanged = GUIBatchUtility::countUnchanged(oldElements, newElements);
+			BS_TEST_ASSERT(numUnchanged == 0);
+
+			bool inPlace[2] = { true, true };
+			GUIBatchUtility::findReusableGeometry(oldElements, newElements, numUnchanged, noUpdates, sources, inPlace);
+
+			BS_TEST_ASSERT(!inPlace[0] && inPlace[1]);
+			BS_TEST_ASSERT(sources[0] == &oldElements[1]);
+			BS_TEST_ASSERT(sources[1] == &oldElements[2]);
+			BS_TEST_ASSERT(sources[2] == &oldElements[3]);
+			BS_TEST_ASSERT(sources[3] == &oldElements[0]);
+		}
+
+		// A new element has no geometry to reuse. Elements before it keep their batches.
+		{
+			Vector<GUIBatchElement> newElements = oldElements;
+			newElements.push_back(createBatchTestElement(elements[4], 0, GUIMeshType::Triangle, 4, 6));
+			assignBatchTestOffsets(newElements);
+
+			const UINT32 numUnchanged = GUIBatchUtility::countUnchanged(oldElements, newElements);
+			BS_TEST_ASSERT(numUnchanged == 4);
+
+			bool inPlace[2] = { false, true };
+			GUIBatchUtility::findReusableGeometry(oldElements, newElements, numUnchanged, noUpdates, sources, inPlace);
+
+			BS_TEST_ASSERT(sources.size() == 5);
+			for(UINT32 i = 0; i < 4; i++)
+				BS_TEST_ASSERT(sources[i] == &oldElements[i]);
+
+			BS_TEST_ASSERT(sources[4] == nullptr);
+		}
+	}
+
+	void EngineTestSuite::testGUIMeshRangeMerge()
+	{
+		// Ranges are provided in rendering order, not in buffer order
+		Vector<GUIMeshRange> ranges = {
+			{ 8, 4, 12, 6 },
+			{ 0, 4, 0, 6 },
+			{ 20, 4, 30, 6 },
+			{ 4, 4, 6, 6 }
+		};
+
+		GUIBatchUtility::mergeRanges(ranges);
+		BS_TEST_ASSERT(ranges.size() == 2);
+
+		if(ranges.size() == 2)
+		{
+			BS_TEST_ASSERT(ranges[0].vertexOffset == 0 && ranges[0].numVertices == 12);
+			BS_TEST_ASSERT(ranges[0].indexOffset == 0 && ranges[0].numIndices == 18);
+			BS_TEST_ASSERT(ranges[1].vertexOffset == 20 && ranges[1].numVertices == 4);
+			BS_TEST_ASSERT(ranges[1].indexOffset == 30 && ranges[1].numIndices == 6);
+		}
+
+		ranges.clear();
+		GUIBatchUtility::mergeRanges(ranges);
+		BS_TEST_ASSERT(ranges.empty());
+	}
+}
+
+using namespace bs;
+
+int main()
+{
+	SPtr<TestSuite> tests = EngineTestSuite::create<EngineTestSuite>();
+
+	ConsoleTestOutput testOutput;
+	tests->run(testOutput);
+
+	return 0;
+}
@@ -6,11 +6,18 @@
 #include "Mesh/BsMesh.h"
 #include "Material/BsMaterial.h"
 #include "Renderer/BsRenderElement.h"
-
-using namespace std::placeholders;
+#include "Utility/BsRadixSort.h"
 
 namespace bs { namespace ct
 {
+	/** Number of bits in the sort key reserved for each of the sorted properties. */
+	static constexpr UINT32 PRIORITY_BITS = 8;
+	static constexpr UINT32 SHADER_BITS = 20;
+	static constexpr UINT32 PASS_BITS = 4;
+	static constexpr UINT32 DISTANCE_BITS = 32;
+
+	static_assert(PRIORITY_BITS + SHADER_BITS + PASS_BITS + DISTANCE_BITS == 64, "Sort key must be exactly 64 bits.");
+
 	RenderQueue::RenderQueue(StateReduction mode)
 		:mStateReductionMode(mode)
 	{
@@ -20,7 +27,6 @@ namespace bs { namespace ct
 	void RenderQueue::clear()
 	{
 		mSortableElements.clear();
-		mSortableElementIdx.clear();
 		mElements.clear();
 
 		mSortedRenderElements.clear();
@@ -31,9 +37,10 @@ namespace bs { namespace ct
 		SPtr<Material> material = element->material;
 		SPtr<Shader> shader = material->getShader();
 
+		const UINT32 elementIdx = (UINT32)mElements.size();
 		mElements.push_back(element);
 		
-		UINT32 queuePriority = shader->getQueuePriority();
+		INT32 queuePriority = shader->getQueuePriority();
 		QueueSortType sortType = shader->getQueueSortType();
 		UINT32 shaderId = shader->getId();
 		bool separablePasses = shader->getAllowSeparablePasses();
@@ -56,60 +63,87 @@ namespace bs { namespace ct
 
 		for (UINT32 i = 0; i < numPasses; i++)
 		{
-			UINT32 idx = (UINT32)mSortableElementIdx.size();
-			mSortableElementIdx.push_back(idx);
-
 			mSortableElements.push_back(SortableElement());
 			SortableElement& sortableElem = mSortableElements.back();
 
-			sortableElem.seqIdx = idx;
+			sortableElem.elementIdx = elementIdx;
 			sortableElem.priority = queuePriority;
 			sortableElem.shaderId = shaderId;
 			sortableElem.passIdx = i;
 			sortableElem.distFromCamera = distFromCamera;
+			sortableElem.separablePasses = separablePasses;
 		}
 	}
 
-	void RenderQueue::sort()
+	void RenderQueue::append(const RenderQueue& other)
 	{
-		std::function<bool(UINT32, UINT32, const Vector<SortableElement>&)> sortMethod;
+		const UINT32 elementOffset = (UINT32)mElements.size();
+		mElements.insert(mElements.end(), other.mElements.begin(), other.mElements.end());
 
-		switch (mStateReductionMode)
+		for (auto& entry : other.mSortableElements)
 		{
-		case StateReduction::None:
-			sortMethod = &elementSorterNoGroup;
-			break;
-		case StateReduction::Material:
-			sortMethod = &elementSorterPreferGroup;
-			break;
-		case StateReduction::Distance:
-			sortMethod = &elementSorterPreferSort;
-			break;
+			mSortableElements.push_back(entry);
+			mSortableElements.back().elementIdx += elementOffset;
 		}
+	}
+
+	void RenderQueue::sort()
+	{
+		const UINT32 numElements = (UINT32)mSortableElements.size();
 
-		// Sort only indices since we generate an entirely new data set anyway, it doesn't make sense to move sortable elements
-		std::sort(mSortableElementIdx.begin(), mSortableElementIdx.end(), std::bind(sortMethod, _1, _2, mSortableElements));
+		// Find all unique priorities, so they can be encoded in the key by their rank instead of their full value. There
+		// are normally only a handful of them.
+		mPriorities.clear();
 
-		UINT32 prevShaderId = (UINT32)-1;
-		UINT32 prevPassIdx = (UINT32)-1;
-		const RenderElement* renderElem = nullptr;
-		INT32 currentElementIdx = -1;
-		UINT32 numPassesInCurrentElement = 0;
-		bool separablePasses = true;
-		for (UINT32 i = 0; i < (UINT32)mSortableElementIdx.size(); i++)
+		INT32 lastPriority = 0;
+		for (UINT32 i = 0; i < numElements; i++)
 		{
-			UINT32 idx = mSortableElementIdx[i];
+			const INT32 priority = mSortableElements[i].priority;
+			if (i > 0 && priority == lastPriority)
+				continue;
 
-			while (numPassesInCurrentElement == 0)
+			if (std::find(mPriorities.begin(), mPriorities.end(), priority) == mPriorities.end())
+				mPriorities.push_back(priority);
+
+			lastPriority = priority;
+		}
+
+		std::sort(mPriorities.begin(), mPriorities.end(), std::greater<INT32>());
+
+		// Generate the sort keys
+		mSortKeys.resize(numElements);
+		mSortKeysTmp.resize(numElements);
+		mSortableElementIdx.resize(numElements);
+		mSortableElementIdxTmp.resize(numElements);
+
+		UINT32 lastRank = 0;
+		for (UINT32 i = 0; i < numElements; i++)
+		{
+			const SortableElement& elem = mSortableElements[i];
+			if (i == 0 || elem.priority != lastPriority)
 			{
-				currentElementIdx++;
-				renderElem = mElements[currentElementIdx];
-				numPassesInCurrentElement = renderElem->material->getNumPasses();
-				separablePasses = renderElem->material->getShader()->getAllowSeparablePasses();
+				auto iterFind = std::lower_bound(mPriorities.begin(), mPriorities.end(), elem.priority, std::greater<INT32>());
+				lastRank = (UINT32)(iterFind - mPriorities.begin());
+				lastPriority = elem.priority;
 			}
 
-			const SortableElement& elem = mSortableElements[idx];
-			if (separablePasses)
+			mSortKeys[i] = getSortKey(elem, lastRank);
+			mSortableElementIdx[i] = i;
+		}
+
+		// Sort only indices since we generate an entirely new data set anyway, it doesn't make sense to move sortable
+		// elements. The sort is stable, so elements with equal keys keep the order they were added in.
+		radixSort(mSortKeys.data(), mSortableElementIdx.data(), mSortKeysTmp.data(), mSortableElementIdxTmp.data(),
+			numElements);
+
+		UINT32 prevShaderId = (UINT32)-1;
+		UINT32 prevPassIdx = (UINT32)-1;
+		for (UINT32 i = 0; i < numElements; i++)
+		{
+			const SortableElement& elem = mSortableElements[mSortableElementIdx[i]];
+			const RenderElement* renderElem = mElements[elem.elementIdx];
+
+			if (elem.separablePasses)
 			{
 				mSortedRenderElements.push_back(RenderQueueElement());
 
@@ -125,12 +159,11 @@ namespace bs { namespace ct
 				}
 				else
 					sortedElem.applyPass = false;
-
-				numPassesInCurrentElement--;
 			}
 			else
 			{
-				for (UINT32 j = 0; j < numPassesInCurrentElement; j++)
+				const UINT32 numPasses = renderElem->material->getNumPasses();
+				for (UINT32 j = 0; j < numPasses; j++)
 				{
 					mSortedRenderElements.push_back(RenderQueueElement());
 
@@ -142,66 +175,32 @@ namespace bs { namespace ct
 					prevShaderId = elem.shaderId;
 					prevPassIdx = j;
 				}
-
-				numPassesInCurrentElement = 0;
-			}			
+			}
 		}
 	}
 
-	bool RenderQueue::elementSorterNoGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup)
+	UINT64 RenderQueue::getSortKey(const SortableElement& elem, UINT32 priorityRank) const
 	{
-		const SortableElement& a = lookup[aIdx];
-		const SortableElement& b = lookup[bIdx];
-
-		UINT8 isHigher = (a.priority > b.priority) << 2 |
-			(a.distFromCamera < b.distFromCamera) << 1 |
-			(a.seqIdx < b.seqIdx);
-
-		UINT8 isLower = (a.priority < b.priority) << 2 |
-			(a.distFromCamera > b.distFromCamera) << 1 |
-			(a.seqIdx > b.seqIdx);
+		// Higher priorities are rendered first and map to lower ranks. If there are more unique priorities than can fit
+		// in the key, the lowest ones end up sharing a rank.
+		const UINT64 priority = std::min(priorityRank, (1U << PRIORITY_BITS) - 1);
 
-		return isHigher > isLower;
-	}
-
-	bool RenderQueue::elementSorterPreferGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup)
-	{
-		const SortableElement& a = lookup[aIdx];
-		const SortableElement& b = lookup[bIdx];
-		
-		UINT8 isHigher = (a.priority > b.priority) << 4 |
-			(a.shaderId < b.shaderId) << 3 |
-			(a.passIdx < b.passIdx) << 2 |
-			(a.distFromCamera < b.distFromCamera) << 1 |
-			(a.seqIdx < b.seqIdx);
-
-		UINT8 isLower = (a.priority < b.priority) << 4 |
-			(a.shaderId > b.shaderId) << 3 |
-			(a.passIdx > b.passIdx) << 2 |
-			(a.distFromCamera > b.distFromCamera) << 1 |
-			(a.seqIdx > b.seqIdx);
-
-		return isHigher > isLower;
-	}
+		// Shader IDs only serve to group elements together, so it's fine for them to wrap around
+		const UINT64 shaderId = elem.shaderId & ((1U << SHADER_BITS) - 1);
+		const UINT64 passIdx = std::min(elem.passIdx, (1U << PASS_BITS) - 1);
+		const UINT64 distance = floatToSortableUInt(elem.distFromCamera);
 
-	bool RenderQueue::elementSorterPreferSort(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup)
-	{
-		const SortableElement& a = lookup[aIdx];
-		const SortableElement& b = lookup[bIdx];
-
-		UINT8 isHigher = (a.priority > b.priority) << 4 | 
-			(a.distFromCamera < b.distFromCamera) << 3 | 
-			(a.shaderId < b.shaderId) << 2 | 
-			(a.passIdx < b.passIdx) << 1 | 
-			(a.seqIdx < b.seqIdx);
-
-		UINT8 isLower = (a.priority < b.priority) << 4 |
-			(a.distFromCamera > b.distFromCamera) << 3 |
-			(a.shaderId > b.shaderId) << 2 |
-			(a.passIdx > b.passIdx) << 1 |
-			(a.seqIdx > b.seqIdx);
-
-		return isHigher > isLower;
+		const UINT64 priorityKey = priority << (64 - PRIORITY_BITS);
+		switch (mStateReductionMode)
+		{
+		default:
+		case StateReduction::None:
+			return priorityKey | distance;
+		case StateReduction::Material:
+			return priorityKey | (shaderId << (PASS_BITS + DISTANCE_BITS)) | (passIdx << DISTANCE_BITS) | distance;
+		case StateReduction::Distance:
+			return priorityKey | (distance << (SHADER_BITS + PASS_BITS)) | (shaderId << PASS_BITS) | passIdx;
+		}
 	}
 
 	const Vector<RenderQueueElement>& RenderQueue::getSortedElements() const
@@ -40,11 +40,12 @@ namespace bs { namespace ct
 		/**	Data used for renderable element sorting. Represents a single pass for a single mesh. */
 		struct SortableElement
 		{
-			UINT32 seqIdx;
+			UINT32 elementIdx;
 			INT32 priority;
 			float distFromCamera;
 			UINT32 shaderId;
 			UINT32 passIdx;
+			bool separablePasses;
 		};
 
 	public:
@@ -59,6 +60,12 @@ namespace bs { namespace ct
 		 */
 		void add(const RenderElement* element, float distFromCamera);
 
+		/**
+		 * Adds all entries from another queue to the end of this queue, in the order they were added to the other queue.
+		 * Allows a queue to be built in parallel by filling a separate queue per thread, and then merging the results.
+		 */
+		void append(const RenderQueue& other);
+
 		/**	Clears all render operations from the queue. */
 		void clear();
 		
@@ -75,19 +82,26 @@ namespace bs { namespace ct
 		void setStateReduction(StateReduction mode) { mStateReductionMode = mode; }
 
 	protected:
-		/**	Callback used for sorting elements with no material grouping. */
-		static bool elementSorterNoGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup);
-
-		/**	Callback used for sorting elements with preferred material grouping. */
-		static bool elementSorterPreferGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup);
-
-		/**	Callback used for sorting elements with material grouping after sorting. */
-		static bool elementSorterPreferSort(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup);
+		/**
+		 * Encodes the sortable element into a 64-bit key whose ascending order matches the render order for the current
+		 * state reduction mode.
+		 *
+		 * @param[in]	elem			Element to generate the key for.
+		 * @param[in]	priorityRank	Rank of the element's priority among all priorities in the queue, with 0 being the
+		 *								highest priority.
+		 */
+		UINT64 getSortKey(const SortableElement& elem, UINT32 priorityRank) const;
 
 		Vector<SortableElement> mSortableElements;
-		Vector<UINT32> mSortableElementIdx;
 		Vector<const RenderElement*> mElements;
 
+		// Sort buffers, kept around so they don't need to be re-allocated every frame
+		Vector<UINT64> mSortKeys;
+		Vector<UINT64> mSortKeysTmp;
+		Vector<UINT32> mSortableElementIdx;
+		Vector<UINT32> mSortableElementIdxTmp;
+		Vector<INT32> mPriorities;
+
 		Vector<RenderQueueElement> mSortedRenderElements;
 		StateReduction mStateReductionMode;
 	};
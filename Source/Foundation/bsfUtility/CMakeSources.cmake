@@ -4,6 +4,7 @@ set(BS_UTILITY_INC_THREADING
 	"bsfUtility/Threading/BsSpinLock.h"
 	"bsfUtility/Threading/BsThreadPool.h"
 	"bsfUtility/Threading/BsTaskScheduler.h"
+	"bsfUtility/Threading/BsWorkStealingQueue.h"
 )
 
 set(BS_UTILITY_SRC_THIRDPARTY
@@ -57,6 +58,7 @@ set(BS_UTILITY_INC_DEBUG
 	"bsfUtility/Debug/BsBitmapWriter.h"
 	"bsfUtility/Debug/BsDebug.h"
 	"bsfUtility/Debug/BsLog.h"
+	"bsfUtility/Debug/BsTraceRecorder.h"
 )
 
 set(BS_UTILITY_INC_FILESYSTEM
@@ -98,6 +100,7 @@ set(BS_UTILITY_INC_UTILITY
 	"bsfUtility/Utility/BsNonCopyable.h"
 	"bsfUtility/Utility/BsUUID.h"
 	"bsfUtility/Utility/BsOctree.h"
+	"bsfUtility/Utility/BsRadixSort.h"
 	"bsfUtility/Utility/BsDataBlob.h"
 	"bsfUtility/Utility/BsLookupTable.h"
 )
@@ -118,6 +121,7 @@ set(BS_UTILITY_SRC_DEBUG
 	"bsfUtility/Debug/BsBitmapWriter.cpp"
 	"bsfUtility/Debug/BsLog.cpp"
 	"bsfUtility/Debug/BsDebug.cpp"
+	"bsfUtility/Debug/BsTraceRecorder.cpp"
 )
 
 set(BS_UTILITY_INC_RTTI
@@ -0,0 +1,351 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Debug/BsTraceRecorder.h"
+#include "Debug/BsDebug.h"
+#include "FileSystem/BsDataStream.h"
+#include "FileSystem/BsFileSystem.h"
+#include "Utility/BsBitwise.h"
+
+#if BS_ARCH_TYPE == BS_ARCHITECTURE_x86_32 || BS_ARCH_TYPE == BS_ARCHITECTURE_x86_64
+	#define BS_TRACE_USE_RDTSC 1
+
+	#if BS_COMPILER == BS_COMPILER_MSVC
+		#include <intrin.h>
+	#else
+		#include <x86intrin.h>
+	#endif
+#else
+	#define BS_TRACE_USE_RDTSC 0
+#endif
+
+using namespace std::chrono;
+
+namespace bs
+{
+	/** Ring buffer of events recorded by a single thread. Only the owning thread writes to it. */
+	struct TraceRecorder::ThreadBuffer
+	{
+		TraceEvent* events = nullptr;
+		UINT32 mask = 0;
+
+		std::atomic<UINT64> writeIdx { 0 };
+		std::atomic<UINT64> clearIdx { 0 };
+
+		String name;
+	};
+
+	namespace
+	{
+		/** Names of all events registered through TraceRecorder::registerName(). */
+		struct TraceNameRegistry
+		{
+			Mutex mutex;
+			UnorderedMap<String, UINT32> ids;
+			Vector<String> names;
+		};
+
+		TraceNameRegistry& getNameRegistry()
+		{
+			static TraceNameRegistry registry;
+			return registry;
+		}
+
+		/** Used for telling apart thread buffers of different recorder instances, in case the recorder is restarted. */
+		std::atomic<UINT32> gNextInstanceId { 1 };
+
+		BS_THREADLOCAL UINT32 gThreadBufferOwner = 0;
+		BS_THREADLOCAL void* gThreadBuffer = nullptr;
+
+		/** Appends the provided string to the output, escaped so it can be used as a JSON string. */
+		void appendJSONString(String& output, const String& input)
+		{
+			output += '"';
+			for(auto& entry : input)
+			{
+				switch(entry)
+				{
+				case '"': output += "\\\""; break;
+				case '\\': output += "\\\\"; break;
+				case '\n': output += "\\n"; break;
+				case '\r': output += "\\r"; break;
+				case '\t': output += "\\t"; break;
+				default:
+					if((UINT8)entry < 0x20)
+					{
+						char escaped[8];
+						snprintf(escaped, sizeof(escaped), "\\u%04x", (UINT32)entry);
+						output += escaped;
+					}
+					else
+						output += entry;
+					break;
+				}
+			}
+			output += '"';
+		}
+	}
+
+	TraceRecorder::TraceRecorder(UINT32 eventsPerThread)
+		: mEnabled(false), mInstanceId(gNextInstanceId.fetch_add(1))
+		, mEventsPerThread(Bitwise::nextPow2(eventsPerThread)), mStartTimestamp(getTimestamp())
+		, mStartTime(steady_clock::now())
+	{ }
+
+	TraceRecorder::~TraceRecorder()
+	{
+		Lock lock(mMutex);
+
+		for(auto& buffer : mThreadBuffers)
+		{
+			if(buffer->events != nullptr)
+				bs_deleteN(buffer->events, buffer->mask + 1);
+
+			bs_delete(buffer);
+		}
+
+		mThreadBuffers.clear();
+	}
+
+	UINT32 TraceRecorder::registerName(const char* name)
+	{
+		TraceNameRegistry& registry = getNameRegistry();
+		Lock lock(registry.mutex);
+
+		auto iterFind = registry.ids.find(name);
+		if(iterFind != registry.ids.end())
+			return iterFind->second;
+
+		const UINT32 id = (UINT32)registry.names.size();
+		registry.names.push_back(name);
+		registry.ids[name] = id;
+
+		return id;
+	}
+
+	String TraceRecorder::getName(UINT32 id)
+	{
+		TraceNameRegistry& registry = getNameRegistry();
+		Lock lock(registry.mutex);
+
+		if(id >= (UINT32)registry.names.size())
+			return StringUtil::BLANK;
+
+		return registry.names[id];
+	}
+
+	void TraceRecorder::setThreadName(const String& name)
+	{
+		ThreadBuffer* buffer = getThreadBuffer();
+
+		Lock lock(mMutex);
+		buffer->name = name;
+	}
+
+	void TraceRecorder::clear()
+	{
+		Lock lock(mMutex);
+
+		for(auto& buffer : mThreadBuffers)
+			buffer->clearIdx.store(buffer->writeIdx.load(std::memory_order_acquire), std::memory_order_relaxed);
+	}
+
+	void TraceRecorder::record(UINT32 name, TraceEventType type)
+	{
+		ThreadBuffer* buffer = getThreadBuffer();
+
+		// Allocated on first use, so threads that only get named don't pay for the buffer
+		if(buffer->events == nullptr)
+		{
+			Lock lock(mMutex);
+
+			buffer->events = bs_newN<TraceEvent>(mEventsPerThread);
+			buffer->mask = mEventsPerThread - 1;
+		}
+
+		const UINT64 idx = buffer->writeIdx.load(std::memory_order_relaxed);
+
+		TraceEvent& event = buffer->events[idx & buffer->mask];
+		event.timestamp = getTimestamp();
+		event.name = name;
+		event.type = type;
+
+		buffer->writeIdx.store(idx + 1, std::memory_order_release);
+	}
+
+	TraceRecorder::ThreadBuffer* TraceRecorder::getThreadBuffer()
+	{
+		if(gThreadBufferOwner == mInstanceId)
+			return (ThreadBuffer*)gThreadBuffer;
+
+		ThreadBuffer* buffer = bs_new<ThreadBuffer>();
+
+		{
+			Lock lock(mMutex);
+
+			buffer->name = "Thread " + toString((UINT32)mThreadBuffers.size());
+			mThreadBuffers.push_back(buffer);
+		}
+
+		gThreadBufferOwner = mInstanceId;
+		gThreadBuffer = buffer;
+
+		return buffer;
+	}
+
+	void TraceRecorder::getEvents(Vector<String>& threadNames, Vector<Vector<TraceEvent>>& threadEvents) const
+	{
+		Lock lock(mMutex);
+
+		for(auto& buffer : mThreadBuffers)
+		{
+			if(buffer->events == nullptr)
+				continue;
+
+			const UINT64 capacity = buffer->mask + 1;
+			const UINT64 end = buffer->writeIdx.load(std::memory_order_acquire);
+			const UINT64 start = std::max(buffer->clearIdx.load(std::memory_order_relaxed),
+				end > capacity ? end - capacity : 0);
+
+			Vector<TraceEvent> events;
+			events.reserve((size_t)(end - start));
+
+			for(UINT64 i = start; i < end; i++)
+				events.push_back(buffer->events[i & buffer->mask]);
+
+			// The recording thread may have overwritten some of the oldest events while they were being copied,
+			// including the slot it is currently writing to
+			std::atomic_thread_fence(std::memory_order_acquire);
+			const UINT64 newEnd = buffer->writeIdx.load(std::memory_order_relaxed);
+
+			if(newEnd + 1 > start + capacity)
+			{
+				const UINT64 numOverwritten = std::min((UINT64)events.size(), newEnd + 1 - (start + capacity));
+				events.erase(events.begin(), events.begin() + (size_t)numOverwritten);
+			}
+
+			if(events.empty())
+				continue;
+
+			threadNames.push_back(buffer->name);
+			threadEvents.push_back(std::move(events));
+		}
+	}
+
+	void TraceRecorder::exportChromeTrace(DataStream& stream) const
+	{
+		Vector<String> threadNames;
+		Vector<Vector<TraceEvent>> threadEvents;
+		getEvents(threadNames, threadEvents);
+
+		// Names are only resolved once per export, and events refer to them by identifier
+		UnorderedMap<UINT32, String> escapedNames;
+		const double ticksPerUs = getTicksPerMicrosecond();
+
+		String output = "{\"traceEvents\":[\n";
+		bool first = true;
+		char buffer[128];
+
+		for(UINT32 i = 0; i < (UINT32)threadEvents.size(); i++)
+		{
+			const UINT32 threadId = i + 1;
+
+			snprintf(buffer, sizeof(buffer), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+				"\"args\":{\"name\":", threadId);
+
+			if(!first)
+				output += ",\n";
+
+			output += buffer;
+			appendJSONString(output, threadNames[i]);
+			output += "}}";
+			first = false;
+
+			UINT32 depth = 0;
+			for(auto& event : threadEvents[i])
+			{
+				if(event.type == TraceEventType::End)
+				{
+					// Begin event was overwritten, or recorded before the last clear
+					if(depth == 0)
+						continue;
+
+					depth--;
+				}
+				else
+					depth++;
+
+				auto iterFind = escapedNames.find(event.name);
+				if(iterFind == escapedNames.end())
+				{
+					String escapedName;
+					appendJSONString(escapedName, getName(event.name));
+
+					iterFind = escapedNames.insert(std::make_pair(event.name, escapedName)).first;
+				}
+
+				// Signed, as timestamps from different cores aren't guaranteed to be perfectly in sync
+				const double timeUs = (double)(INT64)(event.timestamp - mStartTimestamp) / ticksPerUs;
+				const char phase = event.type == TraceEventType::Begin ? 'B' : 'E';
+
+				snprintf(buffer, sizeof(buffer), ",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}", phase, timeUs,
+					threadId);
+
+				output += ",\n{\"name\":";
+				output += iterFind->second;
+				output += buffer;
+
+				// Flush periodically so large traces don't need to be kept in memory in their entirety
+				if(output.size() > 64 * 1024)
+				{
+					stream.write(output.data(), output.size());
+					output.clear();
+				}
+			}
+		}
+
+		output += "\n],\"displayTimeUnit\":\"ms\"}\n";
+		stream.write(output.data(), output.size());
+	}
+
+	void TraceRecorder::exportChromeTrace(const Path& path) const
+	{
+		SPtr<DataStream> stream = FileSystem::createAndOpenFile(path);
+		if(stream == nullptr)
+		{
+			LOGERR("Unable to export a trace to: " + path.toString());
+			return;
+		}
+
+		exportChromeTrace(*stream);
+		stream->close();
+	}
+
+	UINT64 TraceRecorder::getTimestamp()
+	{
+#if BS_TRACE_USE_RDTSC
+		return __rdtsc();
+#else
+		return (UINT64)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+#endif
+	}
+
+	double TraceRecorder::getTicksPerMicrosecond() const
+	{
+#if BS_TRACE_USE_RDTSC
+		// Calibrate the counter against the system clock, over a long enough period for the result to be accurate
+		static constexpr INT64 MIN_CALIBRATION_TIME_US = 10000;
+
+		INT64 elapsedUs;
+		UINT64 elapsedTicks;
+		do
+		{
+			elapsedTicks = getTimestamp() - mStartTimestamp;
+			elapsedUs = duration_cast<microseconds>(steady_clock::now() - mStartTime).count();
+		} while(elapsedUs < MIN_CALIBRATION_TIME_US);
+
+		return (double)elapsedTicks / elapsedUs;
+#else
+		return 1000.0;
+#endif
+	}
+}
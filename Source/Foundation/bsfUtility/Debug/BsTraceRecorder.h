@@ -0,0 +1,188 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Utility/BsModule.h"
+#include <atomic>
+#include <chrono>
+
+namespace bs
+{
+	/** @addtogroup Debug
+	 *  @{
+	 */
+
+	/** Types of events that can be recorded by TraceRecorder. */
+	enum class TraceEventType : UINT32
+	{
+		Begin, /**< Start of a timed scope. */
+		End /**< End of a timed scope, matching the last Begin event on the same thread. */
+	};
+
+	/** A single event recorded by TraceRecorder. */
+	struct TraceEvent
+	{
+		UINT64 timestamp; /**< Time at which the event was recorded, in TraceRecorder::getTimestamp() units. */
+		UINT32 name; /**< Identifier of the event name, as returned by TraceRecorder::registerName(). */
+		TraceEventType type;
+	};
+
+	/**
+	 * Records a timeline of events on all threads, so that interactions between threads (e.g. sim thread, core thread
+	 * and task workers) can be inspected after the fact. Unlike ProfilerCPU which aggregates samples, every event is
+	 * kept along with its timestamp.
+	 *
+	 * Each thread records into its own fixed-size ring buffer, so recording requires no locks and only overwrites the
+	 * oldest events of that thread when the buffer fills up. Event names are registered once and then referenced by
+	 * their identifier (see BS_TRACE_SCOPE), so recording doesn't perform any lookups either.
+	 *
+	 * Recorded events can be exported in the Chrome trace event format, viewable in chrome://tracing or Perfetto.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_UTILITY_EXPORT TraceRecorder : public Module<TraceRecorder>
+	{
+		struct ThreadBuffer;
+
+	public:
+		/**
+		 * Constructs the recorder. Recording starts disabled.
+		 *
+		 * @param[in]	eventsPerThread		Size of the event buffer of each thread. Rounded up to a power of two.
+		 *									Since the oldest event might be getting overwritten when the buffer is
+		 *									read, one less event than this can be retrieved from the buffer.
+		 */
+		TraceRecorder(UINT32 eventsPerThread = 64 * 1024);
+		~TraceRecorder();
+
+		/**
+		 * Returns an identifier for the provided event name, registering the name if this is the first time it was
+		 * seen. The identifier remains valid for the lifetime of the application, even across recorder restarts. This
+		 * performs a lookup and should be done once per name, ideally ahead of time, with the identifier stored for
+		 * later use.
+		 */
+		static UINT32 registerName(const char* name);
+
+		/** Returns the name registered with registerName(). */
+		static String getName(UINT32 id);
+
+		/** Enables or disables recording of new events. Disabled recorder ignores all begin/end calls. */
+		void setEnabled(bool enabled) { mEnabled.store(enabled, std::memory_order_relaxed); }
+
+		/** Checks is recording of new events enabled. */
+		bool isEnabled() const { return mEnabled.load(std::memory_order_relaxed); }
+
+		/** Records the start of a scope with the provided name identifier, on the calling thread. */
+		void beginEvent(UINT32 name)
+		{
+			if(isEnabled())
+				record(name, TraceEventType::Begin);
+		}
+
+		/** Records the end of a scope with the provided name identifier, on the calling thread. */
+		void endEvent(UINT32 name)
+		{
+			if(isEnabled())
+				record(name, TraceEventType::End);
+		}
+
+		/** Assigns a name to the calling thread, to be displayed in exported traces. */
+		void setThreadName(const String& name);
+
+		/** Discards all events recorded so far. */
+		void clear();
+
+		/**
+		 * Returns all the events currently held by the recorder for each thread that recorded any, ordered from oldest
+		 * to newest. Can be called while other threads are recording.
+		 *
+		 * @param[out]	threadNames		Names of the threads, with one entry per thread.
+		 * @param[out]	threadEvents	Events recorded on each thread, with one entry per thread.
+		 */
+		void getEvents(Vector<String>& threadNames, Vector<Vector<TraceEvent>>& threadEvents) const;
+
+		/**
+		 * Writes all the events currently held by the recorder as JSON in the Chrome trace event format. End events
+		 * whose begin event was already overwritten are skipped. Can be called while other threads are recording.
+		 */
+		void exportChromeTrace(DataStream& stream) const;
+
+		/** Writes all the events currently held by the recorder in the Chrome trace event format, to a file. */
+		void exportChromeTrace(const Path& path) const;
+
+		/** Returns the current time, in the units used by TraceEvent::timestamp. */
+		static UINT64 getTimestamp();
+
+		/** Returns the timestamp at which the recorder was constructed. */
+		UINT64 getStartTimestamp() const { return mStartTimestamp; }
+
+		/**
+		 * Returns the number of timestamp units in a microsecond. Timestamps might be measured in CPU cycles, in which
+		 * case the first call made shortly after the recorder was constructed will block until the counter can be
+		 * accurately calibrated (at most 10 milliseconds).
+		 */
+		double getTicksPerMicrosecond() const;
+
+	private:
+		/** Appends a new event to the calling thread's buffer. */
+		void record(UINT32 name, TraceEventType type);
+
+		/** Returns the calling thread's buffer, creating it if it doesn't exist. */
+		ThreadBuffer* getThreadBuffer();
+
+		std::atomic<bool> mEnabled;
+		UINT32 mInstanceId;
+		UINT32 mEventsPerThread;
+
+		UINT64 mStartTimestamp;
+		std::chrono::steady_clock::time_point mStartTime;
+
+		Vector<ThreadBuffer*> mThreadBuffers;
+		mutable Mutex mMutex;
+	};
+
+	/**
+	 * Helper class that records a trace event for the duration of the current block. Scope begin event is recorded when
+	 * the class is constructed and end event upon destruction. Use BS_TRACE_SCOPE instead of using it directly.
+	 */
+	class TraceScope
+	{
+	public:
+		TraceScope(UINT32 name)
+			:mName(name)
+		{
+			mRecording = TraceRecorder::isStarted() && TraceRecorder::instance().isEnabled();
+			if(mRecording)
+				TraceRecorder::instance().beginEvent(mName);
+		}
+
+		~TraceScope()
+		{
+			if(mRecording)
+				TraceRecorder::instance().endEvent(mName);
+		}
+
+	private:
+		UINT32 mName;
+		bool mRecording;
+	};
+
+#define BS_TRACE_CONCAT_INNER(a, b) a##b
+#define BS_TRACE_CONCAT(a, b) BS_TRACE_CONCAT_INNER(a, b)
+
+	/**
+	 * Records a trace event with the provided name for the remainder of the current block. The name must be a string
+	 * literal (or otherwise never change for the same call site), as it is only registered the first time the block is
+	 * entered.
+	 */
+#if BS_PROFILING_ENABLED
+	#define BS_TRACE_SCOPE(name)																					\
+		static const bs::UINT32 BS_TRACE_CONCAT(_bsTraceName, __LINE__) = bs::TraceRecorder::registerName(name);	\
+		bs::TraceScope BS_TRACE_CONCAT(_bsTraceScope, __LINE__)(BS_TRACE_CONCAT(_bsTraceName, __LINE__));
+#else
+	#define BS_TRACE_SCOPE(name)
+#endif
+
+	/** @} */
+}
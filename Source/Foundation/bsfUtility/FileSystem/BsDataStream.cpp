@@ -225,11 +225,35 @@ namespace bs
 		assert(mEnd >= mPos);
 	}
 
+	MemoryDataStream::MemoryDataStream(const SPtr<MemoryDataStream>& sourceStream, size_t offset, size_t size)
+		: DataStream(READ), mFreeOnClose(false), mSourceStream(sourceStream)
+	{
+		offset = std::min(offset, sourceStream->size());
+		size = std::min(size, sourceStream->size() - offset);
+
+		mData = mPos = sourceStream->getPtr() + offset;
+		mSize = size;
+		mEnd = mData + mSize;
+	}
+
 	MemoryDataStream::~MemoryDataStream()
 	{
 		close();
 	}
 
+	bool MemoryDataStream::isMemoryReferenceable() const
+	{
+		if (mData == nullptr || mSourceStream == nullptr)
+			return false;
+
+		// Memory must stay valid for as long as the source stream is alive
+		const MemoryDataStream* source = mSourceStream.get();
+		while (source->mSourceStream != nullptr)
+			source = source->mSourceStream.get();
+
+		return source->mFreeOnClose && source->mData != nullptr;
+	}
+
 	size_t MemoryDataStream::read(void* buf, size_t count)
 	{
 		size_t cnt = count;
@@ -307,6 +331,20 @@ namespace bs
 
 			mData = nullptr;
 		}
+
+		mSourceStream = nullptr;
+	}
+
+	MappedFileDataStream::MappedFileDataStream(const Path& filePath, void* memory, size_t size)
+		: MemoryDataStream(memory, size, true), mPath(filePath)
+	{
+		mAccess = READ;
+	}
+
+	MappedFileDataStream::~MappedFileDataStream()
+	{
+		// Unmap here, as the base class destructor would otherwise try to free the memory
+		close();
 	}
 
 	FileDataStream::FileDataStream(const Path& path, AccessMode accessMode, bool freeOnClose)
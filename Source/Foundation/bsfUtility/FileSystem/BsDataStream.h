@@ -187,6 +187,16 @@ namespace bs
 		 */
 		MemoryDataStream(const SPtr<DataStream>& sourceStream);
 
+		/**
+		 * Create a stream referencing a portion of the memory of another stream, without copying it. The source stream
+		 * is kept alive for as long as this stream exists.
+		 *
+		 * @param[in]	sourceStream	Stream whose memory to reference.
+		 * @param[in]	offset			Offset to the first referenced byte, from the start of the source stream.
+		 * @param[in]	size			Number of bytes to reference. Clamped to the size of the source stream.
+		 */
+		MemoryDataStream(const SPtr<MemoryDataStream>& sourceStream, size_t offset, size_t size);
+
 		~MemoryDataStream();
 
 		bool isFile() const override { return false; }
@@ -196,6 +206,14 @@ namespace bs
 		
 		/** Get a pointer to the current position in the memory block this stream holds. */
 		UINT8* getCurrentPtr() const { return mPos; }
+
+		/**
+		 * Checks can the consumer of this stream reference its memory directly instead of copying it, as long as it
+		 * keeps a reference to the stream. Only true for streams referencing a portion of another stream that owns its
+		 * memory (see the relevant constructor), in which case the referenced memory is considered to be handed off to
+		 * the consumer, and may also be modified by it.
+		 */
+		bool isMemoryReferenceable() const;
 		
 		/** @copydoc DataStream::read */
 		size_t read(void* buf, size_t count) override;
@@ -227,6 +245,40 @@ namespace bs
 		UINT8* mEnd;
 
 		bool mFreeOnClose;
+		SPtr<MemoryDataStream> mSourceStream;
+	};
+
+	/**
+	 * Data stream for reading a file mapped into memory. Unlike with FileDataStream reads are plain memory copies, and
+	 * portions of the file can be referenced without being copied at all (see MemoryDataStream). The file is mapped
+	 * copy-on-write, so the memory can be modified without affecting the file. The file itself must not be modified
+	 * while this stream, or any other stream referencing its memory, exists.
+	 *
+	 * @note	Use FileSystem::mapFile() to create the stream.
+	 */
+	class BS_UTILITY_EXPORT MappedFileDataStream : public MemoryDataStream
+	{
+	public:
+		/**
+		 * Wraps a file that has already been mapped into memory. The memory is unmapped when the stream is closed or
+		 * goes out of scope.
+		 *
+		 * @param[in]	filePath	Path of the mapped file.
+		 * @param[in]	memory		Start of the memory the file was mapped to.
+		 * @param[in]	size		Size of the mapped file in bytes.
+		 */
+		MappedFileDataStream(const Path& filePath, void* memory, size_t size);
+
+		~MappedFileDataStream();
+
+		/** @copydoc DataStream::close */
+		void close() override;
+
+		/** Returns the path of the mapped file. */
+		const Path& getPath() const { return mPath; }
+
+	protected:
+		Path mPath;
 	};
 
 	/** Data stream for handling data from standard streams. */
@@ -30,6 +30,17 @@ namespace bs
 		 */
 		static SPtr<DataStream> createAndOpenFile(const Path& fullPath);
 
+		/**
+		 * Maps a file into memory and returns a read-only stream of its contents. Reading from such a stream is faster
+		 * than reading from a stream returned by openFile(), and parts of the file can be referenced without copying
+		 * them. See MappedFileDataStream for details.
+		 *
+		 * @param[in]	fullPath	Full path to a file.
+		 * @return					Stream of the mapped file, or null if the file cannot be mapped (e.g. if it
+		 *							doesn't exist or is empty). In that case openFile() should be used instead.
+		 */
+		static SPtr<DataStream> mapFile(const Path& fullPath);
+
 		/**
 		 * Returns the size of a file in bytes.
 		 *
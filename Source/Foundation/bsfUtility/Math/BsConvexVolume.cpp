@@ -5,6 +5,7 @@
 #include "Math/BsSphere.h"
 #include "Math/BsPlane.h"
 #include "Math/BsMath.h"
+#include "Math/BsSIMD.h"
 #include "Error/BsException.h"
 
 namespace bs
@@ -114,6 +115,77 @@ namespace bs
 		return true;
 	}
 
+	void ConvexVolume::intersects(const float* const centers[3], const float* const extents[3], UINT32 count, 
+		UINT32* output) const
+	{
+		intersects(centers, extents, nullptr, count, output);
+	}
+
+	void ConvexVolume::intersects(const float* const centers[3], const float* const extents[3], const float* radii,
+		UINT32 count, UINT32* output) const
+	{
+		using namespace simd;
+
+		const UINT32 numPlanes = (UINT32)mPlanes.size();
+		const UINT32 numSimdBoxes = count & ~3U;
+
+		for(UINT32 i = 0; i < numSimdBoxes; i += 4)
+		{
+			float32x4 centerX = load_u<float32x4>(centers[0] + i);
+			float32x4 centerY = load_u<float32x4>(centers[1] + i);
+			float32x4 centerZ = load_u<float32x4>(centers[2] + i);
+
+			float32x4 extentX = load_u<float32x4>(extents[0] + i);
+			float32x4 extentY = load_u<float32x4>(extents[1] + i);
+			float32x4 extentZ = load_u<float32x4>(extents[2] + i);
+
+			// A bound is outside if either its box or its sphere is fully behind a plane, so we can test against the
+			// smaller of the two radii
+			float32x4 radius = radii ? load_u<float32x4>(radii + i) : splat<float32x4>(std::numeric_limits<float>::max());
+
+			uint32x4 outside = make_zero();
+			for(UINT32 j = 0; j < numPlanes; j++)
+			{
+				const Plane& plane = mPlanes[j];
+
+				float32x4 normalX = load_splat<float32x4>(&plane.normal.x);
+				float32x4 normalY = load_splat<float32x4>(&plane.normal.y);
+				float32x4 normalZ = load_splat<float32x4>(&plane.normal.z);
+				float32x4 planeD = load_splat<float32x4>(&plane.d);
+
+				float32x4 dist = sub(add(add(mul(centerX, normalX), mul(centerY, normalY)), mul(centerZ, normalZ)), planeD);
+
+				float32x4 effectiveRadius = mul(extentX, abs(normalX));
+				effectiveRadius = add(effectiveRadius, mul(extentY, abs(normalY)));
+				effectiveRadius = add(effectiveRadius, mul(extentZ, abs(normalZ)));
+
+				effectiveRadius = min(effectiveRadius, radius);
+
+				outside = bit_or(outside, bit_cast<uint32x4>(cmp_lt(dist, neg(effectiveRadius))));
+			}
+
+			// Each lane sets four bits in the byte mask, keep one bit per lane
+			const UINT32 byteMask = extract_bits_any(bit_cast<uint8x16>(outside));
+			const UINT32 outsideMask = (byteMask & 0x1) | ((byteMask >> 3) & 0x2) | ((byteMask >> 6) & 0x4) | 
+				((byteMask >> 9) & 0x8);
+
+			output[i >> 5] |= (~outsideMask & 0xF) << (i & 31);
+		}
+
+		for(UINT32 i = numSimdBoxes; i < count; i++)
+		{
+			const Vector3 center(centers[0][i], centers[1][i], centers[2][i]);
+			const Vector3 extent(extents[0][i], extents[1][i], extents[2][i]);
+			const bs::AABox box(center - extent, center + extent);
+
+			if(radii && !intersects(Sphere(center, radii[i])))
+				continue;
+
+			if(intersects(box))
+				output[i >> 5] |= 1 << (i & 31);
+		}
+	}
+
 	bool ConvexVolume::intersects(const Sphere& sphere) const
 	{
 		Vector3 center = sphere.getCenter();
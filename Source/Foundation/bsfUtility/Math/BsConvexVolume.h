@@ -38,6 +38,36 @@ namespace bs
 		 */
 		bool intersects(const AABox& box) const;
 
+		/**
+		 * Checks which of the provided axis aligned boxes intersect the volume. The boxes are provided in
+		 * structure-of-arrays form and are tested four at a time using SIMD instructions.
+		 *
+		 * @param[in]	centers		Three arrays containing the x, y and z components of the box centers.
+		 * @param[in]	extents		Three arrays containing the x, y and z components of the box extents (half-size).
+		 * @param[in]	count		Number of boxes to test.
+		 * @param[out]	output		Bitfield data containing one bit per box, 32 bits per element. Bits of the boxes that
+		 *							intersect the volume will be set, while the remaining bits will be left unchanged. This
+		 *							allows results of multiple volumes to be accumulated.
+		 */
+		void intersects(const float* const centers[3], const float* const extents[3], UINT32 count, 
+			UINT32* output) const;
+
+		/**
+		 * Checks which of the provided bounds intersect the volume. Each bound is represented by an axis aligned box and
+		 * a bounding sphere sharing the same center, and is considered intersecting only if both the box and the sphere
+		 * intersect the volume. The bounds are provided in structure-of-arrays form and are tested four at a time using
+		 * SIMD instructions.
+		 *
+		 * @param[in]	centers		Three arrays containing the x, y and z components of the box & sphere centers.
+		 * @param[in]	extents		Three arrays containing the x, y and z components of the box extents (half-size).
+		 * @param[in]	radii		Array containing the sphere radii. If null only the boxes are tested.
+		 * @param[in]	count		Number of bounds to test.
+		 * @param[out]	output		Bitfield data containing one bit per bound, 32 bits per element. Bits of the bounds
+		 *							that intersect the volume will be set, while the remaining bits will be left unchanged.
+		 */
+		void intersects(const float* const centers[3], const float* const extents[3], const float* radii, UINT32 count,
+			UINT32* output) const;
+
 		/**
 		 * Checks does the volume intersects the provided sphere.
 		 * This will return true if the sphere is fully inside the volume.
@@ -54,7 +84,7 @@ namespace bs
 		bool contains(const Vector3& p, float expand = 0.0f) const;
 
 		/** Returns the internal set of planes that represent the volume. */
-		Vector<Plane> getPlanes() const { return mPlanes; }
+		const Vector<Plane>& getPlanes() const { return mPlanes; }
 
 		/** Returns the specified plane that represents the volume. */
 		const Plane& getPlane(FrustumPlane whichPlane) const;
@@ -72,6 +72,7 @@ namespace bs
 	class FileSystem;
 	class Timer;
 	class Task;
+	class TaskGroup;
 	class GpuResourceData;
 	class PixelData;
 	class HString;
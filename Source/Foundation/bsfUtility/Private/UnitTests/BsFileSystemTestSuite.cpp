@@ -5,6 +5,7 @@
 #include "Debug/BsDebug.h"
 #include "Error/BsException.h"
 #include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
 
 #include <algorithm>
 #include <fstream>
@@ -84,6 +85,7 @@ namespace bs
 		BS_ADD_TEST(FileSystemTestSuite::testGetChildren);
 		BS_ADD_TEST(FileSystemTestSuite::testGetLastModifiedTime);
 		BS_ADD_TEST(FileSystemTestSuite::testGetTempDirectoryPath);
+		BS_ADD_TEST(FileSystemTestSuite::testMapFile);
 	}
 
 	void FileSystemTestSuite::testExists_yes_file()
@@ -299,4 +301,36 @@ namespace bs
 		/* No judging. */
 		BS_TEST_ASSERT(!path.toString().empty());
 	}
+
+	void FileSystemTestSuite::testMapFile()
+	{
+		Path path = mTestDirectory + "mapped";
+		createFile(path, "0123456789");
+
+		SPtr<DataStream> stream = FileSystem::mapFile(path);
+		BS_TEST_ASSERT(stream != nullptr && !stream->isFile());
+		BS_TEST_ASSERT(stream->size() == 10);
+		BS_TEST_ASSERT(stream->getAsString() == "0123456789");
+
+		// Views keep the mapping alive after the stream is released
+		SPtr<MemoryDataStream> memStream = std::static_pointer_cast<MemoryDataStream>(stream);
+		SPtr<MemoryDataStream> view = bs_shared_ptr_new<MemoryDataStream>(memStream, 4, 100);
+		BS_TEST_ASSERT(!memStream->isMemoryReferenceable());
+		BS_TEST_ASSERT(view->isMemoryReferenceable());
+
+		stream = nullptr;
+		memStream = nullptr;
+
+		BS_TEST_ASSERT(view->size() == 6);
+		BS_TEST_ASSERT(view->getAsString() == "456789");
+
+		// Mapping is copy-on-write
+		view->getPtr()[0] = 'x';
+		view = nullptr;
+		BS_TEST_ASSERT(readFile(path) == "0123456789");
+
+		createEmptyFile(mTestDirectory + "mappedEmpty");
+		BS_TEST_ASSERT(FileSystem::mapFile(mTestDirectory + "mappedEmpty") == nullptr);
+		BS_TEST_ASSERT(FileSystem::mapFile(mTestDirectory + "mappedMissing") == nullptr);
+	}
 }
@@ -35,6 +35,7 @@ namespace bs
 		void testGetChildren();
 		void testGetLastModifiedTime();
 		void testGetTempDirectoryPath();
+		void testMapFile();
 
 		Path mTestDirectory;
 	};
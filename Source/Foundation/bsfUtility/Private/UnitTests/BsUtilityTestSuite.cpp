@@ -4,6 +4,15 @@
 #include "Private/UnitTests/BsFileSystemTestSuite.h"
 #include "Utility/BsOctree.h"
 #include "Utility/BsBitfield.h"
+#include "Utility/BsRadixSort.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Utility/BsTimer.h"
+#include "Debug/BsDebug.h"
+#include "Debug/BsTraceRecorder.h"
+#include "FileSystem/BsDataStream.h"
+#include "Math/BsConvexVolume.h"
+#include "Math/BsSphere.h"
+#include "Math/BsMatrix4.h"
 
 namespace bs
 {
@@ -39,20 +48,84 @@ namespace bs
 	};
 
 	typedef Octree<UINT32, DebugOctreeOptions> DebugOctree;
+
+	/** Number of root tasks queued per frame by runTinyTasks(). */
+	static constexpr UINT32 NUM_TINY_ROOT_TASKS = 64;
+
+	/** Number of child tasks each root task queues from within a worker in runTinyTasks(). */
+	static constexpr UINT32 NUM_TINY_CHILD_TASKS = 500;
+
+	/** Total number of tasks executed per frame by runTinyTasks(). */
+	static constexpr UINT32 NUM_TINY_TASKS_PER_FRAME = NUM_TINY_ROOT_TASKS * NUM_TINY_CHILD_TASKS;
+
+	/**
+	 * Queues a set of root tasks per frame, each of which queues many tiny child tasks from within a worker, and waits
+	 * for all of them to complete before starting the next frame. Returns the number of child tasks that were executed.
+	 */
+	static UINT32 runTinyTasks(UINT32 numFrames)
+	{
+		std::atomic<UINT32> counter{0};
+		Vector<SPtr<Task>> rootTasks(NUM_TINY_ROOT_TASKS);
+		Vector<SPtr<Task>> childTasks(NUM_TINY_TASKS_PER_FRAME);
+
+		for(UINT32 i = 0; i < numFrames; i++)
+		{
+			for(UINT32 j = 0; j < NUM_TINY_ROOT_TASKS; j++)
+			{
+				rootTasks[j] = Task::create("TestRoot", [&counter, &childTasks, j]()
+				{
+					for(UINT32 k = 0; k < NUM_TINY_CHILD_TASKS; k++)
+					{
+						SPtr<Task>& childTask = childTasks[j * NUM_TINY_CHILD_TASKS + k];
+
+						childTask = Task::create("TestChild", [&counter]() { counter++; });
+						TaskScheduler::instance().addTask(childTask);
+					}
+				});
+
+				TaskScheduler::instance().addTask(rootTasks[j]);
+			}
+
+			for(auto& rootTask : rootTasks)
+				rootTask->wait();
+
+			for(auto& childTask : childTasks)
+				childTask->wait();
+		}
+
+		return counter;
+	}
+
 	void UtilityTestSuite::startUp()
 	{
 		SPtr<TestSuite> fileSystemTests = create<FileSystemTestSuite>();
 		add(fileSystemTests);
+
+		const UINT32 numCores = BS_THREAD_HARDWARE_CONCURRENCY;
+		ThreadPool::startUp<TThreadPool<>>(numCores, std::max(16U, numCores * 2));
+		TaskScheduler::startUp();
 	}
 
 	void UtilityTestSuite::shutDown()
 	{
+		TaskScheduler::shutDown();
+		ThreadPool::shutDown();
 	}
 
 	UtilityTestSuite::UtilityTestSuite()
 	{
 		BS_ADD_TEST(UtilityTestSuite::testOctree);
 		BS_ADD_TEST(UtilityTestSuite::testBitfield)
+		BS_ADD_TEST(UtilityTestSuite::testTaskScheduler)
+		BS_ADD_TEST(UtilityTestSuite::testConvexVolume)
+		BS_ADD_TEST(UtilityTestSuite::testOctreeCulling)
+		BS_ADD_TEST(UtilityTestSuite::testRadixSort)
+		BS_ADD_TEST(UtilityTestSuite::testTraceRecorder)
+
+#if BS_BENCHMARKS
+		BS_ADD_TEST(UtilityTestSuite::benchmarkTaskScheduler)
+		BS_ADD_TEST(UtilityTestSuite::benchmarkParallelFor)
+#endif
 	}
 
 	void UtilityTestSuite::testBitfield()
@@ -220,4 +293,594 @@ namespace bs
 		for(auto& entry : octreeData.elements)
 			octree.removeElement(entry.octreeId);
 	}
+
+	void UtilityTestSuite::testTaskScheduler()
+	{
+		// Dependencies
+		{
+			std::atomic<UINT32> order{0};
+			UINT32 orderA = 0, orderB = 0;
+
+			SPtr<Task> taskA = Task::create("TestA", [&]() { BS_THREAD_SLEEP(10); orderA = ++order; });
+			SPtr<Task> taskB = Task::create("TestB", [&]() { orderB = ++order; }, TaskPriority::VeryHigh, taskA);
+
+			TaskScheduler::instance().addTask(taskB);
+			TaskScheduler::instance().addTask(taskA);
+			taskB->wait();
+
+			BS_TEST_ASSERT(taskA->isComplete());
+			BS_TEST_ASSERT(orderA == 1 && orderB == 2);
+		}
+
+		// Canceled dependencies, dependents must get canceled in turn rather than executed
+		{
+			std::atomic<bool> gateOpen{false};
+			std::atomic<UINT32> numExecuted{0};
+
+			SPtr<Task> gate = Task::create("TestGate", [&]() { while(!gateOpen) BS_THREAD_SLEEP(1); });
+			SPtr<Task> taskA = Task::create("TestA", [&]() { numExecuted++; }, TaskPriority::Normal, gate);
+			SPtr<Task> taskB = Task::create("TestB", [&]() { numExecuted++; }, TaskPriority::Normal, taskA);
+			SPtr<Task> taskC = Task::create("TestC", [&]() { numExecuted++; }, TaskPriority::Normal, taskB);
+			SPtr<TaskGroup> group = TaskGroup::create("TestGroup", [&](UINT32 idx) { numExecuted++; }, 100,
+				TaskPriority::Normal, taskA);
+
+			TaskScheduler::instance().addTask(gate);
+			TaskScheduler::instance().addTask(taskA);
+			TaskScheduler::instance().addTask(taskB);
+			TaskScheduler::instance().addTask(taskC);
+			TaskScheduler::instance().addTaskGroup(group);
+
+			taskA->cancel();
+			gateOpen = true;
+
+			taskC->wait();
+			group->wait();
+
+			// Added after its dependency was already canceled
+			SPtr<Task> taskD = Task::create("TestD", [&]() { numExecuted++; }, TaskPriority::Normal, taskA);
+			TaskScheduler::instance().addTask(taskD);
+			taskD->wait();
+
+			BS_TEST_ASSERT(gate->isComplete());
+			BS_TEST_ASSERT(taskB->isCanceled() && taskC->isCanceled() && taskD->isCanceled());
+			BS_TEST_ASSERT(!group->isComplete());
+			BS_TEST_ASSERT(numExecuted == 0);
+		}
+
+		// Task groups
+		{
+			static constexpr UINT32 NUM_ITEMS = 1000;
+			std::atomic<UINT32> visited[NUM_ITEMS];
+			for(auto& entry : visited)
+				entry = 0;
+
+			SPtr<TaskGroup> group = TaskGroup::create("TestGroup", [&](UINT32 idx) { visited[idx]++; }, NUM_ITEMS);
+			TaskScheduler::instance().addTaskGroup(group);
+			group->wait();
+
+			for(auto& entry : visited)
+				BS_TEST_ASSERT(entry == 1);
+		}
+
+		// Many tiny tasks, queued from outside and from within the workers
+		{
+			static constexpr UINT32 NUM_FRAMES = 10;
+
+			const UINT32 numExecuted = runTinyTasks(NUM_FRAMES);
+			BS_TEST_ASSERT(numExecuted == NUM_FRAMES * NUM_TINY_TASKS_PER_FRAME);
+		}
+
+		// Parallel for, each index must be visited exactly once
+		{
+			static constexpr UINT32 NUM_ITEMS = 1000000;
+			Vector<UINT8> visited(NUM_ITEMS, 0);
+
+			TaskScheduler::instance().parallelFor(0, NUM_ITEMS, 0, [&visited](UINT32 begin, UINT32 end)
+			{
+				for(UINT32 i = begin; i < end; i++)
+					visited[i]++;
+			});
+
+			bool allVisitedOnce = true;
+			for(auto& entry : visited)
+				allVisitedOnce &= entry == 1;
+
+			BS_TEST_ASSERT(allVisitedOnce);
+
+			// Uneven work per index, with small grains
+			std::atomic<UINT64> sum{0};
+			TaskScheduler::instance().parallelFor(10, 5000, 3, [&sum](UINT32 begin, UINT32 end)
+			{
+				UINT64 localSum = 0;
+				for(UINT32 i = begin; i < end; i++)
+				{
+					if((i % 100) == 0)
+						BS_THREAD_SLEEP(1);
+
+					localSum += i;
+				}
+
+				sum += localSum;
+			});
+
+			BS_TEST_ASSERT(sum == (4990ULL * (10 + 4999)) / 2);
+
+			// Nested calls from tasks occupying every worker, the helper tasks never get to run
+			static constexpr UINT32 NUM_OUTER = 64;
+			static constexpr UINT32 NUM_INNER = 256;
+
+			const UINT32 numTasks = TaskScheduler::instance().getNumWorkers();
+			std::atomic<UINT32> numInnerItems{0};
+
+			Vector<SPtr<Task>> tasks;
+			for(UINT32 i = 0; i < numTasks; i++)
+			{
+				tasks.push_back(Task::create("NestedParallelFor", [&numInnerItems]()
+				{
+					TaskScheduler::instance().parallelFor(0, NUM_OUTER, 1, [&numInnerItems](UINT32 begin, UINT32 end)
+					{
+						for(UINT32 j = begin; j < end; j++)
+						{
+							TaskScheduler::instance().parallelFor(0, NUM_INNER, 1,
+								[&numInnerItems](UINT32 innerBegin, UINT32 innerEnd)
+							{
+								numInnerItems += innerEnd - innerBegin;
+							});
+						}
+					});
+				}));
+
+				TaskScheduler::instance().addTask(tasks.back());
+			}
+
+			for(auto& task : tasks)
+				task->wait();
+
+			BS_TEST_ASSERT(numInnerItems == numTasks * NUM_OUTER * NUM_INNER);
+		}
+
+		// Parallel radix sort, must match the serial one
+		{
+			static constexpr UINT32 NUM_ELEMENTS = 100000;
+
+			Vector<UINT32> keys;
+			Vector<UINT32> values;
+			for(UINT32 i = 0; i < NUM_ELEMENTS; i++)
+			{
+				keys.push_back(((UINT32)(rand() % 16) << 24) | (UINT32)(rand() % 4096));
+				values.push_back(i);
+			}
+
+			Vector<UINT32> expectedKeys = keys;
+			Vector<UINT32> expectedValues = values;
+
+			Vector<UINT32> tmpKeys(NUM_ELEMENTS);
+			Vector<UINT32> tmpValues(NUM_ELEMENTS);
+			radixSort(expectedKeys.data(), expectedValues.data(), tmpKeys.data(), tmpValues.data(), NUM_ELEMENTS);
+			radixSortParallel(keys.data(), values.data(), tmpKeys.data(), tmpValues.data(), NUM_ELEMENTS);
+
+			BS_TEST_ASSERT(keys == expectedKeys);
+			BS_TEST_ASSERT(values == expectedValues);
+		}
+
+		// Statistics and tracing
+		{
+			static constexpr UINT32 NUM_TASKS = 100;
+
+			TaskScheduler& scheduler = TaskScheduler::instance();
+			TraceRecorder::startUp();
+			TraceRecorder::instance().setEnabled(true);
+
+			scheduler.setStatisticsEnabled(true);
+			scheduler.resetStatistics();
+
+			Vector<SPtr<Task>> tasks(NUM_TASKS);
+			for(UINT32 i = 0; i < NUM_TASKS; i++)
+			{
+				tasks[i] = Task::create("TestStats", []() { BS_THREAD_SLEEP(0); });
+				scheduler.addTask(tasks[i]);
+			}
+
+			SPtr<Task> slowTask = Task::create("TestStatsSlow", []() { BS_THREAD_SLEEP(5); });
+			scheduler.addTask(slowTask);
+			slowTask->wait();
+
+			for(auto& task : tasks)
+				task->wait();
+
+			TaskSchedulerReport report = scheduler.generateReport();
+			scheduler.setStatisticsEnabled(false);
+
+			const TaskStatistics* stats = nullptr;
+			const TaskStatistics* slowStats = nullptr;
+			for(auto& entry : report.tasks)
+			{
+				if(entry.name == "TestStats")
+					stats = &entry;
+				else if(entry.name == "TestStatsSlow")
+					slowStats = &entry;
+			}
+
+			BS_TEST_ASSERT(stats != nullptr && slowStats != nullptr);
+			if(stats != nullptr && slowStats != nullptr)
+			{
+				BS_TEST_ASSERT(stats->numExecuted == NUM_TASKS);
+				BS_TEST_ASSERT(slowStats->numExecuted == 1);
+				BS_TEST_ASSERT(slowStats->maxRunTimeNs >= 4000000);
+				BS_TEST_ASSERT(slowStats->runTimes.buckets[TaskTimeHistogram::NUM_BUCKETS - 1] == 0);
+
+				UINT32 numLatencies = 0;
+				for(auto& entry : stats->latencies.buckets)
+					numLatencies += entry;
+
+				BS_TEST_ASSERT(numLatencies == NUM_TASKS);
+			}
+
+			UINT32 numExecuted = 0;
+			for(auto& entry : report.workers)
+				numExecuted += entry.numExecuted;
+
+			BS_TEST_ASSERT(numExecuted == NUM_TASKS + 1);
+			BS_TEST_ASSERT(report.maxQueuedTasks >= 1);
+			BS_TEST_ASSERT(report.numWaits >= 1 && report.numWaitWorkers >= 1);
+
+			// Tasks are recorded on the worker threads, and the blocked wait on this thread
+			Vector<String> threadNames;
+			Vector<Vector<TraceEvent>> threadEvents;
+			TraceRecorder::instance().getEvents(threadNames, threadEvents);
+
+			const UINT32 taskName = TraceRecorder::registerName("TestStatsSlow");
+			const UINT32 waitName = TraceRecorder::registerName("TaskScheduler wait");
+
+			bool foundTask = false;
+			bool foundWait = false;
+			for(UINT32 i = 0; i < (UINT32)threadEvents.size(); i++)
+			{
+				for(auto& event : threadEvents[i])
+				{
+					foundTask |= event.name == taskName && threadNames[i].find("TaskWorker") == 0;
+					foundWait |= event.name == waitName;
+				}
+			}
+
+			BS_TEST_ASSERT(foundTask && foundWait);
+
+			TraceRecorder::shutDown();
+		}
+	}
+
+#if BS_BENCHMARKS
+	void UtilityTestSuite::benchmarkTaskScheduler()
+	{
+		static constexpr UINT32 NUM_FRAMES = 10;
+
+		TaskScheduler& scheduler = TaskScheduler::instance();
+		const UINT32 numCores = scheduler.getNumWorkers();
+
+		// Tens of thousands of tiny tasks per frame, on an increasing number of workers
+		for(UINT32 numWorkers = 1;; numWorkers = std::min(numWorkers * 2, numCores))
+		{
+			while(scheduler.getNumWorkers() > numWorkers)
+				scheduler.removeWorker();
+
+			while(scheduler.getNumWorkers() < numWorkers)
+				scheduler.addWorker();
+
+			// Warm up, so lazily created workers don't skew the results
+			runTinyTasks(1);
+
+			Timer timer;
+			const UINT32 numExecuted = runTinyTasks(NUM_FRAMES);
+			const UINT64 elapsedUs = timer.getMicroseconds();
+
+			BS_TEST_ASSERT(numExecuted == NUM_FRAMES * NUM_TINY_TASKS_PER_FRAME);
+
+			gDebug().logDebug("TaskScheduler: " + toString(NUM_TINY_TASKS_PER_FRAME) + " tasks per frame on " +
+				toString(numWorkers) + " workers, " + toString(elapsedUs / NUM_FRAMES) + "us per frame.");
+
+			if(numWorkers >= numCores)
+				break;
+		}
+	}
+
+	void UtilityTestSuite::benchmarkParallelFor()
+	{
+		static constexpr UINT32 NUM_ITEMS = 1000000;
+		static constexpr UINT32 NUM_GROUP_ITEMS = 100000;
+
+		Vector<UINT32> values(NUM_ITEMS, 0);
+		const auto worker = [&values](UINT32 begin, UINT32 end)
+		{
+			for(UINT32 i = begin; i < end; i++)
+				values[i]++;
+		};
+
+		// Per-item overhead with automatically picked grains, and with one item per grain
+		String timings;
+		for(auto grainSize : { 0U, 1U })
+		{
+			Timer timer;
+			TaskScheduler::instance().parallelFor(0, NUM_ITEMS, grainSize, worker);
+			const UINT64 elapsedUs = timer.getMicroseconds();
+
+			timings += ", grain " + toString(grainSize) + " " + toString(elapsedUs * 1000 / NUM_ITEMS) + "ns/item";
+		}
+
+		// Same for a task group, which calls its worker once per index
+		Timer timer;
+		SPtr<TaskGroup> group = TaskGroup::create("TestGroup", [&values](UINT32 idx) { values[idx]++; },
+			NUM_GROUP_ITEMS);
+		TaskScheduler::instance().addTaskGroup(group);
+		group->wait();
+		const UINT64 groupUs = timer.getMicroseconds();
+
+		bool allVisited = true;
+		for(UINT32 i = 0; i < NUM_ITEMS; i++)
+			allVisited &= values[i] == (i < NUM_GROUP_ITEMS ? 3U : 2U);
+
+		BS_TEST_ASSERT(allVisited);
+
+		gDebug().logDebug("TaskScheduler: parallelFor over " + toString(NUM_ITEMS) + " items on " +
+			toString(TaskScheduler::instance().getNumWorkers()) + " workers" + timings + ", task group " +
+			toString(groupUs * 1000 / NUM_GROUP_ITEMS) + "ns/item.");
+	}
+#endif
+
+	void UtilityTestSuite::testConvexVolume()
+	{
+		static constexpr UINT32 NUM_BOXES = 1001;
+
+		Matrix4 proj = Matrix4::projectionPerspective(Degree(90.0f), 1.0f, 0.1f, 100.0f);
+		ConvexVolume frustum(proj);
+
+		Vector<AABox> boxes;
+		Vector<float> centers[3];
+		Vector<float> extents[3];
+		for(UINT32 i = 0; i < NUM_BOXES; i++)
+		{
+			Vector3 center(
+				((rand() / (float)RAND_MAX) * 2.0f - 1.0f) * 150.0f,
+				((rand() / (float)RAND_MAX) * 2.0f - 1.0f) * 150.0f,
+				((rand() / (float)RAND_MAX) * 2.0f - 1.0f) * 150.0f
+			);
+
+			Vector3 extent = Vector3::ONE * (0.1f + (rand() / (float)RAND_MAX) * 10.0f);
+			boxes.push_back(AABox(center - extent, center + extent));
+
+			for(UINT32 j = 0; j < 3; j++)
+			{
+				centers[j].push_back(center[j]);
+				extents[j].push_back(extent[j]);
+			}
+		}
+
+		Bitfield visibility;
+		visibility.resize(NUM_BOXES, false);
+
+		const float* const centerData[3] = { centers[0].data(), centers[1].data(), centers[2].data() };
+		const float* const extentData[3] = { extents[0].data(), extents[1].data(), extents[2].data() };
+		frustum.intersects(centerData, extentData, NUM_BOXES, visibility.data());
+
+		for(UINT32 i = 0; i < NUM_BOXES; i++)
+			BS_TEST_ASSERT(visibility[i] == frustum.intersects(boxes[i]));
+
+		// Combined sphere & box test
+		Vector<float> radii;
+		for(UINT32 i = 0; i < NUM_BOXES; i++)
+			radii.push_back(boxes[i].getHalfSize().length() * (rand() / (float)RAND_MAX));
+
+		visibility.reset(false);
+		frustum.intersects(centerData, extentData, radii.data(), NUM_BOXES, visibility.data());
+
+		for(UINT32 i = 0; i < NUM_BOXES; i++)
+		{
+			const bool expected = frustum.intersects(boxes[i]) && 
+				frustum.intersects(Sphere(boxes[i].getCenter(), radii[i]));
+
+			BS_TEST_ASSERT(visibility[i] == expected);
+		}
+	}
+
+	void UtilityTestSuite::testOctreeCulling()
+	{
+		static constexpr UINT32 NUM_ELEMENTS = 10000;
+
+		DebugOctreeData octreeData;
+		DebugOctree octree(Vector3::ZERO, 2000.0f, &octreeData);
+
+		for(UINT32 i = 0; i < NUM_ELEMENTS; i++)
+		{
+			Vector3 position(
+				((rand() / (float)RAND_MAX) * 2.0f - 1.0f) * 2000.0f,
+				((rand() / (float)RAND_MAX) * 2.0f - 1.0f) * 200.0f,
+				((rand() / (float)RAND_MAX) * 2.0f - 1.0f) * 2000.0f
+			);
+
+			Vector3 extent = Vector3::ONE * (0.5f + (rand() / (float)RAND_MAX) * 5.0f);
+
+			DebugOctreeElem elem;
+			elem.box = AABox(position - extent, position + extent);
+
+			octreeData.elements.push_back(elem);
+			octree.addElement(i);
+		}
+
+		// Elements outside of the octree bounds must still be found
+		DebugOctreeElem outsideElem;
+		outsideElem.box = AABox(Vector3(-5.0f, -5.0f, -3000.0f), Vector3(5.0f, 5.0f, -2990.0f));
+		octreeData.elements.push_back(outsideElem);
+		octree.addElement(NUM_ELEMENTS);
+
+		Matrix4 proj = Matrix4::projectionPerspective(Degree(75.0f), 16.0f / 9.0f, 0.1f, 5000.0f);
+		ConvexVolume frustum(proj);
+
+		Bitfield visibility;
+		visibility.resize(NUM_ELEMENTS + 1, false);
+
+		DebugOctree::VolumeIntersectIterator iter(octree, frustum);
+		while(iter.moveNext())
+		{
+			UINT32 element = iter.getElement();
+			BS_TEST_ASSERT(visibility[element] == false);
+
+			visibility[element] = true;
+		}
+
+		// Ensure the octree found exactly the same elements as testing each element individually
+		for(UINT32 i = 0; i < (UINT32)octreeData.elements.size(); i++)
+			BS_TEST_ASSERT(visibility[i] == frustum.intersects(octreeData.elements[i].box));
+
+		BS_TEST_ASSERT(visibility[NUM_ELEMENTS]);
+
+		// Remove half of the elements, ensuring node collapse keeps the element IDs valid
+		for(UINT32 i = 0; i < NUM_ELEMENTS; i += 2)
+			octree.removeElement(octreeData.elements[i].octreeId);
+
+		visibility.reset(false);
+		DebugOctree::VolumeIntersectIterator iter2(octree, frustum);
+		while(iter2.moveNext())
+		{
+			UINT32 element = iter2.getElement();
+			BS_TEST_ASSERT((element & 1) == 1 || element == NUM_ELEMENTS);
+
+			visibility[element] = true;
+		}
+
+		for(UINT32 i = 1; i < NUM_ELEMENTS; i += 2)
+			BS_TEST_ASSERT(visibility[i] == frustum.intersects(octreeData.elements[i].box));
+
+		for(UINT32 i = 1; i < NUM_ELEMENTS; i += 2)
+			octree.removeElement(octreeData.elements[i].octreeId);
+
+		octree.removeElement(octreeData.elements[NUM_ELEMENTS].octreeId);
+	}
+
+	void UtilityTestSuite::testRadixSort()
+	{
+		static constexpr UINT32 NUM_ELEMENTS = 5000;
+
+		// Keys with duplicates and a few constant bytes, to test stability and skipping of trivial digits
+		Vector<UINT64> keys;
+		Vector<UINT32> values;
+		for(UINT32 i = 0; i < NUM_ELEMENTS; i++)
+		{
+			keys.push_back(((UINT64)(rand() % 4) << 56) | ((UINT64)(rand() % 512) << 8));
+			values.push_back(i);
+		}
+
+		Vector<std::pair<UINT64, UINT32>> expected;
+		for(UINT32 i = 0; i < NUM_ELEMENTS; i++)
+			expected.push_back(std::make_pair(keys[i], values[i]));
+
+		std::stable_sort(expected.begin(), expected.end(),
+			[](const std::pair<UINT64, UINT32>& a, const std::pair<UINT64, UINT32>& b) { return a.first < b.first; });
+
+		Vector<UINT64> tmpKeys(NUM_ELEMENTS);
+		Vector<UINT32> tmpValues(NUM_ELEMENTS);
+		radixSort(keys.data(), values.data(), tmpKeys.data(), tmpValues.data(), NUM_ELEMENTS);
+
+		for(UINT32 i = 0; i < NUM_ELEMENTS; i++)
+		{
+			BS_TEST_ASSERT(keys[i] == expected[i].first);
+			BS_TEST_ASSERT(values[i] == expected[i].second);
+		}
+
+		// Float keys
+		float floats[] = { 5.0f, -0.0f, -1.5f, 0.0f, 1e-30f, -1e30f, 3.0f, -2.0f };
+		for(UINT32 i = 0; i < sizeof(floats) / sizeof(floats[0]) - 1; i++)
+		{
+			for(UINT32 j = i + 1; j < sizeof(floats) / sizeof(floats[0]); j++)
+			{
+				const UINT32 a = floatToSortableUInt(floats[i]);
+				const UINT32 b = floatToSortableUInt(floats[j]);
+
+				BS_TEST_ASSERT((floats[i] < floats[j]) == (a < b));
+				BS_TEST_ASSERT((floats[i] == floats[j]) == (a == b));
+			}
+		}
+	}
+
+	void UtilityTestSuite::testTraceRecorder()
+	{
+		static constexpr UINT32 EVENTS_PER_THREAD = 64;
+		TraceRecorder recorder(EVENTS_PER_THREAD);
+
+		const UINT32 outerName = TraceRecorder::registerName("Outer");
+		const UINT32 innerName = TraceRecorder::registerName("Inner \"quoted\"");
+		BS_TEST_ASSERT(TraceRecorder::registerName("Outer") == outerName);
+		BS_TEST_ASSERT(TraceRecorder::getName(innerName) == "Inner \"quoted\"");
+
+		// Nothing is recorded while disabled
+		recorder.beginEvent(outerName);
+		recorder.endEvent(outerName);
+
+		recorder.setEnabled(true);
+		recorder.setThreadName("Main");
+
+		recorder.beginEvent(outerName);
+		recorder.beginEvent(innerName);
+		recorder.endEvent(innerName);
+		recorder.endEvent(outerName);
+
+		Thread thread([&recorder, innerName]()
+		{
+			recorder.setThreadName("Worker");
+			recorder.beginEvent(innerName);
+			recorder.endEvent(innerName);
+		});
+		thread.join();
+
+		Vector<String> threadNames;
+		Vector<Vector<TraceEvent>> threadEvents;
+		recorder.getEvents(threadNames, threadEvents);
+
+		BS_TEST_ASSERT(threadNames.size() == 2 && threadEvents.size() == 2);
+		BS_TEST_ASSERT(threadNames[0] == "Main" && threadNames[1] == "Worker");
+		BS_TEST_ASSERT(threadEvents[0].size() == 4 && threadEvents[1].size() == 2);
+
+		if(threadEvents.size() == 2 && threadEvents[0].size() == 4)
+		{
+			const Vector<TraceEvent>& events = threadEvents[0];
+			BS_TEST_ASSERT(events[0].name == outerName && events[0].type == TraceEventType::Begin);
+			BS_TEST_ASSERT(events[1].name == innerName && events[1].type == TraceEventType::Begin);
+			BS_TEST_ASSERT(events[2].name == innerName && events[2].type == TraceEventType::End);
+			BS_TEST_ASSERT(events[3].name == outerName && events[3].type == TraceEventType::End);
+
+			for(UINT32 i = 1; i < 4; i++)
+				BS_TEST_ASSERT(events[i].timestamp >= events[i - 1].timestamp);
+		}
+
+		// Only the newest events are kept once the buffer wraps around, and the end events left without their begin
+		// event aren't exported
+		recorder.clear();
+
+		recorder.beginEvent(outerName);
+		for(UINT32 i = 0; i < EVENTS_PER_THREAD; i++)
+		{
+			recorder.beginEvent(innerName);
+			recorder.endEvent(innerName);
+		}
+		recorder.endEvent(outerName);
+
+		threadNames.clear();
+		threadEvents.clear();
+		recorder.getEvents(threadNames, threadEvents);
+
+		BS_TEST_ASSERT(threadEvents.size() == 1);
+		if(threadEvents.size() == 1)
+		{
+			// Oldest slot is always considered to be in the process of being overwritten
+			BS_TEST_ASSERT(threadEvents[0].size() == EVENTS_PER_THREAD - 1);
+			BS_TEST_ASSERT(threadEvents[0].back().name == outerName);
+		}
+
+		MemoryDataStream stream(1024 * 1024);
+		recorder.exportChromeTrace(stream);
+
+		String trace((const char*)stream.getPtr(), stream.tell());
+		BS_TEST_ASSERT(trace.find("\"args\":{\"name\":\"Main\"}") != String::npos);
+		BS_TEST_ASSERT(trace.find("\"Inner \\\"quoted\\\"\",\"ph\":\"B\"") != String::npos);
+		BS_TEST_ASSERT(trace.find("\"Outer\",\"ph\"") == String::npos);
+		BS_TEST_ASSERT(trace.find("Worker") == String::npos);
+	}
 }
@@ -16,5 +16,15 @@ namespace bs
 	private:
 		void testBitfield();
 		void testOctree();
+		void testTaskScheduler();
+		void testConvexVolume();
+		void testOctreeCulling();
+		void testRadixSort();
+		void testTraceRecorder();
+
+#if BS_BENCHMARKS
+		void benchmarkTaskScheduler();
+		void benchmarkParallelFor();
+#endif
 	};
 }
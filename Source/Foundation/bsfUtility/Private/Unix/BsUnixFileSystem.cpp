@@ -8,6 +8,8 @@
 
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -150,6 +152,44 @@ namespace bs
 		return bs_shared_ptr_new<FileDataStream>(path, DataStream::AccessMode::WRITE, true);
 	}
 
+	SPtr<DataStream> FileSystem::mapFile(const Path& path)
+	{
+		int fileHandle = open(path.toString().c_str(), O_RDONLY);
+		if (fileHandle == -1)
+			return nullptr;
+
+		struct stat st_buf;
+		if (fstat(fileHandle, &st_buf) != 0 || !S_ISREG(st_buf.st_mode) || st_buf.st_size == 0)
+		{
+			::close(fileHandle);
+			return nullptr;
+		}
+
+		// Private mapping so that any writes to the memory stay local to the process, instead of modifying the file
+		const size_t size = (size_t)st_buf.st_size;
+		void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileHandle, 0);
+
+		// Mapping remains valid after the file is closed
+		::close(fileHandle);
+
+		if (memory == MAP_FAILED)
+			return nullptr;
+
+		// Streams are generally read from start to end, so start reading in the contents right away
+		madvise(memory, size, MADV_WILLNEED);
+
+		return bs_shared_ptr_new<MappedFileDataStream>(path, memory, size);
+	}
+
+	void MappedFileDataStream::close()
+	{
+		if (mData != nullptr)
+		{
+			munmap(mData, mSize);
+			mData = nullptr;
+		}
+	}
+
 	UINT64 FileSystem::getFileSize(const Path& path)
 	{
 		struct stat st_buf;
@@ -293,6 +293,50 @@ namespace bs
 		return bs_shared_ptr_new<FileDataStream>(fullPath, DataStream::AccessMode::WRITE, true);
 	}
 
+	SPtr<DataStream> FileSystem::mapFile(const Path& fullPath)
+	{
+		WString pathWString = UTF8::toWide(fullPath.toString());
+
+		HANDLE fileHandle = CreateFileW(pathWString.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (fileHandle == INVALID_HANDLE_VALUE)
+			return nullptr;
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+		{
+			CloseHandle(fileHandle);
+			return nullptr;
+		}
+
+		// Copy-on-write mapping, so writes to the memory stay local to the process instead of modifying the file
+		HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+		void* memory = nullptr;
+		if (mappingHandle != nullptr)
+		{
+			memory = MapViewOfFile(mappingHandle, FILE_MAP_COPY, 0, 0, 0);
+
+			// View remains valid after the handles are closed
+			CloseHandle(mappingHandle);
+		}
+
+		CloseHandle(fileHandle);
+
+		if (memory == nullptr)
+			return nullptr;
+
+		return bs_shared_ptr_new<MappedFileDataStream>(fullPath, memory, (size_t)fileSize.QuadPart);
+	}
+
+	void MappedFileDataStream::close()
+	{
+		if (mData != nullptr)
+		{
+			UnmapViewOfFile(mData);
+			mData = nullptr;
+		}
+	}
+
 	UINT64 FileSystem::getFileSize(const Path& fullPath)
 	{
 		return win32_getFileSize(UTF8::toWide(fullPath.toString()));
@@ -397,6 +397,16 @@ namespace bs
 							// Data block size
 							COPY_TO_BUFFER(&dataBlockSize, sizeof(UINT32))
 
+							// Padding, so the data starts at an aligned offset
+							const UINT32 dataOffset = mTotalBytesWritten + *bytesWritten + sizeof(UINT8);
+							const UINT32 misalignment = dataOffset % DATA_BLOCK_ALIGNMENT;
+							const UINT8 paddingSize = (UINT8)(misalignment != 0 ?
+								DATA_BLOCK_ALIGNMENT - misalignment : 0);
+							const UINT8 padding[DATA_BLOCK_ALIGNMENT] = { 0 };
+
+							COPY_TO_BUFFER(&paddingSize, sizeof(UINT8))
+							COPY_TO_BUFFER(padding, paddingSize)
+
 							// Data block data
 							UINT8* dataToStore = (UINT8*)bs_stack_alloc(dataBlockSize);
 							blockStream->read(dataToStore, dataBlockSize);
@@ -552,7 +562,9 @@ namespace bs
 			UINT8 fieldSize;
 			bool hasDynamicSize;
 			bool terminator;
-			decodeFieldMetaData(metaData, fieldId, fieldSize, isArray, fieldType, hasDynamicSize, terminator);
+			bool alignedDataBlock;
+			decodeFieldMetaData(metaData, fieldId, fieldSize, isArray, fieldType, hasDynamicSize, terminator,
+				alignedDataBlock);
 
 			if (terminator)
 			{
@@ -840,6 +852,18 @@ namespace bs
 						BS_EXCEPT(InternalErrorException, "Error decoding data.");
 					}
 
+					// Padding (not present in data encoded before data blocks were aligned)
+					if (alignedDataBlock)
+					{
+						UINT8 paddingSize = 0;
+						if(data->read(&paddingSize, sizeof(UINT8)) != sizeof(UINT8))
+						{
+							BS_EXCEPT(InternalErrorException, "Error decoding data.");
+						}
+
+						data->skip(paddingSize);
+					}
+
 					// Data block data
 					if (curField != nullptr)
 					{
@@ -853,11 +877,13 @@ namespace bs
 						}
 						else
 						{
-							UINT8* dataBlockBuffer = (UINT8*)bs_alloc(dataBlockSize);
-							data->read(dataBlockBuffer, dataBlockSize);
+							// Reference the data in place, fields will copy it if they need to
+							SPtr<MemoryDataStream> memStream = std::static_pointer_cast<MemoryDataStream>(data);
+							SPtr<DataStream> stream = bs_shared_ptr_new<MemoryDataStream>(memStream, memStream->tell(),
+								dataBlockSize);
 
-							SPtr<DataStream> stream = bs_shared_ptr_new<MemoryDataStream>(dataBlockBuffer, dataBlockSize);
 							curField->setValue(rttiInstance, output.get(), stream, dataBlockSize);
+							memStream->seek(memStream->tell() + stream->size());
 						}
 					}
 					else
@@ -898,7 +924,7 @@ namespace bs
 		bool hasDynamicSize, bool terminator)
 	{
 		// If O == 0 - Meta contains field information (Encoded using this method)
-		//// Encoding: IIII IIII IIII IIII SSSS SSSS xTYP DCAO
+		//// Encoding: IIII IIII IIII IIII SSSS SSSS LTYP DCAO
 		//// I - Id
 		//// S - Size
 		//// C - Complex
@@ -908,10 +934,11 @@ namespace bs
 		//// O - Object descriptor
 		//// Y - Plain field has dynamic size
 		//// T - Terminator (last field in an object)
+		//// L - Data block contents are padded to DATA_BLOCK_ALIGNMENT
 
 		return (id << 16 | size << 8 | 
 			(array ? 0x02 : 0) | 
-			((type == SerializableFT_DataBlock) ? 0x04 : 0) | 
+			((type == SerializableFT_DataBlock) ? (0x04 | 0x80) : 0) | 
 			((type == SerializableFT_Reflectable) ? 0x08 : 0) | 
 			((type == SerializableFT_ReflectablePtr) ? 0x10 : 0) | 
 			(hasDynamicSize ? 0x20 : 0) |
@@ -919,7 +946,7 @@ namespace bs
 	}
 
 	void BinarySerializer::decodeFieldMetaData(UINT32 encodedData, UINT16& id, UINT8& size, 
-		bool& array, SerializableFieldType& type, bool& hasDynamicSize, bool& terminator)
+		bool& array, SerializableFieldType& type, bool& hasDynamicSize, bool& terminator, bool& alignedDataBlock)
 	{
 		if(isObjectMetaData(encodedData))
 		{
@@ -927,6 +954,7 @@ namespace bs
 				"Meta data represents an object description but is trying to be decoded as a field descriptor.");
 		}
 
+		alignedDataBlock = (encodedData & 0x80) != 0;
 		terminator = (encodedData & 0x40) != 0;
 		hasDynamicSize = (encodedData & 0x20) != 0;
 
@@ -68,6 +68,12 @@ namespace bs
 		 */
 		SPtr<IReflectable> decode(const SPtr<DataStream>& data, UINT32 dataLength, 
 			const UnorderedMap<String, UINT64>& params = UnorderedMap<String, UINT64>());
+
+		/**
+		 * Alignment of data block contents, in bytes, relative to the start of the encoded data. As long as the encoded
+		 * data itself starts at an address aligned to this value, decoded data blocks can be referenced in place.
+		 */
+		static constexpr const UINT32 DATA_BLOCK_ALIGNMENT = 16;
 	private:
 		struct ObjectMetaData
 		{
@@ -127,7 +133,7 @@ namespace bs
 
 		/** Decode meta field that was encoded using encodeFieldMetaData().*/
 		static void decodeFieldMetaData(UINT32 encodedData, UINT16& id, UINT8& size, bool& array, 
-			SerializableFieldType& type, bool& hasDynamicSize, bool& terminator);
+			SerializableFieldType& type, bool& hasDynamicSize, bool& terminator, bool& alignedDataBlock);
 
 		/**
 		 * Encodes data required for representing an object identifier, into 8 bytes.
@@ -2,9 +2,62 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Threading/BsTaskScheduler.h"
 #include "Threading/BsThreadPool.h"
+#include "Debug/BsTraceRecorder.h"
+#include "Math/BsMath.h"
+#include "Utility/BsBitwise.h"
+
+using namespace std::chrono;
 
 namespace bs
 {
+	/** Returns the current time in nanoseconds, used for task statistics. */
+	static UINT64 getTimeNs()
+	{
+		return (UINT64)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+	}
+
+	/** Returns the trace recorder if it is currently recording, or null otherwise. */
+	static TraceRecorder* getActiveTraceRecorder()
+	{
+		if(!TraceRecorder::isStarted())
+			return nullptr;
+
+		TraceRecorder* recorder = TraceRecorder::instancePtr();
+		return recorder->isEnabled() ? recorder : nullptr;
+	}
+
+	void TaskTimeHistogram::add(UINT64 timeNs)
+	{
+		const UINT64 timeUs = timeNs / 1000;
+
+		UINT32 bucket = 0;
+		if(timeUs > 0)
+		{
+			const UINT32 clampedTimeUs = (UINT32)std::min(timeUs, (UINT64)std::numeric_limits<UINT32>::max());
+			bucket = std::min(Bitwise::mostSignificantBit(clampedTimeUs) + 1, NUM_BUCKETS - 1);
+		}
+
+		buckets[bucket]++;
+	}
+
+	void TaskTimeHistogram::merge(const TaskTimeHistogram& other)
+	{
+		for(UINT32 i = 0; i < NUM_BUCKETS; i++)
+			buckets[i] += other.buckets[i];
+	}
+
+	void TaskStatistics::merge(const TaskStatistics& other)
+	{
+		numExecuted += other.numExecuted;
+		totalRunTimeNs += other.totalRunTimeNs;
+		maxRunTimeNs = std::max(maxRunTimeNs, other.maxRunTimeNs);
+		totalLatencyNs += other.totalLatencyNs;
+		maxLatencyNs = std::max(maxLatencyNs, other.maxLatencyNs);
+
+		runTimes.merge(other.runTimes);
+		latencies.merge(other.latencies);
+	}
+
 	Task::Task(const PrivatelyConstruct& dummy, const String& name, std::function<void()> taskWorker,
 		TaskPriority priority, SPtr<Task> dependency)
 		: mName(name), mPriority(priority), mTaskWorker(std::move(taskWorker)), mTaskDependency(std::move(dependency))
@@ -59,217 +112,752 @@ namespace bs
 		return mNumRemainingTasks == 0;
 	}
 
+	bool TaskGroup::isDependencyCanceled() const
+	{
+		return mTaskDependency != nullptr && mTaskDependency->isCanceled();
+	}
+
 	void TaskGroup::wait()
 	{
-		if(mParent != nullptr)
-			mParent->waitUntilComplete(this);
+		if(mParent == nullptr)
+			return;
+
+		// Help out with the remaining items, unless we're still waiting on the dependency
+		if(mTaskDependency == nullptr || mTaskDependency->isComplete())
+			executeItems();
+
+		mParent->waitUntilComplete(this);
 	}
 
-	TaskScheduler::TaskScheduler()
-		:mTaskQueue(&TaskScheduler::taskCompare)
+	void TaskGroup::executeItems()
 	{
-		mMaxActiveTasks = BS_THREAD_HARDWARE_CONCURRENCY;
+		while(mNextItem.load(std::memory_order_relaxed) < mCount)
+		{
+			const UINT32 idx = mNextItem.fetch_add(1);
+			if(idx >= mCount)
+				break;
 
-		mTaskSchedulerThread = ThreadPool::instance().run("TaskScheduler", std::bind(&TaskScheduler::runMain, this));
+			mTaskWorker(idx);
+			--mNumRemainingTasks;
+		}
 	}
 
-	TaskScheduler::~TaskScheduler()
+	/** 
+	 * Shared state of a single TaskScheduler::parallelFor() call. Each participating thread owns a slot containing a
+	 * portion of the range that is yet to be processed. Slots are not tied to a specific thread, whichever thread gets
+	 * to a slot first claims it, so the portions of helper tasks that haven't started yet can be picked up by others.
+	 */
+	struct ParallelForJob
 	{
-		// Wait until all tasks complete
+		/** Portion of the range owned by a single thread, with the start in the lower and the end in the upper 32 bits. */
+		struct alignas(64) Slot
 		{
-			Lock activeTaskLock(mReadyMutex);
+			std::atomic<UINT64> range{0};
+			std::atomic<bool> claimed{false};
+		};
 
-			while (mActiveTasks.size() > 0)
+		ParallelForJob(const std::function<void(UINT32, UINT32)>& worker, UINT32 grainSize, UINT32 numRemaining, 
+			UINT32 numSlots)
+			: worker(worker), grainSize(grainSize), numRemaining(numRemaining), numSlots(numSlots)
+		{
+			slots = bs_newN<Slot>(numSlots);
+		}
+
+		~ParallelForJob()
+		{
+			bs_deleteN(slots, numSlots);
+		}
+
+		static UINT64 packRange(UINT32 begin, UINT32 end) { return ((UINT64)end << 32) | begin; }
+		static UINT32 getBegin(UINT64 range) { return (UINT32)(range & 0xFFFFFFFF); }
+		static UINT32 getEnd(UINT64 range) { return (UINT32)(range >> 32); }
+
+		/** 
+		 * Processes the range in the provided slot, followed by ranges of any other slots no thread has claimed yet,
+		 * and finally any ranges stolen from other slots. Does nothing if all the slots have already been claimed.
+		 */
+		void execute(UINT32 slotIdx)
+		{
+			UINT32 ownSlotIdx = (UINT32)-1;
+			for(UINT32 i = 0; i < numSlots; i++)
 			{
-				SPtr<Task> task = mActiveTasks[0];
-				activeTaskLock.unlock();
+				const UINT32 idx = (slotIdx + i) % numSlots;
 
-				task->wait();
-				activeTaskLock.lock();
+				bool claimed = false;
+				if(!slots[idx].claimed.compare_exchange_strong(claimed, true))
+					continue;
+
+				executeSlot(idx);
+				ownSlotIdx = idx;
 			}
+
+			if(ownSlotIdx == (UINT32)-1)
+				return;
+
+			while(steal(ownSlotIdx))
+				executeSlot(ownSlotIdx);
 		}
 
-		// Start shutdown of the main queue worker and wait until it exits
+		/** Processes the range in the provided slot one grain at a time, until the range is empty. */
+		void executeSlot(UINT32 slotIdx)
 		{
-			Lock lock(mReadyMutex);
+			std::atomic<UINT64>& range = slots[slotIdx].range;
+
+			UINT64 curRange = range.load();
+			while(true)
+			{
+				const UINT32 begin = getBegin(curRange);
+				const UINT32 end = getEnd(curRange);
+
+				if(begin >= end)
+					break;
+
+				const UINT32 chunkEnd = begin + std::min(end - begin, grainSize);
+				if(!range.compare_exchange_weak(curRange, packRange(chunkEnd, end)))
+					continue;
+
+				worker(begin, chunkEnd);
+				numRemaining -= chunkEnd - begin;
+
+				curRange = range.load();
+			}
+		}
+
+		/** 
+		 * Finds the slot with the most work remaining, and moves the second half of its range into the provided
+		 * (empty) slot. Returns false if there is no work worth stealing.
+		 */
+		bool steal(UINT32 slotIdx)
+		{
+			while(numRemaining > 0)
+			{
+				UINT32 victimIdx = (UINT32)-1;
+				UINT64 victimRange = 0;
+				UINT32 victimSize = grainSize;
+				for(UINT32 i = 0; i < numSlots; i++)
+				{
+					const UINT64 range = slots[i].range.load(std::memory_order_relaxed);
+					const UINT32 size = getEnd(range) - std::min(getBegin(range), getEnd(range));
+
+					if(size > victimSize)
+					{
+						victimIdx = i;
+						victimRange = range;
+						victimSize = size;
+					}
+				}
+
+				if(victimIdx == (UINT32)-1)
+					return false;
+
+				const UINT32 begin = getBegin(victimRange);
+				const UINT32 end = getEnd(victimRange);
+				const UINT32 mid = begin + (end - begin) / 2;
+
+				if(slots[victimIdx].range.compare_exchange_strong(victimRange, packRange(begin, mid)))
+				{
+					slots[slotIdx].range.store(packRange(mid, end));
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		const std::function<void(UINT32, UINT32)>& worker;
+		UINT32 grainSize;
+		std::atomic<UINT32> numRemaining;
+
+		Slot* slots;
+		UINT32 numSlots;
+	};
+
+	/** Data used by a single worker thread of the task scheduler. */
+	struct TaskScheduler::Worker
+	{
+		WorkStealingQueue<Task*> queues[TASK_PRIORITY_COUNT];
+		TaskScheduler* parent = nullptr;
+		UINT32 index = 0;
+		HThread thread;
+
+		bool sleeping = false;
+		Signal wakeCond;
+
+		/** Statistics of tasks executed by this worker, per task name. Guarded by statsLock. */
+		UnorderedMap<String, TaskStatistics> taskStats;
+		TaskWorkerStatistics stats;
+		UINT64 lastTaskEndTime = 0;
+		SpinLock statsLock;
+
+		/** TraceRecorder identifiers of the task names executed by this worker. Only accessed by the worker thread. */
+		UnorderedMap<String, UINT32> traceNames;
+		bool traceNamed = false;
+	};
+
+	BS_THREADLOCAL TaskScheduler::Worker* TaskScheduler::sCurrentWorker = nullptr;
 
+	TaskScheduler::TaskScheduler()
+	{
+		mMaxActiveTasks = std::max(1U, (UINT32)BS_THREAD_HARDWARE_CONCURRENCY);
+
+		for(auto& entry : mSharedQueueSizes)
+			entry.store(0, std::memory_order_relaxed);
+	}
+
+	TaskScheduler::~TaskScheduler()
+	{
+		// Signal the workers to exit as soon as they finish their current task, and wait until they do
+		{
+			Lock lock(mWorkerMutex);
 			mShutdown = true;
+
+			for(UINT32 i = 0; i < mNumWorkers; i++)
+				mWorkers[i]->wakeCond.notify_one();
 		}
 
-		mTaskReadyCond.notify_one();
+		UINT32 numWorkers = mNumWorkers;
+		for(UINT32 i = 0; i < numWorkers; i++)
+			mWorkers[i]->thread.blockUntilComplete();
+
+		// Release any tasks that never got the chance to execute
+		for(UINT32 i = 0; i < numWorkers; i++)
+		{
+			for(auto& queue : mWorkers[i]->queues)
+			{
+				while(Task* task = queue.pop())
+					task->mQueuedRef = nullptr;
+			}
 
-		mTaskSchedulerThread.blockUntilComplete();
+			bs_delete(mWorkers[i]);
+		}
+
+		for(auto& queue : mSharedQueues)
+		{
+			for(auto& task : queue)
+				task->mQueuedRef = nullptr;
+		}
 	}
 
 	void TaskScheduler::addTask(SPtr<Task> task)
 	{
-		Lock lock(mReadyMutex);
-
 		assert(task->mState != 1 && "Task is already executing, it cannot be executed again until it finishes.");
 
 		task->mParent = this;
-		task->mTaskId = mNextTaskId++;
 		task->mState.store(0); // Reset state in case the task is getting re-queued
 
-		mCheckTasks = true;
-		mTaskQueue.insert(std::move(task));
+		// If the dependency is still pending, the task will get queued (or canceled) once it finishes
+		Task* dependency = task->mTaskDependency.get();
+		if(dependency != nullptr)
+		{
+			ScopedSpinLock lock(dependency->mDependentsLock);
+
+			if(dependency->mState < 2)
+			{
+				dependency->mDependents.push_back(std::move(task));
+				return;
+			}
+		}
 
-		// Wake main scheduler thread
-		mTaskReadyCond.notify_one();
+		// A canceled dependency will never complete, so neither can the task
+		if(dependency != nullptr && dependency->isCanceled())
+		{
+			task->mState.store(3);
+			onTaskFinished(task.get());
+			return;
+		}
+
+		queueTask(std::move(task));
 	}
 
 	void TaskScheduler::addTaskGroup(const SPtr<TaskGroup>& taskGroup)
 	{
-		Lock lock(mReadyMutex);
+		taskGroup->mParent = this;
 
-		for(UINT32 i = 0; i < taskGroup->mCount; i++)
+		// Queue one task per worker, each task processing items until none remain
+		const UINT32 numTasks = std::min(taskGroup->mCount, std::max(1U, getNumWorkers()));
+		for(UINT32 i = 0; i < numTasks; i++)
 		{
-			const auto worker = [i, taskGroup] 
-			{ 
-				taskGroup->mTaskWorker(i); 
-				--taskGroup->mNumRemainingTasks;
-			};
+			const auto worker = [taskGroup] { taskGroup->executeItems(); };
+			addTask(Task::create(taskGroup->mName, worker, taskGroup->mPriority, taskGroup->mTaskDependency));
+		}
+	}
+
+	void TaskScheduler::parallelFor(UINT32 begin, UINT32 end, UINT32 grainSize, 
+		const std::function<void(UINT32, UINT32)>& worker, TaskPriority priority)
+	{
+		if(begin >= end)
+			return;
+
+		const UINT32 count = end - begin;
+		const UINT32 maxThreads = getNumWorkers() + 1;
 
-			SPtr<Task> task = Task::create(taskGroup->mName, worker, taskGroup->mPriority, taskGroup->mTaskDependency);
-			task->mParent = this;
-			task->mTaskId = mNextTaskId++;
-			task->mState.store(0); // Reset state in case the task is getting re-queued
+		// Aim for a few grains per thread, so work can be re-balanced if some threads finish early
+		if(grainSize == 0)
+			grainSize = std::max(1U, count / (maxThreads * 4));
 
-			mCheckTasks = true;
-			mTaskQueue.insert(std::move(task));
+		const UINT32 numSlots = std::min(maxThreads, Math::divideAndRoundUp(count, grainSize));
+		if(numSlots <= 1)
+		{
+			worker(begin, end);
+			return;
 		}
 
-		taskGroup->mParent = this;
+		SPtr<ParallelForJob> job = bs_shared_ptr_new<ParallelForJob>(worker, grainSize, count, numSlots);
+
+		const UINT32 slotSize = count / numSlots;
+		for(UINT32 i = 0; i < numSlots; i++)
+		{
+			const UINT32 slotBegin = begin + i * slotSize;
+			const UINT32 slotEnd = (i == (numSlots - 1)) ? end : slotBegin + slotSize;
+
+			job->slots[i].range.store(ParallelForJob::packRange(slotBegin, slotEnd), std::memory_order_relaxed);
+		}
+
+		// Slot 0 belongs to the calling thread, the rest to the helper tasks. If the workers are busy (or this is one
+		// of the workers), the calling thread claims the slots of any helpers that haven't started yet.
+		Vector<SPtr<Task>> helpers;
+		helpers.reserve(numSlots - 1);
 
-		// Wake main scheduler thread
-		mTaskReadyCond.notify_one();
+		for(UINT32 i = 1; i < numSlots; i++)
+		{
+			helpers.push_back(Task::create("ParallelFor", [job, i]() { job->execute(i); }, priority));
+			addTask(helpers.back());
+		}
+
+		job->execute(0);
+
+		// All slots are claimed at this point, so any helpers that haven't started have nothing left to do
+		for(auto& helper : helpers)
+		{
+			UINT32 expectedState = 0;
+			helper->mState.compare_exchange_strong(expectedState, 3);
+		}
+
+		// Wait for any sub-ranges still being processed by the helpers. Worker threads keep executing queued tasks
+		// meanwhile, same as TaskGroup::wait(), so the worker isn't left idle.
+		Worker* currentWorker = isWorkerThread() ? sCurrentWorker : nullptr;
+		while(job->numRemaining > 0)
+		{
+			Task* task = currentWorker != nullptr ? findTask(currentWorker) : nullptr;
+			if(task != nullptr)
+				runTask(task);
+			else
+				std::this_thread::yield();
+		}
 	}
 
 	void TaskScheduler::addWorker()
 	{
-		Lock lock(mReadyMutex);
+		Lock lock(mWorkerMutex);
 
 		mMaxActiveTasks++;
 
-		// A spot freed up, queue new tasks on main scheduler thread if they exist
-		mTaskReadyCond.notify_one();
+		// A spot freed up, let a worker pick up the queued tasks if they exist
+		wakeWorkerLocked();
+	}
+
+	bool TaskScheduler::isWorkerThread() const
+	{
+		return sCurrentWorker != nullptr && sCurrentWorker->parent == this;
 	}
 
 	void TaskScheduler::removeWorker()
 	{
-		Lock lock(mReadyMutex);
+		Lock lock(mWorkerMutex);
 
 		if(mMaxActiveTasks > 0)
 			mMaxActiveTasks--;
 	}
 
-	void TaskScheduler::runMain()
+	void TaskScheduler::queueTask(SPtr<Task> task)
 	{
-		while(true)
+		Task* taskPtr = task.get();
+		taskPtr->mQueuedRef = std::move(task);
+
+		const UINT32 queueIdx = getQueueIdx(taskPtr->mPriority);
+		const UINT32 numQueuedTasks = ++mNumQueuedTasks;
+
+		if(isStatisticsEnabled())
 		{
-			Lock lock(mReadyMutex);
+			taskPtr->mQueueTime = getTimeNs();
 
-			while((!mCheckTasks || (UINT32)mActiveTasks.size() >= mMaxActiveTasks) && !mShutdown)
-				mTaskReadyCond.wait(lock);
+			UINT32 maxQueuedTasks = mMaxQueuedTasks.load(std::memory_order_relaxed);
+			while(numQueuedTasks > maxQueuedTasks && 
+				!mMaxQueuedTasks.compare_exchange_weak(maxQueuedTasks, numQueuedTasks, std::memory_order_relaxed))
+			{ }
+		}
+		else
+			taskPtr->mQueueTime = 0;
+
+		// Workers push to their own queue, other threads use the shared queue
+		Worker* worker = sCurrentWorker;
+		if(worker != nullptr && worker->parent == this)
+			worker->queues[queueIdx].push(taskPtr);
+		else
+		{
+			ScopedSpinLock lock(mSharedQueueLock);
 
-			mCheckTasks = false;
+			mSharedQueues[queueIdx].push_back(taskPtr);
+			mSharedQueueSizes[queueIdx]++;
+		}
 
-			if(mShutdown)
-				break;
+		wakeWorker();
+	}
 
-			for(auto iter = mTaskQueue.begin(); iter != mTaskQueue.end();)
-			{
-				if ((UINT32)mActiveTasks.size() >= mMaxActiveTasks)
-					break;	
+	Task* TaskScheduler::findTask(Worker* worker)
+	{
+		if(worker->index >= mMaxActiveTasks || mShutdown)
+			return nullptr;
 
-				SPtr<Task> curTask = *iter;
+		const UINT32 numWorkers = mNumWorkers.load(std::memory_order_acquire);
+		for(UINT32 i = 0; i < TASK_PRIORITY_COUNT; i++)
+		{
+			if(Task* task = worker->queues[i].pop())
+				return task;
 
-				if(curTask->isCanceled())
+			if(mSharedQueueSizes[i].load(std::memory_order_relaxed) > 0)
+			{
+				ScopedSpinLock lock(mSharedQueueLock);
+
+				if(!mSharedQueues[i].empty())
 				{
-					iter = mTaskQueue.erase(iter);
-					continue;
+					Task* task = mSharedQueues[i].front();
+					mSharedQueues[i].pop_front();
+					mSharedQueueSizes[i]--;
+
+					return task;
 				}
+			}
+
+			for(UINT32 j = 1; j < numWorkers; j++)
+			{
+				Worker* victim = mWorkers[(worker->index + j) % numWorkers];
+				if(Task* task = victim->queues[i].steal())
+					return task;
+			}
+		}
 
-				if(curTask->mTaskDependency != nullptr && !curTask->mTaskDependency->isComplete())
+		return nullptr;
+	}
+
+	void TaskScheduler::runWorker(Worker* worker)
+	{
+		sCurrentWorker = worker;
+
+		while(true)
+		{
+			Task* task = nullptr;
+			for(UINT32 i = 0; i < NUM_SPIN_ITERATIONS; i++)
+			{
+				task = findTask(worker);
+				if(task != nullptr || mShutdown)
+					break;
+
+				std::this_thread::yield();
+			}
+
+			if(task != nullptr)
+			{
+				runTask(task);
+				continue;
+			}
+
+			// Nothing to do, sleep until more tasks get queued
+			Lock lock(mWorkerMutex);
+
+			worker->sleeping = true;
+			mNumSleepingWorkers++;
+
+			while(worker->sleeping && !mShutdown)
+			{
+				if(mNumQueuedTasks > 0)
 				{
-					++iter;
-					continue;
+					if(worker->index < mMaxActiveTasks)
+						break;
+
+					// We're not allowed to run, make sure someone else picks up the work
+					wakeWorkerLocked();
 				}
 
-				iter = mTaskQueue.erase(iter);
+				worker->wakeCond.wait(lock);
+			}
+
+			worker->sleeping = false;
+			mNumSleepingWorkers--;
+
+			if(mShutdown)
+				break;
+		}
+
+		sCurrentWorker = nullptr;
+	}
 
-				curTask->mState.store(1);
-				mActiveTasks.push_back(curTask);
+	void TaskScheduler::runTask(Task* taskPtr)
+	{
+		SPtr<Task> task = std::move(taskPtr->mQueuedRef);
+		mNumQueuedTasks--;
+
+		// Skip the task if it was canceled while in the queue
+		UINT32 expectedState = 0;
+		if(task->mState.compare_exchange_strong(expectedState, 1))
+		{
+			Worker* worker = sCurrentWorker;
+			const bool recordStatistics = isStatisticsEnabled();
+			const UINT64 startTime = recordStatistics ? getTimeNs() : 0;
+
+			TraceRecorder* recorder = getActiveTraceRecorder();
+			UINT32 traceName = 0;
+
+			if(recorder != nullptr)
+			{
+				// Named here rather than on worker creation, as the recorder may be enabled at any point
+				if(!worker->traceNamed)
+				{
+					recorder->setThreadName("TaskWorker " + toString(worker->index));
+					worker->traceNamed = true;
+				}
 
-				ThreadPool::instance().run(curTask->mName, std::bind(&TaskScheduler::runTask, this, curTask));
+				traceName = getTraceName(worker, task->mName);
+				recorder->beginEvent(traceName);
 			}
+
+			task->mTaskWorker();
+
+			if(recorder != nullptr)
+				recorder->endEvent(traceName);
+
+			if(recordStatistics)
+				recordTaskStatistics(worker, *task, startTime, getTimeNs());
+
+			task->mState.store(2);
 		}
+
+		onTaskFinished(task.get());
 	}
 
-	void TaskScheduler::runTask(SPtr<Task> task)
+	void TaskScheduler::recordTaskStatistics(Worker* worker, const Task& task, UINT64 startTime, UINT64 endTime)
 	{
-		task->mTaskWorker();
+		const UINT64 runTime = endTime - startTime;
+
+		ScopedSpinLock lock(worker->statsLock);
+
+		TaskStatistics& taskStats = worker->taskStats[task.mName];
+		taskStats.numExecuted++;
+		taskStats.totalRunTimeNs += runTime;
+		taskStats.maxRunTimeNs = std::max(taskStats.maxRunTimeNs, runTime);
+		taskStats.runTimes.add(runTime);
 
+		// Tasks queued before statistics were enabled have no queue time
+		if(task.mQueueTime != 0 && task.mQueueTime <= startTime)
 		{
-			Lock lock(mReadyMutex);
+			const UINT64 latency = startTime - task.mQueueTime;
 
-			auto findIter = std::find(mActiveTasks.begin(), mActiveTasks.end(), task);
-			if (findIter != mActiveTasks.end())
-				mActiveTasks.erase(findIter);
+			taskStats.totalLatencyNs += latency;
+			taskStats.maxLatencyNs = std::max(taskStats.maxLatencyNs, latency);
+			taskStats.latencies.add(latency);
 		}
 
+		TaskWorkerStatistics& workerStats = worker->stats;
+		workerStats.numExecuted++;
+		workerStats.busyTimeNs += runTime;
+
+		if(worker->lastTaskEndTime != 0 && worker->lastTaskEndTime <= startTime)
+			workerStats.idleTimeNs += startTime - worker->lastTaskEndTime;
+
+		worker->lastTaskEndTime = endTime;
+	}
+
+	UINT32 TaskScheduler::getTraceName(Worker* worker, const String& taskName)
+	{
+		// Cached per worker, so names only need to be registered (which requires a lock) once per worker
+		auto iterFind = worker->traceNames.find(taskName);
+		if(iterFind != worker->traceNames.end())
+			return iterFind->second;
+
+		const UINT32 traceName = TraceRecorder::registerName(taskName.c_str());
+		worker->traceNames[taskName] = traceName;
+
+		return traceName;
+	}
+
+	TaskSchedulerReport TaskScheduler::generateReport() const
+	{
+		TaskSchedulerReport report;
+		UnorderedMap<String, TaskStatistics> taskStats;
+
+		const UINT32 numWorkers = mNumWorkers.load(std::memory_order_acquire);
+		for(UINT32 i = 0; i < numWorkers; i++)
 		{
-			Lock lock(mCompleteMutex);
-			task->mState.store(2);
+			Worker* worker = mWorkers[i];
+			ScopedSpinLock lock(worker->statsLock);
+
+			for(auto& entry : worker->taskStats)
+				taskStats[entry.first].merge(entry.second);
+
+			report.workers.push_back(worker->stats);
+		}
+
+		for(auto& entry : taskStats)
+		{
+			report.tasks.push_back(entry.second);
+			report.tasks.back().name = entry.first;
+		}
+
+		report.numQueuedTasks = mNumQueuedTasks.load(std::memory_order_relaxed);
+		report.maxQueuedTasks = mMaxQueuedTasks.load(std::memory_order_relaxed);
+		report.numWaits = mNumWaits.load(std::memory_order_relaxed);
+		report.numWaitWorkers = mNumWaitWorkers.load(std::memory_order_relaxed);
+
+		return report;
+	}
+
+	void TaskScheduler::resetStatistics()
+	{
+		const UINT32 numWorkers = mNumWorkers.load(std::memory_order_acquire);
+		for(UINT32 i = 0; i < numWorkers; i++)
+		{
+			Worker* worker = mWorkers[i];
+			ScopedSpinLock lock(worker->statsLock);
+
+			worker->taskStats.clear();
+			worker->stats = TaskWorkerStatistics();
+			worker->lastTaskEndTime = 0;
+		}
+
+		mMaxQueuedTasks.store(mNumQueuedTasks.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		mNumWaits.store(0, std::memory_order_relaxed);
+		mNumWaitWorkers.store(0, std::memory_order_relaxed);
+	}
+
+	void TaskScheduler::onTaskFinished(Task* task)
+	{
+		Vector<SPtr<Task>> dependents;
+		{
+			ScopedSpinLock lock(task->mDependentsLock);
+			std::swap(dependents, task->mDependents);
+		}
+
+		// Dependents of a canceled task are canceled in turn, as their dependency will never complete
+		if(task->isCanceled())
+		{
+			for(auto& entry : dependents)
+			{
+				entry->mState.store(3);
+				onTaskFinished(entry.get());
+			}
+		}
+		else
+		{
+			for(auto& entry : dependents)
+				queueTask(std::move(entry));
+		}
 
+		if(mNumWaiters > 0)
+		{
+			Lock lock(mCompleteMutex);
 			mTaskCompleteCond.notify_all();
 		}
+	}
 
-		// Wake the main scheduler thread in case there are other tasks waiting or this task was someone's dependency
+	void TaskScheduler::wakeWorker()
+	{
+		// Quick exit if there are no workers to wake and no new workers are allowed to be created
+		if(mNumSleepingWorkers == 0 && mNumWorkers >= std::min(mMaxActiveTasks.load(), MAX_WORKERS))
+			return;
+
+		Lock lock(mWorkerMutex);
+		wakeWorkerLocked();
+	}
+
+	void TaskScheduler::wakeWorkerLocked()
+	{
+		if(mNumQueuedTasks == 0 || mShutdown)
+			return;
+
+		const UINT32 numWorkers = mNumWorkers;
+		const UINT32 numActive = std::min(numWorkers, mMaxActiveTasks.load());
+		for(UINT32 i = 0; i < numActive; i++)
+		{
+			Worker* worker = mWorkers[i];
+			if(worker->sleeping)
+			{
+				worker->sleeping = false;
+				worker->wakeCond.notify_one();
+				return;
+			}
+		}
+
+		// All allowed workers are busy, spawn a new one if we're allowed to
+		if(numWorkers < mMaxActiveTasks && numWorkers < MAX_WORKERS)
 		{
-			Lock lock(mReadyMutex);
+			Worker* worker = bs_new<Worker>();
+			worker->parent = this;
+			worker->index = numWorkers;
+
+			mWorkers[numWorkers] = worker;
+			mNumWorkers.store(numWorkers + 1, std::memory_order_release);
 
-			mCheckTasks = true;
-			mTaskReadyCond.notify_one();
+			worker->thread = ThreadPool::instance().run("TaskWorker", [this, worker]() { runWorker(worker); });
 		}
 	}
 
 	void TaskScheduler::waitUntilComplete(const Task* task)
 	{
-		if(task->isCanceled())
+		if(task->isCanceled() || task->isComplete())
 			return;
 
+		BS_TRACE_SCOPE("TaskScheduler wait");
+
+		if(isStatisticsEnabled())
+			mNumWaits++;
+
+		mNumWaiters++;
 		{
 			Lock lock(mCompleteMutex);
 
-			while(!task->isComplete())
+			while(!task->isComplete() && !task->isCanceled())
 			{
+				if(isStatisticsEnabled())
+					mNumWaitWorkers++;
+
 				addWorker();
 				mTaskCompleteCond.wait(lock);
 				removeWorker();
 			}
 		}
+		mNumWaiters--;
 	}
 
 	void TaskScheduler::waitUntilComplete(const TaskGroup* taskGroup)
 	{
-		Lock lock(mCompleteMutex);
+		if(taskGroup->mNumRemainingTasks == 0 || taskGroup->isDependencyCanceled())
+			return;
+
+		BS_TRACE_SCOPE("TaskScheduler wait");
 
-		while (taskGroup->mNumRemainingTasks > 0)
+		if(isStatisticsEnabled())
+			mNumWaits++;
+
+		mNumWaiters++;
 		{
-			addWorker();
-			mTaskCompleteCond.wait(lock);
-			removeWorker();
+			Lock lock(mCompleteMutex);
+
+			while (taskGroup->mNumRemainingTasks > 0 && !taskGroup->isDependencyCanceled())
+			{
+				if(isStatisticsEnabled())
+					mNumWaitWorkers++;
+
+				addWorker();
+				mTaskCompleteCond.wait(lock);
+				removeWorker();
+			}
 		}
+		mNumWaiters--;
 	}
 
-	bool TaskScheduler::taskCompare(const SPtr<Task>& lhs, const SPtr<Task>& rhs)
+	UINT32 TaskScheduler::getQueueIdx(TaskPriority priority)
 	{
-		// If one tasks priority is higher, that one goes first
-		if(lhs->mPriority > rhs->mPriority)
-			return true;
-
-		// Otherwise we go by smaller id, as that task was queued earlier than the other
-		return lhs->mTaskId < rhs->mTaskId;
+		const INT32 idx = (INT32)TaskPriority::VeryHigh - (INT32)priority;
+		return (UINT32)Math::clamp(idx, 0, (INT32)TASK_PRIORITY_COUNT - 1);
 	}
 }
@@ -5,6 +5,7 @@
 #include "Prerequisites/BsPrerequisitesUtil.h"
 #include "Utility/BsModule.h"
 #include "Threading/BsThreadPool.h"
+#include "Threading/BsWorkStealingQueue.h"
 
 namespace bs
 {
@@ -23,6 +24,9 @@ namespace bs
 		VeryHigh = 102
 	};
 
+	/** Number of distinct values in TaskPriority. */
+	static constexpr UINT32 TASK_PRIORITY_COUNT = 5;
+
 	/**
 	 * Represents a single task that may be queued in the TaskScheduler.
 	 *
@@ -43,7 +47,8 @@ namespace bs
 		 * @param[in]	taskWorker	Worker method that does all of the work in the task.
 		 * @param[in]	priority  	(optional) Higher priority means the tasks will be executed sooner.
 		 * @param[in]	dependency	(optional) Task dependency if one exists. If provided the task will
-		 * 							not be executed until its dependency is complete.
+		 * 							not be executed until its dependency is complete. If the dependency gets
+		 *							canceled the task is canceled as well, along with any tasks depending on it.
 		 */
 		static SPtr<Task> create(const String& name, std::function<void()> taskWorker, 
 			TaskPriority priority = TaskPriority::Normal, SPtr<Task> dependency = nullptr);
@@ -69,12 +74,21 @@ namespace bs
 
 		String mName;
 		TaskPriority mPriority;
-		UINT32 mTaskId = 0;
 		std::function<void()> mTaskWorker;
 		SPtr<Task> mTaskDependency;
 		std::atomic<UINT32> mState{0}; /**< 0 - Inactive, 1 - In progress, 2 - Completed, 3 - Canceled */
 
 		TaskScheduler* mParent = nullptr;
+
+		/** Time at which the task was last queued, in nanoseconds. Only recorded if statistics are enabled. */
+		UINT64 mQueueTime = 0;
+
+		/** Keeps the task alive while it is referenced from one of the scheduler queues. */
+		SPtr<Task> mQueuedRef;
+
+		/** Tasks waiting on this task to complete before they can be queued. */
+		Vector<SPtr<Task>> mDependents;
+		SpinLock mDependentsLock;
 	};
 
 	/**
@@ -96,10 +110,12 @@ namespace bs
 		 * @param[in]	name		Name you can use to more easily identify the tasks in the group.
 		 * @param[in]	taskWorker	Worker method that will get called for each item in the group. Each call will receive
 		 *							a sequential index of the item in the group.
-		 * @param[in]	count		Number of items in the task group. Each item will be processed in a worker thread.
+		 * @param[in]	count		Number of items in the task group. Items will be distributed between the available
+		 *							worker threads.
 		 * @param[in]	priority  	(optional) Higher priority means the tasks will be executed sooner.
 		 * @param[in]	dependency	(optional) Task dependency if one exists. If provided the task will
-		 * 							not be executed until its dependency is complete.
+		 * 							not be executed until its dependency is complete. If the dependency gets
+		 *							canceled none of the items are executed, and wait() returns right away.
 		 */
 		static SPtr<TaskGroup> create(String name, std::function<void(UINT32)> taskWorker, UINT32 count,
 			TaskPriority priority = TaskPriority::Normal, SPtr<Task> dependency = nullptr);
@@ -110,23 +126,89 @@ namespace bs
 		/**
 		 * Blocks the current thread until all tasks in the group have completed.
 		 *
-		 * @note	While waiting adds a new worker thread, so that the blocking threads core can be utilized.
+		 * @note	
+		 * While waiting the calling thread will process any items that haven't yet been picked up by the workers. If
+		 * no such items remain it adds a new worker thread, so that the blocking threads core can be utilized.
 		 */
 		void wait();
 
 	private:
 		friend class TaskScheduler;
 
+		/** Processes items that haven't yet been picked up by any other thread, until no such items remain. */
+		void executeItems();
+
+		/** Checks if the group's dependency was canceled, in which case its items will never be executed. */
+		bool isDependencyCanceled() const;
+
 		String mName;
 		UINT32 mCount;
 		TaskPriority mPriority;
 		std::function<void(UINT32)> mTaskWorker;
 		SPtr<Task> mTaskDependency;
+		std::atomic<UINT32> mNextItem{0};
 		std::atomic<UINT32> mNumRemainingTasks{mCount};
 
 		TaskScheduler* mParent = nullptr;
 	};
 
+	/**
+	 * Histogram of task timings. Bucket sizes increase exponentially, with bucket @p i counting times in range
+	 * [2^(i-1), 2^i) microseconds. The first bucket counts times under a microsecond, and the last bucket all times
+	 * above its lower bound.
+	 */
+	struct BS_UTILITY_EXPORT TaskTimeHistogram
+	{
+		static constexpr UINT32 NUM_BUCKETS = 20;
+
+		/** Counts the provided time (in nanoseconds) in its bucket. */
+		void add(UINT64 timeNs);
+
+		/** Adds the counts of the provided histogram to this histogram. */
+		void merge(const TaskTimeHistogram& other);
+
+		UINT32 buckets[NUM_BUCKETS] = {};
+	};
+
+	/** Statistics about all tasks with the same name, executed since the statistics were last reset. */
+	struct BS_UTILITY_EXPORT TaskStatistics
+	{
+		String name; /**< Name of the tasks. */
+		UINT32 numExecuted = 0; /**< Number of executed tasks. */
+
+		UINT64 totalRunTimeNs = 0; /**< Total time spent executing the tasks, in nanoseconds. */
+		UINT64 maxRunTimeNs = 0; /**< Longest time spent executing a single task, in nanoseconds. */
+		UINT64 totalLatencyNs = 0; /**< Total time the tasks spent queued before they started executing, in ns. */
+		UINT64 maxLatencyNs = 0; /**< Longest time a single task spent queued before it started executing, in ns. */
+
+		TaskTimeHistogram runTimes; /**< Distribution of task execution times. */
+		TaskTimeHistogram latencies; /**< Distribution of times tasks spent queued before they started executing. */
+
+		/** Adds the values of the provided statistics to these statistics. */
+		void merge(const TaskStatistics& other);
+	};
+
+	/** Statistics about a single worker thread of the task scheduler, since the statistics were last reset. */
+	struct TaskWorkerStatistics
+	{
+		UINT32 numExecuted = 0; /**< Number of tasks the worker executed. */
+		UINT64 busyTimeNs = 0; /**< Time the worker spent executing tasks, in nanoseconds. */
+		UINT64 idleTimeNs = 0; /**< Time between the end of one and the start of the next task, in nanoseconds. */
+	};
+
+	/** Statistics about the work done by the task scheduler, since the statistics were last reset. */
+	struct TaskSchedulerReport
+	{
+		Vector<TaskStatistics> tasks; /**< Statistics per task name, in no particular order. */
+		Vector<TaskWorkerStatistics> workers; /**< Statistics per worker thread, indexed by worker. */
+
+		UINT32 numQueuedTasks = 0; /**< Number of tasks waiting to be executed, at the time the report was generated. */
+		UINT32 maxQueuedTasks = 0; /**< Largest number of tasks that were waiting to be executed at the same time. */
+
+		UINT32 numWaits = 0; /**< Number of times a thread blocked in Task::wait() or TaskGroup::wait(). */
+		UINT32 numWaitWorkers = 0; /**< Number of times a blocked wait had to add a worker to make use of its core. */
+	};
+
 	/**
 	 * Represents a task scheduler running on multiple threads. You may queue tasks on it from any thread and they will be
 	 * executed in user specified order on any available thread.
@@ -134,15 +216,19 @@ namespace bs
 	 * @note
 	 * Thread safe.
 	 * @note
-	 * This type of task scheduler uses a global queue and is best used for coarse granularity of tasks. (Number of tasks
-	 * in the order of hundreds. Higher number of tasks might require different queuing and locking mechanism, potentially
-	 * at the cost of flexibility.)
+	 * Each worker thread owns a set of lock-free queues (one per priority) that it pushes its own tasks to and executes
+	 * them from. Workers that run out of tasks will steal tasks from the queues of other workers. Tasks queued from
+	 * threads that are not task scheduler workers are placed in a shared queue. Higher priority tasks are always
+	 * looked up before lower priority ones, but the order between tasks of the same priority is not strictly defined.
+	 * This makes the scheduler suitable for large numbers of small tasks (tens of thousands per frame).
 	 * @note
-	 * By default the task scheduler will create as many threads as there are physical CPU cores. You may add or remove
-	 * threads using addWorker()/removeWorker() methods.
+	 * By default the task scheduler will allow as many workers to run as there are logical CPU cores. Workers are
+	 * created lazily as tasks get queued. You may add or remove workers using addWorker()/removeWorker() methods.
 	 */
 	class BS_UTILITY_EXPORT TaskScheduler : public Module<TaskScheduler>
 	{
+		struct Worker;
+
 	public:
 		TaskScheduler();
 		~TaskScheduler();
@@ -159,17 +245,87 @@ namespace bs
 		/**	Removes a worker thread (as soon as its current task is finished). */
 		void removeWorker();
 
+		/**
+		 * Executes the provided worker over the [@p begin, @p end) range, splitting it into sub-ranges that are executed
+		 * in parallel on the worker threads. The calling thread also processes the range, and the method returns once
+		 * the entire range has been processed.
+		 *
+		 * @param[in]	begin		First index in the range.
+		 * @param[in]	end			One past the last index in the range.
+		 * @param[in]	grainSize	Minimum number of indices to process in a single call to @p worker. Set to 0 to have
+		 *							the scheduler pick an appropriate size based on the range size and number of workers.
+		 * @param[in]	worker		Worker method that will get called for every sub-range, receiving the first index
+		 *							and one past the last index of the sub-range.
+		 * @param[in]	priority	(optional) Priority of the helper tasks that process the range on the worker threads.
+		 *
+		 * @note
+		 * Each participating thread starts with an equal portion of the range, which it processes one grain at a time.
+		 * Once a thread runs out of work it splits the largest remaining portion of another thread in half, and
+		 * continues processing that. The calling thread processes portions of any helper tasks that haven't started
+		 * yet, so the call never waits on queued tasks and is safe to make from within a task.
+		 */
+		void parallelFor(UINT32 begin, UINT32 end, UINT32 grainSize, const std::function<void(UINT32, UINT32)>& worker,
+			TaskPriority priority = TaskPriority::Normal);
+
 		/** Returns the maximum available worker threads (maximum number of tasks that can be executed simultaneously). */
 		UINT32 getNumWorkers() const { return mMaxActiveTasks; }
+
+		/** Checks is the calling thread one of this scheduler's worker threads. */
+		bool isWorkerThread() const;
+
+		/**
+		 * Enables or disables recording of statistics about queued and executed tasks, as well as worker threads.
+		 * Disabled by default. Statistics can be retrieved through generateReport().
+		 */
+		void setStatisticsEnabled(bool enabled) { mStatisticsEnabled.store(enabled, std::memory_order_relaxed); }
+
+		/** Checks is recording of statistics enabled. See setStatisticsEnabled(). */
+		bool isStatisticsEnabled() const { return mStatisticsEnabled.load(std::memory_order_relaxed); }
+
+		/** Returns the statistics recorded since the last call to resetStatistics(). */
+		TaskSchedulerReport generateReport() const;
+
+		/** Clears all recorded statistics. */
+		void resetStatistics();
 	protected:
 		friend class Task;
 		friend class TaskGroup;
 
-		/**	Main task scheduler method that dispatches tasks to other threads. */
-		void runMain();
+		/** Maximum number of worker threads the scheduler is allowed to create. */
+		static constexpr UINT32 MAX_WORKERS = 128;
 
-		/**	Worker method that runs a single task. */
-		void runTask(SPtr<Task> task);
+		/** Number of times a worker will try to find a new task before going to sleep. */
+		static constexpr UINT32 NUM_SPIN_ITERATIONS = 64;
+
+		/** Main worker method that executes queued tasks until the scheduler is shut down. */
+		void runWorker(Worker* worker);
+
+		/**	Executes a task retrieved from one of the queues. */
+		void runTask(Task* task);
+
+		/** Records statistics about a task executed by the provided worker. Times are in nanoseconds. */
+		void recordTaskStatistics(Worker* worker, const Task& task, UINT64 startTime, UINT64 endTime);
+
+		/** Returns the TraceRecorder identifier of the provided task name. Must be called from the worker's thread. */
+		static UINT32 getTraceName(Worker* worker, const String& taskName);
+
+		/** Places a task whose dependencies have been resolved in one of the task queues. */
+		void queueTask(SPtr<Task> task);
+
+		/**
+		 * Attempts to find a task to execute, looking up the worker's own queues, the shared queue and queues of other
+		 * workers, in that order. Higher priority tasks are looked up first. Returns null if no task was found.
+		 */
+		Task* findTask(Worker* worker);
+
+		/** Called after a task was executed or discarded. Queues any dependent tasks and notifies any waiting threads. */
+		void onTaskFinished(Task* task);
+
+		/** Wakes up a sleeping worker, or creates a new one if possible, in case there are tasks waiting to execute. */
+		void wakeWorker();
+
+		/** Same as wakeWorker() except it assumes the caller holds the worker mutex. */
+		void wakeWorkerLocked();
 
 		/**	Blocks the calling thread until the specified task has completed. */
 		void waitUntilComplete(const Task* task);
@@ -177,21 +333,31 @@ namespace bs
 		/**	Blocks the calling thread until all the tasks in the provided task group have completed. */
 		void waitUntilComplete(const TaskGroup* taskGroup);
 
-		/**	Method used for sorting tasks. */
-		static bool taskCompare(const SPtr<Task>& lhs, const SPtr<Task>& rhs);
+		/** Converts task priority into an index of the queue the task should be placed in. 0 being the highest priority. */
+		static UINT32 getQueueIdx(TaskPriority priority);
 
-		HThread mTaskSchedulerThread;
-		Set<SPtr<Task>, std::function<bool(const SPtr<Task>&, const SPtr<Task>&)>> mTaskQueue;
-		Vector<SPtr<Task>> mActiveTasks;
-		UINT32 mMaxActiveTasks = 0;
-		UINT32 mNextTaskId = 0;
-		bool mShutdown = false;
-		bool mCheckTasks = false;
+		Worker* mWorkers[MAX_WORKERS];
+		std::atomic<UINT32> mNumWorkers{0};
+		std::atomic<UINT32> mMaxActiveTasks{0};
+		std::atomic<UINT32> mNumSleepingWorkers{0};
+		std::atomic<UINT32> mNumQueuedTasks{0};
+		std::atomic<UINT32> mNumWaiters{0};
+		std::atomic<bool> mShutdown{false};
 
-		Mutex mReadyMutex;
+		std::atomic<bool> mStatisticsEnabled{false};
+		std::atomic<UINT32> mMaxQueuedTasks{0};
+		std::atomic<UINT32> mNumWaits{0};
+		std::atomic<UINT32> mNumWaitWorkers{0};
+
+		Deque<Task*> mSharedQueues[TASK_PRIORITY_COUNT];
+		std::atomic<UINT32> mSharedQueueSizes[TASK_PRIORITY_COUNT];
+		SpinLock mSharedQueueLock;
+
+		Mutex mWorkerMutex;
 		Mutex mCompleteMutex;
-		Signal mTaskReadyCond;
 		Signal mTaskCompleteCond;
+
+		static BS_THREADLOCAL Worker* sCurrentWorker;
 	};
 
 	/** @} */
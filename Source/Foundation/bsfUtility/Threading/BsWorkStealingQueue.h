@@ -0,0 +1,180 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Utility/BsBitwise.h"
+
+namespace bs
+{
+	/** @addtogroup Internal-Utility
+	 *  @{
+	 */
+
+	/** @addtogroup Threading-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Lock-free double ended queue owned by a single thread (Chase-Lev). The owner thread pushes and pops elements at the
+	 * bottom of the queue, in LIFO order, while any other thread may steal elements from the top of the queue, in FIFO
+	 * order. The queue grows as needed.
+	 *
+	 * @tparam	T	Type of element to store. Must be a pointer type.
+	 *
+	 * @note	push() and pop() may only be called from the owner thread. steal() and isEmpty() are thread safe.
+	 */
+	template<class T>
+	class WorkStealingQueue
+	{
+		static_assert(std::is_pointer<T>::value, "WorkStealingQueue can only store pointers.");
+
+		/** Circular buffer holding the queue elements. */
+		struct Buffer
+		{
+			Buffer(INT64 capacity)
+				:capacity(capacity), mask(capacity - 1)
+			{
+				elements = bs_newN<std::atomic<T>>((size_t)capacity);
+			}
+
+			~Buffer()
+			{
+				bs_deleteN(elements, (size_t)capacity);
+			}
+
+			T get(INT64 idx) const { return elements[idx & mask].load(std::memory_order_relaxed); }
+			void put(INT64 idx, T value) { elements[idx & mask].store(value, std::memory_order_relaxed); }
+
+			INT64 capacity;
+			INT64 mask;
+			std::atomic<T>* elements;
+		};
+
+	public:
+		/**
+		 * Constructs a new queue.
+		 *
+		 * @param[in]	capacity	Initial number of elements the queue can hold. Must be a power of two.
+		 */
+		WorkStealingQueue(UINT32 capacity = 256)
+		{
+			assert(Bitwise::isPow2(capacity));
+
+			mBuffer.store(bs_new<Buffer>(capacity), std::memory_order_relaxed);
+		}
+
+		~WorkStealingQueue()
+		{
+			for(auto& entry : mRetiredBuffers)
+				bs_delete(entry);
+
+			bs_delete(mBuffer.load(std::memory_order_relaxed));
+		}
+
+		/** Pushes a new element to the bottom of the queue. May only be called from the owner thread. */
+		void push(T value)
+		{
+			INT64 bottom = mBottom.load(std::memory_order_relaxed);
+			INT64 top = mTop.load(std::memory_order_acquire);
+			Buffer* buffer = mBuffer.load(std::memory_order_relaxed);
+
+			if((bottom - top) > (buffer->capacity - 1))
+				buffer = grow(buffer, bottom, top);
+
+			buffer->put(bottom, value);
+			std::atomic_thread_fence(std::memory_order_release);
+			mBottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+
+		/**
+		 * Pops an element from the bottom of the queue. Returns null if the queue is empty. May only be called from the
+		 * owner thread.
+		 */
+		T pop()
+		{
+			INT64 bottom = mBottom.load(std::memory_order_relaxed) - 1;
+			Buffer* buffer = mBuffer.load(std::memory_order_relaxed);
+			mBottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			INT64 top = mTop.load(std::memory_order_relaxed);
+
+			T output = nullptr;
+			if(top <= bottom)
+			{
+				output = buffer->get(bottom);
+
+				// Last element, race with the stealing threads
+				if(top == bottom)
+				{
+					if(!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+						output = nullptr;
+
+					mBottom.store(bottom + 1, std::memory_order_relaxed);
+				}
+			}
+			else
+				mBottom.store(bottom + 1, std::memory_order_relaxed);
+
+			return output;
+		}
+
+		/**
+		 * Steals an element from the top of the queue. Returns null if the queue is empty, or if another thread won the
+		 * race for the element. Can be called from any thread.
+		 */
+		T steal()
+		{
+			INT64 top = mTop.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			INT64 bottom = mBottom.load(std::memory_order_acquire);
+
+			if(top < bottom)
+			{
+				Buffer* buffer = mBuffer.load(std::memory_order_acquire);
+				T output = buffer->get(top);
+
+				if(!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					return nullptr;
+
+				return output;
+			}
+
+			return nullptr;
+		}
+
+		/** Checks if the queue has no elements. The result is only approximate if called from a non-owner thread. */
+		bool isEmpty() const
+		{
+			INT64 bottom = mBottom.load(std::memory_order_relaxed);
+			INT64 top = mTop.load(std::memory_order_relaxed);
+
+			return bottom <= top;
+		}
+
+	private:
+		/**
+		 * Allocates a larger buffer and copies the existing elements into it. The old buffer is kept alive until the queue
+		 * is destroyed, since stealing threads might still be reading from it.
+		 */
+		Buffer* grow(Buffer* buffer, INT64 bottom, INT64 top)
+		{
+			Buffer* newBuffer = bs_new<Buffer>(buffer->capacity * 2);
+			for(INT64 i = top; i < bottom; i++)
+				newBuffer->put(i, buffer->get(i));
+
+			mRetiredBuffers.push_back(buffer);
+			mBuffer.store(newBuffer, std::memory_order_release);
+
+			return newBuffer;
+		}
+
+		alignas(64) std::atomic<INT64> mTop { 0 };
+		alignas(64) std::atomic<INT64> mBottom { 0 };
+		std::atomic<Buffer*> mBuffer { nullptr };
+		Vector<Buffer*> mRetiredBuffers;
+	};
+
+	/** @} */
+	/** @} */
+}
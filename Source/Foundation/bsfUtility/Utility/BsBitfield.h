@@ -366,12 +366,53 @@ namespace bs
 			}
 		}
 
+		/** 
+		 * Changes the number of bits in the field. Existing bits are preserved, while any newly added bits are set to 
+		 * @p value. 
+		 */
+		void resize(uint32_t count, bool value = false)
+		{
+			if(count > mMaxBits)
+				realloc(count);
+
+			if(count > mNumBits)
+			{
+				// Set the unused bits in the last partially used dword
+				const uint32_t numUsedBits = mNumBits & (BITS_PER_DWORD - 1);
+				if(numUsedBits != 0)
+				{
+					const uint32_t usedMask = (1 << numUsedBits) - 1;
+					uint32_t& data = mData[mNumBits >> BITS_PER_DWORD_LOG2];
+
+					data = value ? (data | ~usedMask) : (data & usedMask);
+				}
+
+				// Set all the dwords following it
+				const uint32_t startDword = Math::divideAndRoundUp(mNumBits, BITS_PER_DWORD);
+				const uint32_t endDword = Math::divideAndRoundUp(count, BITS_PER_DWORD);
+
+				if(endDword > startDword)
+					memset(mData + startDword, value ? 0xFF : 0, (endDword - startDword) * sizeof(uint32_t));
+			}
+
+			mNumBits = count;
+		}
+
 		/** Returns the number of bits in the bitfield */
 		uint32_t size() const
 		{
 			return mNumBits;
 		}
 
+		/** 
+		 * Returns the internal buffer containing the bits. Each dword contains 32 sequential bits, starting with the
+		 * least significant bit. Bits past size() in the last dword have undefined values.
+		 */
+		uint32_t* data() { return mData; }
+
+		/** @copydoc data() */
+		const uint32_t* data() const { return mData; }
+
 		/** Returns a non-const iterator pointing to the first bit in the bitfield. */
 		Iterator begin()
 		{
@@ -134,6 +134,18 @@ namespace bs
 #endif
 		}
 
+		/** Counts the number of set bits in the provided value. */
+		static UINT32 popcnt(UINT32 val)
+		{
+#if BS_COMPILER == BS_COMPILER_MSVC
+			return __popcnt(val);
+#elif BS_COMPILER == BS_COMPILER_GNUC || BS_COMPILER == BS_COMPILER_CLANG
+			return __builtin_popcount(val);
+#else
+			static_assert(false, "Not implemented");
+#endif
+		}
+
 		/** Determines whether the number is power-of-two or not. */
 		template<typename T>
 		static bool isPow2(T n)
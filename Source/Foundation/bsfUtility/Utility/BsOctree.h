@@ -6,6 +6,7 @@
 #include "Math/BsMath.h"
 #include "Math/BsVector4I.h"
 #include "Math/BsSIMD.h"
+#include "Math/BsConvexVolume.h"
 #include "Allocators/BsPoolAlloc.h"
 
 namespace bs
@@ -250,7 +251,8 @@ namespace bs
 				auto positiveCenter = simd::add(nodeCenter, childOffset);
 				auto positiveDiff = simd::sub(positiveCenter, queryCenter);
 
-				auto diff = simd::min(negativeDiff, positiveDiff);
+				// Distance to the closest child center. Must be absolute, as the query can lie outside of the node.
+				auto diff = simd::min(simd::abs(negativeDiff), simd::abs(positiveDiff));
 
 				auto queryExtents = simd::load<simd::float32x4>(&bounds.extents);
 				auto childExtent = simd::load_splat<simd::float32x4>(&mChildExtent);
@@ -556,6 +558,94 @@ namespace bs
 			simd::AABox mBounds;
 		};
 
+		/** Iterator that iterates over all elements intersecting the specified convex volume (e.g. a frustum). */
+		class VolumeIntersectIterator
+		{
+		public:
+			/** 
+			 * Constructs an iterator that iterates over all elements in the specified tree that intersect the specified 
+			 * volume. The volume must remain valid for the lifetime of the iterator.
+			 */
+			VolumeIntersectIterator(const Octree& tree, const ConvexVolume& volume)
+				:mNodeIter(tree), mRoot(&tree.mRoot), mVolume(volume)
+			{ }
+
+			/** 
+			 * Returns the contents of the current element. moveNext() must be called at least once and it must return true
+			 * prior to attempting to access this data.
+			 */
+			const ElemType& getElement() const
+			{
+				return mElemIter.getCurrentElem();
+			}
+
+			/** 
+			 * Moves to the next intersecting element. Iterator starts at a position before the first element, therefore
+			 * this method must be called at least once before attempting to access the current element data. If the method
+			 * returns false it means iterator end has been reached and attempting to access data will result in an error.
+			 */
+			bool moveNext()
+			{
+				while(true)
+				{
+					// First check elements of the current node (if any)
+					while (mElemIter.moveNext())
+					{
+						if (intersects(mElemIter.getCurrentBounds()))
+							return true;
+					}
+
+					// No more elements in this node, move to the next one
+					if(!mNodeIter.moveNext())
+						return false; // No more nodes to check
+
+					// Skip the node, and all of its children, if outside of the volume. Root node is always checked since
+					// it also contains elements that lie outside of the tree bounds.
+					const HNode& nodeRef = mNodeIter.getCurrent();
+					if(nodeRef.getNode() != mRoot && !intersects(nodeRef.getBounds().getBounds()))
+					{
+						mElemIter = ElementIterator();
+						continue;
+					}
+
+					mElemIter = ElementIterator(nodeRef.getNode());
+
+					for(UINT32 i = 0; i < 8; i++)
+					{
+						if(nodeRef.getNode()->hasChild(i))
+							mNodeIter.pushChild(i);
+					}
+				}
+
+				return false;
+			}
+
+		private:
+			/** Checks if the provided bounds intersect the volume. */
+			bool intersects(const simd::AABox& bounds) const
+			{
+				for(auto& plane : mVolume.getPlanes())
+				{
+					float dist = bounds.center.x * plane.normal.x + bounds.center.y * plane.normal.y + 
+						bounds.center.z * plane.normal.z - plane.d;
+
+					float effectiveRadius = bounds.extents.x * Math::abs(plane.normal.x);
+					effectiveRadius += bounds.extents.y * Math::abs(plane.normal.y);
+					effectiveRadius += bounds.extents.z * Math::abs(plane.normal.z);
+
+					if (dist < -effectiveRadius)
+						return false;
+				}
+
+				return true;
+			}
+
+			NodeIterator mNodeIter;
+			ElementIterator mElemIter;
+			const Node* mRoot;
+			const ConvexVolume& mVolume;
+		};
+
 		/** 
 		 * Constructs an octree with the specified bounds. 
 		 * 
@@ -608,7 +698,7 @@ namespace bs
 				bs_frame_mark();
 				{
 					FrameStack<Node*> todo;
-					todo.push(node);
+					todo.push(nodeToCollapse);
 
 					while(!todo.empty())
 					{
@@ -623,7 +713,7 @@ namespace bs
 
 								ElementIterator elemIter(childNode);
 								while(elemIter.moveNext())
-									pushElement(node, elemIter.getCurrentElem(), elemIter.getCurrentBounds());
+									pushElement(nodeToCollapse, elemIter.getCurrentElem(), elemIter.getCurrentBounds());
 
 								todo.push(childNode);
 							}
@@ -632,17 +722,17 @@ namespace bs
 				}
 				bs_frame_clear();
 				
-				node->mIsLeaf = true;
+				nodeToCollapse->mIsLeaf = true;
 
 				// Recursively delete all child nodes
 				for (UINT32 i = 0; i < 8; i++)
 				{
-					if(node->mChildren[i])
+					if(nodeToCollapse->mChildren[i])
 					{
-						destroyNode(node->mChildren[i]);
+						destroyNode(nodeToCollapse->mChildren[i]);
 
-						mNodeAlloc.destruct(node->mChildren[i]);
-						node->mChildren[i] = nullptr;
+						mNodeAlloc.destruct(nodeToCollapse->mChildren[i]);
+						nodeToCollapse->mChildren[i] = nullptr;
 					}
 				}
 			}
@@ -0,0 +1,258 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	/** @addtogroup General
+	 *  @{
+	 */
+
+	/**
+	 * Sorts a set of key/value pairs in ascending order of their keys using a least-significant-digit radix sort. The sort
+	 * is stable, runs in linear time and performs no allocations, as the caller provides the temporary storage. Digits
+	 * that are equal for all keys are detected up front and skipped, so keys with sparsely populated bits sort faster.
+	 *
+	 * @param[in, out]	keys		Keys to sort. Contains the sorted keys when the method returns.
+	 * @param[in, out]	values		Values associated with each key. Re-ordered along with the keys.
+	 * @param[in]		tmpKeys		Temporary storage with room for at least @p count keys.
+	 * @param[in]		tmpValues	Temporary storage with room for at least @p count values.
+	 * @param[in]		count		Number of entries in @p keys and @p values.
+	 *
+	 * @tparam			Key			Unsigned integer type used for the keys.
+	 * @tparam			Value		Type of the values. Should be cheap to copy (e.g. an index).
+	 */
+	template<class Key, class Value>
+	void radixSort(Key* keys, Value* values, Key* tmpKeys, Value* tmpValues, UINT32 count)
+	{
+		static_assert(std::is_unsigned<Key>::value, "Radix sort keys must be unsigned integers.");
+
+		static constexpr UINT32 NUM_DIGITS = sizeof(Key);
+		static constexpr UINT32 NUM_BUCKETS = 256;
+
+		if(count < 2)
+			return;
+
+		// Build histograms for all digits in a single pass
+		UINT32 histograms[NUM_DIGITS][NUM_BUCKETS];
+		memset(histograms, 0, sizeof(histograms));
+
+		for(UINT32 i = 0; i < count; i++)
+		{
+			const Key key = keys[i];
+			for(UINT32 j = 0; j < NUM_DIGITS; j++)
+				histograms[j][(key >> (j * 8)) & 0xFF]++;
+		}
+
+		Key* srcKeys = keys;
+		Value* srcValues = values;
+		Key* dstKeys = tmpKeys;
+		Value* dstValues = tmpValues;
+
+		for(UINT32 i = 0; i < NUM_DIGITS; i++)
+		{
+			UINT32* histogram = histograms[i];
+
+			// If all keys share this digit the pass would not change the order
+			const UINT32 firstDigit = (UINT32)(srcKeys[0] >> (i * 8)) & 0xFF;
+			if(histogram[firstDigit] == count)
+				continue;
+
+			// Convert counts to output offsets
+			UINT32 offset = 0;
+			for(UINT32 j = 0; j < NUM_BUCKETS; j++)
+			{
+				const UINT32 bucketCount = histogram[j];
+				histogram[j] = offset;
+				offset += bucketCount;
+			}
+
+			for(UINT32 j = 0; j < count; j++)
+			{
+				const Key key = srcKeys[j];
+				const UINT32 dstIdx = histogram[(key >> (i * 8)) & 0xFF]++;
+
+				dstKeys[dstIdx] = key;
+				dstValues[dstIdx] = srcValues[j];
+			}
+
+			std::swap(srcKeys, dstKeys);
+			std::swap(srcValues, dstValues);
+		}
+
+		// Odd number of passes, results are in the temporary buffers
+		if(srcKeys != keys)
+		{
+			memcpy(keys, srcKeys, count * sizeof(Key));
+
+			for(UINT32 i = 0; i < count; i++)
+				values[i] = srcValues[i];
+		}
+	}
+
+	/**
+	 * Version of radixSort() that splits the keys into chunks processed in parallel by the task scheduler workers. Each
+	 * chunk counts its own digits and scatters its own keys, into a separate part of every output bucket so the sort
+	 * remains stable. Falls back to radixSort() if the scheduler isn't running or there are too few keys to split.
+	 * Temporary per-chunk digit counts are allocated from the frame allocator of the calling thread.
+	 *
+	 * @param[in, out]	keys		Keys to sort. Contains the sorted keys when the method returns.
+	 * @param[in, out]	values		Values associated with each key. Re-ordered along with the keys.
+	 * @param[in]		tmpKeys		Temporary storage with room for at least @p count keys.
+	 * @param[in]		tmpValues	Temporary storage with room for at least @p count values.
+	 * @param[in]		count		Number of entries in @p keys and @p values.
+	 *
+	 * @tparam			Key			Unsigned integer type used for the keys.
+	 * @tparam			Value		Type of the values. Should be cheap to copy (e.g. an index).
+	 */
+	template<class Key, class Value>
+	void radixSortParallel(Key* keys, Value* values, Key* tmpKeys, Value* tmpValues, UINT32 count)
+	{
+		static constexpr UINT32 NUM_DIGITS = sizeof(Key);
+		static constexpr UINT32 NUM_BUCKETS = 256;
+		static constexpr UINT32 MIN_CHUNK_SIZE = 16384;
+
+		UINT32 numChunks = 1;
+		if(TaskScheduler::isStarted())
+			numChunks = std::min(count / MIN_CHUNK_SIZE, TaskScheduler::instance().getNumWorkers() + 1);
+
+		if(numChunks <= 1)
+		{
+			radixSort(keys, values, tmpKeys, tmpValues, count);
+			return;
+		}
+
+		const UINT32 chunkSize = Math::divideAndRoundUp(count, numChunks);
+		const auto getChunkEnd = [chunkSize, count](UINT32 chunkIdx)
+		{
+			return std::min((chunkIdx + 1) * chunkSize, count);
+		};
+
+		bs_frame_mark();
+		{
+			// Histograms of all digits for each chunk, built in a single pass over the keys. Digit totals over all
+			// chunks don't change between passes, but the per-chunk counts do, so later passes recount their digit.
+			FrameVector<UINT32> histograms(numChunks * NUM_DIGITS * NUM_BUCKETS, 0);
+			const auto getHistogram = [&histograms](UINT32 chunkIdx, UINT32 digitIdx)
+			{
+				return &histograms[(chunkIdx * NUM_DIGITS + digitIdx) * NUM_BUCKETS];
+			};
+
+			TaskScheduler& scheduler = TaskScheduler::instance();
+			scheduler.parallelFor(0, numChunks, 1, [&](UINT32 begin, UINT32 end)
+			{
+				for(UINT32 i = begin; i < end; i++)
+				{
+					UINT32* chunkHistograms = getHistogram(i, 0);
+					for(UINT32 j = i * chunkSize; j < getChunkEnd(i); j++)
+					{
+						const Key key = keys[j];
+						for(UINT32 k = 0; k < NUM_DIGITS; k++)
+							chunkHistograms[k * NUM_BUCKETS + ((key >> (k * 8)) & 0xFF)]++;
+					}
+				}
+			});
+
+			Key* srcKeys = keys;
+			Value* srcValues = values;
+			Key* dstKeys = tmpKeys;
+			Value* dstValues = tmpValues;
+
+			UINT32 numPasses = 0;
+			for(UINT32 i = 0; i < NUM_DIGITS; i++)
+			{
+				// If all keys share this digit the pass would not change the order
+				const UINT32 firstDigit = (UINT32)(srcKeys[0] >> (i * 8)) & 0xFF;
+
+				UINT32 firstDigitCount = 0;
+				for(UINT32 j = 0; j < numChunks; j++)
+					firstDigitCount += getHistogram(j, i)[firstDigit];
+
+				if(firstDigitCount == count)
+					continue;
+
+				if(numPasses > 0)
+				{
+					scheduler.parallelFor(0, numChunks, 1, [&](UINT32 begin, UINT32 end)
+					{
+						for(UINT32 j = begin; j < end; j++)
+						{
+							UINT32* histogram = getHistogram(j, i);
+							memset(histogram, 0, NUM_BUCKETS * sizeof(UINT32));
+
+							for(UINT32 k = j * chunkSize; k < getChunkEnd(j); k++)
+								histogram[(srcKeys[k] >> (i * 8)) & 0xFF]++;
+						}
+					});
+				}
+
+				// Convert counts to output offsets. Within a bucket, earlier chunks are placed first.
+				UINT32 offset = 0;
+				for(UINT32 j = 0; j < NUM_BUCKETS; j++)
+				{
+					for(UINT32 k = 0; k < numChunks; k++)
+					{
+						UINT32& entry = getHistogram(k, i)[j];
+
+						const UINT32 bucketCount = entry;
+						entry = offset;
+						offset += bucketCount;
+					}
+				}
+
+				scheduler.parallelFor(0, numChunks, 1, [&](UINT32 begin, UINT32 end)
+				{
+					for(UINT32 j = begin; j < end; j++)
+					{
+						UINT32* histogram = getHistogram(j, i);
+						for(UINT32 k = j * chunkSize; k < getChunkEnd(j); k++)
+						{
+							const Key key = srcKeys[k];
+							const UINT32 dstIdx = histogram[(key >> (i * 8)) & 0xFF]++;
+
+							dstKeys[dstIdx] = key;
+							dstValues[dstIdx] = srcValues[k];
+						}
+					}
+				});
+
+				std::swap(srcKeys, dstKeys);
+				std::swap(srcValues, dstValues);
+				numPasses++;
+			}
+
+			// Odd number of passes, results are in the temporary buffers
+			if(srcKeys != keys)
+			{
+				memcpy(keys, srcKeys, count * sizeof(Key));
+
+				for(UINT32 i = 0; i < count; i++)
+					values[i] = srcValues[i];
+			}
+		}
+		bs_frame_clear();
+	}
+
+	/**
+	 * Converts a floating point value into an unsigned integer whose ordering, when compared as an integer, matches the
+	 * ordering of the original floating point values. Useful for creating radix sort keys from floating point values.
+	 */
+	inline UINT32 floatToSortableUInt(float value)
+	{
+		// Ensure negative zero maps to the same key as positive zero
+		value += 0.0f;
+
+		UINT32 bits;
+		memcpy(&bits, &value, sizeof(bits));
+
+		// Negative values have all their bits flipped so larger magnitudes sort first, positive values only the sign bit
+		const UINT32 mask = (UINT32)(-(INT32)(bits >> 31)) | 0x80000000;
+		return bits ^ mask;
+	}
+
+	/** @} */
+}
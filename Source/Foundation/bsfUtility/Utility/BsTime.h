@@ -52,6 +52,15 @@ namespace bs
 		/** Returns the time (in seconds) the latest fixed update has started. */
 		float getLastFixedUpdateTime() const { return (float)(mLastFixedUpdateTime * MICROSEC_TO_SEC); }
 
+		/** 
+		 * Returns the time (in seconds) by which the latest fixed update is ahead of the start of the latest frame. Fixed
+		 * updates are executed in whole steps, so they can run up to one step ahead of the frame time.
+		 */
+		float getFixedUpdateLead() const
+		{
+			return (float)((INT64)(mLastFixedUpdateTime - mLastFrameTime) * MICROSEC_TO_SEC);
+		}
+
 		/**
 		 * Returns the sequential index of the current frame. First frame is 0.
 		 *
@@ -188,6 +188,11 @@ namespace bs
 
 		SPtr<Texture> newTexture = Texture::_createPtr(texDesc);
 
+		// Surfaces of all faces and mip levels are compressed together, so the work can be split between threads
+		const bool compress = PixelUtil::isCompressed(texDesc.format);
+		Vector<SPtr<PixelData>> uncompressedSurfaces;
+		Vector<SPtr<PixelData>> compressedSurfaces;
+
 		UINT32 numFaces = (UINT32)faceData.size();
 		for (UINT32 i = 0; i < numFaces; i++)
 		{
@@ -206,11 +211,33 @@ namespace bs
 			{
 				SPtr<PixelData> dst = newTexture->getProperties().allocBuffer(0, mip);
 
-				PixelUtil::bulkPixelConversion(*mipLevels[mip], *dst);
-				newTexture->writeData(dst, i, mip);
+				if (compress)
+				{
+					uncompressedSurfaces.push_back(mipLevels[mip]);
+					compressedSurfaces.push_back(dst);
+				}
+				else
+				{
+					PixelUtil::bulkPixelConversion(*mipLevels[mip], *dst);
+					newTexture->writeData(dst, i, mip);
+				}
 			}
 		}
 
+		if (compress)
+		{
+			CompressionOptions compressionOptions;
+			compressionOptions.format = texDesc.format;
+			compressionOptions.isSRGB = sRGB;
+			compressionOptions.quality = textureImportOptions->getCompressionQuality();
+
+			PixelUtil::compress(uncompressedSurfaces, compressedSurfaces, compressionOptions);
+
+			const UINT32 numMipLevels = (UINT32)compressedSurfaces.size() / numFaces;
+			for (UINT32 i = 0; i < (UINT32)compressedSurfaces.size(); i++)
+				newTexture->writeData(compressedSurfaces[i], i / numMipLevels, i % numMipLevels);
+		}
+
 		const String fileName = filePath.getFilename(false);
 		newTexture->setName(fileName);
 
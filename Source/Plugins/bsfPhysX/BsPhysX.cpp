@@ -21,6 +21,8 @@
 #include "Components/BsCCollider.h"
 #include "BsFPhysXCollider.h"
 #include "Utility/BsTime.h"
+#include "Scene/BsSceneObject.h"
+#include "Profiling/BsProfilerCPU.h"
 #include "Math/BsVector3.h"
 #include "Math/BsAABox.h"
 #include "Math/BsCapsule.h"
@@ -284,28 +286,208 @@ namespace bs
 		}
 	};
 
+	/**
+	 * Executes PhysX tasks on the task scheduler worker threads. Tasks are stored in pre-allocated per-worker queues,
+	 * so submitting a task performs no allocations. Rather than wrapping each PhysX task in a scheduler task, a small
+	 * number of drain tasks are started, each executing PhysX tasks from its own queue and stealing from others, until
+	 * all queues are empty. The thread waiting for the simulation results can execute tasks as well, through runTask().
+	 */
 	class PhysXCPUDispatcher : public PxCpuDispatcher
 	{
+		/** Maximum number of tasks a single queue can hold. Tasks that don't fit in any queue are executed directly. */
+		static constexpr UINT32 QUEUE_CAPACITY = 1024;
+
+		/** Maximum number of queues, regardless of the number of workers. */
+		static constexpr UINT32 MAX_QUEUES = 16;
+
+		/** Number of times a drain task will look for new tasks before finishing. */
+		static constexpr UINT32 NUM_SPIN_ITERATIONS = 64;
+
+		/** Fixed size ring buffer of tasks. */
+		struct TaskQueue
+		{
+			/** Adds a task to the end of the queue. Returns false if the queue is full. */
+			bool push(PxBaseTask* task)
+			{
+				ScopedSpinLock lock(mLock);
+
+				if (mSize == QUEUE_CAPACITY)
+					return false;
+
+				mTasks[(mHead + mSize) % QUEUE_CAPACITY] = task;
+				mSize++;
+
+				return true;
+			}
+
+			/** Removes a task from the start of the queue. Returns null if the queue is empty. */
+			PxBaseTask* pop()
+			{
+				ScopedSpinLock lock(mLock);
+
+				if (mSize == 0)
+					return nullptr;
+
+				PxBaseTask* task = mTasks[mHead];
+				mHead = (mHead + 1) % QUEUE_CAPACITY;
+				mSize--;
+
+				return task;
+			}
+
+		private:
+			PxBaseTask* mTasks[QUEUE_CAPACITY];
+			UINT32 mHead = 0;
+			UINT32 mSize = 0;
+			SpinLock mLock;
+		};
+
 	public:
+		/** Sets up the dispatcher for the provided number of worker threads. Must be called before submitting tasks. */
+		void initialize(UINT32 numWorkers)
+		{
+			mNumWorkers = std::max(numWorkers, 1U);
+			mNumQueues = std::min(mNumWorkers + 1, MAX_QUEUES);
+		}
+
 		void submitTask(PxBaseTask& physxTask) override
 		{
-			// Note: Banshee's task scheduler is pretty low granularity. Consider a better task manager in case PhysX ends
-			// up submitting many tasks.
-			// - PhysX's task manager doesn't seem much lighter either. But perhaps I can at least create a task pool to 
-			//   avoid allocating them constantly.
+			// Keep tasks on the thread that submitted them if possible, otherwise spread them over all queues
+			UINT32 queueIdx = sQueueIdx;
+			if (queueIdx == (UINT32)-1)
+				queueIdx = mNextQueueIdx.fetch_add(1, std::memory_order_relaxed) % mNumQueues;
+
+			mNumQueuedTasks.fetch_add(1);
 
-			auto runTask = [&]() { physxTask.run(); physxTask.release(); };
-			SPtr<Task> task = Task::create("PhysX", runTask);
+			for (UINT32 i = 0; i < mNumQueues; i++)
+			{
+				if (mQueues[(queueIdx + i) % mNumQueues].push(&physxTask))
+				{
+					startDrainers();
+					return;
+				}
+			}
 
-			TaskScheduler::instance().addTask(task);
+			// All queues are full, execute the task right away rather than allocating more storage
+			mNumQueuedTasks.fetch_sub(1);
+			execute(physxTask);
 		}
 
 		PxU32 getWorkerCount() const override
 		{
-			return (PxU32)TaskScheduler::instance().getNumWorkers();
+			return (PxU32)mNumWorkers;
+		}
+
+		/** Executes a single queued task on the calling thread, if any. Returns true if a task was executed. */
+		bool runTask()
+		{
+			PxBaseTask* task = findTask(mNextQueueIdx.load(std::memory_order_relaxed) % mNumQueues);
+			if (!task)
+				return false;
+
+			execute(*task);
+			return true;
+		}
+
+		/** Returns the number of tasks executed since the last call to resetStats(). */
+		UINT32 getNumExecutedTasks() const { return mNumExecutedTasks.load(std::memory_order_relaxed); }
+
+		/** Resets the counters reported by getNumExecutedTasks(). */
+		void resetStats() { mNumExecutedTasks.store(0, std::memory_order_relaxed); }
+
+	private:
+		/** Starts a new drain task if there are more queued tasks than drain tasks, up to the number of workers. */
+		void startDrainers()
+		{
+			UINT32 numDrainers = mNumDrainers.load();
+			while (numDrainers < mNumWorkers && numDrainers < mNumQueuedTasks.load())
+			{
+				if (mNumDrainers.compare_exchange_weak(numDrainers, numDrainers + 1))
+				{
+					SPtr<Task> task = Task::create("PhysX", [this]() { drain(); });
+					TaskScheduler::instance().addTask(task);
+
+					break;
+				}
+			}
+		}
+
+		/** Executes queued tasks until all queues remain empty for a while. */
+		void drain()
+		{
+			sQueueIdx = mNextQueueIdx.fetch_add(1, std::memory_order_relaxed) % mNumQueues;
+
+			while (true)
+			{
+				PxBaseTask* task = nullptr;
+				for (UINT32 i = 0; i < NUM_SPIN_ITERATIONS && !task; i++)
+				{
+					task = findTask(sQueueIdx);
+
+					if (!task)
+						std::this_thread::yield();
+				}
+
+				if (task)
+				{
+					execute(*task);
+					continue;
+				}
+
+				mNumDrainers.fetch_sub(1);
+
+				// A task could have been queued after the search above, while this drainer was still counted as
+				// running, in which case nobody else will pick it up
+				if (mNumQueuedTasks.load() == 0)
+					break;
+
+				UINT32 numDrainers = mNumDrainers.load();
+				if (numDrainers >= mNumWorkers || !mNumDrainers.compare_exchange_strong(numDrainers, numDrainers + 1))
+					break;
+			}
+
+			sQueueIdx = (UINT32)-1;
+		}
+
+		/** Finds a queued task, starting with the queue at the provided index and then checking the others in order. */
+		PxBaseTask* findTask(UINT32 queueIdx)
+		{
+			for (UINT32 i = 0; i < mNumQueues; i++)
+			{
+				PxBaseTask* task = mQueues[(queueIdx + i) % mNumQueues].pop();
+				if (task)
+				{
+					mNumQueuedTasks.fetch_sub(1);
+					return task;
+				}
+			}
+
+			return nullptr;
+		}
+
+		/** Runs and releases a task, on the calling thread. */
+		void execute(PxBaseTask& physxTask)
+		{
+			physxTask.run();
+			physxTask.release();
+
+			mNumExecutedTasks.fetch_add(1, std::memory_order_relaxed);
 		}
+
+		TaskQueue mQueues[MAX_QUEUES];
+		UINT32 mNumQueues = 1;
+		UINT32 mNumWorkers = 1;
+
+		std::atomic<UINT32> mNextQueueIdx{0};
+		std::atomic<UINT32> mNumQueuedTasks{0};
+		std::atomic<UINT32> mNumDrainers{0};
+		std::atomic<UINT32> mNumExecutedTasks{0};
+
+		static BS_THREADLOCAL UINT32 sQueueIdx;
 	};
 
+	BS_THREADLOCAL UINT32 PhysXCPUDispatcher::sQueueIdx = (UINT32)-1;
+
 	class PhysXBroadPhaseCallback : public PxBroadPhaseCallback
 	{
 		void onObjectOutOfBounds(PxShape& shape, PxActor& actor) override
@@ -388,6 +570,16 @@ namespace bs
 		}
 	}
 
+	/** 
+	 * Returns the PhysX transform of a capsule used in a scene query. Query capsules extend along their local Y axis,
+	 * while PhysX capsules extend along their local X axis.
+	 */
+	PxTransform toPxCapsuleTransform(const Vector3& center, const Quaternion& rotation)
+	{
+		static const Quaternion CAPSULE_ALIGNMENT(Vector3::UNIT_Z, Degree(90.0f));
+		return toPxTransform(center, rotation * CAPSULE_ALIGNMENT);
+	}
+
 	struct PhysXRaycastQueryCallback : PxRaycastCallback
 	{
 		static const int MAX_HITS = 32;
@@ -454,6 +646,29 @@ namespace bs
 		}
 	};
 
+	/** Overlap query callback that writes the overlapping colliders into a fixed size buffer. */
+	struct PhysXOverlapBufferCallback : PxOverlapCallback
+	{
+		static const int MAX_HITS = 32;
+		PxOverlapHit buffer[MAX_HITS];
+
+		Collider** output;
+		UINT32 capacity;
+		UINT32 count = 0;
+
+		PhysXOverlapBufferCallback(Collider** output, UINT32 capacity)
+			:PxOverlapCallback(buffer, MAX_HITS), output(output), capacity(capacity)
+		{ }
+
+		PxAgain processTouches(const PxOverlapHit* buffer, PxU32 nbHits) override
+		{
+			for (PxU32 i = 0; i < nbHits && count < capacity; i++)
+				output[count++] = (Collider*)buffer[i].shape->userData;
+
+			return count < capacity;
+		}
+	};
+
 	static PhysXAllocator gPhysXAllocator;
 	static PhysXErrorCallback gPhysXErrorHandler;
 	static PhysXCPUDispatcher gPhysXCPUDispatcher;
@@ -485,6 +700,7 @@ namespace bs
 
 		PxSceneDesc sceneDesc(mScale); // TODO - Test out various other parameters provided by scene desc
 		sceneDesc.gravity = toPxVector(input.gravity);
+		gPhysXCPUDispatcher.initialize(TaskScheduler::instance().getNumWorkers());
 		sceneDesc.cpuDispatcher = &gPhysXCPUDispatcher;
 		sceneDesc.filterShader = PhysXFilterShader;
 		sceneDesc.simulationEventCallback = &gPhysXEventCallback;
@@ -505,10 +721,18 @@ namespace bs
 		mCharManager = PxCreateControllerManager(*mScene);
 
 		mDefaultMaterial = mPhysics->createMaterial(1.0f, 1.0f, 0.5f);
+
+		// Persistent, as a simulation running in the background can outlive the frame it was started on
+		mScratchBuffer = (UINT8*)bs_alloc_aligned16(SCRATCH_BUFFER_SIZE);
 	}
 
 	PhysX::~PhysX()
 	{
+		if (mSimulationInProgress)
+			mScene->fetchResults(true);
+
+		bs_free_aligned16(mScratchBuffer);
+
 		mCharManager->release();
 		mScene->release();
 
@@ -524,21 +748,64 @@ namespace bs
 		if (mPaused)
 			return;
 
-		mUpdateInProgress = true;
+		// Finish the previous step, in case the async option was toggled or sync wasn't called
+		syncSimulation();
+
+		gPhysXCPUDispatcher.resetStats();
+		mScene->simulate(step, nullptr, mScratchBuffer, SCRATCH_BUFFER_SIZE);
+		mSimulationInProgress = true;
+		mLastStep = step;
+
+		// When running asynchronously results are applied on the next sync point, allowing the simulation to run in
+		// parallel with the rest of the frame, at a cost to input latency
+		if (!mFlags.isSet(PhysicsFlag::AsyncSimulation))
+			syncSimulation();
+	}
 
-		// Note: Consider delaying fetchResults one frame. This could improve performance because Physics update would be
-		//       able to run parallel to the simulation thread, but at a cost to input latency.
-		bs_frame_mark();
-		UINT8* scratchBuffer = bs_frame_alloc_aligned(SCRATCH_BUFFER_SIZE, 16);
+	void PhysX::syncSimulation()
+	{
+		if (!mSimulationInProgress)
+			return;
+
+		gProfilerCPU().beginSample("PhysX wait");
+		const UINT64 waitStart = gTime().getTimePrecise();
+
+		// Help execute the simulation tasks instead of blocking
+		UINT32 numTasksOnWaitingThread = 0;
+		while (!mScene->checkResults(false))
+		{
+			if (gPhysXCPUDispatcher.runTask())
+				numTasksOnWaitingThread++;
+			else
+				std::this_thread::yield();
+		}
 
-		mScene->simulate(step, nullptr, scratchBuffer, SCRATCH_BUFFER_SIZE);
+		mUpdateInProgress = true;
 
 		UINT32 errorState;
 		if (!mScene->fetchResults(true, &errorState))
 			LOGWRN("Physics simulation failed. Error code: " + toString(errorState));
 
-		bs_frame_free_aligned(scratchBuffer);
-		bs_frame_clear();
+		mSimulationInProgress = false;
+
+		PhysicsStepStats stepStats;
+		stepStats.numTasks = gPhysXCPUDispatcher.getNumExecutedTasks();
+		stepStats.numTasksOnWaitingThread = numTasksOnWaitingThread;
+		stepStats.waitTime = (gTime().getTimePrecise() - waitStart) / 1000.0f;
+		mPendingStepStats.push_back(stepStats);
+		gProfilerCPU().endSample("PhysX wait");
+
+		// Bodies that aren't reported as active below haven't moved during this step
+		const bool interpolate = mFlags.isSet(PhysicsFlag::Interpolation);
+		if (interpolate)
+		{
+			for (auto& entry : mInterpolatedPoses)
+			{
+				InterpolatedPose& pose = entry.second;
+				pose.prevPosition = pose.position;
+				pose.prevRotation = pose.rotation;
+			}
+		}
 
 		// Update rigidbodies with new transforms
 		PxU32 numActiveTransforms;
@@ -555,12 +822,33 @@ namespace bs
 				continue;
 
 			const PxTransform& transform = activeTransforms[i].actor2World;
+			const Vector3 position = fromPxVector(transform.p);
+			const Quaternion rotation = fromPxQuaternion(transform.q);
+
+			if (interpolate)
+			{
+				auto iterFind = mInterpolatedPoses.find(rigidbody);
+				if (iterFind == mInterpolatedPoses.end())
+				{
+					// Body just started moving, its scene object still holds the pose from before this step
+					const Transform& tfrm = rigidbody->_getLinkedSO()->getTransform();
+
+					InterpolatedPose newPose;
+					newPose.prevPosition = tfrm.getPosition();
+					newPose.prevRotation = tfrm.getRotation();
+
+					iterFind = mInterpolatedPoses.insert(std::make_pair(rigidbody, newPose)).first;
+				}
 
-			// Note: Make this faster, avoid dereferencing Rigidbody and attempt to access pos/rot destination directly,
-			//       use non-temporal writes
-			rigidbody->_setTransform(fromPxVector(transform.p), fromPxQuaternion(transform.q));
+				iterFind->second.position = position;
+				iterFind->second.rotation = rotation;
+			}
+
+			queueTransform(rigidbody, position, rotation);
 		}
 
+		applyTransforms();
+
 		// Note: Consider extrapolating for the remaining "simulationAmount" value
 		mUpdateInProgress = false;
 
@@ -569,7 +857,60 @@ namespace bs
 
 	void PhysX::update()
 	{
-		// Note: Potentially interpolate (would mean a one frame delay needs to be introduced)
+		// Expose the steps completed since the last frame, and start recording the ones for the next frame
+		std::swap(mStepStats, mPendingStepStats);
+		mPendingStepStats.clear();
+
+		if (mPaused || mInterpolatedPoses.empty())
+			return;
+
+		// Fixed updates run in whole steps, so the most recent step can be ahead of the current frame by up to a step.
+		// Display the state in between the two most recent steps that matches the frame time. When simulating
+		// asynchronously the most recent applied step is one step older, which delays the displayed state by a step.
+		const float t = Math::clamp01(1.0f - gTime().getFixedUpdateLead() / mLastStep);
+
+		mUpdateInProgress = true;
+
+		for (auto iter = mInterpolatedPoses.begin(); iter != mInterpolatedPoses.end();)
+		{
+			const InterpolatedPose& pose = iter->second;
+
+			const Vector3 position = Vector3::lerp(t, pose.prevPosition, pose.position);
+			const Quaternion rotation = Quaternion::slerp(t, pose.prevRotation, pose.rotation);
+			queueTransform(iter->first, position, rotation);
+
+			// Body has come to rest, no need to interpolate until it starts moving again
+			if (pose.prevPosition == pose.position && pose.prevRotation == pose.rotation)
+				iter = mInterpolatedPoses.erase(iter);
+			else
+				++iter;
+		}
+
+		applyTransforms();
+		mUpdateInProgress = false;
+	}
+
+	void PhysX::queueTransform(Rigidbody* rigidbody, const Vector3& position, const Quaternion& rotation)
+	{
+		mTransformObjects.push_back(rigidbody->_getLinkedSO().get());
+		mTransformPositions.push_back(position);
+		mTransformRotations.push_back(rotation);
+	}
+
+	void PhysX::applyTransforms()
+	{
+		SceneObject::_setWorldTransforms(mTransformObjects.data(), mTransformPositions.data(),
+			mTransformRotations.data(), (UINT32)mTransformObjects.size());
+
+		// Keep the capacity, so following steps don't need to allocate
+		mTransformObjects.clear();
+		mTransformPositions.clear();
+		mTransformRotations.clear();
+	}
+
+	void PhysX::_resetInterpolation(Rigidbody* rigidbody)
+	{
+		mInterpolatedPoses.erase(rigidbody);
 	}
 
 	void PhysX::_reportContactEvent(const ContactEvent& event)
@@ -831,7 +1172,7 @@ namespace bs
 		PhysicsQueryHit& hit, UINT64 layer, float max) const
 	{
 		PxCapsuleGeometry geometry(capsule.getRadius(), capsule.getHeight() * 0.5f);
-		PxTransform transform = toPxTransform(capsule.getCenter(), Quaternion::IDENTITY);
+		PxTransform transform = toPxCapsuleTransform(capsule.getCenter(), rotation);
 
 		return sweep(geometry, transform, unitDir, hit, layer, max);
 	}
@@ -888,7 +1229,7 @@ namespace bs
 		const Vector3& unitDir, UINT64 layer, float max) const
 	{
 		PxCapsuleGeometry geometry(capsule.getRadius(), capsule.getHeight() * 0.5f);
-		PxTransform transform = toPxTransform(capsule.getCenter(), Quaternion::IDENTITY);
+		PxTransform transform = toPxCapsuleTransform(capsule.getCenter(), rotation);
 
 		return sweepAll(geometry, transform, unitDir, layer, max);
 	}
@@ -944,7 +1285,7 @@ namespace bs
 		UINT64 layer, float max) const
 	{
 		PxCapsuleGeometry geometry(capsule.getRadius(), capsule.getHeight() * 0.5f);
-		PxTransform transform = toPxTransform(capsule.getCenter(), Quaternion::IDENTITY);
+		PxTransform transform = toPxCapsuleTransform(capsule.getCenter(), rotation);
 
 		return sweepAny(geometry, transform, unitDir, layer, max);
 	}
@@ -986,7 +1327,7 @@ namespace bs
 		UINT64 layer) const
 	{
 		PxCapsuleGeometry geometry(capsule.getRadius(), capsule.getHeight() * 0.5f);
-		PxTransform transform = toPxTransform(capsule.getCenter(), Quaternion::IDENTITY);
+		PxTransform transform = toPxCapsuleTransform(capsule.getCenter(), rotation);
 
 		return overlap(geometry, transform, layer);
 	}
@@ -1027,7 +1368,7 @@ namespace bs
 		UINT64 layer) const
 	{
 		PxCapsuleGeometry geometry(capsule.getRadius(), capsule.getHeight() * 0.5f);
-		PxTransform transform = toPxTransform(capsule.getCenter(), Quaternion::IDENTITY);
+		PxTransform transform = toPxCapsuleTransform(capsule.getCenter(), rotation);
 
 		return overlapAny(geometry, transform, layer);
 	}
@@ -1110,10 +1451,47 @@ namespace bs
 		return output.data;
 	}
 
+	UINT32 PhysX::_overlap(const PhysicsShapeQuery& query, Collider** colliders, UINT32 maxColliders) const
+	{
+		PxQueryFilterData filterData;
+		memcpy(&filterData.data.word0, &query.layer, sizeof(query.layer));
+
+		PhysXOverlapBufferCallback output(colliders, maxColliders);
+		switch (query.shape)
+		{
+		case PhysicsQueryShape::Box:
+			mScene->overlap(PxBoxGeometry(toPxVector(query.extents)), toPxTransform(query.center, query.rotation), 
+				output, filterData);
+			break;
+		case PhysicsQueryShape::Sphere:
+			mScene->overlap(PxSphereGeometry(query.extents.x), toPxTransform(query.center, Quaternion::IDENTITY), 
+				output, filterData);
+			break;
+		case PhysicsQueryShape::Capsule:
+			mScene->overlap(PxCapsuleGeometry(query.extents.x, query.extents.y),
+				toPxCapsuleTransform(query.center, query.rotation), output, filterData);
+			break;
+		}
+
+		return output.count;
+	}
+
 	void PhysX::setFlag(PhysicsFlags flag, bool enabled)
 	{
 		Physics::setFlag(flag, enabled);
 
+		// Move bodies that were being interpolated to their simulated poses
+		if (!mFlags.isSet(PhysicsFlag::Interpolation))
+		{
+			mUpdateInProgress = true;
+
+			for (auto& entry : mInterpolatedPoses)
+				entry.first->_setTransform(entry.second.position, entry.second.rotation);
+
+			mUpdateInProgress = false;
+			mInterpolatedPoses.clear();
+		}
+
 		mCharManager->setOverlapRecoveryModule(mFlags.isSet(PhysicsFlag::CCT_OverlapRecovery));
 		mCharManager->setPreciseSweeps(mFlags.isSet(PhysicsFlag::CCT_PreciseSweeps));
 		mCharManager->setTessellation(mFlags.isSet(PhysicsFlag::CCT_Tesselation), mTesselationLength);
@@ -51,6 +51,15 @@ namespace bs
 			Joint* joint; /** Broken joint. */
 		};
 
+		/** Poses of a rigidbody before and after the most recent physics step, used for interpolating its transform. */
+		struct InterpolatedPose
+		{
+			Vector3 prevPosition;
+			Quaternion prevRotation;
+			Vector3 position;
+			Quaternion rotation;
+		};
+
 	public:
 		PhysX(const PHYSICS_INIT_DESC& input);
 		~PhysX();
@@ -189,6 +198,9 @@ namespace bs
 		/** @copydoc Physics::setPaused */
 		void setPaused(bool paused) override;
 
+		/** @copydoc Physics::syncSimulation */
+		void syncSimulation() override;
+
 		/** @copydoc Physics::getGravity */
 		Vector3 getGravity() const override;
 
@@ -225,6 +237,9 @@ namespace bs
 		Vector<Collider*> _convexOverlap(const HPhysicsMesh& mesh, const Vector3& position,
 			const Quaternion& rotation, UINT64 layer = BS_ALL_LAYERS) const override;
 
+		/** @copydoc Physics::_overlap */
+		UINT32 _overlap(const PhysicsShapeQuery& query, Collider** colliders, UINT32 maxColliders) const override;
+
 		/** @copydoc Physics::_rayCast */
 		bool _rayCast(const Vector3& origin, const Vector3& unitDir, const Collider& collider, PhysicsQueryHit& hit, 
 			float maxDist = FLT_MAX) const override;
@@ -238,6 +253,12 @@ namespace bs
 		/** Triggered by the PhysX simulation when a joint breaks. */
 		void _reportJointBreakEvent(const JointBreakEvent& event);
 
+		/** 
+		 * Stops interpolating the transform of the provided rigidbody, until the simulation moves it again. Must be called
+		 * when the rigidbody is teleported or destroyed.
+		 */
+		void _resetInterpolation(Rigidbody* rigidbody);
+
 		/** Returns the default PhysX material. */
 		physx::PxMaterial* getDefaultMaterial() const { return mDefaultMaterial; }
 
@@ -288,14 +309,30 @@ namespace bs
 		/** Helper method that checks if the provided geometry overlaps any physics object. */
 		inline bool overlapAny(const physx::PxGeometry& geometry, const physx::PxTransform& tfrm, UINT64 layer) const;
 
+		/** Queues a transform to be applied to the rigidbody's scene object by the next applyTransforms() call. */
+		void queueTransform(Rigidbody* rigidbody, const Vector3& position, const Quaternion& rotation);
+
+		/** Applies all transforms queued by queueTransform() to their scene objects. */
+		void applyTransforms();
+
 		float mTesselationLength = 3.0f;
 		UINT32 mNextRegionIdx = 1;
 		bool mPaused = false;
+		bool mSimulationInProgress = false;
+		UINT8* mScratchBuffer = nullptr;
+		float mLastStep = 0.0f;
+		Vector<PhysicsStepStats> mPendingStepStats;
 
 		Vector<TriggerEvent> mTriggerEvents;
 		Vector<ContactEvent> mContactEvents;
 		Vector<JointBreakEvent> mJointBreakEvents;
 		UnorderedMap<UINT32, UINT32> mBroadPhaseRegionHandles;
+		UnorderedMap<Rigidbody*, InterpolatedPose> mInterpolatedPoses;
+
+		// Transforms to write back to scene objects, stored as separate arrays so they can be applied in bulk
+		Vector<SceneObject*> mTransformObjects;
+		Vector<Vector3> mTransformPositions;
+		Vector<Quaternion> mTransformRotations;
 
 		physx::PxFoundation* mFoundation = nullptr;
 		physx::PxPhysics* mPhysics = nullptr;
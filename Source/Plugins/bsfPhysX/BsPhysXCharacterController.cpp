@@ -84,6 +84,9 @@ namespace bs
 
 	CharacterCollisionFlags PhysXCharacterController::move(const Vector3& displacement)
 	{
+		// Controller queries and writes its kinematic actor directly, which can't overlap a step running in the background
+		gPhysX().syncSimulation();
+
 		PxControllerFilters filters;
 		filters.mFilterCallback = this;
 		filters.mFilterFlags = PxQueryFlag::eANY_HIT | PxQueryFlag::eSTATIC | PxQueryFlag::eDYNAMIC | PxQueryFlag::ePREFILTER;
@@ -59,6 +59,8 @@ namespace bs
 
 	PhysXRigidbody::~PhysXRigidbody()
 	{
+		gPhysX()._resetInterpolation(this);
+
 		mInternal->userData = nullptr;
 		mInternal->release();
 	}
@@ -111,6 +113,9 @@ namespace bs
 
 	void PhysXRigidbody::setTransform(const Vector3& pos, const Quaternion& rot)
 	{
+		// Teleported, don't interpolate from the previous pose
+		gPhysX()._resetInterpolation(this);
+
 		mInternal->setGlobalPose(toPxTransform(pos, rot));
 	}
 
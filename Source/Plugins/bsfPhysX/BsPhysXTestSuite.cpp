@@ -0,0 +1,174 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Testing/BsTestSuite.h"
+#include "BsPhysX.h"
+#include "Physics/BsBoxCollider.h"
+#include "Profiling/BsProfilerCPU.h"
+#include "Utility/BsTime.h"
+#include "Threading/BsThreadPool.h"
+#include "Threading/BsTaskScheduler.h"
+
+namespace bs
+{
+	/** Runs unit tests for systems specific to the PhysX plugin. */
+	class PhysXTestSuite : public TestSuite
+	{
+	public:
+		PhysXTestSuite();
+
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void testBatchedQueries();
+		void testStepStats();
+	};
+
+	PhysXTestSuite::PhysXTestSuite()
+	{
+		BS_ADD_TEST(PhysXTestSuite::testBatchedQueries);
+		BS_ADD_TEST(PhysXTestSuite::testStepStats);
+	}
+
+	void PhysXTestSuite::startUp()
+	{
+		MemStack::beginThread();
+		ProfilerCPU::startUp();
+		Time::startUp();
+
+		const UINT32 numCores = BS_THREAD_HARDWARE_CONCURRENCY;
+		ThreadPool::startUp<TThreadPool<>>(numCores, std::max(16U, numCores * 2));
+		TaskScheduler::startUp();
+
+		Physics::startUp<PhysX>(PHYSICS_INIT_DESC());
+	}
+
+	void PhysXTestSuite::shutDown()
+	{
+		Physics::shutDown();
+		TaskScheduler::shutDown();
+		ThreadPool::shutDown();
+
+		Time::shutDown();
+		ProfilerCPU::shutDown();
+		MemStack::endThread();
+	}
+
+	void PhysXTestSuite::testBatchedQueries()
+	{
+		static constexpr UINT32 NUM_QUERIES = 4;
+		static constexpr UINT32 MAX_COLLIDERS = 4;
+		static constexpr float EPSILON = 0.01f;
+
+		// Box to the side of the origin, along the X axis
+		SPtr<BoxCollider> box = BoxCollider::create(Vector3(0.5f, 0.5f, 0.5f), Vector3(4.0f, 0.0f, 0.0f));
+		Collider* boxCollider = box.get();
+
+		// Capsules extend along their local Y axis, and only reach the box once rotated towards the X axis. Boxes are
+		// long along their local X axis, and no longer reach the box once rotated towards the Y axis.
+		PhysicsShapeQuery queries[NUM_QUERIES];
+		queries[0].shape = PhysicsQueryShape::Capsule;
+		queries[0].extents = Vector3(0.5f, 4.0f, 0.0f);
+
+		queries[1] = queries[0];
+		queries[1].rotation = Quaternion(Vector3::UNIT_Z, Degree(-90.0f));
+
+		queries[2].shape = PhysicsQueryShape::Box;
+		queries[2].extents = Vector3(4.0f, 0.5f, 0.5f);
+
+		queries[3] = queries[2];
+		queries[3].rotation = Quaternion(Vector3::UNIT_Z, Degree(90.0f));
+
+		const bool expectedOverlaps[NUM_QUERIES] = { false, true, true, false };
+
+		bool overlaps[NUM_QUERIES];
+		gPhysics().overlapAnyBatch(queries, NUM_QUERIES, overlaps);
+
+		Collider* colliders[NUM_QUERIES * MAX_COLLIDERS];
+		UINT32 numColliders[NUM_QUERIES];
+		gPhysics().overlapBatch(queries, NUM_QUERIES, colliders, MAX_COLLIDERS, numColliders);
+
+		for(UINT32 i = 0; i < NUM_QUERIES; i++)
+		{
+			BS_TEST_ASSERT(overlaps[i] == expectedOverlaps[i]);
+			BS_TEST_ASSERT(numColliders[i] == (expectedOverlaps[i] ? 1U : 0U));
+
+			if(numColliders[i] > 0)
+				BS_TEST_ASSERT(colliders[i * MAX_COLLIDERS] == boxCollider);
+		}
+
+		// Same shapes cast downwards onto the box, from above it. Shapes long along the Y axis hit it sooner.
+		for(auto& query : queries)
+		{
+			query.center = Vector3(4.0f, 10.0f, 0.0f);
+			query.unitDir = -Vector3::UNIT_Y;
+			query.max = 20.0f;
+		}
+
+		const float expectedDistances[NUM_QUERIES] = { 5.0f, 9.0f, 9.0f, 5.5f };
+
+		PhysicsQueryHit hits[NUM_QUERIES];
+		bool wasHit[NUM_QUERIES];
+		gPhysics().shapeCastBatch(queries, NUM_QUERIES, hits, wasHit);
+
+		for(UINT32 i = 0; i < NUM_QUERIES; i++)
+		{
+			BS_TEST_ASSERT(wasHit[i]);
+
+			if(wasHit[i])
+			{
+				BS_TEST_ASSERT(hits[i].colliderRaw == boxCollider);
+				BS_TEST_ASSERT(Math::approxEquals(hits[i].distance, expectedDistances[i], EPSILON));
+			}
+		}
+	}
+
+	void PhysXTestSuite::testStepStats()
+	{
+		static constexpr UINT32 NUM_STEPS = 3;
+		static constexpr UINT32 NUM_BOXES = 64;
+		static constexpr float STEP = 1.0f / 60.0f;
+
+		// Enough objects for the simulation to spread its work over multiple dispatcher tasks
+		Vector<SPtr<BoxCollider>> boxes;
+		for(UINT32 i = 0; i < NUM_BOXES; i++)
+			boxes.push_back(BoxCollider::create(Vector3(0.5f, 0.5f, 0.5f), Vector3((float)i * 0.75f, 0.0f, 0.0f)));
+
+		// Clear any steps recorded by other tests
+		gPhysics().update();
+
+		// Every step gets recorded, and reported by the next update
+		for(UINT32 i = 0; i < NUM_STEPS; i++)
+			gPhysics().fixedUpdate(STEP);
+
+		BS_TEST_ASSERT(gPhysics().getStepStats().empty());
+		gPhysics().update();
+
+		const Vector<PhysicsStepStats>& stepStats = gPhysics().getStepStats();
+		BS_TEST_ASSERT(stepStats.size() == NUM_STEPS);
+
+		for(auto& entry : stepStats)
+		{
+			BS_TEST_ASSERT(entry.numTasks > 0);
+			BS_TEST_ASSERT(entry.numTasksOnWaitingThread <= entry.numTasks);
+			BS_TEST_ASSERT(entry.waitTime >= 0.0f);
+		}
+
+		// Asynchronous steps are recorded once they are synced
+		gPhysics().setFlag(PhysicsFlag::AsyncSimulation, true);
+		gPhysics().fixedUpdate(STEP);
+		gPhysics().update();
+		BS_TEST_ASSERT(gPhysics().getStepStats().empty());
+
+		gPhysics().syncSimulation();
+		gPhysics().update();
+		BS_TEST_ASSERT(gPhysics().getStepStats().size() == 1);
+		BS_TEST_ASSERT(gPhysics().getStepStats()[0].numTasks > 0);
+
+		gPhysics().setFlag(PhysicsFlag::AsyncSimulation, false);
+
+		// No steps, nothing to report
+		gPhysics().update();
+		BS_TEST_ASSERT(gPhysics().getStepStats().empty());
+	}
+}
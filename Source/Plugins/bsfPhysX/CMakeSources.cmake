@@ -40,6 +40,7 @@ set(BS_PHYSX_SRC_NOFILTER
 	"BsPhysXSphericalJoint.cpp"
 	"BsPhysXD6Joint.cpp"
 	"BsPhysXCharacterController.cpp"
+	"BsPhysXTestSuite.cpp"
 )
 
 set(BS_PHYSX_INC_RTTI
@@ -2,9 +2,68 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Testing/BsTestSuite.h"
 #include "Utility/BsTextureRowAllocator.h"
+#include "Utility/BsSceneOctree.h"
+#include "Utility/BsTimer.h"
+#include "Debug/BsDebug.h"
+#include "BsRendererView.h"
 
 namespace bs
 {
+	/** Randomly placed objects, stored both as a flat list of bounds and in an octree. */
+	struct CullingTestWorld
+	{
+		ct::CullInfoSoA cullInfos;
+		ct::SceneOctree octree;
+	};
+
+	/** Fills the provided world with a large number of objects spread over a wide, flat area. */
+	static void buildCullingTestWorld(UINT32 numObjects, CullingTestWorld& world)
+	{
+		for(UINT32 i = 0; i < numObjects; i++)
+		{
+			Vector3 position(
+				((rand() / (float)RAND_MAX) * 2.0f - 1.0f) * 4000.0f,
+				((rand() / (float)RAND_MAX) * 2.0f - 1.0f) * 200.0f,
+				((rand() / (float)RAND_MAX) * 2.0f - 1.0f) * 4000.0f
+			);
+
+			Vector3 extent = Vector3::ONE * (0.5f + (rand() / (float)RAND_MAX) * 5.0f);
+			AABox box(position - extent, position + extent);
+
+			world.cullInfos.add(ct::CullInfo(Bounds(box, Sphere(position, extent.length()))));
+			world.octree.add(i, box);
+		}
+	}
+
+	/** Marks the visible objects of the world by testing every object against the frustum. */
+	static void cullLinear(const CullingTestWorld& world, const ConvexVolume& frustum, Bitfield& visibility)
+	{
+		const ct::CullInfoSoA& cullInfos = world.cullInfos;
+
+		const float* const centers[3] = 
+			{ cullInfos.centers[0].data(), cullInfos.centers[1].data(), cullInfos.centers[2].data() };
+		const float* const extents[3] = 
+			{ cullInfos.extents[0].data(), cullInfos.extents[1].data(), cullInfos.extents[2].data() };
+
+		frustum.intersects(centers, extents, cullInfos.radii.data(), (UINT32)cullInfos.radii.size(), visibility.data());
+	}
+
+	/** Marks the visible objects of the world by testing only the objects in octree nodes the frustum intersects. */
+	static void cullOctree(const CullingTestWorld& world, const ConvexVolume& frustum, Bitfield& visibility)
+	{
+		const ct::CullInfoSoA& cullInfos = world.cullInfos;
+
+		ct::SceneOctree::VolumeIterator iter(world.octree, frustum);
+		while(iter.moveNext())
+		{
+			const UINT32 idx = iter.getId();
+			const Vector3 center(cullInfos.centers[0][idx], cullInfos.centers[1][idx], cullInfos.centers[2][idx]);
+
+			if(frustum.intersects(Sphere(center, cullInfos.radii[idx])))
+				visibility[idx] = true;
+		}
+	}
+
 	/** Runs unit tests for systems specific to the RenderBeast plugin. */
 	class RenderBeastTestSuite : public TestSuite
 	{
@@ -13,11 +72,21 @@ namespace bs
 
 	private:
 		void testTextureRowAllocator();
+		void testSceneCulling();
+
+#if BS_BENCHMARKS
+		void benchmarkSceneCulling();
+#endif
 	};
 
 	RenderBeastTestSuite::RenderBeastTestSuite()
 	{
 		BS_ADD_TEST(RenderBeastTestSuite::testTextureRowAllocator);
+		BS_ADD_TEST(RenderBeastTestSuite::testSceneCulling);
+
+#if BS_BENCHMARKS
+		BS_ADD_TEST(RenderBeastTestSuite::benchmarkSceneCulling);
+#endif
 	}
 
 	void RenderBeastTestSuite::testTextureRowAllocator()
@@ -71,4 +140,97 @@ namespace bs
 		auto a13 = alloc.alloc(0);
 		BS_TEST_ASSERT(a13.length == 0);
 	}
+
+	void RenderBeastTestSuite::testSceneCulling()
+	{
+		static constexpr UINT32 NUM_OBJECTS = 100000;
+
+		// Large static world
+		CullingTestWorld world;
+		buildCullingTestWorld(NUM_OBJECTS, world);
+
+		ct::SceneOctree& octree = world.octree;
+
+		// Views with a decreasing portion of the world visible
+		float farPlanes[] = { 5000.0f, 1000.0f, 200.0f };
+		for(auto farPlane : farPlanes)
+		{
+			ConvexVolume frustum(Matrix4::projectionPerspective(Degree(75.0f), 16.0f / 9.0f, 0.1f, farPlane));
+
+			Bitfield linearVisibility;
+			linearVisibility.resize(NUM_OBJECTS, false);
+			cullLinear(world, frustum, linearVisibility);
+
+			Bitfield octreeVisibility;
+			octreeVisibility.resize(NUM_OBJECTS, false);
+			cullOctree(world, frustum, octreeVisibility);
+
+			for(UINT32 i = 0; i < NUM_OBJECTS; i++)
+				BS_TEST_ASSERT(linearVisibility[i] == octreeVisibility[i]);
+		}
+
+		// Incremental updates
+		for(UINT32 i = 0; i < NUM_OBJECTS; i += 3)
+			octree.update(i, AABox(Vector3(-1.0f, -1.0f, -11.0f), Vector3(1.0f, 1.0f, -9.0f)));
+
+		for(UINT32 i = 0; i < NUM_OBJECTS / 2; i++)
+			octree.remove((i * 7919) % octree.size());
+
+		BS_TEST_ASSERT(octree.size() == NUM_OBJECTS / 2);
+	}
+
+#if BS_BENCHMARKS
+	void RenderBeastTestSuite::benchmarkSceneCulling()
+	{
+		static constexpr UINT32 NUM_ITERATIONS = 10;
+
+		// Large static worlds, culled by views with a decreasing portion of the world visible
+		for(auto numObjects : { 10000U, 100000U, 1000000U })
+		{
+			CullingTestWorld world;
+			buildCullingTestWorld(numObjects, world);
+
+			for(auto farPlane : { 5000.0f, 1000.0f, 200.0f })
+			{
+				ConvexVolume frustum(Matrix4::projectionPerspective(Degree(75.0f), 16.0f / 9.0f, 0.1f, farPlane));
+
+				Bitfield linearVisibility;
+				linearVisibility.resize(numObjects, false);
+
+				Timer timer;
+				for(UINT32 i = 0; i < NUM_ITERATIONS; i++)
+				{
+					linearVisibility.reset(false);
+					cullLinear(world, frustum, linearVisibility);
+				}
+
+				const UINT64 linearUs = timer.getMicroseconds() / NUM_ITERATIONS;
+
+				Bitfield octreeVisibility;
+				octreeVisibility.resize(numObjects, false);
+
+				timer.reset();
+				for(UINT32 i = 0; i < NUM_ITERATIONS; i++)
+				{
+					octreeVisibility.reset(false);
+					cullOctree(world, frustum, octreeVisibility);
+				}
+
+				const UINT64 octreeUs = timer.getMicroseconds() / NUM_ITERATIONS;
+
+				UINT32 numVisible = 0;
+				for(UINT32 i = 0; i < numObjects; i++)
+				{
+					BS_TEST_ASSERT(linearVisibility[i] == octreeVisibility[i]);
+
+					if(linearVisibility[i])
+						numVisible++;
+				}
+
+				gDebug().logDebug("Scene culling of " + toString(numObjects) + " objects (" + toString(numVisible) + 
+					" visible): linear " + toString(linearUs) + "us, octree " + toString(octreeUs) + "us.");
+			}
+		}
+	}
+#endif
 }
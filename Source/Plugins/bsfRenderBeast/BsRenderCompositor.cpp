@@ -366,6 +366,10 @@ namespace bs { namespace ct
 				// Bind textures/buffers from GPU simulation
 				else if(rendererParticles.gpuParticleSystem)
 					rendererParticles.bindGPUSimulatedInputs(gpuSimResources, inputs.view);
+				// Simulation skipped this frame, any bound textures are from an earlier frame and might be reused by
+				// other systems
+				else if(particleData->culledBounds.find(particleSystem->getId()) != particleData->culledBounds.end())
+					renderElement.numParticles = 0;
 			}
 		}
 
@@ -636,35 +640,36 @@ namespace bs { namespace ct
 					systemsToSort.push_back({ particleSystem, simulationData });
 			}
 
-			const auto worker = [&systemsToSort, viewOrigin = viewProps.viewOrigin](UINT32 idx)
+			const auto worker = [&systemsToSort, viewOrigin = viewProps.viewOrigin](UINT32 begin, UINT32 end)
 			{
-				const SortData& data = systemsToSort[idx];
+				for(UINT32 i = begin; i < end; i++)
+				{
+					const SortData& data = systemsToSort[i];
 
-				Vector3 refPoint = viewOrigin;
+					Vector3 refPoint = viewOrigin;
 
-				// Transform the view point into particle system's local space
-				const ParticleSystemSettings& settings = data.system->getSettings();
-				if (settings.simulationSpace == ParticleSimulationSpace::Local)
-					refPoint = data.system->getTransform().getInvMatrix().multiplyAffine(refPoint);
+					// Transform the view point into particle system's local space
+					const ParticleSystemSettings& settings = data.system->getSettings();
+					if (settings.simulationSpace == ParticleSimulationSpace::Local)
+						refPoint = data.system->getTransform().getInvMatrix().multiplyAffine(refPoint);
 
-				if (settings.renderMode == ParticleRenderMode::Billboard)
-				{
-					auto renderData = static_cast<ParticleBillboardRenderData*>(data.renderData);
-					ParticleRenderer::sortByDistance(refPoint, renderData->positionAndRotation,
-						renderData->numParticles, 4, renderData->indices);
-				}
-				else
-				{
-					auto renderData = static_cast<ParticleMeshRenderData*>(data.renderData);
-					ParticleRenderer::sortByDistance(refPoint, renderData->position, renderData->numParticles,
-						3, renderData->indices);
+					if (settings.renderMode == ParticleRenderMode::Billboard)
+					{
+						auto renderData = static_cast<ParticleBillboardRenderData*>(data.renderData);
+						ParticleRenderer::sortByDistance(refPoint, renderData->positionAndRotation,
+							renderData->numParticles, 4, renderData->indices);
+					}
+					else
+					{
+						auto renderData = static_cast<ParticleMeshRenderData*>(data.renderData);
+						ParticleRenderer::sortByDistance(refPoint, renderData->position, renderData->numParticles,
+							3, renderData->indices);
+					}
 				}
 			};
 
-			SPtr<TaskGroup> sortTask = TaskGroup::create("ParticleSort", worker, (UINT32)systemsToSort.size());
-
-			TaskScheduler::instance().addTaskGroup(sortTask);
-			sortTask->wait();
+			// Each system is a sizable amount of work, so let every system be picked up separately
+			TaskScheduler::instance().parallelFor(0, (UINT32)systemsToSort.size(), 1, worker);
 		}
 		bs_frame_clear();
 	}
@@ -10,6 +10,7 @@
 #include "Shading/BsGpuParticleSimulation.h"
 #include "Material/BsGpuParamsSet.h"
 #include "BsRendererView.h"
+#include "Utility/BsRadixSort.h"
 
 namespace bs { namespace ct
 {
@@ -381,31 +382,24 @@ namespace bs { namespace ct
 	void ParticleRenderer::sortByDistance(const Vector3& refPoint, const PixelData& positions, UINT32 numParticles, 
 		UINT32 stride, Vector<UINT32>& indices)
 	{
-		struct ParticleSortData
-		{
-			ParticleSortData(float key, UINT32 idx)
-				:key(key), idx(idx)
-			{ }
-
-			float key;
-			UINT32 idx;
-		};
-
 		const UINT32 size = positions.getWidth();
 		UINT8* positionPtr = positions.getData();
 
 		bs_frame_mark();
 		{
-			FrameVector<ParticleSortData> sortData;
-			sortData.reserve(numParticles);
+			FrameVector<UINT32> keys(numParticles);
+			FrameVector<UINT32> tmpKeys(numParticles);
+			FrameVector<UINT32> tmpIndices(numParticles);
 
 			UINT32 x = 0;
 			for (UINT32 i = 0; i < numParticles; i++)
 			{
 				const Vector3& position = *(Vector3*)positionPtr;
 
+				// Inverted so the ascending radix sort outputs the furthest particles first
 				float distance = refPoint.squaredDistance(position);
-				sortData.emplace_back(distance, i);
+				keys[i] = ~floatToSortableUInt(distance);
+				indices[i] = i;
 
 				positionPtr += sizeof(float) * stride;
 				x++;
@@ -417,14 +411,7 @@ namespace bs { namespace ct
 				}
 			}
 
-			std::sort(sortData.begin(), sortData.end(),
-				[](const ParticleSortData& lhs, const ParticleSortData& rhs)
-			{
-				return rhs.key < lhs.key;
-			});
-
-			for (UINT32 i = 0; i < numParticles; i++)
-				indices[i] = sortData[i].idx;
+			radixSortParallel(keys.data(), indices.data(), tmpKeys.data(), tmpIndices.data(), numParticles);
 		}
 		bs_frame_clear();
 	}
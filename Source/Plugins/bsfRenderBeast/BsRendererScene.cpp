@@ -139,6 +139,7 @@ namespace bs {	namespace ct
 
 				mInfo.radialLights.push_back(RendererLight(light));
 				mInfo.radialLightWorldBounds.push_back(light->getBounds());
+				mInfo.radialLightOctree.add(lightId, light->getBounds());
 			}
 			else // Spot
 			{
@@ -147,6 +148,7 @@ namespace bs {	namespace ct
 
 				mInfo.spotLights.push_back(RendererLight(light));
 				mInfo.spotLightWorldBounds.push_back(light->getBounds());
+				mInfo.spotLightOctree.add(lightId, light->getBounds());
 			}
 		}
 	}
@@ -156,9 +158,15 @@ namespace bs {	namespace ct
 		UINT32 lightId = light->getRendererId();
 
 		if (light->getType() == LightType::Radial)
+		{
 			mInfo.radialLightWorldBounds[lightId] = light->getBounds();
+			mInfo.radialLightOctree.update(lightId, light->getBounds());
+		}
 		else if(light->getType() == LightType::Spot)
+		{
 			mInfo.spotLightWorldBounds[lightId] = light->getBounds();
+			mInfo.spotLightOctree.update(lightId, light->getBounds());
+		}
 	}
 
 	void RendererScene::unregisterLight(Light* light)
@@ -198,6 +206,7 @@ namespace bs {	namespace ct
 				// Last element is the one we want to erase
 				mInfo.radialLights.erase(mInfo.radialLights.end() - 1);
 				mInfo.radialLightWorldBounds.erase(mInfo.radialLightWorldBounds.end() - 1);
+				mInfo.radialLightOctree.remove(lightId);
 			}
 			else // Spot
 			{
@@ -216,6 +225,7 @@ namespace bs {	namespace ct
 				// Last element is the one we want to erase
 				mInfo.spotLights.erase(mInfo.spotLights.end() - 1);
 				mInfo.spotLightWorldBounds.erase(mInfo.spotLightWorldBounds.end() - 1);
+				mInfo.spotLightOctree.remove(lightId);
 			}
 		}
 	}
@@ -228,6 +238,8 @@ namespace bs {	namespace ct
 
 		mInfo.renderables.push_back(bs_new<RendererRenderable>());
 		mInfo.renderableCullInfos.push_back(CullInfo(renderable->getBounds(), renderable->getLayer()));
+		mInfo.renderableCullData.add(mInfo.renderableCullInfos.back());
+		mInfo.renderableOctree.add(renderableId, renderable->getBounds().getBox());
 
 		RendererRenderable* rendererRenderable = mInfo.renderables.back();
 		rendererRenderable->renderable = renderable;
@@ -430,6 +442,8 @@ namespace bs {	namespace ct
 
 		mInfo.renderables[renderableId]->updatePerObjectBuffer();
 		mInfo.renderableCullInfos[renderableId].bounds = renderable->getBounds();
+		mInfo.renderableCullData.setBounds(renderableId, renderable->getBounds());
+		mInfo.renderableOctree.update(renderableId, renderable->getBounds().getBox());
 	}
 
 	void RendererScene::unregisterRenderable(Renderable* renderable)
@@ -470,6 +484,8 @@ namespace bs {	namespace ct
 		// Last element is the one we want to erase
 		mInfo.renderables.erase(mInfo.renderables.end() - 1);
 		mInfo.renderableCullInfos.erase(mInfo.renderableCullInfos.end() - 1);
+		mInfo.renderableCullData.swapAndRemove(renderableId);
+		mInfo.renderableOctree.remove(renderableId);
 
 		bs_delete(rendererRenderable);
 	}
@@ -483,6 +499,7 @@ namespace bs {	namespace ct
 		RendererReflectionProbe& probeInfo = mInfo.reflProbes.back();
 
 		mInfo.reflProbeWorldBounds.push_back(probe->getBounds());
+		mInfo.reflProbeOctree.add(probeId, probe->getBounds());
 
 		// Find a spot in cubemap array
 		UINT32 numArrayEntries = (UINT32)mInfo.reflProbeCubemapArrayUsedSlots.size();
@@ -515,6 +532,7 @@ namespace bs {	namespace ct
 		// Should only get called if transform changes, any other major changes and ReflProbeInfo entry gets rebuild
 		UINT32 probeId = probe->getRendererId();
 		mInfo.reflProbeWorldBounds[probeId] = probe->getBounds();
+		mInfo.reflProbeOctree.update(probeId, probe->getBounds());
 
 		if (texture)
 		{
@@ -546,6 +564,7 @@ namespace bs {	namespace ct
 		// Last element is the one we want to erase
 		mInfo.reflProbes.erase(mInfo.reflProbes.end() - 1);
 		mInfo.reflProbeWorldBounds.erase(mInfo.reflProbeWorldBounds.end() - 1);
+		mInfo.reflProbeOctree.remove(probeId);
 	}
 
 	void RendererScene::setReflectionProbeArrayIndex(UINT32 probeIdx, UINT32 arrayIdx, bool markAsClean)
@@ -1177,12 +1196,20 @@ namespace bs {	namespace ct
 		{
 			const UINT32 rendererId = entry.particleSystem->getRendererId();
 
+			const UINT32 id = entry.particleSystem->getId();
+
 			AABox worldBounds = AABox::INF_BOX;
-			const auto iterFind = particleRenderData->cpuData.find(entry.particleSystem->getId());
+			const auto iterFind = particleRenderData->cpuData.find(id);
 			if(iterFind != particleRenderData->cpuData.end())
 				worldBounds = iterFind->second->bounds;
 			else if(entry.gpuParticleSystem)
 				worldBounds = entry.gpuParticleSystem->getBounds();
+			else
+			{
+				const auto iterFindCulled = particleRenderData->culledBounds.find(id);
+				if(iterFindCulled != particleRenderData->culledBounds.end())
+					worldBounds = iterFindCulled->second;
+			}
 
 			const ParticleSystemSettings& settings = entry.particleSystem->getSettings();
 			if (settings.simulationSpace == ParticleSimulationSpace::Local)
@@ -8,6 +8,7 @@
 #include "BsRendererParticles.h"
 #include "Shading/BsLightProbes.h"
 #include "Utility/BsSamplerOverrides.h"
+#include "Utility/BsSceneOctree.h"
 
 namespace bs 
 { 
@@ -36,6 +37,8 @@ namespace bs
 		// Renderables
 		Vector<RendererRenderable*> renderables;
 		Vector<CullInfo> renderableCullInfos;
+		CullInfoSoA renderableCullData; // Same as renderableCullInfos, in a layout suitable for batch culling
+		SceneOctree renderableOctree;
 
 		// Lights
 		Vector<RendererLight> directionalLights;
@@ -43,10 +46,13 @@ namespace bs
 		Vector<RendererLight> spotLights;
 		Vector<Sphere> radialLightWorldBounds;
 		Vector<Sphere> spotLightWorldBounds;
+		SceneOctree radialLightOctree;
+		SceneOctree spotLightOctree;
 
 		// Reflection probes
 		Vector<RendererReflectionProbe> reflProbes;
 		Vector<Sphere> reflProbeWorldBounds;
+		SceneOctree reflProbeOctree;
 		Vector<bool> reflProbeCubemapArrayUsedSlots;
 		SPtr<Texture> reflProbeCubemapsTex;
 
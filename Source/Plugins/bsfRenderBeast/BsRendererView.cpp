@@ -10,12 +10,75 @@
 #include "BsRendererLight.h"
 #include "BsRendererScene.h"
 #include "BsRenderBeast.h"
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs { namespace ct
 {
+	/** 
+	 * Renderables are culled by walking the scene octree if less than 1/N of them were visible during the last frame.
+	 * Otherwise testing all renderables linearly is faster.
+	 */
+	static constexpr UINT32 OCTREE_CULLING_VISIBLE_RATIO = 16;
+
 	PerCameraParamDef gPerCameraParamDef;
 	SkyboxParamDef gSkyboxParamDef;
 
+	void CullInfoSoA::add(const CullInfo& cullInfo)
+	{
+		for(UINT32 i = 0; i < 3; i++)
+		{
+			centers[i].push_back(0.0f);
+			extents[i].push_back(0.0f);
+		}
+
+		radii.push_back(0.0f);
+		layers.push_back(cullInfo.layer);
+
+		setBounds(size() - 1, cullInfo.bounds);
+	}
+
+	void CullInfoSoA::setBounds(UINT32 idx, const Bounds& bounds)
+	{
+		const AABox& box = bounds.getBox();
+		const Vector3 center = box.getCenter();
+		const Vector3 extent = box.getHalfSize();
+
+		for(UINT32 i = 0; i < 3; i++)
+		{
+			centers[i][idx] = center[i];
+			extents[i][idx] = extent[i];
+		}
+
+		// Sphere might not be centered on the box, expand it so it is while still fully containing the original
+		const Sphere& sphere = bounds.getSphere();
+		radii[idx] = sphere.getRadius() + sphere.getCenter().distance(center);
+	}
+
+	void CullInfoSoA::swapAndRemove(UINT32 idx)
+	{
+		const UINT32 lastIdx = size() - 1;
+		if(idx != lastIdx)
+		{
+			for(UINT32 i = 0; i < 3; i++)
+			{
+				centers[i][idx] = centers[i][lastIdx];
+				extents[i][idx] = extents[i][lastIdx];
+			}
+
+			radii[idx] = radii[lastIdx];
+			layers[idx] = layers[lastIdx];
+		}
+
+		for(UINT32 i = 0; i < 3; i++)
+		{
+			centers[i].pop_back();
+			extents[i].pop_back();
+		}
+
+		radii.pop_back();
+		layers.pop_back();
+	}
+
 	SkyboxMat::SkyboxMat()
 	{
 		if(mParams->hasTexture(GPT_FRAGMENT_PROGRAM, "gSkyTex"))
@@ -157,25 +220,28 @@ namespace bs { namespace ct
 		mTransparentQueue->clear();
 	}
 
-	void RendererView::determineVisible(const Vector<RendererRenderable*>& renderables, const Vector<CullInfo>& cullInfos,
-		Vector<bool>* visibility)
+	void RendererView::determineVisible(const Vector<RendererRenderable*>& renderables, const CullInfoSoA& cullInfos,
+		const SceneOctree& octree, Bitfield* visibility)
 	{
 		mVisibility.renderables.clear();
-		mVisibility.renderables.resize(renderables.size(), false);
+		mVisibility.renderables.resize((UINT32)renderables.size(), false);
 
 		if (mRenderSettings->overlayOnly)
 			return;
 
-		calculateVisibility(cullInfos, mVisibility.renderables);
+		if (mNumVisibleRenderables * OCTREE_CULLING_VISIBLE_RATIO < cullInfos.size())
+			mNumVisibleRenderables = calculateVisibility(cullInfos, octree, mVisibility.renderables);
+		else
+			mNumVisibleRenderables = calculateVisibility(cullInfos, mVisibility.renderables);
 
 		if(visibility != nullptr)
 		{
-			for (UINT32 i = 0; i < (UINT32)renderables.size(); i++)
-			{
-				bool visible = (*visibility)[i];
+			const UINT32 numDwords = Math::divideAndRoundUp((UINT32)renderables.size(), 32U);
+			const UINT32* src = mVisibility.renderables.data();
+			UINT32* dst = visibility->data();
 
-				(*visibility)[i] = visible || mVisibility.renderables[i];
-			}
+			for (UINT32 i = 0; i < numDwords; i++)
+				dst[i] |= src[i];
 		}
 	}
 
@@ -202,7 +268,7 @@ namespace bs { namespace ct
 	}
 
 	void RendererView::determineVisible(const Vector<RendererLight>& lights, const Vector<Sphere>& bounds, 
-		LightType lightType, Vector<bool>* visibility)
+		const SceneOctree& octree, LightType lightType, Vector<bool>* visibility)
 	{
 		// Special case for directional lights, they're always visible
 		if(lightType == LightType::Directional)
@@ -232,7 +298,7 @@ namespace bs { namespace ct
 		if (mRenderSettings->overlayOnly)
 			return;
 
-		calculateVisibility(bounds, *perViewVisibility);
+		calculateVisibility(bounds, octree, *perViewVisibility);
 
 		if(visibility != nullptr)
 		{
@@ -245,39 +311,92 @@ namespace bs { namespace ct
 		}
 	}
 
-	void RendererView::calculateVisibility(const Vector<CullInfo>& cullInfos, Vector<bool>& visibility) const
+	UINT32 RendererView::calculateVisibility(const CullInfoSoA& cullInfos, Bitfield& visibility) const
 	{
 		UINT64 cameraLayers = mProperties.visibleLayers;
 		const ConvexVolume& worldFrustum = mProperties.cullFrustum;
 
-		for (UINT32 i = 0; i < (UINT32)cullInfos.size(); i++)
+		// Cull in blocks of 32 objects, one output dword at a time. Layer test is done first, so blocks with no
+		// objects in visible layers can skip frustum culling entirely.
+		const UINT32 numObjects = cullInfos.size();
+		UINT32* output = visibility.data();
+		UINT32 numVisible = 0;
+		for (UINT32 blockStart = 0; blockStart < numObjects; blockStart += 32)
 		{
-			if ((cullInfos[i].layer & cameraLayers) == 0)
-				continue;
+			const UINT32 blockSize = std::min(numObjects - blockStart, 32U);
 
-			// Do frustum culling
-			// Note: This is bound to be a bottleneck at some point. When it is ensure that intersect methods use vector
-			// operations, as it is trivial to update them. Also consider spatial partitioning.
-			const Sphere& boundingSphere = cullInfos[i].bounds.getSphere();
-			if (worldFrustum.intersects(boundingSphere))
+			UINT32 layerMask = 0;
+			for (UINT32 i = 0; i < blockSize; i++)
 			{
-				// More precise with the box
-				const AABox& boundingBox = cullInfos[i].bounds.getBox();
-
-				if (worldFrustum.intersects(boundingBox))
-					visibility[i] = true;
+				if ((cullInfos.layers[blockStart + i] & cameraLayers) != 0)
+					layerMask |= 1U << i;
 			}
+
+			if (layerMask == 0)
+				continue;
+
+			const float* const centers[3] = 
+			{ 
+				cullInfos.centers[0].data() + blockStart,
+				cullInfos.centers[1].data() + blockStart,
+				cullInfos.centers[2].data() + blockStart
+			};
+
+			const float* const extents[3] = 
+			{ 
+				cullInfos.extents[0].data() + blockStart,
+				cullInfos.extents[1].data() + blockStart,
+				cullInfos.extents[2].data() + blockStart
+			};
+
+			UINT32 frustumMask = 0;
+			worldFrustum.intersects(centers, extents, cullInfos.radii.data() + blockStart, blockSize, &frustumMask);
+
+			const UINT32 visibleMask = layerMask & frustumMask;
+			output[blockStart >> 5] |= visibleMask;
+			numVisible += Bitwise::popcnt(visibleMask);
 		}
+
+		return numVisible;
 	}
 
-	void RendererView::calculateVisibility(const Vector<Sphere>& bounds, Vector<bool>& visibility) const
+	UINT32 RendererView::calculateVisibility(const CullInfoSoA& cullInfos, const SceneOctree& octree, 
+		Bitfield& visibility) const
 	{
+		UINT64 cameraLayers = mProperties.visibleLayers;
 		const ConvexVolume& worldFrustum = mProperties.cullFrustum;
 
-		for (UINT32 i = 0; i < (UINT32)bounds.size(); i++)
+		// Octree only tests the boxes, the layer & sphere tests are done here
+		UINT32 numVisible = 0;
+		SceneOctree::VolumeIterator iter(octree, worldFrustum);
+		while (iter.moveNext())
 		{
-			if (worldFrustum.intersects(bounds[i]))
-				visibility[i] = true;
+			const UINT32 idx = iter.getId();
+			if ((cullInfos.layers[idx] & cameraLayers) == 0)
+				continue;
+
+			const Vector3 center(cullInfos.centers[0][idx], cullInfos.centers[1][idx], cullInfos.centers[2][idx]);
+			if (!worldFrustum.intersects(Sphere(center, cullInfos.radii[idx])))
+				continue;
+
+			visibility[idx] = true;
+			numVisible++;
+		}
+
+		return numVisible;
+	}
+
+	void RendererView::calculateVisibility(const Vector<Sphere>& bounds, const SceneOctree& octree, 
+		Vector<bool>& visibility) const
+	{
+		const ConvexVolume& worldFrustum = mProperties.cullFrustum;
+
+		SceneOctree::VolumeIterator iter(octree, worldFrustum);
+		while (iter.moveNext())
+		{
+			const UINT32 idx = iter.getId();
+			if (worldFrustum.intersects(bounds[idx]))
+				visibility[idx] = true;
 		}
 	}
 
@@ -293,12 +412,53 @@ namespace bs { namespace ct
 	}
 
 	void RendererView::queueRenderElements(const SceneInfo& sceneInfo)
+	{
+		const UINT32 numChunks = beginQueueRenderElements(sceneInfo);
+
+		auto worker = [this, &sceneInfo](UINT32 begin, UINT32 end)
+		{
+			for(UINT32 i = begin; i < end; i++)
+				queueRenderElements(sceneInfo, i);
+		};
+
+		TaskScheduler::instance().parallelFor(0, numChunks, 1, worker);
+		endQueueRenderElements();
+	}
+
+	UINT32 RendererView::beginQueueRenderElements(const SceneInfo& sceneInfo)
 	{
 		if (mRenderSettings->overlayOnly)
-			return;
+			mNumQueueChunks = 0;
+		else
+		{
+			const auto numObjects = (UINT32)(sceneInfo.renderables.size() + sceneInfo.particleSystems.size());
+			mNumQueueChunks = Math::divideAndRoundUp(numObjects, QUEUE_CHUNK_SIZE);
+		}
+
+		// Only ever grow, so the queues in existing chunks can keep their allocations
+		if (mQueueChunks.size() < mNumQueueChunks)
+			mQueueChunks.resize(mNumQueueChunks);
+
+		return mNumQueueChunks;
+	}
+
+	void RendererView::queueRenderElements(const SceneInfo& sceneInfo, UINT32 chunkIdx)
+	{
+		RenderQueueChunk& chunk = mQueueChunks[chunkIdx];
+		chunk.deferredOpaque.clear();
+		chunk.forwardOpaque.clear();
+		chunk.transparent.clear();
 
-		// Update per-object param buffers and queue render elements
-		for(UINT32 i = 0; i < (UINT32)sceneInfo.renderables.size(); i++)
+		// Renderables come first, followed by particle systems
+		const auto numRenderables = (UINT32)sceneInfo.renderables.size();
+		const auto numParticleSystems = (UINT32)sceneInfo.particleSystems.size();
+
+		const UINT32 begin = chunkIdx * QUEUE_CHUNK_SIZE;
+		const UINT32 end = std::min(begin + QUEUE_CHUNK_SIZE, numRenderables + numParticleSystems);
+
+		// Queue render elements. Per-object param buffers are updated separately, when a renderable is updated
+		// (RendererScene::updateRenderable) and flushed before rendering (RendererScene::prepareRenderable).
+		for(UINT32 i = begin; i < std::min(end, numRenderables); i++)
 		{
 			if (!mVisibility.renderables[i])
 				continue;
@@ -312,16 +472,18 @@ namespace bs { namespace ct
 				ShaderFlags shaderFlags = renderElem.material->getShader()->getFlags();
 
 				if (shaderFlags.isSet(ShaderFlag::Transparent))
-					mTransparentQueue->add(&renderElem, distanceToCamera);
+					chunk.transparent.add(&renderElem, distanceToCamera);
 				else if (shaderFlags.isSet(ShaderFlag::Forward))
-					mForwardOpaqueQueue->add(&renderElem, distanceToCamera);
+					chunk.forwardOpaque.add(&renderElem, distanceToCamera);
 				else
-					mDeferredOpaqueQueue->add(&renderElem, distanceToCamera);
+					chunk.deferredOpaque.add(&renderElem, distanceToCamera);
 			}
 		}
 
-		// Queue render elements
-		for(UINT32 i = 0; i < (UINT32)sceneInfo.particleSystems.size(); i++)
+		// Queue particle system render elements
+		const UINT32 particleBegin = std::max(begin, numRenderables) - numRenderables;
+		const UINT32 particleEnd = std::max(end, numRenderables) - numRenderables;
+		for(UINT32 i = particleBegin; i < particleEnd; i++)
 		{
 			if (!mVisibility.particleSystems[i])
 				continue;
@@ -336,11 +498,24 @@ namespace bs { namespace ct
 			ShaderFlags shaderFlags = renderElem.material->getShader()->getFlags();
 
 			if (shaderFlags.isSet(ShaderFlag::Transparent))
-				mTransparentQueue->add(&renderElem, distanceToCamera);
+				chunk.transparent.add(&renderElem, distanceToCamera);
 			else if (shaderFlags.isSet(ShaderFlag::Forward))
-				mForwardOpaqueQueue->add(&renderElem, distanceToCamera);
+				chunk.forwardOpaque.add(&renderElem, distanceToCamera);
 			else
-				mDeferredOpaqueQueue->add(&renderElem, distanceToCamera);
+				chunk.deferredOpaque.add(&renderElem, distanceToCamera);
+		}
+	}
+
+	void RendererView::endQueueRenderElements()
+	{
+		// Merge in chunk order, so the queues end up the same as if they were built on a single thread
+		for(UINT32 i = 0; i < mNumQueueChunks; i++)
+		{
+			const RenderQueueChunk& chunk = mQueueChunks[i];
+
+			mDeferredOpaqueQueue->append(chunk.deferredOpaque);
+			mForwardOpaqueQueue->append(chunk.forwardOpaque);
+			mTransparentQueue->append(chunk.transparent);
 		}
 
 		mForwardOpaqueQueue->sort();
@@ -602,21 +777,56 @@ namespace bs { namespace ct
 			return;
 
 		// Calculate renderable visibility per view
-		mVisibility.renderables.resize(sceneInfo.renderables.size(), false);
-		mVisibility.renderables.assign(sceneInfo.renderables.size(), false);
+		mVisibility.renderables.resize((UINT32)sceneInfo.renderables.size(), false);
+		mVisibility.renderables.reset(false);
 
 		mVisibility.particleSystems.resize(sceneInfo.particleSystems.size(), false);
 		mVisibility.particleSystems.assign(sceneInfo.particleSystems.size(), false);
 
 		for(UINT32 i = 0; i < numViews; i++)
 		{
-			mViews[i]->determineVisible(sceneInfo.renderables, sceneInfo.renderableCullInfos, &mVisibility.renderables);
+			mViews[i]->determineVisible(sceneInfo.renderables, sceneInfo.renderableCullData, sceneInfo.renderableOctree,
+				&mVisibility.renderables);
 			mViews[i]->determineVisible(sceneInfo.particleSystems, sceneInfo.particleSystemBounds, &mVisibility.particleSystems);
 		}
 		
-		// Generate render queues per camera
+		// Generate render queues per camera. Chunks of all views are processed together, as views don't depend on each
+		// other and it lets the work be spread evenly over the workers even if there are only a few views.
+		mQueueChunkOffsets.resize(numViews + 1);
+
+		UINT32 numChunks = 0;
 		for(UINT32 i = 0; i < numViews; i++)
-			mViews[i]->queueRenderElements(sceneInfo);
+		{
+			mQueueChunkOffsets[i] = numChunks;
+			numChunks += mViews[i]->beginQueueRenderElements(sceneInfo);
+		}
+
+		mQueueChunkOffsets[numViews] = numChunks;
+
+		auto queueWorker = [this, &sceneInfo](UINT32 begin, UINT32 end)
+		{
+			// Find the view the first chunk belongs to
+			auto iterFind = std::upper_bound(mQueueChunkOffsets.begin(), mQueueChunkOffsets.end(), begin);
+			auto viewIdx = (UINT32)(iterFind - mQueueChunkOffsets.begin()) - 1;
+
+			for(UINT32 i = begin; i < end; i++)
+			{
+				while(i >= mQueueChunkOffsets[viewIdx + 1])
+					viewIdx++;
+
+				mViews[viewIdx]->queueRenderElements(sceneInfo, i - mQueueChunkOffsets[viewIdx]);
+			}
+		};
+
+		TaskScheduler::instance().parallelFor(0, numChunks, 1, queueWorker);
+
+		auto sortWorker = [this](UINT32 begin, UINT32 end)
+		{
+			for(UINT32 i = begin; i < end; i++)
+				mViews[i]->endQueueRenderElements();
+		};
+
+		TaskScheduler::instance().parallelFor(0, numViews, 1, sortWorker);
 
 		// Calculate light visibility for all views
 		const auto numRadialLights = (UINT32)sceneInfo.radialLights.size();
@@ -632,11 +842,11 @@ namespace bs { namespace ct
 			if (mViews[i]->getRenderSettings().overlayOnly)
 				continue;
 
-			mViews[i]->determineVisible(sceneInfo.radialLights, sceneInfo.radialLightWorldBounds, LightType::Radial,
-				&mVisibility.radialLights);
+			mViews[i]->determineVisible(sceneInfo.radialLights, sceneInfo.radialLightWorldBounds, 
+				sceneInfo.radialLightOctree, LightType::Radial, &mVisibility.radialLights);
 
-			mViews[i]->determineVisible(sceneInfo.spotLights, sceneInfo.spotLightWorldBounds, LightType::Spot,
-				&mVisibility.spotLights);
+			mViews[i]->determineVisible(sceneInfo.spotLights, sceneInfo.spotLightWorldBounds, 
+				sceneInfo.spotLightOctree, LightType::Spot, &mVisibility.spotLights);
 		}
 
 		// Calculate refl. probe visibility for all views
@@ -653,7 +863,8 @@ namespace bs { namespace ct
 			if (viewProps.capturingReflections)
 				continue;
 
-			mViews[i]->calculateVisibility(sceneInfo.reflProbeWorldBounds, mVisibility.reflProbes);
+			mViews[i]->calculateVisibility(sceneInfo.reflProbeWorldBounds, sceneInfo.reflProbeOctree, 
+				mVisibility.reflProbes);
 		}
 
 		// Organize light and refl. probe visibility infomation in a more GPU friendly manner
@@ -8,6 +8,7 @@
 #include "Renderer/BsRenderSettings.h"
 #include "Math/BsBounds.h"
 #include "Math/BsConvexVolume.h"
+#include "Utility/BsBitfield.h"
 #include "Shading/BsLightGrid.h"
 #include "Shading/BsShadowRendering.h"
 #include "BsRendererView.h"
@@ -19,6 +20,7 @@ namespace bs { namespace ct
 {
 	struct SceneInfo;
 	class RendererLight;
+	class SceneOctree;
 
 	/** @addtogroup RenderBeast
 	 *  @{
@@ -197,7 +199,7 @@ namespace bs { namespace ct
 	/** Information whether certain scene objects are visible in a view, per object type. */
 	struct VisibilityInfo
 	{
-		Vector<bool> renderables;
+		Bitfield renderables;
 		Vector<bool> radialLights;
 		Vector<bool> spotLights;
 		Vector<bool> reflProbes;
@@ -215,6 +217,30 @@ namespace bs { namespace ct
 		UINT64 layer;
 	};
 
+	/** 
+	 * Culling information for a set of objects, stored in structure-of-arrays form so multiple objects can be culled at
+	 * once using SIMD instructions. 
+	 */
+	struct CullInfoSoA
+	{
+		/** Appends a new entry to the end of the set. */
+		void add(const CullInfo& cullInfo);
+
+		/** Updates the bounds of an existing entry. */
+		void setBounds(UINT32 idx, const Bounds& bounds);
+
+		/** Moves the last entry in place of the entry at @p idx, and then removes the last entry. */
+		void swapAndRemove(UINT32 idx);
+
+		/** Returns the number of entries in the set. */
+		UINT32 size() const { return (UINT32)radii.size(); }
+
+		Vector<float> centers[3];
+		Vector<float> extents[3];
+		Vector<float> radii;
+		Vector<UINT64> layers;
+	};
+
 	/**	Renderer information specific to a single render target. */
 	struct RendererRenderTarget
 	{
@@ -277,6 +303,9 @@ namespace bs { namespace ct
 		 * @param[in]	renderables			A set of renderable objects to iterate over and determine visibility for.
 		 * @param[in]	cullInfos			A set of world bounds & other information relevant for culling the provided
 		 *									renderable objects. Must be the same size as the @p renderables array.
+		 * @param[in]	octree				Spatial index containing the world bounds of the provided renderable objects.
+		 *									Used instead of testing every object individually when only a small part of
+		 *									the scene is expected to be visible.
 		 * @param[out]	visibility			Output parameter that will have the true bit set for any visible renderable
 		 *									object. If the bit for an object is already set to true, the method will never
 		 *									change it to false which allows the same bitfield to be provided to multiple
@@ -285,8 +314,8 @@ namespace bs { namespace ct
 		 *									As a side-effect, per-view visibility data is also calculated and can be
 		 *									retrieved by calling getVisibilityMask().
 		 */
-		void determineVisible(const Vector<RendererRenderable*>& renderables, const Vector<CullInfo>& cullInfos,
-			Vector<bool>* visibility = nullptr);
+		void determineVisible(const Vector<RendererRenderable*>& renderables, const CullInfoSoA& cullInfos,
+			const SceneOctree& octree, Bitfield* visibility = nullptr);
 
 		/**
 		 * Populates view render queues by determining visible particle systems. 
@@ -311,6 +340,7 @@ namespace bs { namespace ct
 		 * @param[in]	lights				A set of lights to determine visibility for.
 		 * @param[in]	bounds				Bounding sphere for each provided light. Must be the same size as the @p lights
 		 *									array.
+		 * @param[in]	octree				Spatial index containing the bounds of the provided lights.
 		 * @param[in]	type				Type of all the lights in the @p lights array.
 		 * @param[out]	visibility			Output parameter that will have the true bit set for any visible light. If the
 		 *									bit for a light is already set to true, the method will never change it to false
@@ -320,20 +350,30 @@ namespace bs { namespace ct
 		 *									As a side-effect, per-view visibility data is also calculated and can be
 		 *									retrieved by calling getVisibilityMask().
 		 */
-		void determineVisible(const Vector<RendererLight>& lights, const Vector<Sphere>& bounds, LightType type, 
-			Vector<bool>* visibility = nullptr);
+		void determineVisible(const Vector<RendererLight>& lights, const Vector<Sphere>& bounds, 
+			const SceneOctree& octree, LightType type, Vector<bool>* visibility = nullptr);
 
 		/**
 		 * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
-		 * which entry is or isn't visible by this view. Both inputs must be arrays of the same size.
+		 * which entry is or isn't visible by this view. Both inputs must be arrays of the same size. Returns the number of
+		 * visible entries.
+		 */
+		UINT32 calculateVisibility(const CullInfoSoA& cullInfos, Bitfield& visibility) const;
+
+		/**
+		 * Same as calculateVisibility(const CullInfoSoA&, Bitfield&), except only the objects whose bounds are found 
+		 * in the frustum by walking the provided spatial index are tested. The index must contain the same objects as
+		 * @p cullInfos.
 		 */
-		void calculateVisibility(const Vector<CullInfo>& cullInfos, Vector<bool>& visibility) const;
+		UINT32 calculateVisibility(const CullInfoSoA& cullInfos, const SceneOctree& octree, Bitfield& visibility) const;
 
 		/**
 		 * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
-		 * which entry is or isn't visible by this view. Both inputs must be arrays of the same size.
+		 * which entry is or isn't visible by this view. Both inputs must be arrays of the same size. Only the entries
+		 * found in the frustum by walking the provided spatial index are tested.
 		 */
-		void calculateVisibility(const Vector<Sphere>& bounds, Vector<bool>& visibility) const;
+		void calculateVisibility(const Vector<Sphere>& bounds, const SceneOctree& octree, 
+			Vector<bool>& visibility) const;
 
 		/**
 		 * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
@@ -348,6 +388,25 @@ namespace bs { namespace ct
 		 */
 		void queueRenderElements(const SceneInfo& sceneInfo);
 
+		/**
+		 * Prepares for building the render queues in parallel. Scene objects are split into chunks that can be queued
+		 * independently by calling queueRenderElements(const SceneInfo&, UINT32) for each chunk, after which
+		 * endQueueRenderElements() must be called. Returns the number of chunks.
+		 */
+		UINT32 beginQueueRenderElements(const SceneInfo& sceneInfo);
+
+		/**
+		 * Inserts visible renderable elements in the specified chunk into a set of render queues specific to that chunk.
+		 * Calls for different chunks can be made from different threads.
+		 */
+		void queueRenderElements(const SceneInfo& sceneInfo, UINT32 chunkIdx);
+
+		/** 
+		 * Merges the per-chunk render queues filled by queueRenderElements(const SceneInfo&, UINT32) into the view's
+		 * render queues and sorts them. 
+		 */
+		void endQueueRenderElements();
+
 		/** Returns the visibility mask calculated with the last call to determineVisible(). */
 		const VisibilityInfo& getVisibilityMasks() const { return mVisibility; }
 
@@ -415,6 +474,17 @@ namespace bs { namespace ct
 		 */
 		static Vector2 getNDCZToDeviceZ();
 	private:
+		/** Render queues filled by a single chunk of scene objects, when building render queues in parallel. */
+		struct RenderQueueChunk
+		{
+			RenderQueue deferredOpaque;
+			RenderQueue forwardOpaque;
+			RenderQueue transparent;
+		};
+
+		/** Number of scene objects processed in a single chunk when building render queues. */
+		static constexpr UINT32 QUEUE_CHUNK_SIZE = 256;
+
 		RendererViewProperties mProperties;
 		RENDERER_VIEW_TARGET_DESC mTargetDesc;
 		Camera* mCamera;
@@ -423,12 +493,16 @@ namespace bs { namespace ct
 		SPtr<RenderQueue> mForwardOpaqueQueue;
 		SPtr<RenderQueue> mTransparentQueue;
 
+		Vector<RenderQueueChunk> mQueueChunks;
+		UINT32 mNumQueueChunks = 0;
+
 		RenderCompositor mCompositor;
 		SPtr<RenderSettings> mRenderSettings;
 		UINT32 mRenderSettingsHash;
 
 		SPtr<GpuParamBlockBuffer> mParamBuffer;
 		VisibilityInfo mVisibility;
+		UINT32 mNumVisibleRenderables = 0;
 		LightGrid mLightGrid;
 		UINT32 mViewIdx;
 	};
@@ -489,6 +563,7 @@ namespace bs { namespace ct
 	private:
 		Vector<RendererView*> mViews;
 		VisibilityInfo mVisibility;
+		Vector<UINT32> mQueueChunkOffsets;
 		bool mIsMainPass = false;
 
 		VisibleLightData mVisibleLightData;
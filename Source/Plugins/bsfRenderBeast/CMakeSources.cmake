@@ -53,12 +53,14 @@ set(BS_RENDERBEAST_INC_UTILITY
 	"Utility/BsSamplerOverrides.h"
 	"Utility/BsRendererTextures.h"
 	"Utility/BsTextureRowAllocator.h"
+	"Utility/BsSceneOctree.h"
 )
 
 set(BS_RENDERBEAST_SRC_UTILITY
 	"Utility/BsGpuSort.cpp"
 	"Utility/BsSamplerOverrides.cpp"
 	"Utility/BsRendererTextures.cpp"
+	"Utility/BsSceneOctree.cpp"
 )
 
 source_group("" FILES ${BS_RENDERBEAST_INC_NOFILTER} ${BS_RENDERBEAST_SRC_NOFILTER})
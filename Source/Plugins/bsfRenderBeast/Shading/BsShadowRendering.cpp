@@ -474,9 +474,13 @@ namespace bs { namespace ct
 			{
 				FrameVector<Command> commands[4];
 
-				// Make a list of relevant renderables and prepare them for rendering
-				for (UINT32 i = 0; i < sceneInfo.renderables.size(); i++)
+				// Make a list of relevant renderables and prepare them for rendering. Only renderables in the octree nodes
+				// overlapping the shadow volume are considered.
+				SceneOctree::VolumeIterator iter(sceneInfo.renderableOctree, opt.boundingVolume);
+				while (iter.moveNext())
 				{
+					const UINT32 i = iter.getId();
+
 					const Sphere& bounds = sceneInfo.renderableCullInfos[i].bounds.getSphere();
 					if (!opt.intersects(bounds))
 						continue;
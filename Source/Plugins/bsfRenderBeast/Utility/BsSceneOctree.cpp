@@ -0,0 +1,59 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Utility/BsSceneOctree.h"
+
+namespace bs { namespace ct
+{
+	simd::AABox SceneOctreeOptions::getBounds(UINT32 elem, void* context)
+	{
+		SceneOctree* owner = (SceneOctree*)context;
+		return owner->mBounds[elem];
+	}
+
+	void SceneOctreeOptions::setElementId(UINT32 elem, const OctreeElementId& id, void* context)
+	{
+		SceneOctree* owner = (SceneOctree*)context;
+		owner->mElementIds[elem] = id;
+	}
+
+	SceneOctree::SceneOctree()
+		:mOctree(Vector3::ZERO, WORLD_EXTENT, this)
+	{ }
+
+	void SceneOctree::add(UINT32 id, const simd::AABox& bounds)
+	{
+		assert(id == size());
+
+		mBounds.push_back(bounds);
+		mElementIds.push_back(OctreeElementId());
+
+		mOctree.addElement(id);
+	}
+
+	void SceneOctree::update(UINT32 id, const simd::AABox& bounds)
+	{
+		mOctree.removeElement(mElementIds[id]);
+
+		mBounds[id] = bounds;
+		mOctree.addElement(id);
+	}
+
+	void SceneOctree::remove(UINT32 id)
+	{
+		const UINT32 lastId = size() - 1;
+
+		mOctree.removeElement(mElementIds[id]);
+
+		if(id != lastId)
+		{
+			// Re-insert the last object under the removed object's ID
+			mOctree.removeElement(mElementIds[lastId]);
+
+			mBounds[id] = mBounds[lastId];
+			mOctree.addElement(id);
+		}
+
+		mBounds.erase(mBounds.end() - 1);
+		mElementIds.erase(mElementIds.end() - 1);
+	}
+}}
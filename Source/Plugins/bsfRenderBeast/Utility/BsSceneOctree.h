@@ -0,0 +1,87 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsRenderBeastPrerequisites.h"
+#include "Utility/BsOctree.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup RenderBeast
+	 *  @{
+	 */
+
+	/** Options for the octree used by SceneOctree. Elements are object IDs, and the context is the owning SceneOctree. */
+	struct SceneOctreeOptions
+	{
+		enum { LoosePadding = 16 };
+		enum { MinElementsPerNode = 8 };
+		enum { MaxElementsPerNode = 16 };
+		enum { MaxDepth = 12 };
+
+		static simd::AABox getBounds(UINT32 elem, void* context);
+		static void setElementId(UINT32 elem, const OctreeElementId& id, void* context);
+	};
+
+	/**
+	 * Spatial index over a set of scene objects of the same type (e.g. renderables or lights), used for accelerating
+	 * culling of large scenes. Objects are identified by their renderer ID, and removal mirrors the swap-and-pop removal
+	 * used by the scene object arrays.
+	 */
+	class SceneOctree
+	{
+		typedef Octree<UINT32, SceneOctreeOptions> OctreeType;
+	public:
+		/** Iterates over IDs of all objects whose bounds intersect the provided volume. */
+		class VolumeIterator
+		{
+		public:
+			VolumeIterator(const SceneOctree& owner, const ConvexVolume& volume)
+				:mIter(owner.mOctree, volume)
+			{ }
+
+			/**
+			 * Moves to the next intersecting object. Must be called at least once before calling getId(). Returns false
+			 * when there are no more objects.
+			 */
+			bool moveNext() { return mIter.moveNext(); }
+
+			/** Returns the ID of the current object. */
+			UINT32 getId() const { return mIter.getElement(); }
+
+		private:
+			OctreeType::VolumeIntersectIterator mIter;
+		};
+
+		SceneOctree();
+		SceneOctree(const SceneOctree&) = delete;
+		SceneOctree& operator=(const SceneOctree&) = delete;
+
+		/** Registers a new object. @p id must be equal to the current number of objects in the index. */
+		void add(UINT32 id, const simd::AABox& bounds);
+
+		/** Moves an existing object to new bounds. */
+		void update(UINT32 id, const simd::AABox& bounds);
+
+		/**
+		 * Removes an object. If the object isn't the last one, the last object takes over its ID, in the same way as the
+		 * scene arrays are updated on removal.
+		 */
+		void remove(UINT32 id);
+
+		/** Returns the number of objects in the index. */
+		UINT32 size() const { return (UINT32)mBounds.size(); }
+
+	private:
+		friend struct SceneOctreeOptions;
+
+		/** Half-size of the root node. Objects outside of it are still supported, but are always tested. */
+		static constexpr float WORLD_EXTENT = 8192.0f;
+
+		OctreeType mOctree;
+		Vector<simd::AABox> mBounds;
+		Vector<OctreeElementId> mElementIds;
+	};
+
+	/** @} */
+}}